@@ -1,5 +1,6 @@
 #include "App.h"
 #include "model/ProjectSerializer.h"
+#include "model/StartupProfile.h"
 #include "model/UndoManager.h"
 #include "ui/ChainScreen.h"
 #include "ui/ChannelScreen.h"
@@ -7,6 +8,7 @@
 #include "ui/MixerScreen.h"
 #include "ui/PatternScreen.h"
 #include "ui/SongScreen.h"
+#include <sstream>
 
 // Groove names for cycling
 const char *App::grooveNames_[5] = {"Straight", "Swing 50%", "Swing 66%",
@@ -17,15 +19,25 @@ App::App() {
   setWantsKeyboardFocus(true);
   addKeyListener(this);
 
-  // Initialize preset manager
+  // Initialize preset manager (user presets follow from the background)
   presetManager_.initialize();
 
   // Set up audio
   audioEngine_.setProject(&project_);
 
+  model::StartupProfile::Phase audioPhase("Audio device");
   deviceManager_.initialiseWithDefaultDevices(0, 2);
+  preferJackDevice();
   audioSourcePlayer_.setSource(&audioEngine_);
   deviceManager_.addAudioCallback(&audioSourcePlayer_);
+  audioPhase.end();
+
+  // MIDI input plays instruments directly, sample-accurately within a block
+  audioEngine_.setMidiInput(&midiInput_);
+  midiInput_.attach(deviceManager_);
+
+  // Record to disk taps the engine's output, so it must be set before playing
+  audioEngine_.setDiskRecorder(&diskRecorder_);
 
   // Create key handler
   keyHandler_ = std::make_unique<input::KeyHandler>(modeManager_);
@@ -46,6 +58,8 @@ App::App() {
   };
   keyHandler_->onPlayStop = [this]() {
     if (audioEngine_.isPlaying()) {
+      if (recordMode_)
+        stopRecording();
       audioEngine_.stop();
     } else {
       // Set play mode based on current screen
@@ -71,12 +85,14 @@ App::App() {
 
   // Create screens (1=Song, 2=Chain, 3=Pattern, 4=Instrument, 5=Channel,
   // 6=Mixer)
+  model::StartupProfile::Phase screensPhase("Screens");
   screens_[0] = std::make_unique<ui::SongScreen>(project_, modeManager_);
   screens_[1] = std::make_unique<ui::ChainScreen>(project_, modeManager_);
   screens_[2] = std::make_unique<ui::PatternScreen>(project_, modeManager_);
   screens_[3] = std::make_unique<ui::InstrumentScreen>(project_, modeManager_);
   screens_[4] = std::make_unique<ui::ChannelScreen>(project_, modeManager_);
   screens_[5] = std::make_unique<ui::MixerScreen>(project_, modeManager_);
+  screensPhase.end();
 
   // Give screens access to audio engine for playhead display
   for (auto &screen : screens_) {
@@ -94,9 +110,18 @@ App::App() {
 
   // Initialize audio settings popup (hidden by default)
   audioSettingsPopup_ =
-      std::make_unique<ui::AudioSettingsPopup>(deviceManager_);
+      std::make_unique<ui::AudioSettingsPopup>(deviceManager_, &midiInput_);
   addChildComponent(audioSettingsPopup_.get());
 
+  // Analyser (hidden, and not tapping the engine, until :scope)
+  analyserView_ = std::make_unique<ui::AnalyserView>(audioEngine_);
+  addChildComponent(analyserView_.get());
+
+  // Memory debug panel (hidden, and not collecting, until :memory)
+  memoryPanel_ = std::make_unique<ui::MemoryPanel>(
+      [this]() { return collectMemoryUsage(); });
+  addChildComponent(memoryPanel_.get());
+
   // Initialize Tip Me button (mouse-only, no keyboard focus)
   tipMeButton_.setColour(juce::TextButton::buttonColourId,
                          juce::Colour(0xffff5e5b));
@@ -147,8 +172,33 @@ App::App() {
       previewNoteCounter_ = PREVIEW_NOTE_FRAMES; // Start countdown to release
     };
     instrumentScreen->setPresetManager(&presetManager_);
+    instrumentScreen->setPreviewRenderer(&previewRenderer_);
+
+    // DX7 cartridges load in the background and go to the screen once in
+    auto dxBank = std::make_shared<model::DX7PresetBank>();
+    instrumentScreen->expectDXPresetBank();
+    auto dxPhase = std::make_shared<model::StartupProfile::Phase>(
+        "DX7 banks (background)");
+    jobScheduler_->submit(
+        model::JobScheduler::Priority::Prefetch, startupToken_,
+        [dxBank](const model::JobScheduler::CancellationToken &) {
+          dxBank->ensureLoaded();
+        },
+        [instrumentScreen, dxBank, dxPhase]() {
+          instrumentScreen->adoptDXPresetBank(std::move(*dxBank));
+          dxPhase->end();
+        });
   }
 
+  // Rendered preset auditions play through the engine's preview voice
+  previewRenderer_.onClipReady =
+      [this](std::shared_ptr<const audio::PreviewClip> clip) {
+        audioEngine_.playPreviewClip(std::move(clip));
+      };
+
+  // Background preset rescan finished with changes - refresh preset rows
+  presetManager_.onPresetsChanged = [this]() { repaint(); };
+
   // Wire up chain navigation from SongScreen (now index 0)
   if (auto *songScreen = dynamic_cast<ui::SongScreen *>(screens_[0].get())) {
     songScreen->onJumpToChain = [this](int chainIndex) {
@@ -435,19 +485,105 @@ App::App() {
     }
   };
 
+  keyHandler_->onMidiRoute = [this](int port, int instrument) {
+    midiInput_.setPortInstrument(port, instrument);
+    repaint();
+  };
+
+  keyHandler_->onQuantize = [this](int rows) { recorder_.setQuantize(rows); };
+
+  keyHandler_->onDiskRecord = [this](const std::string &args) {
+    startDiskRecording(args);
+  };
+  keyHandler_->onDiskStop = [this]() { stopDiskRecording(); };
+  keyHandler_->onImportTake = [this](const std::string &args) {
+    importTake(args);
+  };
+
+  keyHandler_->onReverbImpulse = [this](const std::string &arg) {
+    if (arg.empty()) {
+      chooseReverbImpulse();
+      return;
+    }
+    auto &mixer = project_.getMixer();
+    mixer.reverbImpulse =
+        arg == "off" ? std::string()
+                     : juce::File::getCurrentWorkingDirectory()
+                           .getChildFile(juce::String(arg))
+                           .getFullPathName()
+                           .toStdString();
+    applyReverbImpulse();
+    markDirty();
+  };
+  keyHandler_->onReverbTail = [this](float seconds) {
+    project_.getMixer().reverbMaxTail = std::clamp(seconds, 0.1f, 30.0f);
+    applyReverbImpulse();
+    markDirty();
+  };
+
+  keyHandler_->onUsages = [this]() { showUsages(); };
+  keyHandler_->onBus = [this](const std::string &name) { addBus(name); };
+  keyHandler_->onRoute = [this](const std::string &args) {
+    routeChannel(args);
+  };
+  keyHandler_->onSend = [this](const std::string &args) { setSend(args); };
+  keyHandler_->onScope = [this](const std::string &args) {
+    showAnalyser(args);
+  };
+  keyHandler_->onMemory = [this]() { memoryPanel_->toggle(); };
+
+  projectLoader_.onFinished = [this](audio::ProjectLoader::Result result) {
+    finishProjectOpen(std::move(result));
+  };
+
   // Start timer for UI updates (playhead position)
   // 10fps is sufficient for playhead display and reduces CPU load
   startTimerHz(10);
 }
 
 App::~App() {
+  startupToken_.cancel();
   stopTimer();
+  midiInput_.detach();
   deviceManager_.removeAudioCallback(&audioSourcePlayer_);
   audioSourcePlayer_.setSource(nullptr);
   removeKeyListener(this);
 }
 
 void App::timerCallback() {
+  // Write notes recorded by the audio thread into the pattern
+  if (recordMode_) {
+    drainRecordedNotes();
+    if (audioEngine_.isPlaying())
+      recordSawPlaying_ = true;
+    else if (recordSawPlaying_)
+      stopRecording(); // Transport stopped (e.g. MIDI Stop)
+  }
+
+  // Recording time and dropped blocks, or project-open progress, in the
+  // status bar
+  if (diskRecorder_.isRecording() || projectLoader_.isBusy())
+    repaint(getLocalBounds().removeFromBottom(STATUS_BAR_HEIGHT));
+
+  // Instruments the song (or the pattern playing) can reach, kept current
+  // with edits. Only patterns/chains changed since the last tick are rescanned
+  const auto &usage = project_.getUsageIndex();
+  audioEngine_.setReachableInstruments(
+      usage.getInstrumentsInSong() |
+      usage.getInstrumentsInPattern(audioEngine_.getCurrentPattern()));
+
+  // Outputs, sends and buses changed by edits or commands since the last
+  // tick - rebuilt only when the routing actually differs
+  audioEngine_.updateRouting();
+
+  if (statusMessageFrames_ > 0 && --statusMessageFrames_ == 0)
+    repaint(getLocalBounds().removeFromBottom(STATUS_BAR_HEIGHT));
+
+  // Unrouted MIDI ports play the instrument being edited
+  if (auto *instScreen =
+          dynamic_cast<ui::InstrumentScreen *>(screens_[3].get()))
+    midiInput_.setSelectedInstrument(instScreen->getCurrentInstrument());
+
   if (audioEngine_.isPlaying()) {
     // Only repaint the active screen, not the entire app
     // This dramatically reduces CPU usage during playback
@@ -472,13 +608,22 @@ void App::timerCallback() {
   if (autosaveDebounce_ > 0) {
     autosaveDebounce_--;
     if (autosaveDebounce_ == 0 && projectDirty_) {
-      // Save to project file path
+      // Save to project file path. Edits made while it writes mark the
+      // project dirty again
       juce::File savePath = getProjectFilePath();
-      if (model::ProjectSerializer::save(project_, savePath)) {
-        DBG("Autosaved to: " << savePath.getFullPathName());
-        currentProjectFile_ = savePath;
-        projectDirty_ = false;
-      }
+      projectDirty_ = false;
+      writeInBackground(savePath, model::ProjectSerializer::toJson(project_),
+                        [app = juce::Component::SafePointer<App>(this),
+                         savePath](bool written) {
+                          if (!app)
+                            return;
+                          if (written) {
+                            DBG("Autosaved to: " << savePath.getFullPathName());
+                            app->currentProjectFile_ = savePath;
+                          } else {
+                            app->projectDirty_ = true;
+                          }
+                        });
     }
   }
 
@@ -502,9 +647,31 @@ juce::File App::getAutosavePath() const {
 }
 
 void App::autosave() {
-  if (model::ProjectSerializer::save(project_, getAutosavePath())) {
-    DBG("Autosaved to: " << getAutosavePath().getFullPathName());
-  }
+  auto path = getAutosavePath();
+  writeInBackground(path, model::ProjectSerializer::toJson(project_),
+                    [path](bool written) {
+                      if (written)
+                        DBG("Autosaved to: " << path.getFullPathName());
+                    });
+}
+
+void App::writeInBackground(const juce::File &file, juce::String json,
+                            std::function<void(bool)> onWritten) {
+  auto written = std::make_shared<bool>(false);
+
+  model::JobScheduler::Job job;
+  job.priority = model::JobScheduler::Priority::Housekeeping;
+  if (lastWrite_ != 0)
+    job.after = {lastWrite_};
+  job.work = [file, json = std::move(json),
+              written](const model::JobScheduler::CancellationToken &) {
+    *written = file.replaceWithText(json);
+  };
+  job.onComplete = [written, onWritten = std::move(onWritten)]() {
+    if (onWritten)
+      onWritten(*written);
+  };
+  lastWrite_ = jobScheduler_->submit(std::move(job));
 }
 
 void App::paint(juce::Graphics &g) {
@@ -538,6 +705,19 @@ void App::resized() {
   // Help popup covers the whole window
   helpPopup_.setBounds(getLocalBounds());
 
+  // Memory panel docks in the top right corner, over the screen
+  if (memoryPanel_)
+    memoryPanel_->setBounds(
+        area.getRight() - ui::MemoryPanel::kWidth - 4, area.getY() + 4,
+        ui::MemoryPanel::kWidth, ui::MemoryPanel::kHeight);
+
+  // Analyser docks in the bottom right corner, over the screen
+  if (analyserView_)
+    analyserView_->setBounds(
+        area.removeFromBottom(ui::AnalyserView::kHeight)
+            .removeFromRight(ui::AnalyserView::kWidth)
+            .translated(-4, -4));
+
   // Audio settings popup covers the whole window (centered dialog inside)
   if (audioSettingsPopup_)
     audioSettingsPopup_->setBounds(getLocalBounds());
@@ -579,6 +759,14 @@ bool App::keyPressed(const juce::KeyPress &key,
     return false;
   }
 
+  // Escape abandons a project that is still opening
+  if (projectLoader_.isBusy() &&
+      key.getKeyCode() == juce::KeyPress::escapeKey) {
+    projectLoader_.cancel();
+    repaint(getLocalBounds().removeFromBottom(STATUS_BAR_HEIGHT));
+    return true;
+  }
+
   // Handle help popup toggle
   if (key.getTextCharacter() == '?') {
     toggleHelp();
@@ -595,6 +783,10 @@ bool App::keyPressed(const juce::KeyPress &key,
     return true;
   }
 
+  // Record mode: keyboard piano, Esc / Shift+Space to finish the pass
+  if (recordMode_ && handleRecordKey(key))
+    return true;
+
   // Handle tempo adjust mode
   if (tempoAdjustMode_) {
     if (handleTempoAdjustKey(key))
@@ -611,6 +803,14 @@ bool App::keyPressed(const juce::KeyPress &key,
     return true;
   }
 
+  // Record into the pattern (Shift+Space)
+  if (key.getKeyCode() == juce::KeyPress::spaceKey &&
+      key.getModifiers().isShiftDown() &&
+      modeManager_.getMode() == input::Mode::Normal && !screenInTextEdit) {
+    startRecording();
+    return true;
+  }
+
   // Global groove cycling (g/G) - skip if screen is in text edit mode
   if (modeManager_.getMode() == input::Mode::Normal && !screenInTextEdit) {
     if (key.getTextCharacter() == 'g') {
@@ -629,6 +829,541 @@ bool App::keyPressed(const juce::KeyPress &key,
   return handled;
 }
 
+void App::preferJackDevice() {
+  // Share the graph with other audio software when a JACK server is running.
+  // JUCE's JACK device takes sample rate and period size from the server and
+  // connects the main pair to the system outputs.
+  for (auto *type : deviceManager_.getAvailableDeviceTypes()) {
+    if (type->getTypeName() != "JACK")
+      continue;
+
+    type->scanForDevices();
+    if (type->getDeviceNames().isEmpty())
+      return; // No server running - keep the default device
+
+    deviceManager_.setCurrentAudioDeviceType("JACK", true);
+    auto *device = deviceManager_.getCurrentAudioDevice();
+    if (!device)
+      return;
+
+    // Stems get ports of their own client, left unconnected - the device's
+    // outputs are the server's physical ports, which are for the main mix.
+    // Opened before the device restarts so the engine sizes its stem buffer
+    if (jackStems_.open(JACK_STEM_INSTRUMENTS))
+      audioEngine_.setJackStems(&jackStems_);
+
+    auto setup = deviceManager_.getAudioDeviceSetup();
+    setup.useDefaultOutputChannels = false;
+    setup.outputChannels.clear();
+    setup.outputChannels.setRange(0, 2, true);
+    deviceManager_.setAudioDeviceSetup(setup, true);
+
+    if (jackTransport_.connect())
+      audioEngine_.setJackTransport(&jackTransport_);
+    return;
+  }
+}
+
+bool App::keyStateChanged(bool isKeyDown,
+                          juce::Component *originatingComponent) {
+  juce::ignoreUnused(isKeyDown, originatingComponent);
+
+  // Keyboard piano note-offs - JUCE only reports releases as state changes
+  for (auto it = heldRecordKeys_.begin(); it != heldRecordKeys_.end();) {
+    if (!juce::KeyPress::isKeyCurrentlyDown(it->first)) {
+      midiInput_.injectNote(it->second, 0);
+      it = heldRecordKeys_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  return false;
+}
+
+void App::startRecording() {
+  if (recordMode_)
+    return;
+
+  auto *patternScreen = dynamic_cast<ui::PatternScreen *>(screens_[2].get());
+  if (!patternScreen)
+    return;
+
+  // Record into the pattern that is playing, or start the one on screen
+  bool playing = audioEngine_.isPlaying();
+  if (playing &&
+      audioEngine_.getPlayMode() != audio::AudioEngine::PlayMode::Pattern)
+    return; // Song playback has no single pattern to write into
+
+  int patternIndex = playing ? audioEngine_.getCurrentPattern()
+                             : patternScreen->getCurrentPatternIndex();
+  auto *pattern = project_.getPattern(patternIndex);
+  if (!pattern)
+    return;
+
+  recorder_.begin(pattern, patternScreen->getCursorTrack());
+  recordMode_ = true;
+  recordSawPlaying_ = playing;
+
+  if (!playing) {
+    audioEngine_.setPlayMode(audio::AudioEngine::PlayMode::Pattern);
+    audioEngine_.setCurrentPattern(patternIndex);
+    audioEngine_.play();
+  }
+  audioEngine_.setRecording(true);
+  repaint();
+}
+
+void App::stopRecording() {
+  if (!recordMode_)
+    return;
+
+  audioEngine_.setRecording(false);
+  for (const auto &held : heldRecordKeys_)
+    midiInput_.injectNote(held.second, 0);
+  heldRecordKeys_.clear();
+
+  drainRecordedNotes();
+  recorder_.end(); // The whole pass becomes one undo step
+  recordMode_ = false;
+  recordSawPlaying_ = false;
+  repaint();
+}
+
+void App::startDiskRecording(const std::string &args) {
+  // Options: wav|flac, 16|24|32 (bits), fx (effects return), stems
+  audio::DiskRecorder::Options options;
+  bool stems = false;
+  std::istringstream tokens(args);
+  std::string token;
+  while (tokens >> token) {
+    if (token == "flac")
+      options.format = audio::DiskRecorder::Format::Flac;
+    else if (token == "wav")
+      options.format = audio::DiskRecorder::Format::Wav;
+    else if (token == "16" || token == "24" || token == "32")
+      options.bitDepth = std::stoi(token);
+    else if (token == "fx")
+      options.fxBus = true;
+    else if (token == "stems")
+      stems = true;
+  }
+
+  if (stems) {
+    for (int i = 0; i < project_.getInstrumentCount(); ++i)
+      options.instruments.push_back(i);
+  }
+
+  auto dir = juce::File::getSpecialLocation(juce::File::userHomeDirectory)
+                 .getChildFile(".vitracker")
+                 .getChildFile("recordings");
+  auto name =
+      "take-" + juce::Time::getCurrentTime().formatted("%Y%m%d-%H%M%S");
+
+  if (!diskRecorder_.start(dir, name, audioEngine_.getSampleRate(), options))
+    DBG("Disk recording failed to start");
+  repaint();
+}
+
+void App::stopDiskRecording() {
+  diskRecorder_.stop();
+  repaint();
+}
+
+void App::importTake(const std::string &args) {
+  // Loads a file from the last take into a new Sampler (or Slicer) instrument
+  if (diskRecorder_.isRecording())
+    stopDiskRecording();
+
+  bool slicer = false;
+  juce::String label = "master";
+  std::istringstream tokens(args);
+  std::string token;
+  while (tokens >> token) {
+    if (token == "slicer")
+      slicer = true;
+    else if (token == "sampler")
+      slicer = false;
+    else
+      label = juce::String(token).toUpperCase();
+  }
+  if (label == "MASTER" || label == "FX")
+    label = label.toLowerCase();
+  else if (label.length() == 1)
+    label = label.paddedLeft('0', 2);
+
+  juce::File file;
+  for (const auto &take : diskRecorder_.getTakeFiles()) {
+    if (take.label == label)
+      file = take.file;
+  }
+  if (!file.existsAsFile()) {
+    DBG("No recorded take for " << label);
+    return;
+  }
+
+  int slot = project_.addInstrument("Take " + label.toStdString());
+  auto *instrument = project_.getInstrument(slot);
+  if (!instrument)
+    return;
+
+  // Decoded in the background; the Instrument screen refreshes once it's in
+  auto onLoaded = [app = juce::Component::SafePointer<App>(this), file,
+                   slicer](bool loaded) {
+    if (!loaded)
+      DBG("Failed to load take: " << file.getFullPathName());
+    if (!app)
+      return;
+    if (auto *instScreen =
+            dynamic_cast<ui::InstrumentScreen *>(app->screens_[3].get())) {
+      if (slicer)
+        instScreen->updateSlicerDisplay();
+      instScreen->repaint();
+    }
+    app->markDirty();
+  };
+
+  if (slicer) {
+    instrument->setType(model::InstrumentType::Slicer);
+    if (auto *processor = audioEngine_.getSlicerProcessor(slot)) {
+      processor->setInstrument(instrument);
+      processor->loadSampleAsync(file, onLoaded);
+    }
+  } else {
+    instrument->setType(model::InstrumentType::Sampler);
+    if (auto *processor = audioEngine_.getSamplerProcessor(slot)) {
+      processor->setInstrument(instrument);
+      processor->loadSampleAsync(file, onLoaded);
+    }
+  }
+
+  if (auto *instScreen =
+          dynamic_cast<ui::InstrumentScreen *>(screens_[3].get()))
+    instScreen->setCurrentInstrument(slot);
+  switchScreen(3);
+  markDirty();
+}
+
+void App::showUsages() {
+  const auto &usage = project_.getUsageIndex();
+
+  auto hex = [](int value) {
+    return juce::String::toHexString(value).paddedLeft('0', 2).toUpperCase();
+  };
+  // At most a handful of indices, then a count of the rest
+  auto listOf = [&](const std::vector<int> &indices) {
+    constexpr size_t kShown = 8;
+    juce::String text;
+    for (size_t i = 0; i < std::min(indices.size(), kShown); ++i)
+      text << " " << hex(indices[i]);
+    if (indices.size() > kShown)
+      text << " +" << static_cast<int>(indices.size() - kShown);
+    return text;
+  };
+
+  juce::String message;
+  if (auto *instScreen =
+          dynamic_cast<ui::InstrumentScreen *>(screens_[currentScreen_].get())) {
+    int instrument = instScreen->getCurrentInstrument();
+    auto patterns = usage.getPatternsUsingInstrument(instrument);
+    message = "INST " + hex(instrument);
+    if (patterns.empty())
+      message << ": unused, safe to delete";
+    else
+      message << ": " << static_cast<int>(usage.getStepsUsingInstrument(instrument).size())
+              << " steps in PAT" << listOf(patterns)
+              << (usage.getInstrumentsInSong().test(static_cast<size_t>(instrument))
+                      ? ""
+                      : " (not in song)");
+  } else if (auto *patternScreen = dynamic_cast<ui::PatternScreen *>(
+                 screens_[currentScreen_].get())) {
+    int pattern = patternScreen->getCurrentPatternIndex();
+    auto chains = usage.getChainsUsingPattern(pattern);
+    message = "PAT " + hex(pattern);
+    if (chains.empty())
+      message << ": in no chain, safe to delete";
+    else
+      message << ": in CHN" << listOf(chains);
+  } else {
+    int chain = -1;
+    if (auto *chainScreen = dynamic_cast<ui::ChainScreen *>(
+            screens_[currentScreen_].get()))
+      chain = chainScreen->getCurrentChain();
+    else if (auto *songScreen = dynamic_cast<ui::SongScreen *>(
+                 screens_[currentScreen_].get()))
+      chain = songScreen->getChainAtCursor();
+    if (chain < 0)
+      return;
+
+    auto positions = usage.getSongPositionsOfChain(chain);
+    message = "CHN " + hex(chain);
+    if (positions.empty()) {
+      message << ": not in song, safe to delete";
+    } else {
+      std::vector<int> rows;
+      for (const auto &position : positions)
+        rows.push_back(position.row);
+      message << ": " << static_cast<int>(positions.size())
+              << " song cells, rows" << listOf(rows);
+    }
+  }
+
+  showStatus(message);
+}
+
+void App::showStatus(const juce::String &message) {
+  statusMessage_ = message;
+  statusMessageFrames_ = STATUS_MESSAGE_FRAMES;
+  repaint(getLocalBounds().removeFromBottom(STATUS_BAR_HEIGHT));
+}
+
+namespace {
+
+// A mixer channel named in a command: "bN" is bus N, anything else an
+// instrument in hex. Index -1 if it doesn't parse
+struct ChannelRef {
+  bool bus = false;
+  int index = -1;
+};
+
+ChannelRef parseChannel(const std::string &token) {
+  ChannelRef channel;
+  try {
+    if (token.size() > 1 && (token[0] == 'b' || token[0] == 'B')) {
+      channel.bus = true;
+      channel.index = std::stoi(token.substr(1));
+    } else {
+      channel.index = std::stoi(token, nullptr, 16);
+    }
+  } catch (...) {
+    channel.index = -1;
+  }
+  return channel;
+}
+
+juce::String channelName(const ChannelRef &channel) {
+  return channel.bus ? "b" + juce::String(channel.index)
+                     : "INST " + juce::String::toHexString(channel.index)
+                                    .toUpperCase()
+                                    .paddedLeft('0', 2);
+}
+
+} // anonymous namespace
+
+void App::addBus(const std::string &name) {
+  int bus = project_.addBus(name.empty() ? "Bus" : name);
+  if (bus < 0) {
+    showStatus("Bus limit reached (" +
+               juce::String(model::Project::MAX_BUSES) + ")");
+    return;
+  }
+  markDirty();
+  showStatus("Added bus b" + juce::String(bus) + ": route channels to it with "
+             ":route XX b" + juce::String(bus));
+}
+
+void App::routeChannel(const std::string &args) {
+  std::istringstream tokens(args);
+  std::string sourceArg, destArg;
+  tokens >> sourceArg >> destArg;
+  auto source = parseChannel(sourceArg);
+  int output = -1;
+  if (destArg != "master") {
+    auto dest = parseChannel(destArg);
+    output = dest.bus ? dest.index : -2;
+  }
+
+  bool routed = output >= -1 &&
+                (source.bus ? project_.setBusOutput(source.index, output)
+                            : project_.setInstrumentOutput(source.index, output));
+  if (!routed) {
+    showStatus("Can't route " + juce::String(sourceArg) + " to " +
+               juce::String(destArg) + " (no such channel, or a loop)");
+    return;
+  }
+  markDirty();
+  showStatus(channelName(source) + " -> " +
+             (output < 0 ? juce::String("master") : "b" + juce::String(output)));
+}
+
+void App::setSend(const std::string &args) {
+  std::istringstream tokens(args);
+  std::string sourceArg, effect;
+  float percent = -1.0f;
+  tokens >> sourceArg >> effect >> percent;
+  auto source = parseChannel(sourceArg);
+
+  model::SendLevels *sends = nullptr;
+  auto &buses = project_.getMixer().buses;
+  if (source.bus && source.index >= 0 &&
+      source.index < static_cast<int>(buses.size()))
+    sends = &buses[static_cast<size_t>(source.index)].sends;
+  else if (!source.bus)
+    if (auto *instrument = project_.getInstrument(source.index))
+      sends = &instrument->getSends();
+
+  float *level = nullptr;
+  if (sends)
+    level = effect == "reverb"  ? &sends->reverb
+            : effect == "delay" ? &sends->delay
+            : effect == "chorus" ? &sends->chorus
+            : effect == "key"    ? &sends->sidechainKey
+            : effect == "duck"   ? &sends->sidechainDuck
+                                 : nullptr;
+  if (!level || percent < 0.0f) {
+    showStatus("Usage: :send XX|bN reverb|delay|chorus|key|duck PERCENT");
+    return;
+  }
+  *level = std::clamp(percent / 100.0f, 0.0f, 1.0f);
+  markDirty();
+  showStatus(channelName(source) + " " + juce::String(effect) + " send " +
+             juce::String(juce::roundToInt(*level * 100.0f)) + "%");
+}
+
+void App::showAnalyser(const std::string &args) {
+  std::istringstream tokens(args);
+  std::string channelArg;
+  tokens >> channelArg;
+  if (channelArg == "off") {
+    analyserView_->hide();
+    return;
+  }
+  if (channelArg.empty() || channelArg == "master") {
+    analyserView_->show(audio::AnalysisTap::Point::Master, 0, "MASTER");
+    return;
+  }
+
+  auto channel = parseChannel(channelArg);
+  const bool exists =
+      channel.bus ? channel.index >= 0 &&
+                        channel.index < static_cast<int>(
+                                            project_.getMixer().buses.size())
+                  : project_.getInstrument(channel.index) != nullptr;
+  if (!exists) {
+    showStatus("Usage: :scope [XX|bN|master|off]");
+    return;
+  }
+  analyserView_->show(channel.bus ? audio::AnalysisTap::Point::Bus
+                                  : audio::AnalysisTap::Point::Instrument,
+                      channel.index, channelName(channel));
+}
+
+model::MemoryReport App::collectMemoryUsage() {
+  model::MemoryReport report;
+  audioEngine_.reportMemoryUsage(report);
+  report.add("Plaits presets", presetManager_.getAllocatedBytes());
+  if (auto *instrumentScreen =
+          dynamic_cast<ui::InstrumentScreen *>(screens_[3].get()))
+    report.add("DX7 presets",
+               instrumentScreen->getDXPresetBank().getAllocatedBytes());
+  report.add("Undo history",
+             model::UndoManager::instance().getAllocatedBytes());
+  report.add("Disk recorder", diskRecorder_.getAllocatedBytes());
+  return report;
+}
+
+void App::applyReverbImpulse() {
+  const auto &mixer = project_.getMixer();
+  if (mixer.reverbImpulse.empty()) {
+    audioEngine_.clearReverbImpulse();
+    return;
+  }
+
+  juce::File file(mixer.reverbImpulse);
+  if (audioEngine_.setReverbImpulse(file, mixer.reverbMaxTail)) {
+    auto cost = audioEngine_.getReverbCost();
+    DBG("Reverb IR " << file.getFileName() << ": " << cost.seconds << "s, "
+                     << cost.earlyPartitions << " early + "
+                     << cost.tailPartitions << " tail partitions");
+  } else {
+    // Missing or unreadable - fall back to the algorithmic reverb
+    audioEngine_.clearReverbImpulse();
+  }
+}
+
+void App::chooseReverbImpulse() {
+  auto chooser = std::make_shared<juce::FileChooser>(
+      "Load Reverb Impulse Response",
+      juce::File::getSpecialLocation(juce::File::userHomeDirectory),
+      "*.wav;*.aiff;*.aif;*.flac;*.ogg");
+
+  chooser->launchAsync(juce::FileBrowserComponent::openMode |
+                           juce::FileBrowserComponent::canSelectFiles,
+                       [this, chooser](const juce::FileChooser &fc) {
+                         auto results = fc.getResults();
+                         if (results.isEmpty())
+                           return;
+                         project_.getMixer().reverbImpulse =
+                             results[0].getFullPathName().toStdString();
+                         applyReverbImpulse();
+                         markDirty();
+                       });
+}
+
+bool App::handleRecordKey(const juce::KeyPress &key) {
+  if (key.getKeyCode() == juce::KeyPress::escapeKey ||
+      (key.getKeyCode() == juce::KeyPress::spaceKey &&
+       key.getModifiers().isShiftDown())) {
+    stopRecording();
+    return true;
+  }
+
+  if (key.getModifiers().isCtrlDown() || key.getModifiers().isAltDown() ||
+      key.getModifiers().isCommandDown())
+    return false;
+
+  // Two-octave tracker layout: z-row from RECORD_BASE_NOTE, q-row an octave up
+  static const char *lowerRow = "zsxdcvgbhnjm,l.;/";
+  static const char *upperRow = "q2w3er5t6y7ui9o0p";
+  auto c = key.getTextCharacter();
+  int offset = -1;
+  for (int i = 0; lowerRow[i] != 0 && offset < 0; ++i) {
+    if (c == static_cast<juce::juce_wchar>(lowerRow[i]))
+      offset = i;
+  }
+  for (int i = 0; upperRow[i] != 0 && offset < 0; ++i) {
+    if (c == static_cast<juce::juce_wchar>(upperRow[i]))
+      offset = 12 + i;
+  }
+  if (offset < 0)
+    return false;
+
+  // Ignore auto-repeat while the key is held
+  int keyCode = key.getKeyCode();
+  for (const auto &held : heldRecordKeys_) {
+    if (held.first == keyCode)
+      return true;
+  }
+
+  int note = RECORD_BASE_NOTE + offset;
+  heldRecordKeys_.push_back({keyCode, note});
+  midiInput_.injectNote(note, RECORD_KEY_VELOCITY);
+  return true;
+}
+
+void App::drainRecordedNotes() {
+  std::array<audio::AudioEngine::RecordedNote, 64> notes;
+  bool changed = false;
+
+  int count = 0;
+  while ((count = audioEngine_.popRecordedNotes(
+              notes.data(), static_cast<int>(notes.size()))) > 0) {
+    for (int i = 0; i < count; ++i) {
+      const auto &n = notes[static_cast<size_t>(i)];
+      if (n.velocity > 0)
+        recorder_.noteOn(n.row, n.note, n.velocity, n.instrument, n.port);
+      else
+        recorder_.noteOff(n.row, n.note, n.port);
+    }
+    changed = true;
+  }
+
+  if (changed) {
+    markDirty();
+    if (screens_[2])
+      screens_[2]->repaint();
+  }
+}
+
 void App::switchScreen(int screenIndex) {
   if (screenIndex < 0 || screenIndex >= 6)
     return; // Now 6 screens
@@ -667,7 +1402,9 @@ void App::drawStatusBar(juce::Graphics &g, juce::Rectangle<int> area) {
   // Mode indicator (left)
   g.setColour(juce::Colours::white);
   juce::String modeStr =
-      tempoAdjustMode_ ? "TEMPO" : modeManager_.getModeString();
+      tempoAdjustMode_ ? "TEMPO"
+      : recordMode_    ? "REC"
+                       : modeManager_.getModeString();
   g.drawText("-- " + modeStr + " --", area.removeFromLeft(120),
              juce::Justification::centredLeft, true);
 
@@ -688,9 +1425,42 @@ void App::drawStatusBar(juce::Graphics &g, juce::Rectangle<int> area) {
   g.drawText(transportText, area.removeFromLeft(130),
              juce::Justification::centred, true);
 
+  // Disk recording: elapsed time, plus dropped blocks if the disk fell behind
+  if (diskRecorder_.isRecording()) {
+    auto stats = diskRecorder_.getStats();
+    int seconds = static_cast<int>(stats.seconds);
+    juce::String diskText = "DISK " + juce::String(seconds / 60) + ":" +
+                            juce::String(seconds % 60).paddedLeft('0', 2);
+    bool trouble = stats.droppedBlocks > 0 || stats.writeFailed;
+    if (stats.droppedBlocks > 0)
+      diskText << " DROP " << stats.droppedBlocks;
+    else if (stats.writeFailed)
+      diskText << " ERR";
+    g.setColour(trouble ? juce::Colours::orange : juce::Colours::red);
+    g.drawText(diskText, area.removeFromLeft(140),
+               juce::Justification::centred, true);
+  }
+
+  // Project opening in the background
+  if (projectLoader_.isBusy()) {
+    static const char *stageNames[] = {"", "READ", "PARSE", "PREPARE"};
+    auto stage = static_cast<size_t>(projectLoader_.getStage());
+    juce::String openText =
+        "OPEN " + projectLoader_.getFile().getFileNameWithoutExtension() +
+        " " + stageNames[stage] + " " +
+        juce::String(juce::roundToInt(projectLoader_.getProgress() * 100.0f)) +
+        "% (Esc)";
+    g.setColour(juce::Colours::lightblue);
+    g.drawText(openText, area.removeFromLeft(260),
+               juce::Justification::centred, true);
+  }
+
   // Reserve space for Tip Me button (right side)
   area.removeFromRight(75);
 
+  // Tempo and groove take the right, a :usages result gets what is left
+  auto messageArea = area.withTrimmedRight(170);
+
   // Tempo (highlight if in tempo adjust mode)
   g.setColour(tempoAdjustMode_ ? juce::Colours::yellow : juce::Colours::white);
   g.drawText(juce::String(project_.getTempo(), 1) + " BPM",
@@ -700,6 +1470,12 @@ void App::drawStatusBar(juce::Graphics &g, juce::Rectangle<int> area) {
   g.setColour(juce::Colours::white);
   g.drawText(project_.getGrooveTemplate(), area.removeFromRight(90),
              juce::Justification::centredRight, true);
+
+  if (statusMessageFrames_ > 0) {
+    g.setColour(juce::Colours::lightblue);
+    g.drawText(statusMessage_, messageArea.reduced(8, 0),
+               juce::Justification::centredLeft, true);
+  }
 }
 
 void App::saveProject(const std::string &filename) {
@@ -742,33 +1518,48 @@ void App::loadProject(const std::string &filename) {
             juce::FileBrowserComponent::canSelectFiles,
         [this, chooser](const juce::FileChooser &fc) {
           auto results = fc.getResults();
-          if (!results.isEmpty()) {
-            if (model::ProjectSerializer::load(project_, results[0])) {
-              DBG("Project loaded from: " << results[0].getFullPathName());
-              audioEngine_.stop();
-              repaint();
-            } else
-              DBG("Failed to load project");
-          }
+          if (!results.isEmpty())
+            openProject(results[0]);
         });
   } else {
-    auto file = juce::File::getSpecialLocation(juce::File::userHomeDirectory)
-                    .getChildFile(juce::String(filename) + ".vit");
+    openProject(juce::File::getSpecialLocation(juce::File::userHomeDirectory)
+                    .getChildFile(juce::String(filename) + ".vit"));
+  }
+}
 
-    if (model::ProjectSerializer::load(project_, file)) {
-      DBG("Project loaded from: " << file.getFullPathName());
-      audioEngine_.stop();
-      repaint();
-    } else
-      DBG("Failed to load project");
+void App::openProject(const juce::File &file) {
+  // Parsed and prepared off the message thread; finishProjectOpen() swaps it
+  // in. The current project keeps playing meanwhile
+  projectLoader_.open(file, audioEngine_.getSampleRate());
+  repaint(getLocalBounds().removeFromBottom(STATUS_BAR_HEIGHT));
+}
+
+void App::finishProjectOpen(audio::ProjectLoader::Result result) {
+  repaint(getLocalBounds().removeFromBottom(STATUS_BAR_HEIGHT));
+  if (!result.project) {
+    DBG("Failed to load project: " << result.file.getFullPathName());
+    return;
   }
+
+  // Fades out, stops and swaps; the old project is freed off this thread
+  audioEngine_.replaceProject(std::move(*result.project));
+  if (result.reverb)
+    audioEngine_.adoptReverbImpulse(std::move(result.reverb),
+                                    result.reverbFile,
+                                    project_.getMixer().reverbMaxTail);
+  else
+    audioEngine_.clearReverbImpulse(); // No IR, or it couldn't be read
+
+  DBG("Project loaded from: " << result.file.getFullPathName());
+  repaint();
 }
 
 void App::newProject() {
-  audioEngine_.stop();
-  project_ = model::Project("Untitled");
+  projectLoader_.cancel();
+  audioEngine_.replaceProject(model::Project("Untitled"));
   currentProjectFile_ = juce::File(); // Clear current file path
   projectDirty_ = false;
+  applyReverbImpulse();
   updateWindowTitle();
   repaint();
 }
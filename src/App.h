@@ -3,12 +3,16 @@
 #include <JuceHeader.h>
 #include "model/Project.h"
 #include "model/PresetManager.h"
+#include "model/LiveRecorder.h"
 #include "input/ModeManager.h"
 #include "input/KeyHandler.h"
 #include "audio/AudioEngine.h"
+#include "audio/ProjectLoader.h"
 #include "ui/Screen.h"
 #include "ui/HelpPopup.h"
 #include "ui/AudioSettingsPopup.h"
+#include "ui/AnalyserView.h"
+#include "ui/MemoryPanel.h"
 #include <memory>
 #include <array>
 #include <functional>
@@ -26,6 +30,7 @@ public:
     void visibilityChanged() override;
 
     bool keyPressed(const juce::KeyPress& key, juce::Component* originatingComponent) override;
+    bool keyStateChanged(bool isKeyDown, juce::Component* originatingComponent) override;
 
     void timerCallback() override;
 
@@ -35,10 +40,21 @@ private:
 
     void saveProject(const std::string& filename = "");
     void loadProject(const std::string& filename);
+    void openProject(const juce::File& file);
     void newProject();
     void autosave();
     juce::File getAutosavePath() const;
 
+    // Autosaves snapshot the project as JSON here and write it as a background
+    // job. Writes run one after another, in the order they were asked for
+    void writeInBackground(const juce::File& file, juce::String json,
+                           std::function<void(bool)> onWritten);
+
+    // First, so it outlives every member that submits jobs
+    juce::SharedResourcePointer<model::JobScheduler> jobScheduler_;
+    model::JobScheduler::JobId lastWrite_ = 0;
+    model::JobScheduler::CancellationToken startupToken_;  // Background catalogue loads
+
     model::Project project_;
     model::PresetManager presetManager_;
     input::ModeManager modeManager_;
@@ -47,6 +63,12 @@ private:
     audio::AudioEngine audioEngine_;
     juce::AudioDeviceManager deviceManager_;
     juce::AudioSourcePlayer audioSourcePlayer_;
+    audio::PresetPreviewRenderer previewRenderer_;  // Preset audition clips
+    audio::MidiInputHandler midiInput_;             // After deviceManager_ so it detaches first
+    audio::JackTransport jackTransport_;            // Connected only when running on JACK
+    audio::JackStemPorts jackStems_;                // Open only when running on JACK
+    void preferJackDevice();
+    static constexpr int JACK_STEM_INSTRUMENTS = 16;  // Stem port pairs on JACK
 
     std::array<std::unique_ptr<ui::Screen>, 6> screens_;
     int currentScreen_ = 2;  // Pattern screen (was 3, now 2 after removing Project)
@@ -61,6 +83,59 @@ private:
     void exitTempoAdjustMode();
     bool handleTempoAdjustKey(const juce::KeyPress& key);
 
+    // Live record mode (Shift+Space) - notes from MIDI and the computer
+    // keyboard are written into the playing pattern
+    bool recordMode_ = false;
+    bool recordSawPlaying_ = false;  // Transport stopping ends the pass
+    model::LiveRecorder recorder_;
+    std::vector<std::pair<int, int>> heldRecordKeys_;  // keyCode, note
+    void startRecording();
+    void stopRecording();
+    bool handleRecordKey(const juce::KeyPress& key);
+    void drainRecordedNotes();
+    static constexpr int RECORD_BASE_NOTE = 48;  // 'z' on the keyboard piano
+    static constexpr int RECORD_KEY_VELOCITY = 100;
+
+    // Record to disk (:disk-rec / :disk-stop) - takes go to ~/.vitracker/recordings
+    // and can be loaded back as Sampler/Slicer instruments with :import-take
+    audio::DiskRecorder diskRecorder_;
+    void startDiskRecording(const std::string& args);
+    void stopDiskRecording();
+    void importTake(const std::string& args);
+
+    // Projects open in the background (progress in the status bar, Escape
+    // cancels) and are swapped in once fully prepared
+    audio::ProjectLoader projectLoader_;
+    void finishProjectOpen(audio::ProjectLoader::Result result);
+
+    // Convolution reverb - the project's IR file is (re)loaded into the engine
+    void applyReverbImpulse();
+    void chooseReverbImpulse();
+
+    // :usages - where the instrument/pattern/chain being edited is used,
+    // shown in the status bar
+    void showUsages();
+    void showStatus(const juce::String& message);
+    juce::String statusMessage_;
+    int statusMessageFrames_ = 0;
+    static constexpr int STATUS_MESSAGE_FRAMES = 50;  // ~5 seconds at 10fps
+
+    // Mixer routing: :bus, :route and :send. Channels are an instrument (hex,
+    // as displayed) or a bus (bN); the result is shown in the status bar
+    void addBus(const std::string& name);
+    void routeChannel(const std::string& args);
+    void setSend(const std::string& args);
+
+    // :scope - spectrum and oscilloscope of a channel, the master by
+    // default; :scope off closes it
+    std::unique_ptr<ui::AnalyserView> analyserView_;
+    void showAnalyser(const std::string& args);
+
+    // :memory - debug panel of memory by subsystem: the engine's, plus the
+    // preset lists, undo history and disk recorder owned out here
+    std::unique_ptr<ui::MemoryPanel> memoryPanel_;
+    model::MemoryReport collectMemoryUsage();
+
     // Groove cycling
     void cycleGroove(bool reverse);
     static const char* grooveNames_[5];
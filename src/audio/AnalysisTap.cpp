@@ -0,0 +1,60 @@
+#include "AnalysisTap.h"
+
+namespace audio {
+
+AnalysisTap::AnalysisTap(Point point, int index)
+    : point_(point), index_(index)
+{
+    ring_.clear();
+}
+
+void AnalysisTap::write(const float* left, const float* right, int numSamples)
+{
+    if (fifo_.getFreeSpace() < numSamples)
+        return;  // The view fell behind - it only wants recent audio anyway
+
+    int start1, size1, start2, size2;
+    fifo_.prepareToWrite(numSamples, start1, size1, start2, size2);
+    ring_.copyFrom(0, start1, left, size1);
+    ring_.copyFrom(1, start1, right, size1);
+    if (size2 > 0)
+    {
+        ring_.copyFrom(0, start2, left + size1, size2);
+        ring_.copyFrom(1, start2, right + size1, size2);
+    }
+    fifo_.finishedWrite(size1 + size2);
+}
+
+void AnalysisTap::writeSilence(int numSamples)
+{
+    if (fifo_.getFreeSpace() < numSamples)
+        return;
+
+    int start1, size1, start2, size2;
+    fifo_.prepareToWrite(numSamples, start1, size1, start2, size2);
+    ring_.clear(start1, size1);
+    if (size2 > 0)
+        ring_.clear(start2, size2);
+    fifo_.finishedWrite(size1 + size2);
+}
+
+int AnalysisTap::read(float* left, float* right, int maxSamples)
+{
+    const int ready = fifo_.getNumReady();
+    if (ready > maxSamples)
+        fifo_.finishedRead(ready - maxSamples);
+
+    int start1, size1, start2, size2;
+    fifo_.prepareToRead(juce::jmin(ready, maxSamples), start1, size1, start2, size2);
+    juce::FloatVectorOperations::copy(left, ring_.getReadPointer(0, start1), size1);
+    juce::FloatVectorOperations::copy(right, ring_.getReadPointer(1, start1), size1);
+    if (size2 > 0)
+    {
+        juce::FloatVectorOperations::copy(left + size1, ring_.getReadPointer(0, start2), size2);
+        juce::FloatVectorOperations::copy(right + size1, ring_.getReadPointer(1, start2), size2);
+    }
+    fifo_.finishedRead(size1 + size2);
+    return size1 + size2;
+}
+
+} // namespace audio
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+namespace audio {
+
+// A copy of one mixer channel for the analysis views (spectrum and scope).
+//
+// The audio thread copies each block into a preallocated ring - one copy per
+// channel, in two parts where the ring wraps - and never waits. The view
+// drains it on the message thread. If the view falls behind and the ring
+// fills, blocks are dropped. The engine only holds a tap while a view is
+// open, so with none open there is nothing to copy.
+class AnalysisTap
+{
+public:
+    // Where to listen: an instrument or bus channel, post-fader and pre-duck
+    // (as its stem would be), or the master, as heard
+    enum class Point { Instrument, Bus, Master };
+
+    static constexpr int kCapacity = 16384;  // Samples per channel, ~1/3 s at 48 kHz
+
+    AnalysisTap(Point point, int index);
+
+    Point getPoint() const { return point_; }
+    int getIndex() const { return index_; }  // Instrument or bus
+
+    // Audio thread
+    void write(const float* left, const float* right, int numSamples);
+    void writeSilence(int numSamples);
+
+    // Message thread. Reads the oldest unread samples, up to maxSamples, and
+    // returns how many. Anything older than the newest maxSamples is skipped
+    int read(float* left, float* right, int maxSamples);
+
+private:
+    Point point_;
+    int index_;
+    juce::AudioBuffer<float> ring_{2, kCapacity};
+    juce::AbstractFifo fifo_{kCapacity};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AnalysisTap)
+};
+
+} // namespace audio
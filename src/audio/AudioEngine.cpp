@@ -1,20 +1,69 @@
 #include "AudioEngine.h"
+#include "../model/JobScheduler.h"
+#include "../model/StartupProfile.h"
+#include <type_traits>
 
 namespace audio {
 
+static_assert(DiskRecorder::kMaxInstruments == AudioEngine::NUM_INSTRUMENTS,
+              "Disk recorder stem table must cover every instrument");
+
+namespace {
+
+// A replaced project can hold thousands of steps and instruments - free it on
+// a pool worker rather than the message thread
+void destroyInBackground(std::unique_ptr<model::Project> project) {
+  std::shared_ptr<model::Project> shared(std::move(project));
+  juce::SharedResourcePointer<model::JobScheduler> scheduler;
+  scheduler->submit(model::JobScheduler::Priority::Housekeeping, {},
+                    [shared = std::move(shared)](const auto &) mutable {
+                      shared.reset();
+                    });
+}
+
+size_t bufferBytes(const juce::AudioBuffer<float> &buffer) {
+  return static_cast<size_t>(buffer.getNumChannels()) *
+         static_cast<size_t>(buffer.getNumSamples()) * sizeof(float);
+}
+
+} // anonymous namespace
+
 // Track implementation
-void Track::triggerNote(int note, float velocity, const model::Step &step,
-                        InstrumentProcessor *instrument) {
-  if (!instrument)
-    return;
+void Track::releaseVoice() {
+  std::visit(
+      [](auto &v) {
+        if constexpr (!std::is_same_v<std::decay_t<decltype(v)>,
+                                      std::monostate>) {
+          if (v.isActive())
+            v.noteOff();
+        }
+      },
+      voice);
+}
 
-  // Note: Voice creation happens in AudioEngine::triggerNote based on
-  // instrument index This method just handles the tracker FX and note
+size_t Track::getVoiceAllocatedBytes() const {
+  return std::visit(
+      [](const auto &v) -> size_t {
+        if constexpr (std::is_same_v<std::decay_t<decltype(v)>,
+                                     std::monostate>)
+          return 0;
+        else
+          return v.getAllocatedBytes();
+      },
+      voice);
+}
+
+template <typename Processor>
+void Track::triggerNote(int note, float velocity, const model::Step &step,
+                        Processor &instrument) {
+  // Note: Voice creation happens in AudioEngine::triggerTrackNote based on
+  // instrument index. This method just handles the tracker FX and note
   // triggering
+  auto *v = std::get_if<typename Processor::VoiceType>(&voice);
 
   // Stop previous note if active
-  if (voice && voice->isActive()) {
-    voice->noteOff();
+  if (v && v->isActive()) {
+    v->noteOff();
   }
 
   // Start tracker FX
@@ -38,15 +87,17 @@ void Track::triggerNote(int note, float velocity, const model::Step &step,
 
   // Trigger the voice immediately unless there's a delay or portamento
   // POR doesn't retrigger - the voice keeps playing and glides to the new pitch
-  if (!hasDelay && !hasPortamento && voice) {
-    instrument->updateVoiceParameters(voice.get());
-    voice->noteOn(note, velocity);
+  if (!hasDelay && !hasPortamento && v) {
+    instrument.updateVoiceParameters(*v);
+    v->noteOn(note, velocity);
   }
 }
 
+template <typename Processor>
 void Track::process(float *outL, float *outR, int numSamples,
-                    InstrumentProcessor *instrument) {
-  if (!voice || !hasPendingFX || !instrument) {
+                    Processor &instrument) {
+  auto *v = std::get_if<typename Processor::VoiceType>(&voice);
+  if (!v || !hasPendingFX) {
     // Clear output if no voice/FX
     std::fill_n(outL, numSamples, 0.0f);
     std::fill_n(outR, numSamples, 0.0f);
@@ -57,22 +108,19 @@ void Track::process(float *outL, float *outR, int numSamples,
   auto onNoteOn = [&](int n, float vel) {
     // Don't call noteOff() before re-triggering - just re-trigger directly
     // This allows envelopes to restart from their current position
-    instrument->updateVoiceParameters(voice.get());
-    voice->noteOn(n, vel);
+    instrument.updateVoiceParameters(*v);
+    v->noteOn(n, vel);
   };
 
-  auto onNoteOff = [&]() {
-    if (voice)
-      voice->noteOff();
-  };
+  auto onNoteOff = [&]() { v->noteOff(); };
 
   // Process FX timing (handles DLY, RET, CUT, OFF, ARP)
   float pitch = trackerFX.process(numSamples, onNoteOn, onNoteOff);
 
   // Render with modulation
-  if (voice && voice->isActive()) {
-    float pitchMod = pitch - voice->getCurrentNote();
-    voice->process(outL, outR, numSamples, pitchMod, 0.0f, 1.0f, 0.5f);
+  if (v->isActive()) {
+    float pitchMod = pitch - v->getCurrentNote();
+    v->process(outL, outR, numSamples, pitchMod, 0.0f, 1.0f, 0.5f);
   } else {
     std::fill_n(outL, numSamples, 0.0f);
     std::fill_n(outR, numSamples, 0.0f);
@@ -85,7 +133,7 @@ void Track::process(float *outL, float *outR, int numSamples,
 }
 
 AudioEngine::AudioEngine() {
-  // Legacy arrays disabled (Voice is now abstract)
+  // Legacy arrays disabled (voices are owned by Track)
   // trackVoices_.fill(nullptr);
 
   // Legacy tracking (kept temporarily for old trigger methods)
@@ -93,7 +141,18 @@ AudioEngine::AudioEngine() {
   trackNotes_.fill(-1);
   trackChainPositions_.fill(0);
 
-  // Create instrument processors for all slots
+  liveNotes_.fill(-1);
+  livePorts_.fill(-1);
+  liveAges_.fill(0);
+
+  // Nothing is known to be unreachable until the first
+  // setReachableInstruments()
+  for (auto &word : reachable_)
+    word.store(~uint64_t{0}, std::memory_order_relaxed);
+
+  // Create instrument processors for all slots. Serially: the sample
+  // players' first JobScheduler reference has to be made on this thread
+  model::StartupProfile::Phase phase("Engine processors");
   for (int i = 0; i < NUM_INSTRUMENTS; ++i) {
     instrumentProcessors_[i] = std::make_unique<PlaitsInstrument>();
     samplerProcessors_[i] = std::make_unique<SamplerInstrument>();
@@ -121,6 +180,27 @@ void AudioEngine::stop() {
   }
 }
 
+template <typename Processor>
+void AudioEngine::triggerTrackNote(int track, int note, int instrumentIndex,
+                                   float velocity, const model::Step &step,
+                                   Processor &processor) {
+  using VoiceType = typename Processor::VoiceType;
+  auto &t = tracks_[track];
+
+  // Create voice on track if needed (or different instrument/type)
+  if (!std::holds_alternative<VoiceType>(t.voice) ||
+      t.currentInstrumentIndex != instrumentIndex) {
+    processor.initVoice(t.voice.emplace<VoiceType>());
+    t.currentInstrumentIndex = instrumentIndex;
+  }
+
+  // Trigger note through Track (handles UniversalTrackerFX and voice)
+  t.triggerNote(note, velocity, step, processor);
+
+  trackInstruments_[track] = instrumentIndex;
+  trackNotes_[track] = note;
+}
+
 void AudioEngine::triggerNote(int track, int note, int instrumentIndex,
                               float velocity) {
   model::Step emptyStep;
@@ -202,21 +282,7 @@ void AudioEngine::triggerNote(int track, int note, int instrumentIndex,
 
     vaSynth->setInstrument(instrument);
 
-    // Create voice on track if needed (or different instrument/type)
-    if (!tracks_[track].voice ||
-        tracks_[track].currentInstrumentIndex != instrumentIndex ||
-        tracks_[track].currentInstrumentType !=
-            model::InstrumentType::VASynth) {
-      tracks_[track].voice = vaSynth->createVoice();
-      tracks_[track].currentInstrumentIndex = instrumentIndex;
-      tracks_[track].currentInstrumentType = model::InstrumentType::VASynth;
-    }
-
-    // Trigger note through Track (handles UniversalTrackerFX and voice)
-    tracks_[track].triggerNote(note, velocity, step, vaSynth);
-
-    trackInstruments_[track] = instrumentIndex;
-    trackNotes_[track] = note;
+    triggerTrackNote(track, note, instrumentIndex, velocity, step, *vaSynth);
     return;
   }
 
@@ -230,20 +296,7 @@ void AudioEngine::triggerNote(int track, int note, int instrumentIndex,
     // Sync parameters before triggering note
     syncInstrumentParams(instrumentIndex);
 
-    // Create voice on track if needed (or different instrument/type)
-    if (!tracks_[track].voice ||
-        tracks_[track].currentInstrumentIndex != instrumentIndex ||
-        tracks_[track].currentInstrumentType != model::InstrumentType::Plaits) {
-      tracks_[track].voice = plaits->createVoice();
-      tracks_[track].currentInstrumentIndex = instrumentIndex;
-      tracks_[track].currentInstrumentType = model::InstrumentType::Plaits;
-    }
-
-    // Trigger note through Track (handles UniversalTrackerFX and voice)
-    tracks_[track].triggerNote(note, velocity, step, plaits);
-
-    trackInstruments_[track] = instrumentIndex;
-    trackNotes_[track] = note;
+    triggerTrackNote(track, note, instrumentIndex, velocity, step, *plaits);
     return;
   }
 
@@ -256,21 +309,7 @@ void AudioEngine::triggerNote(int track, int note, int instrumentIndex,
     // Sync parameters first to ensure preset is loaded
     syncInstrumentParams(instrumentIndex);
 
-    // Create voice on track if needed (or different instrument/type)
-    if (!tracks_[track].voice ||
-        tracks_[track].currentInstrumentIndex != instrumentIndex ||
-        tracks_[track].currentInstrumentType !=
-            model::InstrumentType::DXPreset) {
-      tracks_[track].voice = dx7->createVoice();
-      tracks_[track].currentInstrumentIndex = instrumentIndex;
-      tracks_[track].currentInstrumentType = model::InstrumentType::DXPreset;
-    }
-
-    // Trigger note through Track (handles UniversalTrackerFX and voice)
-    tracks_[track].triggerNote(note, velocity, step, dx7);
-
-    trackInstruments_[track] = instrumentIndex;
-    trackNotes_[track] = note;
+    triggerTrackNote(track, note, instrumentIndex, velocity, step, *dx7);
     return;
   }
 
@@ -325,40 +364,12 @@ void AudioEngine::releaseNote(int track) {
       }
 
       if (instrument &&
-          instrument->getType() == model::InstrumentType::VASynth) {
-        // Handle VASynth instrument using Track system
-        // Note off is handled by Track voice
-        if (tracks_[track].voice && tracks_[track].voice->isActive()) {
-          tracks_[track].voice->noteOff();
-        }
-        // Stop tracker FX to prevent ARP/RET from continuing
-        tracks_[track].trackerFX.stop();
-        tracks_[track].hasPendingFX = false;
-        trackInstruments_[track] = -1;
-        return;
-      }
-
-      if (instrument &&
-          instrument->getType() == model::InstrumentType::Plaits) {
-        // Handle Plaits instrument using Track system
+          (instrument->getType() == model::InstrumentType::VASynth ||
+           instrument->getType() == model::InstrumentType::Plaits ||
+           instrument->getType() == model::InstrumentType::DXPreset)) {
+        // Handle Track system instruments
         // Note off is handled by Track voice
-        if (tracks_[track].voice && tracks_[track].voice->isActive()) {
-          tracks_[track].voice->noteOff();
-        }
-        // Stop tracker FX to prevent ARP/RET from continuing
-        tracks_[track].trackerFX.stop();
-        tracks_[track].hasPendingFX = false;
-        trackInstruments_[track] = -1;
-        return;
-      }
-
-      if (instrument &&
-          instrument->getType() == model::InstrumentType::DXPreset) {
-        // Handle DX7 preset instrument using Track system
-        // Note off is handled by Track voice
-        if (tracks_[track].voice && tracks_[track].voice->isActive()) {
-          tracks_[track].voice->noteOff();
-        }
+        tracks_[track].releaseVoice();
         // Stop tracker FX to prevent ARP/RET from continuing
         tracks_[track].trackerFX.stop();
         tracks_[track].hasPendingFX = false;
@@ -377,7 +388,86 @@ void AudioEngine::releaseNote(int track) {
   }
   trackInstruments_[track] = -1;
 
-  // Legacy voice array removed (Voice is now abstract, owned by Track)
+  // Legacy voice array removed (voices are owned by Track)
+}
+
+void AudioEngine::replaceProject(model::Project &&project) {
+  if (!project_)
+    return;
+
+  // Fade out first, so neither the swap nor the notes it cuts can click.
+  // Without a running device there is nothing to fade
+  const bool fading = deviceRunning_.load();
+  bool silent = false;
+  if (fading) {
+    switchState_.store(SwitchState::FadingOut, std::memory_order_release);
+    const auto deadline =
+        juce::Time::getMillisecondCounter() + SWITCH_TIMEOUT_MS;
+    while (!(silent = switchState_.load(std::memory_order_acquire) ==
+                      SwitchState::Silent) &&
+           juce::Time::getMillisecondCounter() < deadline)
+      juce::Thread::sleep(1);
+  }
+  // Otherwise the audio thread stops playback at its next block
+  if (!silent)
+    stop();
+
+  // Built before the swap: the old graph may name instruments or buses the
+  // new project doesn't have
+  auto graph = RoutingGraph::compile(project);
+
+  std::unique_ptr<model::Project> previous;
+  {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    previous = std::make_unique<model::Project>(std::move(*project_));
+    *project_ = std::move(project);
+    std::swap(graph_, graph);
+
+    // Processors keep a pointer to their model instrument between notes
+    for (int i = 0; i < NUM_INSTRUMENTS; ++i) {
+      auto *instrument = project_->getInstrument(i);
+      samplerProcessors_[static_cast<size_t>(i)]->setInstrument(instrument);
+      slicerProcessors_[static_cast<size_t>(i)]->setInstrument(instrument);
+      vaSynthProcessors_[static_cast<size_t>(i)]->setInstrument(instrument);
+    }
+  }
+  if (fading)
+    switchState_.store(SwitchState::FadingIn, std::memory_order_release);
+
+  // New instruments get pre-warmed on the next setReachableInstruments()
+  prewarmed_.reset();
+  destroyInBackground(std::move(previous));
+}
+
+void AudioEngine::setReachableInstruments(
+    const model::UsageIndex::InstrumentSet &instruments) {
+  for (int word = 0; word < REACHABLE_WORDS; ++word) {
+    uint64_t bits = 0;
+    for (int bit = 0; bit < 64; ++bit) {
+      if (instruments.test(static_cast<size_t>(word * 64 + bit)))
+        bits |= uint64_t{1} << bit;
+    }
+    reachable_[static_cast<size_t>(word)].store(bits,
+                                                std::memory_order_relaxed);
+  }
+
+  // Pre-warm: sync parameters (DX7 patch unpacking, Plaits settings) now
+  // instead of inside the first note's triggerNote()
+  auto fresh = instruments & ~prewarmed_;
+  prewarmed_ = instruments;
+  if (fresh.none() || !project_)
+    return;
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  for (int i = 0; i < NUM_INSTRUMENTS; ++i) {
+    if (fresh.test(static_cast<size_t>(i)) && project_->getInstrument(i))
+      syncInstrumentParams(i);
+  }
+}
+
+bool AudioEngine::isReachable(int instrumentIndex) const {
+  uint64_t word = reachable_[static_cast<size_t>(instrumentIndex / 64)].load(
+      std::memory_order_relaxed);
+  return (word >> (instrumentIndex % 64)) & 1u;
 }
 
 void AudioEngine::previewChord(const std::vector<int> &notes,
@@ -405,43 +495,29 @@ void AudioEngine::prepareToPlay(int samplesPerBlockExpected,
   sampleRate_ = sampleRate;
   samplesPerBlock_ = samplesPerBlockExpected;
 
-  // Initialize all instrument processors
+  // Initialize every slot's processors. Slots are independent, so they're
+  // spread over the job scheduler's workers - with 128 slots of five types
+  // this is most of the device start
+  model::StartupProfile::Phase phase("Engine prepareToPlay");
   double tempo = project_ ? project_->getTempo() : 120.0;
-  for (auto &processor : instrumentProcessors_) {
-    if (processor) {
+  juce::SharedResourcePointer<model::JobScheduler> scheduler;
+  const auto priority = model::JobScheduler::Priority::Interactive;
+  scheduler->parallelFor(NUM_INSTRUMENTS, priority, [&](int i) {
+    if (auto &processor = instrumentProcessors_[i]) {
       processor->init(sampleRate);
       processor->setTempo(tempo);
     }
-  }
-
-  // Initialize all sampler processors
-  for (auto &sampler : samplerProcessors_) {
-    if (sampler) {
+    if (auto &sampler = samplerProcessors_[i])
       sampler->init(sampleRate);
-    }
-  }
-
-  // Initialize all slicer processors
-  for (auto &slicer : slicerProcessors_) {
-    if (slicer) {
+    if (auto &slicer = slicerProcessors_[i])
       slicer->init(sampleRate);
-    }
-  }
-
-  // Initialize all VA synth processors
-  for (auto &vaSynth : vaSynthProcessors_) {
-    if (vaSynth) {
+    if (auto &vaSynth = vaSynthProcessors_[i]) {
       vaSynth->init(sampleRate);
       vaSynth->setTempo(tempo);
     }
-  }
-
-  // Initialize all DX7 processors
-  for (auto &dx7 : dx7Processors_) {
-    if (dx7) {
+    if (auto &dx7 = dx7Processors_[i])
       dx7->init(sampleRate);
-    }
-  }
+  });
 
   // Initialize channel strips
   for (auto &strip : channelStrips_) {
@@ -450,6 +526,20 @@ void AudioEngine::prepareToPlay(int samplesPerBlockExpected,
     }
     strip->prepare(sampleRate, samplesPerBlockExpected);
   }
+  for (auto &strip : busStrips_) {
+    if (!strip) {
+      strip = std::make_unique<ChannelStrip>();
+    }
+    strip->prepare(sampleRate, samplesPerBlockExpected);
+  }
+
+  // Helpers for rendering the mixer graph's levels in parallel
+  workers_.start(samplesPerBlockExpected, sampleRate);
+
+  // Whole device blocks of stems for the JACK stem ports
+  const int jackStemChannels =
+      jackStems_ ? jackStems_->getNumInstruments() * 2 : 0;
+  jackStemBuffer_.setSize(jackStemChannels, samplesPerBlockExpected);
 
   // Legacy voices removed - Voice is now abstract, owned by Track
   // (will be fully cleaned up in Task 11)
@@ -457,62 +547,88 @@ void AudioEngine::prepareToPlay(int samplesPerBlockExpected,
   // Initialize effects processor
   effects_.init(sampleRate);
   effects_.setTempo(static_cast<float>(tempo));
+
+  // The impulse response was resampled for the old rate - rebuild it
+  if (convolutionReverb_ && reverbImpulseFile_.existsAsFile())
+    setReverbImpulse(reverbImpulseFile_, reverbMaxSeconds_);
+
+  deviceRunning_.store(true);
 }
 
-void AudioEngine::releaseResources() { stop(); }
+void AudioEngine::releaseResources() {
+  deviceRunning_.store(false);
+  stop();
+  workers_.stop();
+}
 
-void AudioEngine::getNextAudioBlock(
-    const juce::AudioSourceChannelInfo &bufferToFill) {
-  bufferToFill.clearActiveBufferRegion();
+void AudioEngine::haltPlayback() {
+  // Called from audio thread
+  playing_.store(false, std::memory_order_relaxed);
 
-  // Handle pending transport commands (lock-free from UI thread)
-  if (pendingStop_.load(std::memory_order_acquire)) {
-    pendingStop_.store(false, std::memory_order_relaxed);
-    playing_.store(false, std::memory_order_relaxed);
+  // Release all notes on all instrument processors
+  for (auto &processor : instrumentProcessors_) {
+    if (processor)
+      processor->allNotesOff();
+  }
 
-    // Release all notes on all instrument processors
-    for (auto &processor : instrumentProcessors_) {
-      if (processor)
-        processor->allNotesOff();
-    }
+  // Release all sampler processors
+  for (auto &sampler : samplerProcessors_) {
+    if (sampler)
+      sampler->allNotesOff();
+  }
 
-    // Release all sampler processors
-    for (auto &sampler : samplerProcessors_) {
-      if (sampler)
-        sampler->allNotesOff();
-    }
+  // Release all slicer processors
+  for (auto &slicer : slicerProcessors_) {
+    if (slicer)
+      slicer->allNotesOff();
+  }
 
-    // Release all slicer processors
-    for (auto &slicer : slicerProcessors_) {
-      if (slicer)
-        slicer->allNotesOff();
-    }
+  // Release all VA synth processors
+  for (auto &vaSynth : vaSynthProcessors_) {
+    if (vaSynth)
+      vaSynth->allNotesOff();
+  }
 
-    // Release all VA synth processors
-    for (auto &vaSynth : vaSynthProcessors_) {
-      if (vaSynth)
-        vaSynth->allNotesOff();
-    }
+  // Release all DX7 processors
+  for (auto &dx7 : dx7Processors_) {
+    if (dx7)
+      dx7->allNotesOff();
+  }
 
-    // Release all DX7 processors
-    for (auto &dx7 : dx7Processors_) {
-      if (dx7)
-        dx7->allNotesOff();
-    }
+  // Stop all track FX to prevent ARP/RET from continuing after playback stops
+  for (auto &track : tracks_) {
+    track.trackerFX.stop();
+    track.hasPendingFX = false;
+    track.releaseVoice();
+  }
 
-    // Stop all track FX to prevent ARP/RET from continuing after playback stops
-    for (auto &track : tracks_) {
-      track.trackerFX.stop();
-      track.hasPendingFX = false;
-      if (track.voice && track.voice->isActive()) {
-        track.voice->noteOff();
-      }
+  // Legacy voice array removed (voices are owned by Track)
+  // Reset tracking arrays
+  trackInstruments_.fill(-1);
+  trackNotes_.fill(-1);
+  liveNotes_.fill(-1);
+}
+
+void AudioEngine::getNextAudioBlock(
+    const juce::AudioSourceChannelInfo &bufferToFill) {
+  bufferToFill.clearActiveBufferRegion();
+
+  // Follow JACK transport starts/stops (edges only, so Space still works)
+  if (jackTransport_ && jackTransport_->isConnected()) {
+    bool rolling = jackTransport_->isRolling();
+    if (rolling != jackWasRolling_) {
+      if (rolling)
+        play();
+      else
+        stop();
+      jackWasRolling_ = rolling;
     }
+  }
 
-    // Legacy voice array removed (Voice is now abstract, owned by Track)
-    // Reset tracking arrays
-    trackInstruments_.fill(-1);
-    trackNotes_.fill(-1);
+  // Handle pending transport commands (lock-free from UI thread)
+  if (pendingStop_.load(std::memory_order_acquire)) {
+    pendingStop_.store(false, std::memory_order_relaxed);
+    haltPlayback();
   }
 
   if (pendingPlay_.load(std::memory_order_acquire)) {
@@ -536,6 +652,114 @@ void AudioEngine::getNextAudioBlock(
 
   int numSamples = bufferToFill.numSamples;
 
+  // Stems go to the JACK stem ports when they're open, otherwise to any
+  // output channels after the main pair
+  const bool jackStems = jackStems_ && jackStems_->isOpen() &&
+                         jackStemBuffer_.getNumChannels() > 0 &&
+                         numSamples <= jackStemBuffer_.getNumSamples();
+  int stemBlockStart = bufferToFill.startSample;
+  if (jackStems) {
+    jackStemBuffer_.clear(0, numSamples);
+    stemBuffer_ = &jackStemBuffer_;
+    stemFirstChannel_ = 0;
+    stemBlockStart = 0;
+    numStems_ = std::min(jackStemBuffer_.getNumChannels() / 2, NUM_INSTRUMENTS);
+  } else {
+    stemBuffer_ = bufferToFill.buffer;
+    stemFirstChannel_ = 2;
+    numStems_ = std::clamp((bufferToFill.buffer->getNumChannels() - 2) / 2, 0,
+                           NUM_INSTRUMENTS);
+  }
+
+  // Pull MIDI received during the last block period
+  int numMidiEvents = 0;
+  if (midiInput_)
+    numMidiEvents = midiInput_->popEvents(midiEvents_.data(),
+                                          MAX_MIDI_EVENTS_PER_BLOCK,
+                                          numSamples, sampleRate_);
+
+  // Render in sub-blocks that end at each event's offset, so notes start on
+  // the exact sample rather than at the start of the block
+  int nextEvent = 0;
+  int pos = 0;
+  while (pos < numSamples) {
+    while (nextEvent < numMidiEvents && midiEvents_[nextEvent].offset <= pos)
+      handleMidiEvent(midiEvents_[nextEvent++]);
+
+    int end = nextEvent < numMidiEvents ? midiEvents_[nextEvent].offset
+                                        : numSamples;
+    end = std::min(end, pos + MAX_RENDER_BLOCK);
+    stemStartSample_ = stemBlockStart + pos;
+    renderBlock(outL + pos, outR + pos, end - pos);
+    pos = end;
+  }
+
+  // Project switch fade - the stem outputs too
+  applySwitchFade(*bufferToFill.buffer, bufferToFill.startSample, numSamples,
+                  jackStems ? &jackStemBuffer_ : nullptr);
+
+  if (jackStems)
+    jackStems_->write(jackStemBuffer_, numSamples);
+}
+
+void AudioEngine::applySwitchFade(juce::AudioBuffer<float> &buffer,
+                                  int startSample, int numSamples,
+                                  juce::AudioBuffer<float> *stems) {
+  // Called from audio thread with mutex_ held. 'stems' (optional) starts at
+  // sample 0 and gets the same gain
+  auto state = switchState_.load(std::memory_order_acquire);
+  if (state == SwitchState::None)
+    return;
+
+  if (state == SwitchState::Silent) {
+    buffer.clear(startSample, numSamples);
+    if (stems)
+      stems->clear(0, numSamples);
+    return;
+  }
+
+  // Linear ramp from wherever the last fade stopped
+  const bool fadingOut = state == SwitchState::FadingOut;
+  const int target = fadingOut ? 0 : SWITCH_FADE_SAMPLES;
+  const int n = std::min(numSamples, std::abs(target - switchFadePos_));
+  const int endPos = switchFadePos_ + (fadingOut ? -n : n);
+  const float scale = 1.0f / static_cast<float>(SWITCH_FADE_SAMPLES);
+  const float startGain = static_cast<float>(switchFadePos_) * scale;
+  const float endGain = static_cast<float>(endPos) * scale;
+  for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+    buffer.applyGainRamp(ch, startSample, n, startGain, endGain);
+  if (stems) {
+    for (int ch = 0; ch < stems->getNumChannels(); ++ch)
+      stems->applyGainRamp(ch, 0, n, startGain, endGain);
+  }
+  switchFadePos_ = endPos;
+  if (switchFadePos_ != target)
+    return;
+
+  if (fadingOut) {
+    buffer.clear(startSample + n, numSamples - n);
+    if (stems)
+      stems->clear(n, numSamples - n);
+    // Nothing of the old project may sound after the swap. The message
+    // thread may already have given up waiting, in which case it has asked
+    // for the fade in and that wins
+    haltPlayback();
+    switchState_.compare_exchange_strong(state, SwitchState::Silent);
+  } else {
+    switchState_.compare_exchange_strong(state, SwitchState::None);
+  }
+}
+
+void AudioEngine::renderBlock(float *outL, float *outR, int numSamples) {
+  // Called from audio thread with mutex_ held
+
+  // Stems and the FX return are summed into the capture buffer as they mix
+  capturing_ = diskRecorder_ && diskRecorder_->isRecording();
+  if (capturing_) {
+    for (int ch = 0; ch < diskRecorder_->getNumStreams() * 2; ++ch)
+      diskCapture_.clear(ch, 0, numSamples);
+  }
+
   // Update tempo for effects
   if (project_)
     effects_.setTempo(project_->getTempo());
@@ -549,7 +773,7 @@ void AudioEngine::getNextAudioBlock(
     // mode)
     int patternLength = 16; // default
     if (playMode_ == PlayMode::Pattern) {
-      auto *pattern = project_->getPattern(currentPattern_);
+      const model::Pattern *pattern = project_->getPattern(currentPattern_);
       if (pattern)
         patternLength = pattern->getLength();
     } else {
@@ -557,7 +781,7 @@ void AudioEngine::getNextAudioBlock(
       for (int col = 0; col < NUM_TRACKS; ++col) {
         int patIdx = getPatternIndexForColumn(col);
         if (patIdx >= 0) {
-          auto *pat = project_->getPattern(patIdx);
+          const model::Pattern *pat = project_->getPattern(patIdx);
           if (pat && pat->getLength() > patternLength)
             patternLength = pat->getLength();
         }
@@ -569,7 +793,8 @@ void AudioEngine::getNextAudioBlock(
       if (samplesUntilNextRow_ <= 0.0) {
         if (playMode_ == PlayMode::Pattern) {
           // Pattern mode: play single pattern on all 16 tracks
-          auto *pattern = project_->getPattern(currentPattern_);
+          const model::Pattern *pattern =
+              project_->getPattern(currentPattern_);
           if (pattern) {
             for (int track = 0; track < NUM_TRACKS; ++track) {
               const auto &step = pattern->getStep(track, currentRow_);
@@ -593,7 +818,7 @@ void AudioEngine::getNextAudioBlock(
             if (patIdx < 0)
               continue;
 
-            auto *pattern = project_->getPattern(patIdx);
+            const model::Pattern *pattern = project_->getPattern(patIdx);
             if (!pattern)
               continue;
 
@@ -657,6 +882,7 @@ void AudioEngine::getNextAudioBlock(
 
         samplesUntilNextRow_ =
             samplesPerRow * (1.0 + static_cast<double>(grooveOffset));
+        currentRowLength_ = samplesUntilNextRow_;
 
         // Ensure samplesUntilNextRow_ is always positive to prevent infinite
         // loop This guards against extreme groove offsets near -1.0
@@ -688,523 +914,773 @@ void AudioEngine::getNextAudioBlock(
     }
   }
 
-  // Temporary buffers for per-instrument rendering
-  std::array<float, 512> tempL{}, tempR{};
-
-  // Buffers for sidechain source capture
-  std::array<float, 512> sidechainSourceL{}, sidechainSourceR{};
-  std::fill(sidechainSourceL.begin(), sidechainSourceL.begin() + numSamples,
-            0.0f);
-  std::fill(sidechainSourceR.begin(), sidechainSourceR.begin() + numSamples,
-            0.0f);
-
-  // Get sidechain source instrument from mixer settings
-  int sidechainSourceInst =
-      project_ ? project_->getMixer().sidechainSource : -1;
-
-  // Render all instrument processors with per-instrument mixing
-  float avgReverb = 0.0f, avgDelay = 0.0f, avgChorus = 0.0f;
-  int activeCount = 0;
+  if (!project_ || !graph_) {
+    renderPreviewClip(outL, outR, numSamples);
+    return;
+  }
 
-  for (int instIdx = 0; instIdx < NUM_INSTRUMENTS; ++instIdx) {
-    auto &processor = instrumentProcessors_[instIdx];
-    if (!processor)
+  // Update effect parameters from project settings
+  const auto &mixer = project_->getMixer();
+  effects_.reverb.setParams(mixer.reverbSize, mixer.reverbDamping, 1.0f);
+  effects_.fdnReverb.setParams(mixer.reverbSize, mixer.reverbDamping);
+  effects_.reverbType =
+      mixer.reverbType == 0 ? ReverbType::Schroeder : ReverbType::Fdn;
+  effects_.delay.setParams(mixer.delayTime, mixer.delayFeedback, 1.0f);
+  effects_.delay.setPingPong(mixer.delayPingPong);
+  effects_.chorus.setParams(mixer.chorusRate, mixer.chorusDepth, 1.0f);
+  effects_.chorus.setEnsemble(mixer.chorusEnsemble);
+  effects_.sidechain.setParams(mixer.sidechainAttack, mixer.sidechainRelease,
+                               mixer.sidechainRatio);
+  effects_.djFilter.setPosition(mixer.djFilterPosition);
+  effects_.limiter.setParams(mixer.limiterThreshold, mixer.limiterRelease);
+
+  // Which tracks each instrument node renders, in track order
+  firstTrack_.fill(-1);
+  for (int trackIdx = NUM_ENGINE_TRACKS - 1; trackIdx >= 0; --trackIdx) {
+    const auto &track = tracks_[static_cast<size_t>(trackIdx)];
+    const int instIdx = track.currentInstrumentIndex;
+    nextTrack_[static_cast<size_t>(trackIdx)] = -1;
+    if (!track.hasVoice() || instIdx < 0 || instIdx >= NUM_INSTRUMENTS)
       continue;
+    nextTrack_[static_cast<size_t>(trackIdx)] =
+        firstTrack_[static_cast<size_t>(instIdx)];
+    firstTrack_[static_cast<size_t>(instIdx)] = trackIdx;
+  }
 
-    // Get instrument model for mixer settings
-    model::Instrument *instrument =
-        project_ ? project_->getInstrument(instIdx) : nullptr;
-
-    // Determine if this instrument should play
-    bool shouldPlay = true;
-    float volume = 1.0f;
-    float pan = 0.0f;
-
-    if (instrument) {
-      // Check mute/solo
-      if (anySoloed) {
-        // In solo mode, only play soloed instruments
-        shouldPlay = instrument->isSoloed();
-      } else {
-        // Normal mode, respect mute
-        shouldPlay = !instrument->isMuted();
+  // Every node of a level only reads nodes of earlier levels, so a level's
+  // nodes render in parallel. Level 0 is the instruments
+  levelTask_.engine = this;
+  levelTask_.numSamples = numSamples;
+  levelTask_.anySoloed = anySoloed;
+  analysisNode_ = -1;
+  if (analysisTap_ &&
+      analysisTap_->getPoint() == AnalysisTap::Point::Instrument)
+    analysisNode_ = graph_->getInstrumentNode(analysisTap_->getIndex());
+  else if (analysisTap_ && analysisTap_->getPoint() == AnalysisTap::Point::Bus)
+    analysisNode_ = graph_->getBusNode(analysisTap_->getIndex());
+  for (int level = 0; level < graph_->getNumLevels(); ++level) {
+    const auto &nodes = graph_->getLevel(level);
+    workers_.run(levelTask_, nodes.data(), static_cast<int>(nodes.size()));
+
+    if (level == 0) {
+      for (int node : nodes) {
+        if (graph_->isActive(node))
+          addToStem(graph_->getNode(node).index, graph_->getChannel(node, 0),
+                    graph_->getChannel(node, 1), numSamples);
       }
-
-      volume = instrument->getVolume();
-      pan = instrument->getPan();
     }
+  }
 
-    if (!shouldPlay) {
-      // Still process to keep envelopes/LFOs running, but don't add to output
-      processor->process(tempL.data(), tempR.data(), numSamples);
-      continue;
-    }
+  renderMaster(outL, outR, numSamples);
+}
 
-    // Clear temp buffers
-    std::fill(tempL.begin(), tempL.begin() + numSamples, 0.0f);
-    std::fill(tempR.begin(), tempR.begin() + numSamples, 0.0f);
+void AudioEngine::renderNode(int node, int thread, int numSamples,
+                             bool anySoloed) {
+  // Called with mutex_ held by the audio thread, on it or a render worker
+  switch (graph_->getNode(node).type) {
+  case RoutingGraph::NodeType::Instrument:
+    renderInstrumentNode(node, thread, numSamples, anySoloed);
+    break;
+  case RoutingGraph::NodeType::Bus:
+    renderBusNode(node, numSamples);
+    break;
+  case RoutingGraph::NodeType::Return:
+    renderReturnNode(node, numSamples);
+    break;
+  case RoutingGraph::NodeType::Key:
+    renderKeyNode(node, numSamples);
+    break;
+  case RoutingGraph::NodeType::Master:
+    break;
+  }
+  if (node == analysisNode_)
+    tapNode(node, numSamples);
+}
 
-    // Render instrument to temp buffers
-    processor->process(tempL.data(), tempR.data(), numSamples);
+void AudioEngine::tapNode(int node, int numSamples) {
+  // On whichever thread rendered the node; a node is only rendered once a
+  // block, so the tap still has one writer at a time
+  const auto &graph = *graph_;
+  if (graph.isActive(node))
+    analysisTap_->write(graph.getChannel(node, 0), graph.getChannel(node, 1),
+                        numSamples);
+  else
+    analysisTap_->writeSilence(numSamples);
+}
 
-    // Apply channel strip processing
-    if (instrument && channelStrips_[instIdx]) {
-      channelStrips_[instIdx]->updateParams(instrument->getChannelStrip());
-      channelStrips_[instIdx]->process(tempL.data(), tempR.data(), numSamples);
-    }
+void AudioEngine::renderInstrumentNode(int node, int thread, int numSamples,
+                                       bool anySoloed) {
+  auto &graph = *graph_;
+  graph.setActive(node, false);
+  const int instIdx = graph.getNode(node).index;
+  model::Instrument *instrument = project_->getInstrument(instIdx);
+  if (!instrument)
+    return;
 
-    // Apply volume and pan, mix into output
-    // Pan law: constant power (sqrt)
-    float leftGain = volume * std::sqrt((1.0f - pan) / 2.0f);
-    float rightGain = volume * std::sqrt((1.0f + pan) / 2.0f);
-
-    for (int i = 0; i < numSamples; ++i) {
-      // Simple pan: distribute mono sum based on pan
-      float monoSample = (tempL[i] + tempR[i]) * 0.5f;
-      outL[i] += monoSample * leftGain * 2.0f; // *2 to compensate for mono sum
-      outR[i] += monoSample * rightGain * 2.0f;
-
-      // Capture sidechain source audio
-      if (instIdx == sidechainSourceInst) {
-        sidechainSourceL[i] += monoSample * leftGain * 2.0f;
-        sidechainSourceR[i] += monoSample * rightGain * 2.0f;
-      }
+  const bool shouldPlay =
+      anySoloed ? instrument->isSoloed() : !instrument->isMuted();
+  const auto slot = static_cast<size_t>(instIdx);
+  float *outL = graph.getChannel(node, 0);
+  float *outR = graph.getChannel(node, 1);
+  auto &scratch = scratch_[static_cast<size_t>(thread)];
+  float *tempL = scratch.left.data();
+  float *tempR = scratch.right.data();
+
+  // Everything the instrument plays is summed, then goes through its channel
+  // strip once
+  bool sounding = false;
+  auto addSource = [&]() {
+    if (sounding) {
+      juce::FloatVectorOperations::add(outL, tempL, numSamples);
+      juce::FloatVectorOperations::add(outR, tempR, numSamples);
+    } else {
+      std::copy(tempL, tempL + numSamples, outL);
+      std::copy(tempR, tempR + numSamples, outR);
+      sounding = true;
     }
+  };
+  auto clearTemp = [&]() {
+    std::fill(tempL, tempL + numSamples, 0.0f);
+    std::fill(tempR, tempR + numSamples, 0.0f);
+  };
 
-    // Accumulate send levels from active instruments
-    if (instrument && shouldPlay) {
-      const auto &sends = instrument->getSends();
-      avgReverb += sends.reverb * volume;
-      avgDelay += sends.delay * volume;
-      avgChorus += sends.chorus * volume;
-      activeCount++;
-    }
+  // Legacy processor - still processed while muted to keep envelopes/LFOs
+  // running. Previews and live notes play through tracks, not this path
+  auto &processor = instrumentProcessors_[slot];
+  if (processor && isReachable(instIdx)) {
+    clearTemp();
+    processor->process(tempL, tempR, numSamples);
+    if (shouldPlay)
+      addSource();
   }
 
-  // Process sampler instruments
-  for (int instIdx = 0; instIdx < NUM_INSTRUMENTS; ++instIdx) {
-    auto &sampler = samplerProcessors_[instIdx];
-    if (!sampler)
-      continue;
-
-    // Get instrument model for mixer settings
-    model::Instrument *instrument =
-        project_ ? project_->getInstrument(instIdx) : nullptr;
-
-    // Only process if this is a Sampler type instrument
-    if (!instrument || instrument->getType() != model::InstrumentType::Sampler)
-      continue;
-
-    // Determine if this instrument should play
-    bool shouldPlay = true;
-    float volume = 1.0f;
-    float pan = 0.0f;
+  if (!shouldPlay)
+    return;
 
-    // Check mute/solo
-    if (anySoloed) {
-      shouldPlay = instrument->isSoloed();
-    } else {
-      shouldPlay = !instrument->isMuted();
+  // Out of the song's reach and not sounding (preview, live input, chop)
+  // sampler and slicer are skipped
+  const auto type = instrument->getType();
+  if (type == model::InstrumentType::Sampler) {
+    auto &sampler = samplerProcessors_[slot];
+    if (sampler && sampler->hasSample() &&
+        (isReachable(instIdx) || sampler->getPlayheadPosition() >= 0)) {
+      clearTemp();
+      sampler->process(tempL, tempR, numSamples);
+      addSource();
     }
-
-    if (!shouldPlay || !sampler->hasSample()) {
-      continue;
+  } else if (type == model::InstrumentType::Slicer) {
+    auto &slicer = slicerProcessors_[slot];
+    if (slicer && slicer->hasSample() &&
+        (isReachable(instIdx) || slicer->getPlayheadPosition() >= 0)) {
+      clearTemp();
+      slicer->process(tempL, tempR, numSamples);
+      addSource();
     }
+  }
 
-    volume = instrument->getVolume();
-    pan = instrument->getPan();
-
-    // Clear temp buffers
-    std::fill(tempL.begin(), tempL.begin() + numSamples, 0.0f);
-    std::fill(tempR.begin(), tempR.begin() + numSamples, 0.0f);
-
-    // Render sampler to temp buffers
-    sampler->process(tempL.data(), tempR.data(), numSamples);
-
-    // Apply channel strip processing
-    if (instrument && channelStrips_[instIdx]) {
-      channelStrips_[instIdx]->updateParams(instrument->getChannelStrip());
-      channelStrips_[instIdx]->process(tempL.data(), tempR.data(), numSamples);
+  // Voice-per-track instruments: every track now playing this one. The type
+  // is switched on once here; each track then renders through the concrete
+  // processor and voice types
+  auto renderTracks = [&](auto *trackProcessor) {
+    if (!trackProcessor)
+      return;
+    for (int trackIdx = firstTrack_[slot]; trackIdx >= 0;
+         trackIdx = nextTrack_[static_cast<size_t>(trackIdx)]) {
+      tracks_[static_cast<size_t>(trackIdx)].process(tempL, tempR, numSamples,
+                                                     *trackProcessor);
+      addSource();
     }
+  };
+  if (type == model::InstrumentType::VASynth)
+    renderTracks(vaSynthProcessors_[slot].get());
+  else if (type == model::InstrumentType::Plaits)
+    renderTracks(instrumentProcessors_[slot].get());
+  else if (type == model::InstrumentType::DXPreset)
+    renderTracks(dx7Processors_[slot].get());
+
+  if (!sounding)
+    return;
 
-    // Apply volume and pan, mix into output
-    float leftGain = volume * std::sqrt((1.0f - pan) / 2.0f);
-    float rightGain = volume * std::sqrt((1.0f + pan) / 2.0f);
+  if (channelStrips_[slot]) {
+    channelStrips_[slot]->updateParams(instrument->getChannelStrip());
+    channelStrips_[slot]->process(outL, outR, numSamples);
+  }
 
-    for (int i = 0; i < numSamples; ++i) {
-      float monoSample = (tempL[i] + tempR[i]) * 0.5f;
-      outL[i] += monoSample * leftGain * 2.0f;
-      outR[i] += monoSample * rightGain * 2.0f;
+  // Volume and pan - constant power (sqrt) on the mono sum, *2 to
+  // compensate for the mono sum
+  const float volume = instrument->getVolume();
+  const float pan = instrument->getPan();
+  const float leftGain = volume * std::sqrt((1.0f - pan) / 2.0f) * 2.0f;
+  const float rightGain = volume * std::sqrt((1.0f + pan) / 2.0f) * 2.0f;
+  for (int i = 0; i < numSamples; ++i) {
+    float monoSample = (outL[i] + outR[i]) * 0.5f;
+    outL[i] = monoSample * leftGain;
+    outR[i] = monoSample * rightGain;
+  }
+  graph.setActive(node, true);
+}
 
-      // Capture sidechain source audio
-      if (instIdx == sidechainSourceInst) {
-        sidechainSourceL[i] += monoSample * leftGain * 2.0f;
-        sidechainSourceR[i] += monoSample * rightGain * 2.0f;
-      }
+void AudioEngine::renderBusNode(int node, int numSamples) {
+  auto &graph = *graph_;
+  graph.setActive(node, false);
+  const int busIdx = graph.getNode(node).index;
+  const auto &buses = project_->getMixer().buses;
+  if (busIdx >= static_cast<int>(buses.size()))
+    return; // Removed since the graph was built
+  const auto &bus = buses[static_cast<size_t>(busIdx)];
+
+  float *outL = graph.getChannel(node, 0);
+  float *outR = graph.getChannel(node, 1);
+  bool sounding = false;
+  for (int input : graph.getNode(node).inputs) {
+    if (!graph.isActive(input))
+      continue;
+    if (!sounding) {
+      std::fill(outL, outL + numSamples, 0.0f);
+      std::fill(outR, outR + numSamples, 0.0f);
+      sounding = true;
     }
+    mixInput(input, outL, outR, 1.0f, numSamples);
+  }
+  if (!sounding || bus.muted)
+    return;
 
-    // Accumulate send levels
-    const auto &sends = instrument->getSends();
-    avgReverb += sends.reverb * volume;
-    avgDelay += sends.delay * volume;
-    avgChorus += sends.chorus * volume;
-    activeCount++;
+  auto &strip = busStrips_[static_cast<size_t>(busIdx)];
+  if (strip) {
+    strip->updateParams(bus.channelStrip);
+    strip->process(outL, outR, numSamples);
   }
 
-  // Process slicer instruments
-  for (int instIdx = 0; instIdx < NUM_INSTRUMENTS; ++instIdx) {
-    auto &slicer = slicerProcessors_[instIdx];
-    if (!slicer)
-      continue;
+  // Balance: the bus is already stereo, so pan only turns one side down
+  const float leftGain = bus.volume * std::min(1.0f, 1.0f - bus.pan);
+  const float rightGain = bus.volume * std::min(1.0f, 1.0f + bus.pan);
+  juce::FloatVectorOperations::multiply(outL, leftGain, numSamples);
+  juce::FloatVectorOperations::multiply(outR, rightGain, numSamples);
+  graph.setActive(node, true);
+}
 
-    // Get instrument model for mixer settings
-    model::Instrument *instrument =
-        project_ ? project_->getInstrument(instIdx) : nullptr;
+void AudioEngine::renderReturnNode(int node, int numSamples) {
+  auto &graph = *graph_;
+  const auto &graphNode = graph.getNode(node);
+  graph.setActive(node, false);
+  // Nothing sends here - the effect isn't run, as with a send at zero
+  if (graphNode.inputs.empty())
+    return;
 
-    // Only process if this is a Slicer type instrument
-    if (!instrument || instrument->getType() != model::InstrumentType::Slicer)
+  // Each source's send, post-fader (and post-duck), with the same headroom
+  // as the master mix
+  constexpr float trackHeadroomGain = 0.25f;
+  float *outL = graph.getChannel(node, 0);
+  float *outR = graph.getChannel(node, 1);
+  std::fill(outL, outL + numSamples, 0.0f);
+  std::fill(outR, outR + numSamples, 0.0f);
+  for (int input : graphNode.inputs) {
+    if (!graph.isActive(input))
       continue;
-
-    // Determine if this instrument should play
-    bool shouldPlay = true;
-    float volume = 1.0f;
-    float pan = 0.0f;
-
-    // Check mute/solo
-    if (anySoloed) {
-      shouldPlay = instrument->isSoloed();
-    } else {
-      shouldPlay = !instrument->isMuted();
-    }
-
-    if (!shouldPlay || !slicer->hasSample()) {
+    const auto *sends = getNodeSends(graph.getNode(input));
+    if (!sends)
       continue;
-    }
-
-    volume = instrument->getVolume();
-    pan = instrument->getPan();
 
-    // Clear temp buffers
-    std::fill(tempL.begin(), tempL.begin() + numSamples, 0.0f);
-    std::fill(tempR.begin(), tempR.begin() + numSamples, 0.0f);
+    const float level = graphNode.index == RoutingGraph::ReverbReturn ? sends->reverb
+                        : graphNode.index == RoutingGraph::DelayReturn
+                            ? sends->delay
+                            : sends->chorus;
+    mixInput(input, outL, outR, level * trackHeadroomGain, numSamples);
+  }
 
-    // Render slicer to temp buffers
-    slicer->process(tempL.data(), tempR.data(), numSamples);
+  // Run even when the sources are silent, so tails ring out
+  const auto effect =
+      graphNode.index == RoutingGraph::ReverbReturn ? EffectsProcessor::Return::Reverb
+      : graphNode.index == RoutingGraph::DelayReturn
+          ? EffectsProcessor::Return::Delay
+          : EffectsProcessor::Return::Chorus;
+  effects_.processReturn(effect, outL, outR, numSamples);
+  graph.setActive(node, true);
+}
 
-    // Apply channel strip processing
-    if (instrument && channelStrips_[instIdx]) {
-      channelStrips_[instIdx]->updateParams(instrument->getChannelStrip());
-      channelStrips_[instIdx]->process(tempL.data(), tempR.data(), numSamples);
+void AudioEngine::renderKeyNode(int node, int numSamples) {
+  // The key is never heard: every keying channel is mixed in at its key
+  // send, and only the peak is kept. Run while nothing sounds too, so the
+  // ducking releases
+  auto &graph = *graph_;
+  float *keyL = graph.getChannel(node, 0);
+  float *keyR = graph.getChannel(node, 1);
+  bool sounding = false;
+  for (int input : graph.getNode(node).inputs) {
+    if (!graph.isActive(input))
+      continue;
+    const auto *sends = getNodeSends(graph.getNode(input));
+    if (!sends)
+      continue;
+    if (!sounding) {
+      std::fill(keyL, keyL + numSamples, 0.0f);
+      std::fill(keyR, keyR + numSamples, 0.0f);
+      sounding = true;
     }
+    juce::FloatVectorOperations::addWithMultiply(
+        keyL, graph.getChannel(input, 0), sends->sidechainKey, numSamples);
+    juce::FloatVectorOperations::addWithMultiply(
+        keyR, graph.getChannel(input, 1), sends->sidechainKey, numSamples);
+  }
 
-    // Apply volume and pan, mix into output
-    float leftGain = volume * std::sqrt((1.0f - pan) / 2.0f);
-    float rightGain = volume * std::sqrt((1.0f + pan) / 2.0f);
+  float peak = 0.0f;
+  if (sounding) {
+    const auto left = juce::FloatVectorOperations::findMinAndMax(keyL, numSamples);
+    const auto right = juce::FloatVectorOperations::findMinAndMax(keyR, numSamples);
+    peak = std::max({-left.getStart(), left.getEnd(), -right.getStart(),
+                     right.getEnd()});
+  }
+  effects_.sidechain.processKey(peak, numSamples);
+}
 
-    for (int i = 0; i < numSamples; ++i) {
-      float monoSample = (tempL[i] + tempR[i]) * 0.5f;
-      outL[i] += monoSample * leftGain * 2.0f;
-      outR[i] += monoSample * rightGain * 2.0f;
+const model::SendLevels *
+AudioEngine::getNodeSends(const RoutingGraph::Node &node) const {
+  if (node.type == RoutingGraph::NodeType::Instrument) {
+    if (auto *instrument = project_->getInstrument(node.index))
+      return &instrument->getSends();
+    return nullptr;
+  }
+  const auto &buses = project_->getMixer().buses;
+  if (node.type == RoutingGraph::NodeType::Bus &&
+      node.index < static_cast<int>(buses.size()))
+    return &buses[static_cast<size_t>(node.index)].sends;
+  return nullptr;
+}
 
-      // Capture sidechain source audio
-      if (instIdx == sidechainSourceInst) {
-        sidechainSourceL[i] += monoSample * leftGain * 2.0f;
-        sidechainSourceR[i] += monoSample * rightGain * 2.0f;
-      }
-    }
+void AudioEngine::mixInput(int input, float *outL, float *outR, float gain,
+                           int numSamples) const {
+  const auto &graph = *graph_;
+  const float *inL = graph.getChannel(input, 0);
+  const float *inR = graph.getChannel(input, 1);
+  const auto &source = graph.getNode(input);
+  const auto *sends = source.ducked ? getNodeSends(source) : nullptr;
+  if (!sends) {
+    juce::FloatVectorOperations::addWithMultiply(outL, inL, gain, numSamples);
+    juce::FloatVectorOperations::addWithMultiply(outR, inR, gain, numSamples);
+    return;
+  }
 
-    // Accumulate send levels
-    const auto &sends = instrument->getSends();
-    avgReverb += sends.reverb * volume;
-    avgDelay += sends.delay * volume;
-    avgChorus += sends.chorus * volume;
-    activeCount++;
+  // Ducked: ramp from the block's start gain to its end gain. The key was
+  // rendered at an earlier level
+  float start, end;
+  effects_.sidechain.getGains(sends->sidechainDuck, start, end);
+  start *= gain;
+  const float step = (end * gain - start) / static_cast<float>(numSamples);
+  for (int i = 0; i < numSamples; ++i) {
+    const float rampGain = start + step * static_cast<float>(i);
+    outL[i] += inL[i] * rampGain;
+    outR[i] += inR[i] * rampGain;
   }
+}
 
-  // Process VA synth instruments via Track system (voice-per-track)
-  for (int trackIdx = 0; trackIdx < NUM_TRACKS; ++trackIdx) {
-    auto &track = tracks_[trackIdx];
+void AudioEngine::renderMaster(float *outL, float *outR, int numSamples) {
+  // Called from audio thread with mutex_ held, after every other node
+  const auto &graph = *graph_;
+  const auto &master = graph.getNode(graph.getMasterNode());
 
-    // Skip if track has no voice or is not a VASynth instrument
-    if (!track.voice || track.currentInstrumentIndex < 0)
-      continue;
+  // Apply master gain compensation for 16-track voice-per-track architecture
+  // With up to 16 tracks potentially active, we need headroom to prevent
+  // clipping 0.25 = 1/4 = good headroom for typical chord usage (3-4 voices)
+  // The limiter at the end will catch any peaks that still exceed.
+  // The returns had it applied to their sends
+  constexpr float trackHeadroomGain = 0.25f;
 
-    int instIdx = track.currentInstrumentIndex;
-    auto *vaSynth = getVASynthProcessor(instIdx);
-    if (!vaSynth)
-      continue;
+  // Effects return (wet only) for the disk recorder
+  int fxStream = capturing_ ? diskRecorder_->getFxStream() : -1;
+  float *fxCaptureL =
+      fxStream >= 0 ? diskCapture_.getWritePointer(fxStream * 2) : nullptr;
+  float *fxCaptureR =
+      fxStream >= 0 ? diskCapture_.getWritePointer(fxStream * 2 + 1) : nullptr;
 
-    // Get instrument model for mixer settings
-    model::Instrument *instrument =
-        project_ ? project_->getInstrument(instIdx) : nullptr;
-    if (!instrument || instrument->getType() != model::InstrumentType::VASynth)
+  for (int input : master.inputs) {
+    if (!graph.isActive(input))
       continue;
-
-    // Determine if this instrument should play
-    bool shouldPlay = true;
-    float volume = 1.0f;
-    float pan = 0.0f;
-
-    // Check mute/solo
-    if (anySoloed) {
-      shouldPlay = instrument->isSoloed();
+    if (graph.getNode(input).type == RoutingGraph::NodeType::Return) {
+      const float *inL = graph.getChannel(input, 0);
+      const float *inR = graph.getChannel(input, 1);
+      juce::FloatVectorOperations::add(outL, inL, numSamples);
+      juce::FloatVectorOperations::add(outR, inR, numSamples);
+      if (fxStream >= 0) {
+        juce::FloatVectorOperations::add(fxCaptureL, inL, numSamples);
+        juce::FloatVectorOperations::add(fxCaptureR, inR, numSamples);
+      }
     } else {
-      shouldPlay = !instrument->isMuted();
+      mixInput(input, outL, outR, trackHeadroomGain, numSamples);
     }
+  }
 
-    if (!shouldPlay) {
-      continue;
-    }
-
-    volume = instrument->getVolume();
-    pan = instrument->getPan();
-
-    // Clear temp buffers
-    std::fill(tempL.begin(), tempL.begin() + numSamples, 0.0f);
-    std::fill(tempR.begin(), tempR.begin() + numSamples, 0.0f);
+  // Preset audition clip - mixed dry, before master volume and the limiter
+  renderPreviewClip(outL, outR, numSamples);
 
-    // Render track (voice + tracker FX) to temp buffers
-    track.process(tempL.data(), tempR.data(), numSamples, vaSynth);
+  // Apply master volume and master bus effects (DJ filter + limiter)
+  float masterVol = project_->getMixer().masterVolume;
+  for (int i = 0; i < numSamples; ++i) {
+    // Apply master volume
+    outL[i] *= masterVol;
+    outR[i] *= masterVol;
 
-    // Apply channel strip processing
-    if (instrument && channelStrips_[instIdx]) {
-      channelStrips_[instIdx]->updateParams(instrument->getChannelStrip());
-      channelStrips_[instIdx]->process(tempL.data(), tempR.data(), numSamples);
-    }
+    // Apply master bus effects (DJ filter then limiter)
+    // Limiter replaces hard clipping for transparent peak control
+    effects_.processMaster(outL[i], outR[i]);
+  }
 
-    // Apply volume and pan, mix into output
-    float leftGain = volume * std::sqrt((1.0f - pan) / 2.0f);
-    float rightGain = volume * std::sqrt((1.0f + pan) / 2.0f);
+  if (analysisTap_ &&
+      analysisTap_->getPoint() == AnalysisTap::Point::Master)
+    analysisTap_->write(outL, outR, numSamples);
 
-    for (int i = 0; i < numSamples; ++i) {
-      float monoSample = (tempL[i] + tempR[i]) * 0.5f;
-      outL[i] += monoSample * leftGain * 2.0f;
-      outR[i] += monoSample * rightGain * 2.0f;
+  // Master is what was heard - stream 0
+  if (capturing_) {
+    diskCapture_.copyFrom(0, 0, outL, numSamples);
+    diskCapture_.copyFrom(1, 0, outR, numSamples);
+    diskRecorder_->push(diskCapture_.getArrayOfReadPointers(), numSamples);
+  }
+}
 
-      // Capture sidechain source audio
-      if (instIdx == sidechainSourceInst) {
-        sidechainSourceL[i] += monoSample * leftGain * 2.0f;
-        sidechainSourceR[i] += monoSample * rightGain * 2.0f;
-      }
-    }
+void AudioEngine::updateRouting() {
+  if (!project_ ||
+      (graph_ && graph_->getKey() == RoutingGraph::makeKey(*project_)))
+    return;
 
-    // Accumulate send levels (only count once per instrument, not per track)
-    const auto &sends = instrument->getSends();
-    avgReverb += sends.reverb * volume;
-    avgDelay += sends.delay * volume;
-    avgChorus += sends.chorus * volume;
-    activeCount++;
+  auto graph = RoutingGraph::compile(*project_);
+  {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    std::swap(graph_, graph);
   }
+  // The old graph is freed here, outside the lock
+}
 
-  // Process Plaits instruments via Track system (voice-per-track)
-  for (int trackIdx = 0; trackIdx < NUM_TRACKS; ++trackIdx) {
-    auto &track = tracks_[trackIdx];
+bool AudioEngine::setReverbImpulse(const juce::File &file, float maxSeconds) {
+  auto impulse = ConvolutionReverb::loadImpulse(file, sampleRate_, maxSeconds);
+  if (impulse.getNumSamples() == 0)
+    return false;
 
-    // Skip if track has no voice or is not a Plaits instrument
-    if (!track.voice || track.currentInstrumentIndex < 0)
-      continue;
+  reverbImpulseFile_ = file;
+  reverbMaxSeconds_ = maxSeconds;
+  installConvolutionReverb(
+      std::make_unique<ConvolutionReverb>(impulse, sampleRate_));
+  return true;
+}
 
-    int instIdx = track.currentInstrumentIndex;
-    auto *plaits = getPlaitsProcessor(instIdx);
-    if (!plaits)
-      continue;
+void AudioEngine::adoptReverbImpulse(std::unique_ptr<ConvolutionReverb> reverb,
+                                     const juce::File &file,
+                                     float maxSeconds) {
+  if (!reverb) {
+    clearReverbImpulse();
+    return;
+  }
+  reverbImpulseFile_ = file;
+  reverbMaxSeconds_ = maxSeconds;
+  installConvolutionReverb(std::move(reverb));
+}
 
-    // Get instrument model for mixer settings
-    model::Instrument *instrument =
-        project_ ? project_->getInstrument(instIdx) : nullptr;
-    if (!instrument || instrument->getType() != model::InstrumentType::Plaits)
-      continue;
+void AudioEngine::clearReverbImpulse() {
+  installConvolutionReverb(nullptr);
+  reverbImpulseFile_ = juce::File();
+}
 
-    // Determine if this instrument should play
-    bool shouldPlay = true;
-    float volume = 1.0f;
-    float pan = 0.0f;
+ConvolutionReverb::CostEstimate AudioEngine::getReverbCost() const {
+  return convolutionReverb_ ? convolutionReverb_->getCostEstimate()
+                            : ConvolutionReverb::CostEstimate{};
+}
 
-    // Check mute/solo
-    if (anySoloed) {
-      shouldPlay = instrument->isSoloed();
-    } else {
-      shouldPlay = !instrument->isMuted();
-    }
+void AudioEngine::reportMemoryUsage(model::MemoryReport &report) {
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
 
-    if (!shouldPlay) {
+  // The engine itself holds the track array, per-thread scratch buffers and
+  // the effects (their delay lines are reported under Effects). The tracks'
+  // voices are held inline and reported under Track voices
+  const size_t voiceSlotBytes = tracks_.size() * sizeof(TrackVoice);
+  report.add("Engine", sizeof(*this) - voiceSlotBytes +
+                           bufferBytes(diskCapture_) +
+                           bufferBytes(jackStemBuffer_));
+
+  // Every slot has a processor of each type, whatever its instrument is
+  for (const auto &plaits : instrumentProcessors_) {
+    if (plaits)
+      report.add("Plaits instruments",
+                 sizeof(PlaitsInstrument) + plaits->getAllocatedBytes());
+  }
+  for (const auto &sampler : samplerProcessors_) {
+    if (!sampler)
       continue;
-    }
+    report.add("Sampler instruments", sizeof(SamplerInstrument));
+    report.add("Samples", bufferBytes(sampler->getSampleBuffer()));
+  }
+  for (const auto &slicer : slicerProcessors_) {
+    if (!slicer)
+      continue;
+    report.add("Slicer instruments", sizeof(SlicerInstrument));
+    report.add("Samples", bufferBytes(slicer->getSampleBuffer()));
+    report.add("Slicer stretch cache",
+               bufferBytes(slicer->getStretchedBuffer()));
+  }
+  for (const auto &vaSynth : vaSynthProcessors_) {
+    if (vaSynth)
+      report.add("VA instruments", sizeof(VASynthInstrument));
+  }
+  for (const auto &dx7 : dx7Processors_) {
+    if (dx7)
+      report.add("DX7 instruments",
+                 sizeof(DX7Instrument) + dx7->getAllocatedBytes());
+  }
 
-    volume = instrument->getVolume();
-    pan = instrument->getPan();
+  size_t voiceBytes = voiceSlotBytes;
+  for (const auto &track : tracks_)
+    voiceBytes += track.getVoiceAllocatedBytes();
+  report.add("Track voices", voiceBytes);
 
-    // Clear temp buffers
-    std::fill(tempL.begin(), tempL.begin() + numSamples, 0.0f);
-    std::fill(tempR.begin(), tempR.begin() + numSamples, 0.0f);
+  size_t stripBytes = 0;
+  for (const auto &strip : channelStrips_) {
+    if (strip)
+      stripBytes += sizeof(ChannelStrip) + strip->getAllocatedBytes();
+  }
+  for (const auto &strip : busStrips_) {
+    if (strip)
+      stripBytes += sizeof(ChannelStrip) + strip->getAllocatedBytes();
+  }
+  report.add("Channel strips", stripBytes);
+
+  report.add("Effects", effects_.getAllocatedBytes());
+  report.add("Convolution reverb",
+             convolutionReverb_ ? sizeof(ConvolutionReverb) +
+                                      convolutionReverb_->getAllocatedBytes()
+                                : 0);
+  report.add("Mixer graph",
+             graph_ ? sizeof(RoutingGraph) + graph_->getAllocatedBytes() : 0);
+
+  size_t previewBytes = 0;
+  for (const auto *clip : {previewClip_.get(), previewFadeClip_.get()}) {
+    if (clip)
+      previewBytes += sizeof(PreviewClip) + model::bytesOf(clip->left) +
+                      model::bytesOf(clip->right);
+  }
+  report.add("Preview clips", previewBytes);
+}
 
-    // Render track (voice + tracker FX) to temp buffers
-    track.process(tempL.data(), tempR.data(), numSamples, plaits);
+void AudioEngine::installConvolutionReverb(
+    std::unique_ptr<ConvolutionReverb> reverb) {
+  std::unique_ptr<ConvolutionReverb> released;
+  {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    released = std::move(convolutionReverb_);
+    convolutionReverb_ = std::move(reverb);
+    effects_.convolution = convolutionReverb_.get();
+  }
+  // The old reverb (and its tail worker) is stopped here, outside the lock
+}
 
-    // Apply channel strip processing
-    if (instrument && channelStrips_[instIdx]) {
-      channelStrips_[instIdx]->updateParams(instrument->getChannelStrip());
-      channelStrips_[instIdx]->process(tempL.data(), tempR.data(), numSamples);
-    }
+void AudioEngine::setAnalysisTap(std::shared_ptr<AnalysisTap> tap) {
+  {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    std::swap(analysisTap_, tap);
+  }
+  // The old tap is freed here, outside the lock (unless its view still
+  // holds it)
+}
 
-    // Apply volume and pan, mix into output
-    float leftGain = volume * std::sqrt((1.0f - pan) / 2.0f);
-    float rightGain = volume * std::sqrt((1.0f + pan) / 2.0f);
+void AudioEngine::playPreviewClip(std::shared_ptr<const PreviewClip> clip) {
+  // Ignore clips rendered for a different device rate
+  if (clip && clip->sampleRate != sampleRate_)
+    return;
 
-    for (int i = 0; i < numSamples; ++i) {
-      float monoSample = (tempL[i] + tempR[i]) * 0.5f;
-      outL[i] += monoSample * leftGain * 2.0f;
-      outR[i] += monoSample * rightGain * 2.0f;
+  std::shared_ptr<const PreviewClip> released;
+  {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    released = std::move(previewFadeClip_);
+    previewFadeClip_ = std::move(previewClip_);
+    previewFadePos_ = previewPos_;
+    previewFadeRemaining_ = previewFadeClip_ ? PREVIEW_FADE_SAMPLES : 0;
+    previewClip_ = std::move(clip);
+    previewPos_ = 0;
+  }
+  // 'released' is destroyed here, outside the lock
+}
 
-      // Capture sidechain source audio
-      if (instIdx == sidechainSourceInst) {
-        sidechainSourceL[i] += monoSample * leftGain * 2.0f;
-        sidechainSourceR[i] += monoSample * rightGain * 2.0f;
-      }
+void AudioEngine::stopPreviewClip() { playPreviewClip(nullptr); }
+
+void AudioEngine::renderPreviewClip(float *outL, float *outR, int numSamples) {
+  // Called from audio thread with mutex_ held
+  if (previewClip_) {
+    const auto &clip = *previewClip_;
+    size_t n = std::min(static_cast<size_t>(numSamples),
+                        clip.left.size() - std::min(previewPos_, clip.left.size()));
+    for (size_t i = 0; i < n; ++i) {
+      outL[i] += clip.left[previewPos_ + i] * PREVIEW_GAIN;
+      outR[i] += clip.right[previewPos_ + i] * PREVIEW_GAIN;
     }
-
-    // Accumulate send levels (only count once per instrument, not per track)
-    const auto &sends = instrument->getSends();
-    avgReverb += sends.reverb * volume;
-    avgDelay += sends.delay * volume;
-    avgChorus += sends.chorus * volume;
-    activeCount++;
+    previewPos_ += n;
   }
 
-  // Process DX7 preset instruments via Track system (voice-per-track)
-  for (int trackIdx = 0; trackIdx < NUM_TRACKS; ++trackIdx) {
-    auto &track = tracks_[trackIdx];
-
-    // Skip if track has no voice or is not a DX7 instrument
-    if (!track.voice || track.currentInstrumentIndex < 0)
-      continue;
-
-    int instIdx = track.currentInstrumentIndex;
-    auto *dx7 = getDX7Processor(instIdx);
-    if (!dx7)
-      continue;
-
-    // Get instrument model for mixer settings
-    model::Instrument *instrument =
-        project_ ? project_->getInstrument(instIdx) : nullptr;
-    if (!instrument || instrument->getType() != model::InstrumentType::DXPreset)
-      continue;
-
-    // Determine if this instrument should play
-    bool shouldPlay = true;
-    float volume = 1.0f;
-    float pan = 0.0f;
-
-    // Check mute/solo
-    if (anySoloed) {
-      shouldPlay = instrument->isSoloed();
-    } else {
-      shouldPlay = !instrument->isMuted();
+  if (previewFadeClip_ && previewFadeRemaining_ > 0) {
+    const auto &clip = *previewFadeClip_;
+    for (int i = 0; i < numSamples && previewFadeRemaining_ > 0; ++i) {
+      if (previewFadePos_ >= clip.left.size()) {
+        previewFadeRemaining_ = 0;
+        break;
+      }
+      float gain = PREVIEW_GAIN * static_cast<float>(previewFadeRemaining_) /
+                   static_cast<float>(PREVIEW_FADE_SAMPLES);
+      outL[i] += clip.left[previewFadePos_] * gain;
+      outR[i] += clip.right[previewFadePos_] * gain;
+      ++previewFadePos_;
+      --previewFadeRemaining_;
     }
+  }
+}
 
-    if (!shouldPlay) {
-      continue;
+void AudioEngine::handleMidiEvent(const MidiInputHandler::Event &event) {
+  // Called from audio thread with mutex_ held
+  const int type = event.status & 0xF0;
+
+  if (type == 0x90 && event.data2 > 0) {
+    liveNoteOn(event.port, event.data1, event.data2 / 127.0f);
+    recordNote(event.port, event.data1, event.data2);
+  } else if (type == 0x80 || type == 0x90) {
+    liveNoteOff(event.port, event.data1);
+    recordNote(event.port, event.data1, 0);
+  } else if (type == 0xB0 && (event.data1 == 120 || event.data1 == 123)) {
+    // All Sound Off / All Notes Off
+    for (int i = 0; i < NUM_LIVE_TRACKS; ++i) {
+      if (livePorts_[i] == event.port)
+        releaseLiveTrack(i);
     }
+  } else if (event.status == 0xFA || event.status == 0xFB) {
+    play(); // Start / Continue from external gear
+  } else if (event.status == 0xFC) {
+    stop();
+  }
+}
 
-    volume = instrument->getVolume();
-    pan = instrument->getPan();
-
-    // Clear temp buffers
-    std::fill(tempL.begin(), tempL.begin() + numSamples, 0.0f);
-    std::fill(tempR.begin(), tempR.begin() + numSamples, 0.0f);
-
-    // Render track (voice + tracker FX) to temp buffers
-    track.process(tempL.data(), tempR.data(), numSamples, dx7);
+void AudioEngine::liveNoteOn(int port, int note, float velocity) {
+  int instrumentIndex = midiInput_ ? midiInput_->resolveInstrument(port) : -1;
+  if (instrumentIndex < 0 || instrumentIndex >= NUM_INSTRUMENTS)
+    return;
 
-    // Apply channel strip processing
-    if (instrument && channelStrips_[instIdx]) {
-      channelStrips_[instIdx]->updateParams(instrument->getChannelStrip());
-      channelStrips_[instIdx]->process(tempL.data(), tempR.data(), numSamples);
+  // Reuse the track already holding this key, else a free one, else steal the
+  // oldest
+  int slot = -1;
+  for (int i = 0; i < NUM_LIVE_TRACKS && slot < 0; ++i) {
+    if (liveNotes_[i] == note && livePorts_[i] == port)
+      slot = i;
+  }
+  for (int i = 0; i < NUM_LIVE_TRACKS && slot < 0; ++i) {
+    if (liveNotes_[i] < 0)
+      slot = i;
+  }
+  if (slot < 0) {
+    slot = 0;
+    for (int i = 1; i < NUM_LIVE_TRACKS; ++i) {
+      if (liveAges_[i] < liveAges_[slot])
+        slot = i;
     }
+    releaseLiveTrack(slot);
+  }
 
-    // Apply volume and pan, mix into output
-    float leftGain = volume * std::sqrt((1.0f - pan) / 2.0f);
-    float rightGain = volume * std::sqrt((1.0f + pan) / 2.0f);
+  liveNotes_[slot] = note;
+  livePorts_[slot] = port;
+  liveAges_[slot] = ++liveNoteCounter_;
+  triggerNote(NUM_TRACKS + slot, note, instrumentIndex, velocity);
+}
 
-    for (int i = 0; i < numSamples; ++i) {
-      float monoSample = (tempL[i] + tempR[i]) * 0.5f;
-      outL[i] += monoSample * leftGain * 2.0f;
-      outR[i] += monoSample * rightGain * 2.0f;
+void AudioEngine::liveNoteOff(int port, int note) {
+  for (int i = 0; i < NUM_LIVE_TRACKS; ++i) {
+    if (liveNotes_[i] == note && livePorts_[i] == port)
+      releaseLiveTrack(i);
+  }
+}
 
-      // Capture sidechain source audio
-      if (instIdx == sidechainSourceInst) {
-        sidechainSourceL[i] += monoSample * leftGain * 2.0f;
-        sidechainSourceR[i] += monoSample * rightGain * 2.0f;
-      }
-    }
+void AudioEngine::releaseLiveTrack(int liveIndex) {
+  int note = liveNotes_[liveIndex];
+  liveNotes_[liveIndex] = -1;
+  if (note < 0)
+    return;
 
-    // Accumulate send levels (only count once per instrument, not per track)
-    const auto &sends = instrument->getSends();
-    avgReverb += sends.reverb * volume;
-    avgDelay += sends.delay * volume;
-    avgChorus += sends.chorus * volume;
-    activeCount++;
+  int track = NUM_TRACKS + liveIndex;
+  int instrumentIndex = trackInstruments_[track];
+  auto *instrument = project_ && instrumentIndex >= 0
+                         ? project_->getInstrument(instrumentIndex)
+                         : nullptr;
+
+  // Sampler/Slicer voices live in the processor, and releaseNote() would cut
+  // every key held on it - release just this one
+  if (instrument && instrument->getType() == model::InstrumentType::Sampler) {
+    if (auto *sampler = getSamplerProcessor(instrumentIndex))
+      sampler->noteOff(note);
+    trackInstruments_[track] = -1;
+    return;
   }
-
-  if (activeCount > 0) {
-    avgReverb /= static_cast<float>(activeCount);
-    avgDelay /= static_cast<float>(activeCount);
-    avgChorus /= static_cast<float>(activeCount);
+  if (instrument && instrument->getType() == model::InstrumentType::Slicer) {
+    if (auto *slicer = getSlicerProcessor(instrumentIndex))
+      slicer->noteOff(note);
+    trackInstruments_[track] = -1;
+    return;
   }
 
-  // Apply master gain compensation for 16-track voice-per-track architecture
-  // With up to 16 tracks potentially active, we need headroom to prevent
-  // clipping 0.25 = 1/4 = good headroom for typical chord usage (3-4 voices)
-  // The limiter at the end will catch any peaks that still exceed
+  releaseNote(track);
+}
+
+void AudioEngine::addToStem(int instIdx, const float *left,
+                            const float *right, int numSamples) {
+  // An instrument's channel with the main mix's headroom, before the master
+  // effects. Feeds the stem outputs and/or the disk recorder's stem streams.
   constexpr float trackHeadroomGain = 0.25f;
-  for (int i = 0; i < numSamples; ++i) {
-    outL[i] *= trackHeadroomGain;
-    outR[i] *= trackHeadroomGain;
-  }
+  auto mixInto = [&](float *stemL, float *stemR) {
+    juce::FloatVectorOperations::addWithMultiply(stemL, left, trackHeadroomGain,
+                                                 numSamples);
+    juce::FloatVectorOperations::addWithMultiply(stemR, right,
+                                                 trackHeadroomGain, numSamples);
+  };
 
-  // Update effect parameters from project settings
-  if (project_) {
-    const auto &mixer = project_->getMixer();
-    effects_.reverb.setParams(mixer.reverbSize, mixer.reverbDamping, 1.0f);
-    effects_.delay.setParams(mixer.delayTime, mixer.delayFeedback, 1.0f);
-    effects_.chorus.setParams(mixer.chorusRate, mixer.chorusDepth, 1.0f);
-    effects_.sidechain.setParams(mixer.sidechainAttack, mixer.sidechainRelease,
-                                 mixer.sidechainRatio);
-    effects_.djFilter.setPosition(mixer.djFilterPosition);
-    effects_.limiter.setParams(mixer.limiterThreshold, mixer.limiterRelease);
+  if (instIdx < numStems_ && stemBuffer_) {
+    const int channel = stemFirstChannel_ + instIdx * 2;
+    mixInto(stemBuffer_->getWritePointer(channel, stemStartSample_),
+            stemBuffer_->getWritePointer(channel + 1, stemStartSample_));
   }
 
-  // Apply effects per sample
-  for (int i = 0; i < numSamples; ++i) {
-    // Feed sidechain envelope follower with source audio level
-    if (sidechainSourceInst >= 0) {
-      float sourceLevel = (sidechainSourceL[i] + sidechainSourceR[i]) * 0.5f;
-      effects_.sidechain.feedSource(sourceLevel);
-    }
+  if (capturing_) {
+    int stream = diskRecorder_->getInstrumentStream(instIdx);
+    if (stream >= 0)
+      mixInto(diskCapture_.getWritePointer(stream * 2),
+              diskCapture_.getWritePointer(stream * 2 + 1));
+  }
+}
 
-    // Apply reverb, delay, chorus
-    effects_.process(outL[i], outR[i], avgReverb, avgDelay, avgChorus);
+void AudioEngine::recordNote(int port, int note, int velocity) {
+  // Called from audio thread at the event's sample, before that sub-block
+  // renders - so the row position here is exactly where the note sounded
+  if (!recording_.load(std::memory_order_relaxed) ||
+      !playing_.load(std::memory_order_relaxed) ||
+      playMode_ != PlayMode::Pattern)
+    return;
 
-    // Apply sidechain ducking to entire output (all instruments except source
-    // are ducked) The source instrument is NOT ducked - it triggers the ducking
-    if (sidechainSourceInst >= 0) {
-      effects_.sidechain.process(outL[i], outR[i]);
-    }
-  }
+  // currentRow_ is the next row to trigger; samplesUntilNextRow_ counts down
+  // to it. Before the first row has played the position is simply row 0.
+  double row = static_cast<double>(currentRow_.load(std::memory_order_relaxed));
+  if (samplesUntilNextRow_ > 0.0 && currentRowLength_ > 0.0)
+    row -= std::min(1.0, samplesUntilNextRow_ / currentRowLength_);
+
+  int start1, size1, start2, size2;
+  recordFifo_.prepareToWrite(1, start1, size1, start2, size2);
+  if (size1 + size2 == 0)
+    return; // UI hasn't drained for a while - drop rather than block
+
+  auto &recorded = recordBuffer_[size1 > 0 ? start1 : start2];
+  recorded.row = row;
+  recorded.note = note;
+  recorded.velocity = velocity;
+  recorded.instrument = midiInput_ ? midiInput_->resolveInstrument(port) : -1;
+  recorded.port = port;
+  recordFifo_.finishedWrite(1);
+}
 
-  // Apply master volume and master bus effects (DJ filter + limiter)
-  if (project_) {
-    float masterVol = project_->getMixer().masterVolume;
-    for (int i = 0; i < numSamples; ++i) {
-      // Apply master volume
-      outL[i] *= masterVol;
-      outR[i] *= masterVol;
-
-      // Apply master bus effects (DJ filter then limiter)
-      // Limiter replaces hard clipping for transparent peak control
-      effects_.processMaster(outL[i], outR[i]);
-    }
-  }
+int AudioEngine::popRecordedNotes(RecordedNote *out, int maxNotes) {
+  int start1, size1, start2, size2;
+  recordFifo_.prepareToRead(std::min(maxNotes, recordFifo_.getNumReady()),
+                            start1, size1, start2, size2);
+  std::copy_n(recordBuffer_.begin() + start1, size1, out);
+  std::copy_n(recordBuffer_.begin() + start2, size2, out + size1);
+  recordFifo_.finishedRead(size1 + size2);
+  return size1 + size2;
 }
 
 void AudioEngine::advancePlayhead() {
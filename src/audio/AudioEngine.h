@@ -1,6 +1,6 @@
 #pragma once
 
-#include "Voice.h"
+#include "TrackVoice.h"
 #include "UniversalTrackerFX.h"
 #include "Effects.h"
 #include "InstrumentProcessor.h"
@@ -10,8 +10,18 @@
 #include "VASynthInstrument.h"
 #include "DX7Instrument.h"
 #include "ChannelStrip.h"
+#include "PresetPreviewRenderer.h"
+#include "MidiInputHandler.h"
+#include "JackTransport.h"
+#include "JackStemPorts.h"
+#include "DiskRecorder.h"
+#include "ConvolutionReverb.h"
+#include "RoutingGraph.h"
+#include "RenderWorkers.h"
+#include "AnalysisTap.h"
 #include "../model/Project.h"
 #include "../model/Groove.h"
+#include "../model/MemoryUsage.h"
 #include <JuceHeader.h>
 #include <array>
 #include <mutex>
@@ -22,16 +32,23 @@ namespace audio {
 
 // Track structure - owns voice and tracker FX
 struct Track {
-    std::unique_ptr<Voice> voice;          // Owned voice instance
+    TrackVoice voice;                      // Voice of the current instrument's type
     UniversalTrackerFX trackerFX;          // FX processor
     int currentInstrumentIndex = -1;       // Which instrument params to use
-    model::InstrumentType currentInstrumentType = model::InstrumentType::Plaits;  // Which type of voice
     bool hasPendingFX = false;             // Whether FX is active
 
+    bool hasVoice() const { return !std::holds_alternative<std::monostate>(voice); }
+    void releaseVoice();                   // Note off, if the voice is sounding
+    size_t getVoiceAllocatedBytes() const;
+
+    // Processor is the concrete instrument type, whose VoiceType this
+    // track's voice must hold
+    template <typename Processor>
     void triggerNote(int note, float velocity, const model::Step& step,
-                    InstrumentProcessor* instrument);
+                    Processor& instrument);
+    template <typename Processor>
     void process(float* outL, float* outR, int numSamples,
-                InstrumentProcessor* instrument);
+                Processor& instrument);
 };
 
 class AudioEngine : public juce::AudioSource
@@ -40,13 +57,62 @@ public:
     static constexpr int NUM_VOICES = 64;
     static constexpr int NUM_TRACKS = 16;
     static constexpr int NUM_INSTRUMENTS = 128;
+    static constexpr int NUM_LIVE_TRACKS = 8;  // Extra tracks for MIDI input, after the sequencer's
 
     enum class PlayMode { Pattern, Song };
 
     AudioEngine();
     ~AudioEngine() override;
 
-    void setProject(model::Project* project) { project_ = project; }
+    void setProject(model::Project* project) { project_ = project; updateRouting(); }
+
+    // Message thread. Rebuilds the mixer's routing graph if the project's
+    // routing (instrument and bus outputs, buses, which sends - sidechain
+    // key and duck included - are on) has changed since the last call;
+    // otherwise cheap.
+    // Fader, pan and send levels are read live and don't need this
+    void updateRouting();
+
+    // Message thread. Switches to a fully built project (see ProjectLoader):
+    // the output fades out, playback stops, the project is moved into the one
+    // set with setProject() under the render lock, and the output fades back
+    // in. The audio thread sees the old project or the new one, never a
+    // half-loaded one. The old project is freed on a background thread.
+    // Blocks for the fade (a few ms) while the device is running.
+    void replaceProject(model::Project&& project);
+
+    // MIDI input - events are played at their sample offsets within each block
+    void setMidiInput(MidiInputHandler* midiInput) { midiInput_ = midiInput; }
+
+    // Start/stop with the JACK transport (checked once per audio block)
+    void setJackTransport(const JackTransport* transport) { jackTransport_ = transport; }
+
+    // Outputs beyond the first stereo pair carry per-instrument stems (each
+    // instrument's channel, wherever it is routed):
+    // channels 3/4 = instrument 00, 5/6 = instrument 01, ...
+    static int getStemChannelCount(int numStems) { return 2 + numStems * 2; }
+
+    // On JACK, stems go to their own ports instead of device channels. Set
+    // before the device starts (the stem buffer is sized in prepareToPlay)
+    void setJackStems(JackStemPorts* stems) { jackStems_ = stems; }
+
+    // Record to disk - each rendered block (master, FX return, instrument
+    // stems) is also handed to the recorder while it is recording
+    void setDiskRecorder(DiskRecorder* recorder) { diskRecorder_ = recorder; }
+
+    // Live recording. While enabled and playing a pattern, every MIDI (and
+    // injected keyboard) note is also queued with its pattern position,
+    // measured at the sample it was played on.
+    struct RecordedNote {
+        double row = 0.0;  // Fractional row within the playing pattern
+        int note = 0;
+        int velocity = 0;  // 0 = note off
+        int instrument = -1;
+        int port = 0;
+    };
+    void setRecording(bool recording) { recording_.store(recording, std::memory_order_relaxed); }
+    bool isRecording() const { return recording_.load(std::memory_order_relaxed); }
+    int popRecordedNotes(RecordedNote* out, int maxNotes);  // Message thread
 
     // Transport (lock-free for UI thread safety)
     void play();
@@ -68,9 +134,44 @@ public:
     void triggerNote(int track, int note, int instrumentIndex, float velocity, const model::Step& step);
     void releaseNote(int track);
 
+    // Message thread. Instruments the song and the pattern being played can
+    // reach (from the project's UsageIndex). The per-slot sampler, slicer and
+    // legacy Plaits processors are only rendered for these, or while they
+    // still have a voice sounding (previews, live input). Instruments that
+    // become reachable get their parameters synced now rather than on their
+    // first note. Until this is first called every instrument is rendered.
+    void setReachableInstruments(const model::UsageIndex::InstrumentSet& instruments);
+
     // Preview a chord (multiple notes at once)
     void previewChord(const std::vector<int>& notes, int instrumentIndex);
 
+    // Preset audition clips (rendered off-thread by PresetPreviewRenderer).
+    // A new clip crossfades over the previous one.
+    void playPreviewClip(std::shared_ptr<const PreviewClip> clip);
+    void stopPreviewClip();
+    double getSampleRate() const { return sampleRate_; }
+
+    // Convolution reverb. While an impulse response is loaded the reverb send
+    // convolves with it instead of running the algorithmic reverb. The IR is
+    // read, resampled and partitioned on the calling (message) thread.
+    bool setReverbImpulse(const juce::File& file, float maxSeconds);
+    void clearReverbImpulse();
+    // Message thread. Same, with a reverb already built from 'file' off-thread
+    void adoptReverbImpulse(std::unique_ptr<ConvolutionReverb> reverb,
+                            const juce::File& file, float maxSeconds);
+    bool hasReverbImpulse() const { return convolutionReverb_ != nullptr; }
+    ConvolutionReverb::CostEstimate getReverbCost() const;
+
+    // Message thread. While a tap is set, each block of its channel is
+    // copied into it for the analysis views; nullptr removes it
+    void setAnalysisTap(std::shared_ptr<AnalysisTap> tap);
+
+    // Message thread. Adds the engine's memory to a report, by subsystem:
+    // instrument processors (every slot has one of each type), track voices,
+    // samples, the slicers' stretch cache, channel strips, effects and the
+    // mixer graph. Briefly holds the render lock
+    void reportMemoryUsage(model::MemoryReport& report);
+
     // AudioSource interface
     void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override;
     void releaseResources() override;
@@ -86,7 +187,12 @@ public:
     DX7Instrument* getDX7Processor(int index);
 
 private:
-    // Voice* allocateVoice(int note);  // Disabled - Voice is now abstract
+    // Voice* allocateVoice(int note);  // Disabled - voices are owned by Track
+    // Track-system note on: (re)creates the track's voice if it was playing
+    // another instrument, then triggers it
+    template <typename Processor>
+    void triggerTrackNote(int track, int note, int instrumentIndex, float velocity,
+                          const model::Step& step, Processor& processor);
     void advancePlayhead();
     void advanceChain();
     void advanceAllChains();  // Advance all song columns
@@ -96,16 +202,55 @@ private:
     int getChainTransposeForColumn(int songColumn) const;  // Get transpose for specific song column
     int transposeNoteByScaleDegrees(int note, int degrees, const std::string& scaleLock) const;
     void syncInstrumentParams(int instrumentIndex);
+    bool isReachable(int instrumentIndex) const;
+    void renderPreviewClip(float* outL, float* outR, int numSamples);
+    void haltPlayback();
+    void applySwitchFade(juce::AudioBuffer<float>& buffer, int startSample, int numSamples,
+                         juce::AudioBuffer<float>* stems);
+    void renderBlock(float* outL, float* outR, int numSamples);
+    void handleMidiEvent(const MidiInputHandler::Event& event);
+    void liveNoteOn(int port, int note, float velocity);
+    void liveNoteOff(int port, int note);
+    void releaseLiveTrack(int liveIndex);
+    void recordNote(int port, int note, int velocity);
+    void addToStem(int instIdx, const float* left, const float* right, int numSamples);
+
+    // Mixer graph nodes, each writing its own buffer in graph_. All but the
+    // master may run on a render worker (thread = RenderWorkers thread index)
+    void renderNode(int node, int thread, int numSamples, bool anySoloed);
+    void renderInstrumentNode(int node, int thread, int numSamples, bool anySoloed);
+    void renderBusNode(int node, int numSamples);
+    void renderReturnNode(int node, int numSamples);
+    void renderKeyNode(int node, int numSamples);
+    void renderMaster(float* outL, float* outR, int numSamples);
+    void tapNode(int node, int numSamples);
+
+    // An instrument or bus node's sends, or nullptr if it has gone
+    const model::SendLevels* getNodeSends(const RoutingGraph::Node& node) const;
+    // Adds an input node into a mix at gain, through the sidechain if it is
+    // ducked
+    void mixInput(int input, float* outL, float* outR, float gain, int numSamples) const;
+
+    struct LevelTask : RenderWorkers::Task {
+        AudioEngine* engine = nullptr;
+        int numSamples = 0;
+        bool anySoloed = false;
+        void run(int node, int thread) override { engine->renderNode(node, thread, numSamples, anySoloed); }
+    };
+    void installConvolutionReverb(std::unique_ptr<ConvolutionReverb> reverb);
 
     model::Project* project_ = nullptr;
 
+    // Sequencer tracks followed by the MIDI input's live tracks
+    static constexpr int NUM_ENGINE_TRACKS = NUM_TRACKS + NUM_LIVE_TRACKS;
+
     // Track array (voice-per-track architecture)
-    std::array<Track, NUM_TRACKS> tracks_;
+    std::array<Track, NUM_ENGINE_TRACKS> tracks_;
 
     // Legacy tracking (kept temporarily for old trigger methods)
     // Will be removed after full migration to Track system
-    std::array<int, NUM_TRACKS> trackInstruments_; // Current instrument per track
-    std::array<int, NUM_TRACKS> trackNotes_;       // Last note triggered per track (-1 = none)
+    std::array<int, NUM_ENGINE_TRACKS> trackInstruments_; // Current instrument per track
+    std::array<int, NUM_ENGINE_TRACKS> trackNotes_;       // Last note triggered per track (-1 = none)
 
     // New instrument processors (one per instrument slot)
     std::array<std::unique_ptr<PlaitsInstrument>, NUM_INSTRUMENTS> instrumentProcessors_;
@@ -116,6 +261,24 @@ private:
 
     // Per-instrument channel strip processing
     std::array<std::unique_ptr<ChannelStrip>, NUM_INSTRUMENTS> channelStrips_;
+    std::array<std::unique_ptr<ChannelStrip>, model::Project::MAX_BUSES> busStrips_;
+
+    // Mixer routing - replaced by the message thread under mutex_, rendered
+    // a level at a time with each level's nodes spread over workers_
+    std::unique_ptr<RoutingGraph> graph_;
+    RenderWorkers workers_;
+    LevelTask levelTask_;
+
+    // Analysis view tap, replaced by the message thread under mutex_. Its
+    // node in graph_ (-1 for the master or none) is found once per block
+    std::shared_ptr<AnalysisTap> analysisTap_;
+    int analysisNode_ = -1;
+
+    // Reachable instruments, one bit each - written by the message thread,
+    // read per block by the audio thread
+    static constexpr int REACHABLE_WORDS = NUM_INSTRUMENTS / 64;
+    std::array<std::atomic<uint64_t>, REACHABLE_WORDS> reachable_;
+    model::UsageIndex::InstrumentSet prewarmed_;  // Message thread only
 
     double sampleRate_ = 48000.0;
     int samplesPerBlock_ = 512;
@@ -126,6 +289,7 @@ private:
     std::atomic<int> currentRow_{0};         // Atomic for lock-free UI reads
     std::atomic<int> currentPattern_{0};     // Atomic for lock-free UI reads
     double samplesUntilNextRow_ = 0.0;
+    double currentRowLength_ = 0.0;          // Length of the row now playing (groove applied)
 
     // Song playback state
     PlayMode playMode_ = PlayMode::Pattern;
@@ -135,7 +299,81 @@ private:
 
     std::recursive_mutex mutex_;
 
+    // Preview voice - guarded by mutex_. Only the message thread replaces these,
+    // and it drops the old references after unlocking, so clips are never
+    // freed on the audio thread.
+    std::shared_ptr<const PreviewClip> previewClip_;
+    std::shared_ptr<const PreviewClip> previewFadeClip_;  // Previous clip, fading out
+    size_t previewPos_ = 0;
+    size_t previewFadePos_ = 0;
+    int previewFadeRemaining_ = 0;
+    static constexpr int PREVIEW_FADE_SAMPLES = 256;
+    static constexpr float PREVIEW_GAIN = 0.25f;  // Same headroom as the track mix
+
+    // Project switch (see replaceProject). The audio thread fades the whole
+    // output down, halts playback and holds silence until the message thread
+    // has swapped the project and asked for the fade back in
+    enum class SwitchState { None, FadingOut, Silent, FadingIn };
+    std::atomic<SwitchState> switchState_{SwitchState::None};
+    std::atomic<bool> deviceRunning_{false};  // Between prepareToPlay and releaseResources
+    static constexpr int SWITCH_FADE_SAMPLES = 512;
+    static constexpr int SWITCH_TIMEOUT_MS = 250;  // Give up waiting for a stalled device
+    int switchFadePos_ = SWITCH_FADE_SAMPLES;      // Audio thread: current gain in samples
+
+    // Blocks are rendered in sub-blocks split at MIDI event offsets, never
+    // longer than the per-instrument scratch buffers
+    static constexpr int MAX_RENDER_BLOCK = RoutingGraph::kMaxBlockSize;
+    static constexpr int MAX_MIDI_EVENTS_PER_BLOCK = 256;
+
+    // Tracks sounding each instrument this block, as lists: firstTrack_ per
+    // instrument, then nextTrack_ per track (-1 ends). Audio thread only
+    std::array<int, NUM_INSTRUMENTS> firstTrack_;
+    std::array<int, NUM_ENGINE_TRACKS> nextTrack_;
+
+    // One instrument source at a time, per render thread
+    struct Scratch {
+        std::array<float, MAX_RENDER_BLOCK> left{};
+        std::array<float, MAX_RENDER_BLOCK> right{};
+    };
+    std::array<Scratch, RenderWorkers::kMaxThreads> scratch_;
+
+    MidiInputHandler* midiInput_ = nullptr;
+    const JackTransport* jackTransport_ = nullptr;
+    bool jackWasRolling_ = false;  // Audio thread only
+
+    // Stem outputs for the block being rendered (audio thread only): device
+    // channels after the main pair, or jackStemBuffer_ for the JACK ports
+    juce::AudioBuffer<float>* stemBuffer_ = nullptr;
+    int stemFirstChannel_ = 0;
+    int stemStartSample_ = 0;
+    int numStems_ = 0;
+    JackStemPorts* jackStems_ = nullptr;
+    juce::AudioBuffer<float> jackStemBuffer_;
+
+    // Disk recorder capture for the sub-block being rendered (audio thread only)
+    DiskRecorder* diskRecorder_ = nullptr;
+    bool capturing_ = false;
+    juce::AudioBuffer<float> diskCapture_{DiskRecorder::kMaxStreams * 2, MAX_RENDER_BLOCK};
+    std::array<MidiInputHandler::Event, MAX_MIDI_EVENTS_PER_BLOCK> midiEvents_;
+
+    // Live (MIDI) voices - audio thread only
+    std::array<int, NUM_LIVE_TRACKS> liveNotes_;     // -1 = free
+    std::array<int, NUM_LIVE_TRACKS> livePorts_;
+    std::array<uint32_t, NUM_LIVE_TRACKS> liveAges_; // For stealing the oldest
+    uint32_t liveNoteCounter_ = 0;
+
+    // Recorded notes, audio thread -> message thread (single producer/consumer)
+    static constexpr int RECORD_FIFO_SIZE = 512;
+    std::atomic<bool> recording_{false};
+    juce::AbstractFifo recordFifo_{RECORD_FIFO_SIZE};
+    std::array<RecordedNote, RECORD_FIFO_SIZE> recordBuffer_;
+
     EffectsProcessor effects_;
+
+    // Message thread only; effects_.convolution points at it under mutex_
+    std::unique_ptr<ConvolutionReverb> convolutionReverb_;
+    juce::File reverbImpulseFile_;
+    float reverbMaxSeconds_ = 0.0f;
     model::GrooveManager grooveManager_;
 };
 
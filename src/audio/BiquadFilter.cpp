@@ -1,4 +1,5 @@
 #include "BiquadFilter.h"
+#include <algorithm>
 #include <cmath>
 
 namespace audio {
@@ -38,6 +39,37 @@ float BiquadFilter::process(float input) {
     return output;
 }
 
+void BiquadFilter::processCascade(BiquadFilter* const* filters, int numFilters,
+                                  float* samples, int numSamples) {
+    numFilters = std::min(numFilters, kMaxCascade);
+    if (numFilters <= 0) return;
+
+    // Coefficients and state in locals for the length of the block
+    Coefficients c[kMaxCascade];
+    float z1[kMaxCascade], z2[kMaxCascade];
+    for (int s = 0; s < numFilters; ++s) {
+        c[s] = filters[s]->getCoefficients();
+        z1[s] = filters[s]->z1_;
+        z2[s] = filters[s]->z2_;
+    }
+
+    for (int i = 0; i < numSamples; ++i) {
+        float x = samples[i];
+        for (int s = 0; s < numFilters; ++s) {
+            const float y = c[s].b0 * x + z1[s];
+            z1[s] = c[s].b1 * x - c[s].a1 * y + z2[s];
+            z2[s] = c[s].b2 * x - c[s].a2 * y;
+            x = y;
+        }
+        samples[i] = x;
+    }
+
+    for (int s = 0; s < numFilters; ++s) {
+        filters[s]->z1_ = z1[s];
+        filters[s]->z2_ = z2[s];
+    }
+}
+
 void BiquadFilter::calculateCoefficients(Type type, float freq, float gainDb, float q) {
     const float w0 = 2.0f * static_cast<float>(M_PI) * freq / static_cast<float>(sampleRate_);
     const float cosW0 = std::cos(w0);
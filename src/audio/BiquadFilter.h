@@ -27,6 +27,16 @@ public:
     // Process single sample (call for each channel)
     float process(float input);
 
+    // Run a chain of filters over a block in place (one channel). Stages are
+    // stepped together per sample so their recurrences overlap in the pipeline
+    static constexpr int kMaxCascade = 8;
+    static void processCascade(BiquadFilter* const* filters, int numFilters,
+                               float* samples, int numSamples);
+
+    // Normalised coefficients, for code that runs several biquads side by side
+    struct Coefficients { float b0, b1, b2, a1, a2; };
+    Coefficients getCoefficients() const { return {b0_, b1_, b2_, a1_, a2_}; }
+
 private:
     void calculateCoefficients(Type type, float freq, float gainDb, float q);
 
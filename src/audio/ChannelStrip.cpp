@@ -10,6 +10,10 @@ ChannelStrip::ChannelStrip() {
 
 ChannelStrip::~ChannelStrip() = default;
 
+size_t ChannelStrip::getAllocatedBytes() const {
+    return drive_ ? sizeof(Drive) : 0;
+}
+
 void ChannelStrip::prepare(double sampleRate, int samplesPerBlock) {
     sampleRate_ = sampleRate;
 
@@ -57,6 +61,7 @@ void ChannelStrip::updateParams(const model::ChannelStripParams& params) {
     drive_->setParams(params_.driveAmount, params_.driveTone);
     punch_.setAmount(params_.punchAmount);
     ott_.setParams(params_.ottLowDepth, params_.ottMidDepth, params_.ottHighDepth, params_.ottMix);
+    ott_.setLinked(params_.ottLink);
 }
 
 void ChannelStrip::updateHPF() {
@@ -79,42 +84,40 @@ void ChannelStrip::updateEQ() {
 }
 
 void ChannelStrip::process(float* left, float* right, int numSamples) {
-    for (int i = 0; i < numSamples; ++i) {
-        float l = left[i];
-        float r = right[i];
-
-        // HPF (if enabled)
-        if (params_.hpfSlope >= 1) {
-            l = hpfL_[0].process(l);
-            r = hpfR_[0].process(r);
-        }
-        if (params_.hpfSlope >= 2) {
-            l = hpfL_[1].process(l);
-            r = hpfR_[1].process(r);
-        }
-
-        // EQ (always active, but gain=0 means no change)
-        l = lowShelfL_.process(l);
-        r = lowShelfR_.process(r);
-        l = midPeakL_.process(l);
-        r = midPeakR_.process(r);
-        l = highShelfL_.process(l);
-        r = highShelfR_.process(r);
-
-        // Drive
-        if (params_.driveAmount > 0.001f) {
-            drive_->process(l, r);
-        }
-
-        // Punch (transient shaper)
-        punch_.process(l, r);
+    // Each stage runs over the whole buffer before the next
+
+    // HPF (if enabled) and EQ (always active, but gain=0 means no change),
+    // as one cascade per channel
+    BiquadFilter* filtersL[5];
+    BiquadFilter* filtersR[5];
+    int numFilters = 0;
+    if (params_.hpfSlope >= 1) {
+        filtersL[numFilters] = &hpfL_[0];
+        filtersR[numFilters++] = &hpfR_[0];
+    }
+    if (params_.hpfSlope >= 2) {
+        filtersL[numFilters] = &hpfL_[1];
+        filtersR[numFilters++] = &hpfR_[1];
+    }
+    filtersL[numFilters] = &lowShelfL_;
+    filtersR[numFilters++] = &lowShelfR_;
+    filtersL[numFilters] = &midPeakL_;
+    filtersR[numFilters++] = &midPeakR_;
+    filtersL[numFilters] = &highShelfL_;
+    filtersR[numFilters++] = &highShelfR_;
+    BiquadFilter::processCascade(filtersL, numFilters, left, numSamples);
+    BiquadFilter::processCascade(filtersR, numFilters, right, numSamples);
+
+    // Drive
+    if (params_.driveAmount > 0.001f) {
+        drive_->process(left, right, numSamples);
+    }
 
-        // OTT (multiband dynamics)
-        ott_.process(l, r);
+    // Punch (transient shaper)
+    punch_.process(left, right, numSamples);
 
-        left[i] = l;
-        right[i] = r;
-    }
+    // OTT (multiband dynamics)
+    ott_.process(left, right, numSamples);
 }
 
 } // namespace audio
@@ -23,6 +23,8 @@ public:
     void updateParams(const model::ChannelStripParams& params);
     void reset();
 
+    size_t getAllocatedBytes() const;  // See model/MemoryUsage.h
+
 private:
     void updateHPF();
     void updateEQ();
@@ -0,0 +1,361 @@
+#include "ConvolutionReverb.h"
+#include "../model/MemoryUsage.h"
+#include <algorithm>
+#include <cmath>
+
+namespace audio {
+
+namespace {
+
+constexpr int kWorkerPollMs = 5;
+constexpr double kLoadSmoothing = 0.02;
+constexpr float kFadeSeconds = 0.01f;  // Fade applied where the tail limit cuts the IR
+
+void storeLoad(std::atomic<double>& load, double seconds, double blockSeconds)
+{
+    double previous = load.load(std::memory_order_relaxed);
+    load.store(previous + (seconds / blockSeconds - previous) * kLoadSmoothing, std::memory_order_relaxed);
+}
+
+} // anonymous namespace
+
+juce::AudioBuffer<float> ConvolutionReverb::loadImpulse(const juce::File& file, double sampleRate, float maxSeconds)
+{
+    juce::AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+
+    std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(file));
+    if (!reader || reader->lengthInSamples <= 0)
+    {
+        DBG("Failed to read impulse response: " << file.getFullPathName());
+        return {};
+    }
+
+    // Stereo IRs keep their width; anything wider uses the first two channels
+    const int numChannels = std::min(2, static_cast<int>(reader->numChannels));
+    const double ratio = reader->sampleRate / sampleRate;
+    const int maxLength = std::max(1, static_cast<int>(maxSeconds * sampleRate));
+    const int sourceLength = static_cast<int>(std::min<juce::int64>(
+        reader->lengthInSamples, static_cast<juce::int64>(std::ceil(maxLength * ratio)) + 1));
+
+    // Zero padding lets the interpolator run past the last sample
+    constexpr int padding = 64;
+    juce::AudioBuffer<float> source(numChannels, sourceLength + padding);
+    source.clear();
+    reader->read(&source, 0, sourceLength, 0, true, true);
+
+    const int length = std::min(maxLength, static_cast<int>(std::ceil(sourceLength / ratio)));
+    const bool truncated = static_cast<double>(reader->lengthInSamples) / ratio > length;
+
+    juce::AudioBuffer<float> impulse(numChannels, length);
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        if (reader->sampleRate == sampleRate)
+        {
+            impulse.copyFrom(ch, 0, source, ch, 0, length);
+        }
+        else
+        {
+            juce::WindowedSincInterpolator interpolator;
+            interpolator.process(ratio, source.getReadPointer(ch), impulse.getWritePointer(ch), length);
+        }
+    }
+
+    if (truncated)
+    {
+        int fade = std::min(length, static_cast<int>(kFadeSeconds * sampleRate));
+        impulse.applyGainRamp(length - fade, fade, 1.0f, 0.0f);
+    }
+
+    // Unit energy in the louder channel, so IRs from different sources land
+    // at similar levels on the send
+    double energy = 0.0;
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        double channelEnergy = 0.0;
+        const float* data = impulse.getReadPointer(ch);
+        for (int i = 0; i < length; ++i)
+            channelEnergy += static_cast<double>(data[i]) * data[i];
+        energy = std::max(energy, channelEnergy);
+    }
+    if (energy > 0.0)
+        impulse.applyGain(static_cast<float>(1.0 / std::sqrt(energy)));
+
+    return impulse;
+}
+
+ConvolutionReverb::ConvolutionReverb(const juce::AudioBuffer<float>& impulse, double sampleRate)
+    : juce::Thread("Convolution Reverb"),
+      sampleRate_(sampleRate),
+      earlyFft_(dsp::RealFFT::forSize(kEarlyFftSize)),
+      tailFft_(dsp::RealFFT::forSize(kTailFftSize))
+{
+    length_ = impulse.getNumSamples();
+    const float* irL = impulse.getReadPointer(0);
+    const float* irR = impulse.getNumChannels() > 1 ? impulse.getReadPointer(1) : irL;
+
+    // IR [offset, offset + blockSize), zero-padded to twice that -> spectrum
+    std::vector<float> segment(static_cast<size_t>(kTailFftSize));
+    auto partition = [&](const float* ir, int offset, int blockSize, int end, float* spectrum) {
+        std::fill(segment.begin(), segment.end(), 0.0f);
+        int count = std::clamp(end - offset, 0, blockSize);
+        std::copy(ir + offset, ir + offset + count, segment.begin());
+        if (blockSize == kHeadSize)
+            earlyFft_->forward(segment.data(), spectrum);
+        else
+            tailFft_->forward(segment.data(), spectrum);
+    };
+
+    // Head FIR, reversed
+    for (int k = 0; k < std::min(kHeadSize, length_); ++k)
+    {
+        headL_[static_cast<size_t>(kHeadSize - 1 - k)] = irL[k];
+        headR_[static_cast<size_t>(kHeadSize - 1 - k)] = irR[k];
+    }
+
+    // Early partitions cover the IR up to where the tail starts
+    const int earlyEnd = std::min(length_, kTailStart);
+    numEarly_ = std::max(0, (earlyEnd - 1) / kHeadSize);
+    earlySpectraL_.assign(static_cast<size_t>(numEarly_ * kEarlyFftSize), 0.0f);
+    earlySpectraR_.assign(static_cast<size_t>(numEarly_ * kEarlyFftSize), 0.0f);
+    earlyHistory_.assign(static_cast<size_t>(numEarly_ * kEarlyFftSize), 0.0f);
+    for (int p = 0; p < numEarly_; ++p)
+    {
+        int offset = kHeadSize + p * kHeadSize;
+        partition(irL, offset, kHeadSize, earlyEnd, &earlySpectraL_[static_cast<size_t>(p * kEarlyFftSize)]);
+        partition(irR, offset, kHeadSize, earlyEnd, &earlySpectraR_[static_cast<size_t>(p * kEarlyFftSize)]);
+    }
+
+    numTail_ = std::max(0, (length_ - kTailStart + kTailBlockSize - 1) / kTailBlockSize);
+    for (auto& block : tailOutputBlock_)
+        block.store(-1, std::memory_order_relaxed);
+    if (numTail_ == 0)
+        return;
+
+    tailSpectraL_.assign(static_cast<size_t>(numTail_ * kTailFftSize), 0.0f);
+    tailSpectraR_.assign(static_cast<size_t>(numTail_ * kTailFftSize), 0.0f);
+    for (int p = 0; p < numTail_; ++p)
+    {
+        int offset = kTailStart + p * kTailBlockSize;
+        partition(irL, offset, kTailBlockSize, length_, &tailSpectraL_[static_cast<size_t>(p * kTailFftSize)]);
+        partition(irR, offset, kTailBlockSize, length_, &tailSpectraR_[static_cast<size_t>(p * kTailFftSize)]);
+    }
+
+    tailInput_.assign(static_cast<size_t>(kTailSlots * kTailBlockSize), 0.0f);
+    tailOutputL_.assign(static_cast<size_t>(kTailSlots * kTailBlockSize), 0.0f);
+    tailOutputR_.assign(static_cast<size_t>(kTailSlots * kTailBlockSize), 0.0f);
+    tailHistory_.assign(static_cast<size_t>(numTail_ * kTailFftSize), 0.0f);
+    tailPrevious_.assign(static_cast<size_t>(kTailBlockSize), 0.0f);
+    tailScratch_.assign(static_cast<size_t>(kTailFftSize), 0.0f);
+    tailAccL_.assign(static_cast<size_t>(kTailFftSize), 0.0f);
+    tailAccR_.assign(static_cast<size_t>(kTailFftSize), 0.0f);
+
+    startThread(juce::Thread::Priority::high);
+}
+
+ConvolutionReverb::~ConvolutionReverb()
+{
+    stopThread(2000);
+}
+
+void ConvolutionReverb::process(float& left, float& right)
+{
+    const float input = (left + right) * 0.5f;
+
+    // Head: direct FIR over the last kHeadSize inputs
+    headHistory_[static_cast<size_t>(headPos_)] = input;
+    headHistory_[static_cast<size_t>(headPos_ + kHeadSize)] = input;
+    const float* window = &headHistory_[static_cast<size_t>(headPos_ + 1)];
+    float outL = 0.0f;
+    float outR = 0.0f;
+    for (int i = 0; i < kHeadSize; ++i)
+    {
+        outL += headL_[static_cast<size_t>(i)] * window[i];
+        outR += headR_[static_cast<size_t>(i)] * window[i];
+    }
+    headPos_ = (headPos_ + 1) % kHeadSize;
+
+    // Early partitions: output was computed when the previous block ended
+    if (numEarly_ > 0)
+    {
+        outL += earlyOutL_[static_cast<size_t>(earlyPos_)];
+        outR += earlyOutR_[static_cast<size_t>(earlyPos_)];
+        earlyInput_[static_cast<size_t>(kHeadSize + earlyPos_)] = input;
+        if (++earlyPos_ == kHeadSize)
+        {
+            processEarlyBlock();
+            earlyPos_ = 0;
+        }
+    }
+
+    // Tail: worker output for the block two blocks back
+    if (numTail_ > 0)
+    {
+        if (tailReadL_)
+        {
+            outL += tailReadL_[tailPos_];
+            outR += tailReadR_[tailPos_];
+        }
+        tailInput_[static_cast<size_t>((tailBlock_ % kTailSlots) * kTailBlockSize + tailPos_)] = input;
+        if (++tailPos_ == kTailBlockSize)
+        {
+            tailPos_ = 0;
+            tailBlocksIn_.store(++tailBlock_, std::memory_order_release);
+            beginTailBlock();
+        }
+    }
+
+    left = outL;
+    right = outR;
+}
+
+void ConvolutionReverb::processEarlyBlock()
+{
+    const auto startTicks = juce::Time::getHighResolutionTicks();
+
+    // Overlap-save: spectrum of [previous block, this block]
+    float* spectrum = &earlyHistory_[static_cast<size_t>(earlyHistoryPos_ * kEarlyFftSize)];
+    earlyScratch_ = earlyInput_;
+    earlyFft_->forward(earlyScratch_.data(), spectrum);
+
+    earlyAccL_.fill(0.0f);
+    earlyAccR_.fill(0.0f);
+    for (int p = 0; p < numEarly_; ++p)
+    {
+        int slot = (earlyHistoryPos_ - p + numEarly_) % numEarly_;
+        const float* x = &earlyHistory_[static_cast<size_t>(slot * kEarlyFftSize)];
+        dsp::RealFFT::multiplyAccumulate(x, &earlySpectraL_[static_cast<size_t>(p * kEarlyFftSize)], earlyAccL_.data(), kEarlyFftSize);
+        dsp::RealFFT::multiplyAccumulate(x, &earlySpectraR_[static_cast<size_t>(p * kEarlyFftSize)], earlyAccR_.data(), kEarlyFftSize);
+    }
+    earlyHistoryPos_ = (earlyHistoryPos_ + 1) % numEarly_;
+
+    // Last half is the valid part; it plays during the next block
+    constexpr float scale = 1.0f / kEarlyFftSize;
+    earlyFft_->inverse(earlyAccL_.data(), earlyScratch_.data());
+    for (int i = 0; i < kHeadSize; ++i)
+        earlyOutL_[static_cast<size_t>(i)] = earlyScratch_[static_cast<size_t>(kHeadSize + i)] * scale;
+    earlyFft_->inverse(earlyAccR_.data(), earlyScratch_.data());
+    for (int i = 0; i < kHeadSize; ++i)
+        earlyOutR_[static_cast<size_t>(i)] = earlyScratch_[static_cast<size_t>(kHeadSize + i)] * scale;
+
+    std::copy(earlyInput_.begin() + kHeadSize, earlyInput_.end(), earlyInput_.begin());
+
+    const double seconds = juce::Time::highResolutionTicksToSeconds(
+        juce::Time::getHighResolutionTicks() - startTicks);
+    storeLoad(audioLoad_, seconds, kHeadSize / sampleRate_);
+}
+
+void ConvolutionReverb::beginTailBlock()
+{
+    // The tail starts kTailStart (two blocks) into the IR, so block j of the
+    // worker's output plays during block j + 2
+    tailReadL_ = nullptr;
+    tailReadR_ = nullptr;
+
+    const int block = tailBlock_ - 2;
+    if (block < 0)
+        return;
+
+    const int slot = block % kTailSlots;
+    if (tailOutputBlock_[static_cast<size_t>(slot)].load(std::memory_order_acquire) == block)
+    {
+        tailReadL_ = &tailOutputL_[static_cast<size_t>(slot * kTailBlockSize)];
+        tailReadR_ = &tailOutputR_[static_cast<size_t>(slot * kTailBlockSize)];
+    }
+    else
+    {
+        // Worker missed its deadline - this block of tail is silent
+        lateTailBlocks_.store(lateTailBlocks_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+}
+
+void ConvolutionReverb::run()
+{
+    while (!threadShouldExit())
+    {
+        const int available = tailBlocksIn_.load(std::memory_order_acquire);
+        if (tailNext_ >= available)
+        {
+            wait(kWorkerPollMs);
+            continue;
+        }
+
+        // Fell so far behind that input slots were reused: restart from the
+        // newest block (the tail loses its history, the audio thread has
+        // already counted the misses)
+        if (available - tailNext_ >= kTailSlots)
+        {
+            tailNext_ = available - 1;
+            std::fill(tailHistory_.begin(), tailHistory_.end(), 0.0f);
+            std::fill(tailPrevious_.begin(), tailPrevious_.end(), 0.0f);
+        }
+
+        processTailBlock(tailNext_++);
+    }
+}
+
+void ConvolutionReverb::processTailBlock(int block)
+{
+    const auto startTicks = juce::Time::getHighResolutionTicks();
+    const int slot = block % kTailSlots;
+
+    // Overlap-save: spectrum of [previous block, this block]
+    const float* input = &tailInput_[static_cast<size_t>(slot * kTailBlockSize)];
+    std::copy(tailPrevious_.begin(), tailPrevious_.end(), tailScratch_.begin());
+    std::copy(input, input + kTailBlockSize, tailScratch_.begin() + kTailBlockSize);
+    std::copy(input, input + kTailBlockSize, tailPrevious_.begin());
+
+    float* spectrum = &tailHistory_[static_cast<size_t>(tailHistoryPos_ * kTailFftSize)];
+    tailFft_->forward(tailScratch_.data(), spectrum);
+
+    std::fill(tailAccL_.begin(), tailAccL_.end(), 0.0f);
+    std::fill(tailAccR_.begin(), tailAccR_.end(), 0.0f);
+    for (int p = 0; p < numTail_; ++p)
+    {
+        int historySlot = (tailHistoryPos_ - p + numTail_) % numTail_;
+        const float* x = &tailHistory_[static_cast<size_t>(historySlot * kTailFftSize)];
+        dsp::RealFFT::multiplyAccumulate(x, &tailSpectraL_[static_cast<size_t>(p * kTailFftSize)], tailAccL_.data(), kTailFftSize);
+        dsp::RealFFT::multiplyAccumulate(x, &tailSpectraR_[static_cast<size_t>(p * kTailFftSize)], tailAccR_.data(), kTailFftSize);
+    }
+    tailHistoryPos_ = (tailHistoryPos_ + 1) % numTail_;
+
+    constexpr float scale = 1.0f / kTailFftSize;
+    float* outL = &tailOutputL_[static_cast<size_t>(slot * kTailBlockSize)];
+    float* outR = &tailOutputR_[static_cast<size_t>(slot * kTailBlockSize)];
+    tailFft_->inverse(tailAccL_.data(), tailScratch_.data());
+    for (int i = 0; i < kTailBlockSize; ++i)
+        outL[i] = tailScratch_[static_cast<size_t>(kTailBlockSize + i)] * scale;
+    tailFft_->inverse(tailAccR_.data(), tailScratch_.data());
+    for (int i = 0; i < kTailBlockSize; ++i)
+        outR[i] = tailScratch_[static_cast<size_t>(kTailBlockSize + i)] * scale;
+
+    tailOutputBlock_[static_cast<size_t>(slot)].store(block, std::memory_order_release);
+
+    const double seconds = juce::Time::highResolutionTicksToSeconds(
+        juce::Time::getHighResolutionTicks() - startTicks);
+    storeLoad(workerLoad_, seconds, kTailBlockSize / sampleRate_);
+}
+
+ConvolutionReverb::CostEstimate ConvolutionReverb::getCostEstimate() const
+{
+    CostEstimate cost;
+    cost.audioThreadLoad = audioLoad_.load(std::memory_order_relaxed);
+    cost.workerLoad = workerLoad_.load(std::memory_order_relaxed);
+    cost.earlyPartitions = numEarly_;
+    cost.tailPartitions = numTail_;
+    cost.lateTailBlocks = lateTailBlocks_.load(std::memory_order_relaxed);
+    cost.seconds = length_ / sampleRate_;
+    return cost;
+}
+
+size_t ConvolutionReverb::getAllocatedBytes() const
+{
+    using model::bytesOf;
+    return bytesOf(earlySpectraL_) + bytesOf(earlySpectraR_) + bytesOf(earlyHistory_)
+         + bytesOf(tailSpectraL_) + bytesOf(tailSpectraR_)
+         + bytesOf(tailInput_) + bytesOf(tailOutputL_) + bytesOf(tailOutputR_)
+         + bytesOf(tailHistory_) + bytesOf(tailPrevious_) + bytesOf(tailScratch_)
+         + bytesOf(tailSpectrum_) + bytesOf(tailAccL_) + bytesOf(tailAccR_);
+}
+
+} // namespace audio
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "../dsp/RealFFT.h"
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace audio {
+
+// Zero-latency convolution reverb for the reverb send.
+//
+// The impulse response is split three ways:
+//   [0, kHeadSize)              direct FIR, per sample
+//   [kHeadSize, kTailStart)     uniformly partitioned FFT convolution (block
+//                               kHeadSize) on the audio thread
+//   [kTailStart, end)           partitions of kTailBlockSize, computed on a
+//                               worker thread one block ahead of use
+// Each section's latency is covered by where it starts in the IR, so the
+// sum is exact and nothing is added. Instances are immutable once built:
+// a new IR means a new ConvolutionReverb, built off the audio thread.
+class ConvolutionReverb : private juce::Thread
+{
+public:
+    static constexpr int kHeadSize = 128;
+    static constexpr int kTailBlockSize = 4096;
+    static constexpr int kTailStart = 2 * kTailBlockSize;  // One block of slack for the worker
+    static constexpr int kTailSlots = 4;
+
+    struct CostEstimate
+    {
+        double audioThreadLoad = 0.0;  // Fraction of real time spent in partitioned work
+        double workerLoad = 0.0;       // Same, for the tail worker
+        int earlyPartitions = 0;
+        int tailPartitions = 0;
+        int lateTailBlocks = 0;        // Tail blocks the worker didn't finish in time
+        double seconds = 0.0;          // IR length after the tail limit
+    };
+
+    // Message thread. Reads an IR with the sampler's formats, resamples it to
+    // sampleRate and cuts it to maxSeconds (with a short fade). Empty on failure.
+    static juce::AudioBuffer<float> loadImpulse(const juce::File& file, double sampleRate, float maxSeconds);
+
+    // Message thread. Partitions the IR (mono or stereo, at sampleRate) and
+    // starts the tail worker if the IR is long enough to need one.
+    ConvolutionReverb(const juce::AudioBuffer<float>& impulse, double sampleRate);
+    ~ConvolutionReverb() override;
+
+    // Audio thread. Mono sum in, 100% wet stereo out - same contract as Reverb
+    void process(float& left, float& right);
+
+    CostEstimate getCostEstimate() const;
+
+    // Partition spectra, histories and hand-off blocks; the FFT plans are
+    // shared and not counted (see model/MemoryUsage.h)
+    size_t getAllocatedBytes() const;
+
+private:
+    static constexpr int kEarlyFftSize = 2 * kHeadSize;
+    static constexpr int kTailFftSize = 2 * kTailBlockSize;
+
+    void processEarlyBlock();
+    void beginTailBlock();
+    void run() override;
+    void processTailBlock(int block);
+
+    double sampleRate_;
+    int length_ = 0;
+
+    // Head FIR (kernels stored reversed; history mirrored so reads are contiguous)
+    std::array<float, kHeadSize> headL_{}, headR_{};
+    std::array<float, 2 * kHeadSize> headHistory_{};
+    int headPos_ = 0;
+
+    std::shared_ptr<const dsp::RealFFT> earlyFft_, tailFft_;
+
+    // Early partitions - audio thread
+    int numEarly_ = 0;
+    std::vector<float> earlySpectraL_, earlySpectraR_;  // numEarly_ x kEarlyFftSize
+    std::vector<float> earlyHistory_;                    // Input spectra, same layout
+    int earlyHistoryPos_ = 0;
+    std::array<float, kEarlyFftSize> earlyInput_{};      // Previous block, then current
+    std::array<float, kEarlyFftSize> earlyScratch_{}, earlyAccL_{}, earlyAccR_{};
+    std::array<float, kHeadSize> earlyOutL_{}, earlyOutR_{};
+    int earlyPos_ = 0;
+
+    // Tail partitions - spectra are read-only after construction
+    int numTail_ = 0;
+    std::vector<float> tailSpectraL_, tailSpectraR_;
+
+    // Audio thread <-> worker hand-off, kTailSlots blocks each way
+    std::vector<float> tailInput_;                    // kTailSlots x kTailBlockSize
+    std::vector<float> tailOutputL_, tailOutputR_;
+    std::array<std::atomic<int>, kTailSlots> tailOutputBlock_;  // Which block a slot holds
+    std::atomic<int> tailBlocksIn_{0};                // Complete input blocks published
+    int tailBlock_ = 0;                               // Audio thread: block being collected
+    int tailPos_ = 0;
+    const float* tailReadL_ = nullptr;                // Output for this block, if ready
+    const float* tailReadR_ = nullptr;
+
+    // Worker only
+    int tailNext_ = 0;
+    std::vector<float> tailHistory_;
+    int tailHistoryPos_ = 0;
+    std::vector<float> tailPrevious_, tailScratch_, tailSpectrum_, tailAccL_, tailAccR_;
+
+    std::atomic<double> audioLoad_{0.0};
+    std::atomic<double> workerLoad_{0.0};
+    std::atomic<int> lateTailBlocks_{0};
+
+    JUCE_DECLARE_NON_COPYABLE(ConvolutionReverb)
+};
+
+} // namespace audio
@@ -1,9 +1,9 @@
 #include "DX7Instrument.h"
 #include "DX7Voice.h"
-#include "Voice.h"
 #include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <mutex>
 
 // Debug logging for DX7
 #define DX7_DEBUG 0
@@ -15,17 +15,14 @@
 
 namespace audio {
 
-std::unique_ptr<audio::Voice> DX7Instrument::createVoice() {
-  auto voice = std::make_unique<DX7Voice>();
-  voice->setSampleRate(sampleRate_);
-  updateVoiceParameters(voice.get());
-  return voice;
+void DX7Instrument::initVoice(DX7Voice &voice) {
+  voice.setSampleRate(sampleRate_);
+  updateVoiceParameters(voice);
 }
 
-void DX7Instrument::updateVoiceParameters(audio::Voice *voice) {
-  auto *dx7Voice = static_cast<DX7Voice *>(voice);
-  dx7Voice->loadPatch(currentPatch_);
-  dx7Voice->setControllers(&controllers_);
+void DX7Instrument::updateVoiceParameters(DX7Voice &voice) {
+  voice.loadPatch(currentPatch_);
+  voice.setControllers(&controllers_);
 }
 
 // DX7 init patch - a simple sine wave (algorithm 32, single carrier)
@@ -109,9 +106,14 @@ DX7Instrument::DX7Instrument() {
 
 DX7Instrument::~DX7Instrument() = default;
 
-void DX7Instrument::init(double sampleRate) {
-  DX7_LOG("init() called with sampleRate=" << sampleRate);
-  sampleRate_ = sampleRate;
+void DX7Instrument::initTables(double sampleRate) {
+  // The msfa tables are global and the same for every instance at a rate, so
+  // the engine preparing 128 slots (in parallel) builds them once
+  static std::mutex mutex;
+  static double tablesRate = 0.0;
+  std::lock_guard<std::mutex> lock(mutex);
+  if (tablesRate == sampleRate)
+    return;
 
   // Initialize static sample rate for msfa components
   Env::init_sr(sampleRate);
@@ -124,6 +126,15 @@ void DX7Instrument::init(double sampleRate) {
   Sin::init(); // CRITICAL: Initialize sine table for FM synthesis!
   DX7_LOG("Lookup tables initialized (including Sin)");
 
+  tablesRate = sampleRate;
+}
+
+void DX7Instrument::init(double sampleRate) {
+  DX7_LOG("init() called with sampleRate=" << sampleRate);
+  sampleRate_ = sampleRate;
+
+  initTables(sampleRate);
+
   // Initialize LFO with default patch
   lfo_.reset(&currentPatch_[137]); // LFO params at offset 137
 
@@ -145,8 +156,7 @@ void DX7Instrument::init(double sampleRate) {
 void DX7Instrument::setSampleRate(double sampleRate) {
   if (sampleRate_ != sampleRate) {
     sampleRate_ = sampleRate;
-    Env::init_sr(sampleRate);
-    Lfo::init(sampleRate);
+    initTables(sampleRate);
     trackerFX_.setSampleRate(sampleRate);
   }
 }
@@ -294,10 +304,6 @@ void DX7Instrument::allNotesOff() {
 }
 
 void DX7Instrument::process(float *outL, float *outR, int numSamples) {
-  static int processCallCount = 0;
-  static int activeVoiceCount = 0;
-  static float maxSampleEver = 0.0f;
-
   // Process tracker FX with callbacks
   if (hasPendingFX_) {
     auto onNoteOn = [this](int note, float velocity) {
@@ -363,10 +369,10 @@ void DX7Instrument::process(float *outL, float *outR, int numSamples) {
       currentActiveVoices++;
   }
 
-  if (currentActiveVoices != activeVoiceCount) {
-    DX7_LOG("process() active voices changed: " << activeVoiceCount << " -> "
-                                                << currentActiveVoices);
-    activeVoiceCount = currentActiveVoices;
+  if (currentActiveVoices != activeVoiceCount_) {
+    DX7_LOG("process() active voices changed: "
+            << activeVoiceCount_ << " -> " << currentActiveVoices);
+    activeVoiceCount_ = currentActiveVoices;
   }
 
   int samplesProcessed = 0;
@@ -412,7 +418,8 @@ void DX7Instrument::process(float *outL, float *outR, int numSamples) {
     // Scale conservatively to prevent distortion - DX7 voices can be very loud
     constexpr float baseScale = 1.0f / (1 << 24);
     // Apply more aggressive polyphony scaling to prevent clipping
-    float voiceScale = 1.0f / static_cast<float>(std::max(1, activeVoiceCount));
+    float voiceScale =
+        1.0f / static_cast<float>(std::max(1, activeVoiceCount_));
     // Additional headroom scaling factor
     constexpr float headroomScale = 0.5f;
     float scale = baseScale * voiceScale * headroomScale;
@@ -430,17 +437,18 @@ void DX7Instrument::process(float *outL, float *outR, int numSamples) {
   }
 
   // Log periodically when there are active voices
-  processCallCount++;
-  if (activeVoiceCount > 0 && (processCallCount % 100 == 0)) {
-    DX7_LOG("process() #" << processCallCount << ": voices=" << activeVoiceCount
+  processCallCount_++;
+  if (activeVoiceCount_ > 0 && (processCallCount_ % 100 == 0)) {
+    DX7_LOG("process() #" << processCallCount_
+                          << ": voices=" << activeVoiceCount_
                           << " maxBuf=" << maxBufVal
                           << " maxSample=" << maxSampleThisCall);
   }
 
-  if (maxSampleThisCall > maxSampleEver) {
-    maxSampleEver = maxSampleThisCall;
-    if (maxSampleEver > 0.0001f) {
-      DX7_LOG("process() NEW MAX SAMPLE: " << maxSampleEver);
+  if (maxSampleThisCall > maxSampleEver_) {
+    maxSampleEver_ = maxSampleThisCall;
+    if (maxSampleEver_ > 0.0001f) {
+      DX7_LOG("process() NEW MAX SAMPLE: " << maxSampleEver_);
     }
   }
 }
@@ -580,6 +588,15 @@ void DX7Instrument::loadPackedPatch(const uint8_t *packedData) {
 
 const char *DX7Instrument::getPatchName() const { return patchName_; }
 
+size_t DX7Instrument::getAllocatedBytes() const {
+  size_t bytes = 0;
+  for (const auto &voice : voices_) {
+    if (voice.note)
+      bytes += sizeof(Dx7Note);
+  }
+  return bytes;
+}
+
 void DX7Instrument::setPolyphony(int voices) {
   polyphony_ = std::clamp(voices, 1, DX7_MAX_POLYPHONY);
 }
@@ -18,12 +18,14 @@
 
 namespace audio {
 
+class DX7Voice;
+
 // DX7 patch size constants
 constexpr int DX7_PATCH_SIZE_PACKED = 128;    // Size of packed patch in sysex bank
 constexpr int DX7_PATCH_SIZE_UNPACKED = 156;  // Size of unpacked patch for Dx7Note
 constexpr int DX7_MAX_POLYPHONY = 16;
 
-class DX7Instrument : public InstrumentProcessor
+class DX7Instrument final : public InstrumentProcessor
 {
 public:
     DX7Instrument();
@@ -33,9 +35,12 @@ public:
     void init(double sampleRate) override;
     void setSampleRate(double sampleRate) override;
 
-    // Voice-per-track interface
-    std::unique_ptr<audio::Voice> createVoice() override;
-    void updateVoiceParameters(audio::Voice* voice) override;
+    // Voice-per-track interface (see TrackVoice.h)
+    using VoiceType = DX7Voice;
+    // Prepares a freshly created track voice
+    void initVoice(DX7Voice& voice);
+    // Syncs a track voice with the current instrument params, once per block
+    void updateVoiceParameters(DX7Voice& voice);
 
     // Legacy methods
     void noteOn(int note, float velocity) override;
@@ -59,6 +64,9 @@ public:
     int getPolyphony() const { return polyphony_; }
     void setTempo(double bpm);
 
+    // Heap memory owned - the voices' notes (see model/MemoryUsage.h)
+    size_t getAllocatedBytes() const;
+
     // Unpack a 128-byte packed patch to 156-byte unpacked format
     static void unpackPatch(const uint8_t* packed, uint8_t* unpacked);
 
@@ -70,6 +78,9 @@ private:
         uint64_t age = 0;  // For voice stealing
     };
 
+    // The shared msfa tables, rebuilt only when the rate changes. Any thread
+    static void initTables(double sampleRate);
+
     int findFreeVoice();
     int findVoiceForNote(int note);
     void processBlock(int32_t* buffer, int numSamples);
@@ -82,6 +93,12 @@ private:
     uint64_t voiceCounter_ = 0;
     int polyphony_ = DX7_MAX_POLYPHONY;
 
+    // Per instance: the live instrument and the preview renderer's run on
+    // different threads
+    int activeVoiceCount_ = 0;   // Scales the mix down as voices are added
+    int processCallCount_ = 0;   // Debug logging only
+    float maxSampleEver_ = 0.0f; // Debug logging only
+
     Lfo lfo_;
     FmCore fmCore_;
     Controllers controllers_;
@@ -65,6 +65,12 @@ void DX7Voice::setSampleRate(double sampleRate) {
   // They are static init methods called from DX7Instrument::init()
 }
 
+size_t DX7Voice::getAllocatedBytes() const {
+  return (dx7Note_ ? sizeof(Dx7Note) : 0) + (lfo_ ? sizeof(Lfo) : 0) +
+         (fmCore_ ? sizeof(FmCore) : 0) +
+         (controllers_ ? sizeof(Controllers) : 0);
+}
+
 void DX7Voice::loadPatch(const uint8_t *patchData) {
   std::memcpy(patch_, patchData, DX7_VOICE_PATCH_SIZE);
   // Reset LFO with new patch parameters (LFO params at offset 137)
@@ -1,6 +1,6 @@
 #pragma once
 
-#include "Voice.h"
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <memory>
@@ -19,22 +19,23 @@ namespace audio {
 // Size constants (matching DX7Instrument)
 constexpr int DX7_VOICE_PATCH_SIZE = 156;
 
-// Single-voice DX7 synthesizer implementing the Voice interface
-// Each track owns one DX7Voice for voice-per-track architecture
-class DX7Voice : public Voice {
+// Single-voice DX7 synthesizer, the track voice for DX7 instruments (see
+// TrackVoice.h). Each track playing a DX7 instrument holds one inline
+class DX7Voice {
 public:
   DX7Voice();
-  ~DX7Voice() override;
+  ~DX7Voice();
 
-  // Voice interface
-  void noteOn(int note, float velocity) override;
-  void noteOff() override;
+  // Track voice members
+  void noteOn(int note, float velocity);
+  void noteOff();
   void process(float *outL, float *outR, int numSamples, float pitchMod = 0.0f,
                float cutoffMod = 0.0f, float volumeMod = 1.0f,
-               float panMod = 0.5f) override;
-  bool isActive() const override { return active_; }
-  int getCurrentNote() const override { return currentNote_; }
-  void setSampleRate(double sampleRate) override;
+               float panMod = 0.5f);
+  bool isActive() const { return active_; }
+  int getCurrentNote() const { return currentNote_; }
+  void setSampleRate(double sampleRate);
+  size_t getAllocatedBytes() const;
 
   // DX7-specific parameter setters (called by
   // DX7Instrument::updateVoiceParameters)
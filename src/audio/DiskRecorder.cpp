@@ -0,0 +1,242 @@
+#include "DiskRecorder.h"
+#include <algorithm>
+
+namespace audio {
+
+namespace {
+
+constexpr int kWriterIntervalMs = 20;
+
+juce::String instrumentLabel(int instrument)
+{
+    return juce::String::toHexString(instrument).paddedLeft('0', 2).toUpperCase();
+}
+
+} // anonymous namespace
+
+DiskRecorder::DiskRecorder()
+    : juce::Thread("Disk Recorder")
+{
+    instrumentStreams_.fill(-1);
+}
+
+DiskRecorder::~DiskRecorder()
+{
+    stop();
+}
+
+bool DiskRecorder::start(const juce::File& directory, const juce::String& name,
+                         double sampleRate, const Options& options)
+{
+    stop();
+
+    if (!directory.isDirectory() && !directory.createDirectory())
+    {
+        DBG("Can't create recording directory: " << directory.getFullPathName());
+        return false;
+    }
+
+    std::unique_ptr<juce::AudioFormat> format;
+    juce::String extension;
+    int bitDepth = options.bitDepth;
+    if (options.format == Format::Flac)
+    {
+        format = std::make_unique<juce::FlacAudioFormat>();
+        extension = ".flac";
+        bitDepth = std::min(bitDepth, 24);
+    }
+    else
+    {
+        format = std::make_unique<juce::WavAudioFormat>();
+        extension = ".wav";
+    }
+
+    // Streams: master, then the FX return, then instrument stems
+    writers_.clear();
+    takeFiles_.clear();
+    instrumentStreams_.fill(-1);
+    fxStream_ = -1;
+
+    takeFiles_.push_back({"master", {}});
+    if (options.fxBus)
+    {
+        fxStream_ = static_cast<int>(takeFiles_.size());
+        takeFiles_.push_back({"fx", {}});
+    }
+    for (int instrument : options.instruments)
+    {
+        if (instrument < 0 || instrument >= kMaxInstruments ||
+            instrumentStreams_[static_cast<size_t>(instrument)] >= 0)
+            continue;
+        if (static_cast<int>(takeFiles_.size()) >= kMaxStreams)
+        {
+            DBG("Disk recorder: only the first " << kMaxInstrumentStems << " instrument stems are recorded");
+            break;
+        }
+        instrumentStreams_[static_cast<size_t>(instrument)] = static_cast<int>(takeFiles_.size());
+        takeFiles_.push_back({instrumentLabel(instrument), {}});
+    }
+
+    for (auto& take : takeFiles_)
+    {
+        take.file = directory.getChildFile(name + "_" + take.label + extension);
+        auto stream = take.file.createOutputStream();
+        if (stream)
+        {
+            // Overwrite, don't append to, an older take of the same name
+            stream->setPosition(0);
+            stream->truncate();
+        }
+
+        std::unique_ptr<juce::AudioFormatWriter> writer;
+        if (stream)
+            writer.reset(format->createWriterFor(stream.get(), sampleRate, 2, bitDepth, {}, 0));
+        if (!writer)
+        {
+            DBG("Can't open " << take.file.getFullPathName() << " for recording");
+            writers_.clear();
+            takeFiles_.clear();
+            instrumentStreams_.fill(-1);
+            fxStream_ = -1;
+            return false;
+        }
+        stream.release();  // Owned by the writer now
+        writers_.push_back(std::move(writer));
+    }
+
+    numStreams_ = static_cast<int>(writers_.size());
+    sampleRate_ = sampleRate;
+
+    // Allocated here so the audio thread never has to
+    const int capacity = static_cast<int>(sampleRate * kBufferSeconds);
+    ring_.setSize(numStreams_ * 2, capacity, false, false, true);
+    fifo_.setTotalSize(capacity);
+    fifo_.reset();
+
+    writtenSamples_.store(0, std::memory_order_relaxed);
+    droppedBlocks_.store(0, std::memory_order_relaxed);
+    droppedSamples_.store(0, std::memory_order_relaxed);
+    writeFailed_.store(false, std::memory_order_relaxed);
+
+    startThread(juce::Thread::Priority::high);
+    recording_.store(true);
+
+    DBG("Recording " << numStreams_ << " stream(s) to " << directory.getFullPathName());
+    return true;
+}
+
+void DiskRecorder::stop()
+{
+    if (!isRecording())
+        return;
+
+    // Once the audio thread is out of push() it can't see recording_ again
+    recording_.store(false);
+    while (pushing_.load())
+        juce::Thread::yield();
+
+    // The writer drains what is left before exiting
+    signalThreadShouldExit();
+    notify();
+    stopThread(10000);
+
+    // Destroying the writers finalises the file headers
+    writers_.clear();
+
+    DBG("Recorded " << getStats().seconds << "s, " << getStats().droppedBlocks << " block(s) dropped");
+}
+
+void DiskRecorder::push(const float* const* channels, int numSamples)
+{
+    pushing_.store(true);
+
+    if (recording_.load())
+    {
+        if (fifo_.getFreeSpace() < numSamples)
+        {
+            // Disk fell behind - losing a block beats blocking the callback
+            droppedBlocks_.store(droppedBlocks_.load(std::memory_order_relaxed) + 1,
+                                 std::memory_order_relaxed);
+            droppedSamples_.store(droppedSamples_.load(std::memory_order_relaxed) + numSamples,
+                                  std::memory_order_relaxed);
+        }
+        else
+        {
+            int start1, size1, start2, size2;
+            fifo_.prepareToWrite(numSamples, start1, size1, start2, size2);
+            for (int ch = 0; ch < numStreams_ * 2; ++ch)
+            {
+                ring_.copyFrom(ch, start1, channels[ch], size1);
+                if (size2 > 0)
+                    ring_.copyFrom(ch, start2, channels[ch] + size1, size2);
+            }
+            fifo_.finishedWrite(size1 + size2);
+        }
+    }
+
+    pushing_.store(false);
+}
+
+DiskRecorder::Stats DiskRecorder::getStats() const
+{
+    Stats stats;
+    stats.recording = isRecording();
+    stats.seconds = static_cast<double>(writtenSamples_.load(std::memory_order_relaxed)) / sampleRate_;
+    stats.droppedBlocks = droppedBlocks_.load(std::memory_order_relaxed);
+    stats.droppedSamples = droppedSamples_.load(std::memory_order_relaxed);
+    stats.bufferFill = stats.recording
+        ? static_cast<float>(fifo_.getNumReady()) / static_cast<float>(fifo_.getTotalSize())
+        : 0.0f;
+    stats.writeFailed = writeFailed_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+size_t DiskRecorder::getAllocatedBytes() const
+{
+    return static_cast<size_t>(ring_.getNumChannels()) * static_cast<size_t>(ring_.getNumSamples()) * sizeof(float);
+}
+
+void DiskRecorder::run()
+{
+    while (!threadShouldExit())
+    {
+        if (!drain())
+            wait(kWriterIntervalMs);
+    }
+
+    // Blocks pushed before stop() took effect
+    while (drain())
+        ;
+}
+
+bool DiskRecorder::drain()
+{
+    const int ready = fifo_.getNumReady();
+    if (ready == 0)
+        return false;
+
+    int start1, size1, start2, size2;
+    fifo_.prepareToRead(ready, start1, size1, start2, size2);
+    writeRange(start1, size1);
+    writeRange(start2, size2);
+    fifo_.finishedRead(size1 + size2);
+
+    writtenSamples_.fetch_add(size1 + size2, std::memory_order_relaxed);
+    return true;
+}
+
+void DiskRecorder::writeRange(int start, int size)
+{
+    if (size <= 0)
+        return;
+
+    for (int stream = 0; stream < numStreams_; ++stream)
+    {
+        const float* channels[] = { ring_.getReadPointer(stream * 2, start),
+                                    ring_.getReadPointer(stream * 2 + 1, start) };
+        if (!writers_[static_cast<size_t>(stream)]->writeFromFloatArrays(channels, 2, size))
+            writeFailed_.store(true, std::memory_order_relaxed);
+    }
+}
+
+} // namespace audio
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace audio {
+
+// Records the master output (and optionally the FX return and per-instrument
+// stems) to disk while playing.
+//
+// The audio thread copies each rendered block into a preallocated ring buffer
+// and never waits; a background thread drains it into one stereo WAV/FLAC
+// file per stream. If the disk falls behind and the ring fills, whole blocks
+// are dropped (in every stream, so the files stay aligned) and counted.
+class DiskRecorder : private juce::Thread
+{
+public:
+    static constexpr int kMaxInstruments = 128;     // AudioEngine::NUM_INSTRUMENTS
+    static constexpr int kMaxInstrumentStems = 16;
+    static constexpr int kMaxStreams = 2 + kMaxInstrumentStems;  // Master, FX return, stems
+    static constexpr double kBufferSeconds = 2.0;
+
+    enum class Format { Wav, Flac };
+
+    struct Options
+    {
+        Format format = Format::Wav;
+        int bitDepth = 24;              // 16 or 24 (WAV also takes 32)
+        bool fxBus = false;             // Reverb/delay/chorus return
+        std::vector<int> instruments;   // Instrument stems, up to kMaxInstrumentStems
+    };
+
+    struct TakeFile
+    {
+        juce::String label;             // "master", "fx" or the instrument in hex
+        juce::File file;
+    };
+
+    struct Stats
+    {
+        bool recording = false;
+        double seconds = 0.0;           // Audio written to disk so far
+        int droppedBlocks = 0;
+        juce::int64 droppedSamples = 0;
+        float bufferFill = 0.0f;        // 0..1, how far the writer is behind
+        bool writeFailed = false;
+    };
+
+    DiskRecorder();
+    ~DiskRecorder() override;
+
+    // Message thread. Opens <directory>/<name>_<label>.<ext> for each stream and
+    // starts capturing. False (and nothing recording) if a file can't be opened.
+    bool start(const juce::File& directory, const juce::String& name,
+               double sampleRate, const Options& options);
+
+    // Message thread. Writes out what is still buffered and closes the files
+    void stop();
+
+    bool isRecording() const { return recording_.load(std::memory_order_acquire); }
+    Stats getStats() const;
+
+    // Message thread. The ring, which is kept between takes
+    size_t getAllocatedBytes() const;
+
+    // Message thread. Files of the current or most recent take
+    const std::vector<TakeFile>& getTakeFiles() const { return takeFiles_; }
+
+    // Audio thread. Stream layout of the block passed to push(): two channels
+    // per stream, master first. -1 when the stream isn't being recorded.
+    int getNumStreams() const { return numStreams_; }
+    int getFxStream() const { return fxStream_; }
+    int getInstrumentStream(int instrument) const
+    {
+        return instrument >= 0 && instrument < kMaxInstruments
+            ? instrumentStreams_[static_cast<size_t>(instrument)]
+            : -1;
+    }
+
+    // Audio thread. Never blocks; drops the block if the ring is full
+    void push(const float* const* channels, int numSamples);
+
+private:
+    void run() override;
+    bool drain();
+    void writeRange(int start, int size);
+
+    // Set up by start() before recording_ is published; read-only while recording
+    std::vector<std::unique_ptr<juce::AudioFormatWriter>> writers_;
+    std::vector<TakeFile> takeFiles_;
+    std::array<int, kMaxInstruments> instrumentStreams_;
+    int numStreams_ = 0;
+    int fxStream_ = -1;
+    double sampleRate_ = 48000.0;
+
+    juce::AudioBuffer<float> ring_;
+    juce::AbstractFifo fifo_{1};
+
+    std::atomic<bool> recording_{false};
+    std::atomic<bool> pushing_{false};  // Audio thread inside push()
+
+    std::atomic<juce::int64> writtenSamples_{0};
+    std::atomic<int> droppedBlocks_{0};
+    std::atomic<juce::int64> droppedSamples_{0};
+    std::atomic<bool> writeFailed_{false};
+
+    JUCE_DECLARE_NON_COPYABLE(DiskRecorder)
+};
+
+} // namespace audio
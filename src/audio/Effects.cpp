@@ -1,4 +1,5 @@
 #include "Effects.h"
+#include "ConvolutionReverb.h"
 #include <algorithm>
 
 namespace audio {
@@ -31,6 +32,16 @@ void Reverb::init(double sampleRate)
     }
 }
 
+size_t Reverb::getAllocatedBytes() const
+{
+    size_t bytes = 0;
+    for (int i = 0; i < NUM_COMBS; ++i)
+        bytes += model::bytesOf(combBuffersL_[i]) + model::bytesOf(combBuffersR_[i]);
+    for (int i = 0; i < NUM_ALLPASS; ++i)
+        bytes += model::bytesOf(allpassBuffersL_[i]) + model::bytesOf(allpassBuffersR_[i]);
+    return bytes;
+}
+
 void Reverb::setParams(float size, float damping, float /*mix*/)
 {
     size_ = size;
@@ -109,15 +120,256 @@ void Reverb::process(float& left, float& right)
     right = outR;
 }
 
+// ============ FDN REVERB ============
+
+namespace {
+
+// Line lengths in ms, with no simple ratios between them so no two lines
+// reinforce each other. The shortest must stay longer than a chunk
+// (29.7ms is still 237 samples at 8kHz)
+constexpr float kFdnDelaysMs[FdnReverb::NUM_LINES] = {
+    29.7f, 37.1f, 41.1f, 43.7f, 53.9f, 59.3f, 67.1f, 73.7f};
+
+constexpr float kFdnModDepthMs = 0.3f;
+constexpr float kFdnModRateHz = 0.7f;
+constexpr float kFdnOutputGain = 1.5f;  // Roughly the Schroeder reverb's level
+
+// In-place 8-point Walsh-Hadamard transform (unnormalised): three stages of
+// butterflies, written out so they compile to a handful of SIMD add/subs
+inline void hadamard8(std::array<float, FdnReverb::NUM_LINES>& x)
+{
+    float a0 = x[0] + x[1], a1 = x[0] - x[1], a2 = x[2] + x[3], a3 = x[2] - x[3];
+    float a4 = x[4] + x[5], a5 = x[4] - x[5], a6 = x[6] + x[7], a7 = x[6] - x[7];
+
+    float b0 = a0 + a2, b1 = a1 + a3, b2 = a0 - a2, b3 = a1 - a3;
+    float b4 = a4 + a6, b5 = a5 + a7, b6 = a4 - a6, b7 = a5 - a7;
+
+    x[0] = b0 + b4; x[1] = b1 + b5; x[2] = b2 + b6; x[3] = b3 + b7;
+    x[4] = b0 - b4; x[5] = b1 - b5; x[6] = b2 - b6; x[7] = b3 - b7;
+}
+
+} // anonymous namespace
+
+void FdnReverb::init(double sampleRate)
+{
+    constexpr float PI = 3.14159265f;
+    sampleRate_ = sampleRate;
+
+    const float msToSamples = static_cast<float>(sampleRate / 1000.0);
+    modDepth_ = kFdnModDepthMs * msToSamples;
+
+    // Longest line plus modulation and interpolation headroom, rounded up to
+    // a power of two
+    int needed = static_cast<int>(kFdnDelaysMs[NUM_LINES - 1] * msToSamples + 2.0f * modDepth_) + 2;
+    lineSize_ = 1;
+    while (lineSize_ < needed)
+        lineSize_ *= 2;
+    mask_ = lineSize_ - 1;
+
+    lines_.assign(static_cast<size_t>(NUM_LINES * lineSize_), 0.0f);
+    writeIndex_ = 0;
+
+    for (int i = 0; i < NUM_LINES; ++i)
+    {
+        delays_[static_cast<size_t>(i)] = kFdnDelaysMs[i] * msToSamples;
+
+        float phase = 2.0f * PI * static_cast<float>(i) / NUM_LINES;
+        modCos_[static_cast<size_t>(i)] = std::cos(phase);
+        modSin_[static_cast<size_t>(i)] = std::sin(phase);
+    }
+    lowpass_.fill(0.0f);
+
+    lfoIncrement_ = 2.0f * PI * kFdnModRateHz / static_cast<float>(sampleRate);
+    lfoPhase_ = 0.0f;
+    lfoCos_ = 1.0f;
+    lfoSin_ = 0.0f;
+
+    size_ = -1.0f;  // Force the gains to be recomputed
+    setParams(0.5f, damping_);
+}
+
+size_t FdnReverb::getAllocatedBytes() const
+{
+    return model::bytesOf(lines_);
+}
+
+void FdnReverb::setParams(float size, float damping)
+{
+    damping_ = damping;
+    if (size != size_)
+    {
+        size_ = size;
+        updateGains();
+    }
+}
+
+void FdnReverb::updateGains()
+{
+    // Size sets the decay time: ~0.3s (small room) to ~8s (huge hall).
+    // Each line gets the gain that gives every path the same T60
+    float t60 = 0.3f + 7.7f * size_ * size_;
+    const float matrixScale = 1.0f / std::sqrt(static_cast<float>(NUM_LINES));
+    for (int i = 0; i < NUM_LINES; ++i)
+    {
+        float seconds = delays_[static_cast<size_t>(i)] / static_cast<float>(sampleRate_);
+        gains_[static_cast<size_t>(i)] = std::pow(10.0f, -3.0f * seconds / t60) * matrixScale;
+    }
+}
+
+void FdnReverb::process(float* left, float* right, int numSamples)
+{
+    constexpr float TWO_PI = 6.28318531f;
+
+    // Same damping range as the Schroeder reverb's comb filters
+    const float damp = damping_ * 0.4f;
+    const float inputGain = 0.5f / std::sqrt(static_cast<float>(NUM_LINES));
+
+    for (int start = 0; start < numSamples; start += CHUNK)
+    {
+        const int count = std::min(CHUNK, numSamples - start);
+
+        // Move the LFO to the end of the chunk; read taps glide between the two
+        const float startCos = lfoCos_;
+        const float startSin = lfoSin_;
+        lfoPhase_ += lfoIncrement_ * static_cast<float>(count);
+        if (lfoPhase_ > TWO_PI)
+            lfoPhase_ -= TWO_PI;
+        lfoCos_ = std::cos(lfoPhase_);
+        lfoSin_ = std::sin(lfoPhase_);
+
+        // Read each line's taps for the chunk (linear interpolation)
+        for (size_t line = 0; line < NUM_LINES; ++line)
+        {
+            float delayStart = delays_[line] + modDepth_ * (1.0f + startCos * modCos_[line] + startSin * modSin_[line]);
+            float delayEnd = delays_[line] + modDepth_ * (1.0f + lfoCos_ * modCos_[line] + lfoSin_ * modSin_[line]);
+            float offset = static_cast<float>(lineSize_) - delayStart;
+            int whole = static_cast<int>(offset);
+            float frac = offset - static_cast<float>(whole);
+            int index = (writeIndex_ + whole) & mask_;
+
+            // The delay moves by well under a sample per chunk, so the read
+            // stays on consecutive samples and only the fraction glides
+            // (straying just past 0 or 1 at the chunk ends)
+            float glide = (delayStart - delayEnd) / static_cast<float>(count);
+
+            const float* base = lines_.data() + line * static_cast<size_t>(lineSize_);
+            auto& taps = chunk_[line];
+            if (index + count < lineSize_)
+            {
+                const float* p = base + index;
+                for (int n = 0; n < count; ++n)
+                {
+                    float f = frac + glide * static_cast<float>(n);
+                    taps[static_cast<size_t>(n)] = p[n] + f * (p[n + 1] - p[n]);
+                }
+            }
+            else
+            {
+                for (int n = 0; n < count; ++n)
+                {
+                    float f = frac + glide * static_cast<float>(n);
+                    float a = base[(index + n) & mask_];
+                    float b = base[(index + n + 1) & mask_];
+                    taps[static_cast<size_t>(n)] = a + f * (b - a);
+                }
+            }
+        }
+
+        // Damp, mix and feed back, one sample at a time across all lines.
+        // Filter state and gains are held in locals so they stay in registers
+        std::array<float, NUM_LINES> lowpass = lowpass_;
+        const std::array<float, NUM_LINES> gains = gains_;
+        for (int n = 0; n < count; ++n)
+        {
+            const size_t i = static_cast<size_t>(n);
+            std::array<float, NUM_LINES> x;
+            for (size_t line = 0; line < NUM_LINES; ++line)
+            {
+                // High frequencies die away faster than lows
+                float tap = chunk_[line][i];
+                lowpass[line] = tap + (lowpass[line] - tap) * damp;
+                x[line] = lowpass[line];
+            }
+
+            // Decorrelated stereo taps: two orthogonal rows of the Hadamard matrix
+            float outL = x[0] - x[1] + x[2] - x[3] + x[4] - x[5] + x[6] - x[7];
+            float outR = x[0] + x[1] - x[2] - x[3] + x[4] + x[5] - x[6] - x[7];
+
+            // Lossless mix, with the input fed in alternating signs
+            for (size_t line = 0; line < NUM_LINES; ++line)
+                x[line] *= gains[line];
+            hadamard8(x);
+
+            float input = (left[start + n] + right[start + n]) * inputGain;
+            for (size_t line = 0; line < NUM_LINES; ++line)
+                chunk_[line][i] = x[line] + ((line & 1) ? -input : input);
+
+            left[start + n] = outL * kFdnOutputGain;
+            right[start + n] = outR * kFdnOutputGain;
+        }
+        lowpass_ = lowpass;
+
+        // Write the chunk back into every line
+        for (size_t line = 0; line < NUM_LINES; ++line)
+        {
+            float* base = lines_.data() + line * static_cast<size_t>(lineSize_);
+            const auto& values = chunk_[line];
+            if (writeIndex_ + count <= lineSize_)
+            {
+                std::copy(values.begin(), values.begin() + count, base + writeIndex_);
+            }
+            else
+            {
+                for (int n = 0; n < count; ++n)
+                    base[(writeIndex_ + n) & mask_] = values[static_cast<size_t>(n)];
+            }
+        }
+        writeIndex_ = (writeIndex_ + count) & mask_;
+    }
+}
+
 // ============ DELAY ============
 
+namespace {
+
+constexpr float kDelayGlideSeconds = 0.08f;   // Read head glide on time/tempo change
+constexpr float kDelayLowpassHz = 6000.0f;    // Repeats darken...
+constexpr float kDelayHighpassHz = 80.0f;     // ...and thin out
+
+// Rational tanh approximation, exact at +-3
+inline float softClip(float x)
+{
+    if (x > 3.0f) return 1.0f;
+    if (x < -3.0f) return -1.0f;
+    return x * (27.0f + x * x) / (27.0f + 9.0f * x * x);
+}
+
+} // anonymous namespace
+
 void Delay::init(double sampleRate)
 {
+    constexpr float PI = 3.14159265f;
     sampleRate_ = sampleRate;
-    int maxDelay = static_cast<int>(sampleRate * 2.0);  // 2 seconds max
-    bufferL_.resize(static_cast<size_t>(maxDelay), 0.0f);
-    bufferR_.resize(static_cast<size_t>(maxDelay), 0.0f);
+
+    int frames = 1;
+    while (frames < static_cast<int>(sampleRate * MAX_SECONDS))
+        frames *= 2;
+    mask_ = frames - 1;
+    buffer_.assign(static_cast<size_t>(frames) * 2, 0.0f);
     writeIndex_ = 0;
+
+    glideCoeff_ = 1.0 - std::exp(-1.0 / (kDelayGlideSeconds * sampleRate));
+    lowpassCoeff_ = 1.0f - std::exp(-2.0f * PI * kDelayLowpassHz / static_cast<float>(sampleRate));
+    highpassCoeff_ = 1.0f - std::exp(-2.0f * PI * kDelayHighpassHz / static_cast<float>(sampleRate));
+    lowpassL_ = lowpassR_ = highpassL_ = highpassR_ = 0.0f;
+
+    updateTarget();
+    delaySamples_ = targetSamples_;  // No glide from nothing
+}
+
+size_t Delay::getAllocatedBytes() const
+{
+    return model::bytesOf(buffer_);
 }
 
 void Delay::setParams(float time, float feedback, float mix)
@@ -125,7 +377,17 @@ void Delay::setParams(float time, float feedback, float mix)
     time_ = time;
     feedback_ = feedback;
     mix_ = mix;
+    updateTarget();
+}
 
+void Delay::setTempo(float bpm)
+{
+    bpm_ = bpm;
+    updateTarget();
+}
+
+void Delay::updateTarget()
+{
     // Calculate delay in samples based on tempo sync
     // time 0-1 maps to common musical divisions including dotted notes:
     // 0.0 = 1/16, 0.15 = 1/8, 0.3 = dotted 1/8, 0.45 = 1/4, 0.6 = dotted 1/4, 0.75 = 1/2, 0.9 = dotted 1/2, 1.0 = 1/1
@@ -146,117 +408,273 @@ void Delay::setParams(float time, float feedback, float mix)
         beatFraction = 3.0f;        // dotted 1/2
     }
 
-    float delaySeconds = (60.0f / bpm_) * beatFraction;
-    delaySamples_ = static_cast<int>(delaySeconds * static_cast<float>(sampleRate_));
-    delaySamples_ = std::clamp(delaySamples_, 1, static_cast<int>(bufferL_.size()) - 1);
-}
-
-void Delay::setTempo(float bpm)
-{
-    bpm_ = bpm;
-    setParams(time_, feedback_, mix_);  // Recalculate delay
+    // Kept fractional - whole samples would drift against the tempo
+    double delaySeconds = (60.0 / std::max(bpm_, 1.0f)) * beatFraction;
+    targetSamples_ = std::clamp(delaySeconds * sampleRate_, 1.0, static_cast<double>(mask_ - 1));
 }
 
-void Delay::process(float& left, float& right)
+void Delay::process(float* left, float* right, int numSamples)
 {
-    int bufSize = static_cast<int>(bufferL_.size());
-    int readIndex = (writeIndex_ - delaySamples_ + bufSize) % bufSize;
+    float* buffer = buffer_.data();
+    const float feedback = feedback_;
 
-    float delayedL = bufferL_[static_cast<size_t>(readIndex)];
-    float delayedR = bufferR_[static_cast<size_t>(readIndex)];
+    // Glide state in locals for the loop
+    double delay = delaySamples_;
+    float lowpassL = lowpassL_, lowpassR = lowpassR_;
+    float highpassL = highpassL_, highpassR = highpassR_;
+    int writeIndex = writeIndex_;
 
-    bufferL_[static_cast<size_t>(writeIndex_)] = left + delayedL * feedback_;
-    bufferR_[static_cast<size_t>(writeIndex_)] = right + delayedR * feedback_;
+    for (int i = 0; i < numSamples; ++i)
+    {
+        delay += (targetSamples_ - delay) * glideCoeff_;
+
+        // Linear interpolation between the two frames around the read head
+        int whole = static_cast<int>(delay);
+        float frac = static_cast<float>(delay - whole);
+        const float* newer = buffer + 2 * ((writeIndex - whole) & mask_);
+        const float* older = buffer + 2 * ((writeIndex - whole - 1) & mask_);
+        float delayedL = newer[0] + frac * (older[0] - newer[0]);
+        float delayedR = newer[1] + frac * (older[1] - newer[1]);
+
+        // Feedback path: lowpass, highpass (lowpass minus a slower lowpass), saturate
+        lowpassL += lowpassCoeff_ * (delayedL - lowpassL);
+        lowpassR += lowpassCoeff_ * (delayedR - lowpassR);
+        highpassL += highpassCoeff_ * (lowpassL - highpassL);
+        highpassR += highpassCoeff_ * (lowpassR - highpassR);
+        float returnL = softClip((lowpassL - highpassL) * feedback);
+        float returnR = softClip((lowpassR - highpassR) * feedback);
+
+        float* frame = buffer + 2 * writeIndex;
+        if (pingPong_)
+        {
+            // Mono in on the left; each repeat crosses to the other side
+            frame[0] = (left[i] + right[i]) * 0.5f + returnR;
+            frame[1] = returnL;
+        }
+        else
+        {
+            frame[0] = left[i] + returnL;
+            frame[1] = right[i] + returnR;
+        }
+        writeIndex = (writeIndex + 1) & mask_;
 
-    writeIndex_ = (writeIndex_ + 1) % bufSize;
+        left[i] = left[i] * (1.0f - mix_) + delayedL * mix_;
+        right[i] = right[i] * (1.0f - mix_) + delayedR * mix_;
+    }
 
-    left = left * (1.0f - mix_) + delayedL * mix_;
-    right = right * (1.0f - mix_) + delayedR * mix_;
+    delaySamples_ = delay;
+    lowpassL_ = lowpassL;
+    lowpassR_ = lowpassR;
+    highpassL_ = highpassL;
+    highpassR_ = highpassR;
+    writeIndex_ = writeIndex;
 }
 
 // ============ CHORUS ============
 
+namespace {
+
+constexpr float kChorusMaxDelaySeconds = 0.025f;
+constexpr float kEnsembleLowpassHz = 8000.0f;  // BBD anti-alias filter
+
+} // anonymous namespace
+
 void Chorus::init(double sampleRate)
 {
     sampleRate_ = sampleRate;
-    int size = static_cast<int>(sampleRate * 0.05);  // 50ms buffer
-    bufferL_.resize(static_cast<size_t>(size), 0.0f);
-    bufferR_.resize(static_cast<size_t>(size), 0.0f);
+
+    int frames = 1;
+    while (frames < static_cast<int>(sampleRate * kChorusMaxDelaySeconds) + 2)
+        frames *= 2;
+    mask_ = frames - 1;
+    buffer_.assign(static_cast<size_t>(frames) * 2, 0.0f);
     writeIndex_ = 0;
-    phase_ = 0.0f;
+
+    slowCos_ = fastCos_ = 1.0f;
+    slowSin_ = fastSin_ = 0.0f;
+    lowpassL_ = lowpassR_ = 0.0f;
+    configure();
+}
+
+size_t Chorus::getAllocatedBytes() const
+{
+    return model::bytesOf(buffer_);
 }
 
 void Chorus::setParams(float rate, float depth, float /*mix*/)
 {
+    // Called every block - only redo the voice setup when something moved
+    if (rate == rate_ && depth == depth_)
+        return;
     rate_ = rate;
     depth_ = depth;
+    configure();
+}
+
+void Chorus::setEnsemble(bool ensemble)
+{
+    if (ensemble == ensemble_)
+        return;
+    ensemble_ = ensemble;
+    configure();
 }
 
-void Chorus::process(float& left, float& right)
+void Chorus::configure()
 {
-    // Classic chorus with multiple voices - outputs 100% wet for send usage
     constexpr float PI = 3.14159265f;
+    const float sr = static_cast<float>(sampleRate_);
 
-    // Three LFOs with different phases for richer chorus
-    float lfo1 = std::sin(phase_ * 2.0f * PI);
-    float lfo2 = std::sin((phase_ + 0.33f) * 2.0f * PI);
-    float lfo3 = std::sin((phase_ + 0.66f) * 2.0f * PI);
-
-    // Update phase - rate controls LFO speed (0.2 - 3 Hz for classic chorus)
-    float freq = 0.2f + rate_ * 2.8f;
-    phase_ += static_cast<float>(freq / sampleRate_);
-    if (phase_ >= 1.0f) phase_ -= 1.0f;
-
-    // Base delay and modulation depth
-    float baseDelay = 0.010f * static_cast<float>(sampleRate_);  // 10ms center
-    float modDepth = depth_ * 0.005f * static_cast<float>(sampleRate_);  // +/- 5ms
-
-    // Three delay taps for each channel
-    float delayL1 = baseDelay + lfo1 * modDepth;
-    float delayL2 = baseDelay * 0.8f + lfo2 * modDepth * 0.7f;
-    float delayR1 = baseDelay + lfo2 * modDepth;  // Different LFO for stereo width
-    float delayR2 = baseDelay * 1.2f + lfo3 * modDepth * 0.8f;
-
-    // Write to buffer
-    bufferL_[static_cast<size_t>(writeIndex_)] = left;
-    bufferR_[static_cast<size_t>(writeIndex_)] = right;
-
-    // Read with cubic interpolation for smoother modulation
-    auto readInterp = [](const std::vector<float>& buf, int writeIdx, float delay) {
-        int size = static_cast<int>(buf.size());
-        float readPos = static_cast<float>(writeIdx) - delay;
-        while (readPos < 0) readPos += static_cast<float>(size);
-
-        int idx0 = static_cast<int>(readPos) % size;
-        int idx1 = (idx0 + 1) % size;
-        float frac = readPos - std::floor(readPos);
-
-        // Linear interpolation (could upgrade to cubic for even smoother)
-        return buf[static_cast<size_t>(idx0)] * (1.0f - frac) + buf[static_cast<size_t>(idx1)] * frac;
+    auto setRate = [sr](float hz, float& stepCos, float& stepSin) {
+        stepCos = std::cos(2.0f * PI * hz / sr);
+        stepSin = std::sin(2.0f * PI * hz / sr);
     };
+    auto setVoice = [this](int voice, int channel, float centre, float slowDepth, float fastDepth, float cycles) {
+        const size_t v = static_cast<size_t>(voice);
+        channel_[v] = channel;
+        centre_[v] = centre;
+        slowDepth_[v] = slowDepth;
+        fastDepth_[v] = fastDepth;
+        offsetCos_[v] = std::cos(2.0f * PI * cycles);
+        offsetSin_[v] = std::sin(2.0f * PI * cycles);
+    };
+
+    if (ensemble_)
+    {
+        // Three voices a third of a cycle apart on each side, the right side
+        // half a voice out from the left. Slow sweep plus fast shimmer
+        setRate(0.5f + rate_ * 1.0f, slowStepCos_, slowStepSin_);
+        setRate(5.0f + rate_ * 3.0f, fastStepCos_, fastStepSin_);
+        float centre = 0.008f * sr;
+        float slowDepth = depth_ * 0.0025f * sr;
+        float fastDepth = depth_ * 0.0004f * sr;
+        for (int i = 0; i < 3; ++i)
+        {
+            setVoice(i, 0, centre, slowDepth, fastDepth, static_cast<float>(i) / 3.0f);
+            setVoice(i + 3, 1, centre, slowDepth, fastDepth, static_cast<float>(i) / 3.0f + 1.0f / 6.0f);
+        }
+        numVoices_ = 6;
+        voiceGain_ = 1.0f / 3.0f;
+        lowpassCoeff_ = 1.0f - std::exp(-2.0f * PI * kEnsembleLowpassHz / sr);
+    }
+    else
+    {
+        // Rate controls LFO speed (0.2 - 3 Hz for classic chorus)
+        setRate(0.2f + rate_ * 2.8f, slowStepCos_, slowStepSin_);
+        fastStepCos_ = 1.0f;
+        fastStepSin_ = 0.0f;
+
+        // 10ms centre, +/- 5ms; voices a third of a cycle apart, with
+        // different LFO phases on each side for stereo width
+        float baseDelay = 0.010f * sr;
+        float modDepth = depth_ * 0.005f * sr;
+        setVoice(0, 0, baseDelay, modDepth, 0.0f, 0.0f);
+        setVoice(1, 0, baseDelay * 0.8f, modDepth * 0.7f, 0.0f, 0.33f);
+        setVoice(2, 1, baseDelay, modDepth, 0.0f, 0.33f);
+        setVoice(3, 1, baseDelay * 1.2f, modDepth * 0.8f, 0.0f, 0.66f);
+        numVoices_ = 4;
+        voiceGain_ = 0.5f;
+        lowpassCoeff_ = 1.0f;
+    }
+}
 
-    // Mix multiple chorus voices
-    float chorusL = (readInterp(bufferL_, writeIndex_, delayL1) +
-                     readInterp(bufferL_, writeIndex_, delayL2)) * 0.5f;
-    float chorusR = (readInterp(bufferR_, writeIndex_, delayR1) +
-                     readInterp(bufferR_, writeIndex_, delayR2)) * 0.5f;
+void Chorus::process(float* left, float* right, int numSamples)
+{
+    float* buffer = buffer_.data();
+    const int numVoices = numVoices_;
 
-    writeIndex_ = (writeIndex_ + 1) % static_cast<int>(bufferL_.size());
+    float slowCos = slowCos_, slowSin = slowSin_;
+    float fastCos = fastCos_, fastSin = fastSin_;
+    float lowpassL = lowpassL_, lowpassR = lowpassR_;
+    int writeIndex = writeIndex_;
 
-    // Output 100% wet signal (send level controls mix externally)
-    left = chorusL;
-    right = chorusR;
+    std::array<float, MAX_VOICES> taps{};
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        float* frame = buffer + 2 * writeIndex;
+        frame[0] = left[i];
+        frame[1] = right[i];
+
+        // Each voice's LFO value is its phase offset applied to the shared
+        // oscillators: sin(a + b) = sin(a)cos(b) + cos(a)sin(b)
+        for (int v = 0; v < numVoices; ++v)
+        {
+            const size_t k = static_cast<size_t>(v);
+            float slow = slowSin * offsetCos_[k] + slowCos * offsetSin_[k];
+            float fast = fastSin * offsetCos_[k] + fastCos * offsetSin_[k];
+            float delay = centre_[k] + slow * slowDepth_[k] + fast * fastDepth_[k];
+
+            int whole = static_cast<int>(delay);
+            float frac = delay - static_cast<float>(whole);
+            const int channel = channel_[k];
+            float newer = buffer[2 * ((writeIndex - whole) & mask_) + channel];
+            float older = buffer[2 * ((writeIndex - whole - 1) & mask_) + channel];
+            taps[k] = newer + frac * (older - newer);
+        }
+
+        float wetL = 0.0f;
+        float wetR = 0.0f;
+        for (int v = 0; v < numVoices; ++v)
+        {
+            if (channel_[static_cast<size_t>(v)] == 0)
+                wetL += taps[static_cast<size_t>(v)];
+            else
+                wetR += taps[static_cast<size_t>(v)];
+        }
+
+        lowpassL += lowpassCoeff_ * (wetL * voiceGain_ - lowpassL);
+        lowpassR += lowpassCoeff_ * (wetR * voiceGain_ - lowpassR);
+
+        // Output 100% wet signal (send level controls mix externally)
+        left[i] = lowpassL;
+        right[i] = lowpassR;
+
+        writeIndex = (writeIndex + 1) & mask_;
+
+        float c = slowCos * slowStepCos_ - slowSin * slowStepSin_;
+        slowSin = slowSin * slowStepCos_ + slowCos * slowStepSin_;
+        slowCos = c;
+        c = fastCos * fastStepCos_ - fastSin * fastStepSin_;
+        fastSin = fastSin * fastStepCos_ + fastCos * fastStepSin_;
+        fastCos = c;
+    }
+
+    // Keep the oscillators on the unit circle
+    float norm = 1.0f / std::sqrt(slowCos * slowCos + slowSin * slowSin);
+    slowCos_ = slowCos * norm;
+    slowSin_ = slowSin * norm;
+    norm = 1.0f / std::sqrt(fastCos * fastCos + fastSin * fastSin);
+    fastCos_ = fastCos * norm;
+    fastSin_ = fastSin * norm;
+
+    lowpassL_ = lowpassL;
+    lowpassR_ = lowpassR;
+    writeIndex_ = writeIndex;
 }
 
 // ============ DRIVE ============
 
+namespace {
+
+// tanh to within 1e-4 (7th-order Lambert continued fraction), branch-free
+// so the shaping loop vectorises
+inline float fastTanh(float x)
+{
+    x = std::clamp(x, -4.97f, 4.97f);
+    float x2 = x * x;
+    return x * (135135.0f + x2 * (17325.0f + x2 * (378.0f + x2)))
+             / (135135.0f + x2 * (62370.0f + x2 * (3150.0f + x2 * 28.0f)));
+}
+
+} // anonymous namespace
+
 void Drive::init(double sampleRate)
 {
     sampleRate_ = sampleRate;
     lpStateL_ = 0.0f;
     lpStateR_ = 0.0f;
-    hpStateL_ = 0.0f;
-    hpStateR_ = 0.0f;
+    currentGain_ = gain_;
+    currentTone_ = tone_;
 }
 
 void Drive::setParams(float gain, float tone)
@@ -265,54 +683,68 @@ void Drive::setParams(float gain, float tone)
     tone_ = tone;
 }
 
-void Drive::process(float& left, float& right)
+void Drive::process(float* left, float* right, int numSamples)
 {
     // Aggressive tube-style saturation with asymmetric clipping
     // Outputs 100% processed signal for send usage
+    if (numSamples <= 0)
+        return;
 
     // Pre-gain (1x to 20x) - more aggressive range for heavy distortion
-    float preGain = 1.0f + gain_ * 19.0f;
+    // Tone control: low-pass filter (darker when tone is low)
+    // Higher tone = more highs preserved
+    // Mix based on tone: low tone = more filtered, high tone = more original saturation
+    // Light makeup gain - let it get louder at high drive for more impact
+    struct Settings { float preGain, lpCoeff, toneBlend, makeupGain; };
+    auto settingsFor = [](float gain, float tone) {
+        return Settings{1.0f + gain * 19.0f,
+                        0.15f + tone * 0.8f,         // 0.15 to 0.95
+                        tone * 0.6f + 0.4f,          // 0.4 to 1.0
+                        1.0f / (1.0f + gain * 0.3f)};
+    };
+    const Settings from = settingsFor(currentGain_, currentTone_);
+    const Settings to = settingsFor(gain_, tone_);
+    currentGain_ = gain_;
+    currentTone_ = tone_;
 
-    // Asymmetric soft saturation (tube-like) with extra harmonics
+    const float n = static_cast<float>(numSamples);
+    const float preGainStep = (to.preGain - from.preGain) / n;
+
+    // Asymmetric soft saturation (tube-like) with extra harmonics. No state,
+    // so this pass runs over the whole block
     auto saturate = [](float x, float drive) {
         x *= drive;
         // Add subtle odd harmonics before main saturation
         float harmonic = x + 0.1f * x * x * x;
-        // Asymmetric waveshaper - positive side clips harder
-        if (harmonic > 0.0f) {
-            // Harder positive clipping (tube-like)
-            return std::tanh(harmonic * 1.5f);
-        } else {
-            // Softer negative clipping for asymmetry
-            return std::tanh(harmonic * 1.1f);
-        }
+        // Asymmetric waveshaper - positive side clips harder (tube-like)
+        return fastTanh(harmonic * (harmonic > 0.0f ? 1.5f : 1.1f));
     };
+    for (int i = 0; i < numSamples; ++i)
+    {
+        float preGain = from.preGain + preGainStep * static_cast<float>(i + 1);
+        left[i] = saturate(left[i], preGain);
+        right[i] = saturate(right[i], preGain);
+    }
 
-    float satL = saturate(left, preGain);
-    float satR = saturate(right, preGain);
-
-    // Tone control: low-pass filter (darker when tone is low)
-    // Higher tone = more highs preserved
-    float lpCoeff = 0.15f + tone_ * 0.8f;  // 0.15 to 0.95
-    lpStateL_ += lpCoeff * (satL - lpStateL_);
-    lpStateR_ += lpCoeff * (satR - lpStateR_);
-
-    // High-pass to remove DC offset from asymmetric clipping
-    float hpCoeff = 0.995f;
-    hpStateL_ = hpCoeff * (hpStateL_ + satL - lpStateL_);
-    hpStateR_ = hpCoeff * (hpStateR_ + satR - lpStateR_);
-
-    // Mix based on tone: low tone = more filtered, high tone = more original saturation
-    float toneBlend = tone_ * 0.6f + 0.4f;  // 0.4 to 1.0
-    left = lpStateL_ * (1.0f - toneBlend) + satL * toneBlend;
-    right = lpStateR_ * (1.0f - toneBlend) + satR * toneBlend;
-
-    // Light makeup gain - let it get louder at high drive for more impact
-    // Only compensate slightly to prevent extreme clipping
-    float makeupGain = 1.0f / (1.0f + gain_ * 0.3f);
-
-    left *= makeupGain;
-    right *= makeupGain;
+    // Tone filter, blend and makeup
+    const float lpStep = (to.lpCoeff - from.lpCoeff) / n;
+    const float blendStep = (to.toneBlend - from.toneBlend) / n;
+    const float makeupStep = (to.makeupGain - from.makeupGain) / n;
+    float lpL = lpStateL_, lpR = lpStateR_;
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float t = static_cast<float>(i + 1);
+        const float lpCoeff = from.lpCoeff + lpStep * t;
+        const float toneBlend = from.toneBlend + blendStep * t;
+        const float makeupGain = from.makeupGain + makeupStep * t;
+
+        lpL += lpCoeff * (left[i] - lpL);
+        lpR += lpCoeff * (right[i] - lpR);
+        left[i] = (lpL * (1.0f - toneBlend) + left[i] * toneBlend) * makeupGain;
+        right[i] = (lpR * (1.0f - toneBlend) + right[i] * toneBlend) * makeupGain;
+    }
+    lpStateL_ = lpL;
+    lpStateR_ = lpR;
 }
 
 // ============ SIDECHAIN ============
@@ -321,6 +753,7 @@ void Sidechain::init(double sampleRate)
 {
     sampleRate_ = sampleRate;
     envelope_ = 0.0f;
+    envelopeStart_ = 0.0f;
 }
 
 void Sidechain::setParams(float attack, float release, float ratio)
@@ -330,28 +763,22 @@ void Sidechain::setParams(float attack, float release, float ratio)
     ratio_ = std::clamp(ratio, 0.0f, 1.0f);
 }
 
-void Sidechain::feedSource(float sourceLevel)
+void Sidechain::processKey(float peak, int numSamples)
 {
-    // Envelope follower - follow the source audio level
-    float target = std::abs(sourceLevel);
-
-    // Use different coefficients for attack and release
-    float coeff = (target > envelope_) ? attack_ : release_;
-
-    // Smooth envelope following
-    float alpha = 1.0f - std::exp(-1.0f / (coeff * static_cast<float>(sampleRate_)));
-    envelope_ = envelope_ + alpha * (target - envelope_);
+    // Envelope follower, stepped a whole block at a time: the same curve as
+    // stepping each sample towards the block's peak
+    envelopeStart_ = envelope_;
+    float coeff = (peak > envelope_) ? attack_ : release_;
+    float alpha = 1.0f - std::exp(-static_cast<float>(numSamples) / (coeff * static_cast<float>(sampleRate_)));
+    envelope_ = envelope_ + alpha * (peak - envelope_);
 }
 
-void Sidechain::process(float& left, float& right)
+void Sidechain::getGains(float amount, float& start, float& end) const
 {
-    // Apply ducking based on envelope and ratio
     // ratio_ controls how much to duck (0 = no ducking, 1 = full duck)
-    float gain = 1.0f - envelope_ * ratio_;
-    gain = std::max(0.0f, gain);  // Clamp to non-negative
-
-    left *= gain;
-    right *= gain;
+    const float depth = ratio_ * std::clamp(amount, 0.0f, 1.0f);
+    start = std::max(0.0f, 1.0f - envelopeStart_ * depth);
+    end = std::max(0.0f, 1.0f - envelope_ * depth);
 }
 
 // ============ EFFECTS PROCESSOR ============
@@ -359,6 +786,7 @@ void Sidechain::process(float& left, float& right)
 void EffectsProcessor::init(double sampleRate)
 {
     reverb.init(sampleRate);
+    fdnReverb.init(sampleRate);
     delay.init(sampleRate);
     chorus.init(sampleRate);
     drive.init(sampleRate);
@@ -369,6 +797,7 @@ void EffectsProcessor::init(double sampleRate)
     // Default settings - good starting points
     // Note: mix parameter is ignored now since effects output 100% wet
     reverb.setParams(0.7f, 0.3f, 1.0f);   // Larger room, less damping for natural sound
+    fdnReverb.setParams(0.7f, 0.3f);
     delay.setParams(0.65f, 0.55f, 1.0f);  // Dotted crotchet, feedback for 3+ repeats
     chorus.setParams(0.4f, 0.6f, 1.0f);   // Moderate rate, good depth
     drive.setParams(0.3f, 0.6f);          // Moderate drive, brighter tone
@@ -381,56 +810,44 @@ void EffectsProcessor::setTempo(float bpm)
     delay.setTempo(bpm);
 }
 
-void EffectsProcessor::process(float& left, float& right,
-                               float reverbSend, float delaySend, float chorusSend)
+size_t EffectsProcessor::getAllocatedBytes() const
 {
-    // Send-based mixing: dry signal preserved, wet signal added on top
-    // Full send (1.0) = 100% wet mixed with dry
-    float dryL = left;
-    float dryR = right;
-
-    // Accumulate wet signals from all effects
-    float wetL = 0.0f;
-    float wetR = 0.0f;
-
-    // Reverb send
-    if (reverbSend > 0.001f)
-    {
-        float tempL = dryL;
-        float tempR = dryR;
-        reverb.process(tempL, tempR);  // Returns 100% wet
-        wetL += tempL * reverbSend;
-        wetR += tempR * reverbSend;
-    }
-
-    // Delay send
-    if (delaySend > 0.001f)
-    {
-        float tempL = dryL;
-        float tempR = dryR;
-        delay.process(tempL, tempR);  // Returns 100% wet
-        wetL += tempL * delaySend;
-        wetR += tempR * delaySend;
-    }
+    return reverb.getAllocatedBytes() + fdnReverb.getAllocatedBytes()
+         + delay.getAllocatedBytes() + chorus.getAllocatedBytes();
+}
 
-    // Chorus send
-    if (chorusSend > 0.001f)
+void EffectsProcessor::processReturn(Return effect, float* left, float* right, int numSamples)
+{
+    // The engine mixes the sends into each return and the returns into the
+    // master. Drive is per-instrument in ChannelStrip; the sidechain is
+    // applied by the engine where each ducked channel is mixed in
+    switch (effect)
     {
-        float tempL = dryL;
-        float tempR = dryR;
-        chorus.process(tempL, tempR);  // Returns 100% wet
-        wetL += tempL * chorusSend;
-        wetR += tempR * chorusSend;
+        case Return::Reverb:
+            if (convolution)
+            {
+                for (int i = 0; i < numSamples; ++i)
+                    convolution->process(left[i], right[i]);
+            }
+            else if (reverbType == ReverbType::Fdn)
+            {
+                fdnReverb.process(left, right, numSamples);
+            }
+            else
+            {
+                for (int i = 0; i < numSamples; ++i)
+                    reverb.process(left[i], right[i]);
+            }
+            break;
+
+        case Return::Delay:
+            delay.process(left, right, numSamples);
+            break;
+
+        case Return::Chorus:
+            chorus.process(left, right, numSamples);
+            break;
     }
-
-    // Mix dry + wet
-    left = dryL + wetL;
-    right = dryR + wetR;
-
-    // Note: Drive is now per-instrument in ChannelStrip, not a master bus send
-    // Note: Sidechain is now handled separately in AudioEngine
-    // Call sidechain.feedSource() with source instrument audio
-    // Then sidechain.process() to apply ducking
 }
 
 void EffectsProcessor::processMaster(float& left, float& right)
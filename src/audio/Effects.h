@@ -1,11 +1,14 @@
 #pragma once
 
+#include "../model/MemoryUsage.h"
 #include <array>
 #include <cmath>
 #include <vector>
 
 namespace audio {
 
+class ConvolutionReverb;
+
 // Simple reverb using Schroeder algorithm
 class Reverb
 {
@@ -13,6 +16,7 @@ public:
     void init(double sampleRate);
     void setParams(float size, float damping, float mix);
     void process(float& left, float& right);
+    size_t getAllocatedBytes() const;  // Delay lines (see model/MemoryUsage.h)
 
 private:
     static constexpr int NUM_COMBS = 4;
@@ -31,45 +35,148 @@ private:
     float damping_ = 0.5f;
 };
 
-// Tempo-synced delay
+// Feedback delay network reverb: 8 delay lines fed back through a Hadamard
+// matrix, with slowly modulated read taps and per-line damping. All lines
+// share one allocation and are power-of-two sized, so indexing is a mask.
+// Works in chunks shorter than the shortest line, so each line's taps for a
+// chunk are read (and written back) in one pass.
+class FdnReverb
+{
+public:
+    static constexpr int NUM_LINES = 8;
+    static constexpr int CHUNK = 64;
+
+    void init(double sampleRate);
+    void setParams(float size, float damping);
+
+    // Mono sum in, 100% wet stereo out, in place
+    void process(float* left, float* right, int numSamples);
+    size_t getAllocatedBytes() const;  // Delay lines (see model/MemoryUsage.h)
+
+private:
+    void updateGains();
+
+    std::vector<float> lines_;  // NUM_LINES x lineSize_
+    int lineSize_ = 0;
+    int mask_ = 0;
+    int writeIndex_ = 0;
+
+    std::array<float, NUM_LINES> delays_{};   // Samples
+    std::array<float, NUM_LINES> gains_{};    // Per-line decay, matrix scale folded in
+    std::array<float, NUM_LINES> lowpass_{};  // Damping filter state
+
+    // Taps read for the current chunk, then the values to write back
+    std::array<std::array<float, CHUNK>, NUM_LINES> chunk_{};
+
+    // One LFO, phase-offset per line; evaluated once per chunk
+    std::array<float, NUM_LINES> modCos_{};
+    std::array<float, NUM_LINES> modSin_{};
+    float modDepth_ = 0.0f;
+    float lfoPhase_ = 0.0f;
+    float lfoIncrement_ = 0.0f;
+    float lfoCos_ = 1.0f;
+    float lfoSin_ = 0.0f;
+
+    double sampleRate_ = 48000.0;
+    float size_ = -1.0f;
+    float damping_ = 0.5f;
+};
+
+enum class ReverbType { Schroeder = 0, Fdn = 1 };
+
+// Tempo-synced delay. The read head is fractional and glides to a new time
+// (tape-style) instead of jumping, so tempo and time changes don't click.
+// Repeats are filtered and softly saturated on the way round.
 class Delay
 {
 public:
+    static constexpr float MAX_SECONDS = 4.0f;
+
     void init(double sampleRate);
     void setParams(float time, float feedback, float mix);
     void setTempo(float bpm);
-    void process(float& left, float& right);
+    void setPingPong(bool pingPong) { pingPong_ = pingPong; }
+
+    // 100% wet, in place
+    void process(float* left, float* right, int numSamples);
+    size_t getAllocatedBytes() const;  // Delay lines (see model/MemoryUsage.h)
 
 private:
-    std::vector<float> bufferL_;
-    std::vector<float> bufferR_;
+    void updateTarget();
+
+    // Interleaved stereo frames, power-of-two sized so indexing is a mask
+    std::vector<float> buffer_;
+    int mask_ = 0;
     int writeIndex_ = 0;
-    int delaySamples_ = 0;
+
+    double delaySamples_ = 1.0;   // Where the read head is
+    double targetSamples_ = 1.0;  // Where it is heading
+    double glideCoeff_ = 0.0;
+
+    // Feedback path filters
+    float lowpassCoeff_ = 0.0f;
+    float highpassCoeff_ = 0.0f;
+    float lowpassL_ = 0.0f;
+    float lowpassR_ = 0.0f;
+    float highpassL_ = 0.0f;
+    float highpassR_ = 0.0f;
 
     double sampleRate_ = 48000.0;
     float time_ = 0.5f;  // 0-1 maps to 1/16 - 1/1
     float feedback_ = 0.4f;
     float mix_ = 0.3f;
     float bpm_ = 120.0f;
+    bool pingPong_ = false;
 };
 
-// Simple chorus
+// Chorus: two modulated voices per side, or in ensemble mode three per side
+// on a slow plus a fast LFO with a BBD-style lowpass (string-machine style).
+// The LFOs are recursive oscillators, so there is no trig per sample.
 class Chorus
 {
 public:
+    static constexpr int MAX_VOICES = 6;
+
     void init(double sampleRate);
     void setParams(float rate, float depth, float mix);
-    void process(float& left, float& right);
+    void setEnsemble(bool ensemble);
+
+    // 100% wet, in place
+    void process(float* left, float* right, int numSamples);
+    size_t getAllocatedBytes() const;  // Delay lines (see model/MemoryUsage.h)
 
 private:
-    std::vector<float> bufferL_;
-    std::vector<float> bufferR_;
+    void configure();
+
+    // Interleaved stereo frames, power-of-two sized so indexing is a mask
+    std::vector<float> buffer_;
+    int mask_ = 0;
     int writeIndex_ = 0;
-    float phase_ = 0.0f;
+
+    // Per voice: the channel it reads, centre delay and modulation depths
+    // (samples), and its phase offset on each LFO
+    int numVoices_ = 0;
+    std::array<int, MAX_VOICES> channel_{};
+    std::array<float, MAX_VOICES> centre_{};
+    std::array<float, MAX_VOICES> slowDepth_{};
+    std::array<float, MAX_VOICES> fastDepth_{};
+    std::array<float, MAX_VOICES> offsetCos_{};
+    std::array<float, MAX_VOICES> offsetSin_{};
+    float voiceGain_ = 0.5f;
+
+    // LFOs as (cos, sin) pairs, rotated by a fixed step each sample
+    float slowCos_ = 1.0f, slowSin_ = 0.0f, slowStepCos_ = 1.0f, slowStepSin_ = 0.0f;
+    float fastCos_ = 1.0f, fastSin_ = 0.0f, fastStepCos_ = 1.0f, fastStepSin_ = 0.0f;
+
+    // Ensemble output filter (bypassed when the coefficient is 1)
+    float lowpassCoeff_ = 1.0f;
+    float lowpassL_ = 0.0f;
+    float lowpassR_ = 0.0f;
 
     double sampleRate_ = 48000.0;
     float rate_ = 0.5f;
     float depth_ = 0.5f;
+    bool ensemble_ = false;
 };
 
 // Tube-style saturation drive
@@ -78,16 +185,18 @@ class Drive
 public:
     void init(double sampleRate);
     void setParams(float gain, float tone);
-    void process(float& left, float& right);
+
+    // In place. Gain and tone changes are ramped across the block
+    void process(float* left, float* right, int numSamples);
 
 private:
     double sampleRate_ = 48000.0;
     float gain_ = 0.5f;
     float tone_ = 0.5f;
+    float currentGain_ = 0.5f;  // Where the last block's ramp ended
+    float currentTone_ = 0.5f;
     float lpStateL_ = 0.0f;
     float lpStateR_ = 0.0f;
-    float hpStateL_ = 0.0f;
-    float hpStateR_ = 0.0f;
 };
 
 // DJ-style bipolar filter: negative = lowpass, positive = highpass, 0 = bypass
@@ -129,18 +238,22 @@ private:
     float gainReduction_ = 0.0f;  // For metering
 };
 
-// Sidechain compressor - follows audio level from source instrument
+// Follows the mixer's sidechain key once per block. The engine mixes every
+// keying channel into the key, hands over its peak, then ducks each ducked
+// channel where it is mixed in, ramping the gain across the block
 class Sidechain
 {
 public:
     void init(double sampleRate);
     void setParams(float attack, float release, float ratio);
 
-    // Feed in the source signal level each sample
-    void feedSource(float sourceLevel);
+    // Once per block, with the key's peak level (0 while nothing keys it, so
+    // the ducking releases)
+    void processKey(float peak, int numSamples);
 
-    // Process audio with ducking based on source envelope
-    void process(float& left, float& right);
+    // Gain at the start and end of this block for a channel ducked by amount
+    // (0-1, times the mixer's ratio)
+    void getGains(float amount, float& start, float& end) const;
 
     // Get current envelope for visualization
     float getEnvelope() const { return envelope_; }
@@ -148,6 +261,7 @@ public:
 private:
     double sampleRate_ = 48000.0;
     float envelope_ = 0.0f;
+    float envelopeStart_ = 0.0f;  // Envelope at the start of this block
     float attack_ = 0.005f;    // 5ms attack
     float release_ = 0.2f;     // 200ms release
     float ratio_ = 0.7f;       // How much to duck (0=none, 1=full)
@@ -161,6 +275,9 @@ public:
     void setTempo(float bpm);
 
     Reverb reverb;
+    FdnReverb fdnReverb;
+    ReverbType reverbType = ReverbType::Fdn;
+    ConvolutionReverb* convolution = nullptr;  // Replaces reverb while an IR is loaded (not owned)
     Delay delay;
     Chorus chorus;
     Drive drive;
@@ -168,12 +285,15 @@ public:
     DJFilter djFilter;
     Limiter limiter;
 
-    // Process audio with send levels (sidechain handled separately)
-    void process(float& left, float& right,
-                 float reverbSend, float delaySend, float chorusSend);
+    // The send effects, each run as a return: 100% wet, in place
+    enum class Return { Reverb, Delay, Chorus };
+    void processReturn(Return effect, float* left, float* right, int numSamples);
 
     // Process master bus effects (DJ filter + limiter)
     void processMaster(float& left, float& right);
+
+    // The effects' delay lines - not the convolution reverb, owned elsewhere
+    size_t getAllocatedBytes() const;
 };
 
 } // namespace audio
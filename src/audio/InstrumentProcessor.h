@@ -7,10 +7,9 @@
 
 namespace audio {
 
-// Forward declaration
-class Voice;
-
 // Base class for all instrument types (Plaits, Sampler, etc.)
+// Track voices don't go through it: the engine renders them through the
+// concrete, final instrument types (see TrackVoice.h)
 class InstrumentProcessor
 {
 public:
@@ -20,14 +19,6 @@ public:
     virtual void init(double sampleRate) = 0;
     virtual void setSampleRate(double sampleRate) = 0;
 
-    // Voice-per-track interface
-    // Create a new voice instance for a track
-    virtual std::unique_ptr<Voice> createVoice() = 0;
-
-    // Update voice parameters from current instrument state
-    // Called before processing to sync voice with instrument params
-    virtual void updateVoiceParameters(Voice* voice) = 0;
-
     // Note handling (legacy - will be removed in later tasks)
     virtual void noteOn(int note, float velocity) = 0;
     virtual void noteOff(int note) = 0;
@@ -0,0 +1,195 @@
+#include "JackStemPorts.h"
+
+#if JUCE_LINUX && JUCE_JACK
+#include <jack/jack.h>
+#endif
+
+namespace audio {
+
+JackStemPorts::~JackStemPorts()
+{
+    close();
+}
+
+void JackStemPorts::write(const juce::AudioBuffer<float>& stems, int numSamples)
+{
+    if (!isOpen())
+        return;
+
+    // The whole block or none of it, so the ports never skip within a period
+    int start1, size1, start2, size2;
+    fifo_.prepareToWrite(numSamples, start1, size1, start2, size2);
+    if (size1 + size2 < numSamples)
+        return;
+
+    for (int ch = 0; ch < fifoBuffer_.getNumChannels(); ++ch)
+    {
+        if (ch >= stems.getNumChannels())
+        {
+            fifoBuffer_.clear(ch, start1, size1);
+            if (size2 > 0)
+                fifoBuffer_.clear(ch, start2, size2);
+            continue;
+        }
+        fifoBuffer_.copyFrom(ch, start1, stems, ch, 0, size1);
+        if (size2 > 0)
+            fifoBuffer_.copyFrom(ch, start2, stems, ch, size1, size2);
+    }
+    fifo_.finishedWrite(size1 + size2);
+}
+
+#if JUCE_LINUX && JUCE_JACK
+
+namespace {
+
+using ClientOpenFn = jack_client_t* (*)(const char*, jack_options_t, jack_status_t*, ...);
+using ClientCloseFn = int (*)(jack_client_t*);
+using ActivateFn = int (*)(jack_client_t*);
+using OnShutdownFn = void (*)(jack_client_t*, JackShutdownCallback, void*);
+using SetProcessCallbackFn = int (*)(jack_client_t*, JackProcessCallback, void*);
+using PortRegisterFn = jack_port_t* (*)(jack_client_t*, const char*, const char*, unsigned long, unsigned long);
+using PortGetBufferFn = void* (*)(jack_port_t*, jack_nframes_t);
+
+} // anonymous namespace
+
+bool JackStemPorts::open(int numInstruments)
+{
+    if (isOpen())
+        return true;
+
+    if (!library_.open("libjack.so.0") && !library_.open("libjack.so"))
+        return false;
+
+    auto clientOpen = reinterpret_cast<ClientOpenFn>(library_.getFunction("jack_client_open"));
+    auto activate = reinterpret_cast<ActivateFn>(library_.getFunction("jack_activate"));
+    auto onShutdownFn = reinterpret_cast<OnShutdownFn>(library_.getFunction("jack_on_shutdown"));
+    auto setProcess = reinterpret_cast<SetProcessCallbackFn>(library_.getFunction("jack_set_process_callback"));
+    auto portRegister = reinterpret_cast<PortRegisterFn>(library_.getFunction("jack_port_register"));
+    getBufferFn_ = library_.getFunction("jack_port_get_buffer");
+    if (!clientOpen || !activate || !onShutdownFn || !setProcess || !portRegister || !getBufferFn_)
+    {
+        library_.close();
+        return false;
+    }
+
+    jack_status_t status;
+    auto* client = clientOpen("Vitracker Stems", JackNoStartServer, &status);
+    if (!client)
+    {
+        library_.close();
+        return false;
+    }
+    client_ = client;
+
+    // Instruments are numbered in hex, as on the instrument screen
+    for (int i = 0; i < numInstruments; ++i)
+    {
+        const auto prefix = "inst_" + juce::String::toHexString(i).paddedLeft('0', 2).toUpperCase();
+        for (const char* side : {"_L", "_R"})
+        {
+            auto* port = portRegister(client, (prefix + side).toRawUTF8(), JACK_DEFAULT_AUDIO_TYPE,
+                                      JackPortIsOutput, 0);
+            if (!port)
+            {
+                close();
+                return false;
+            }
+            ports_.push_back(port);
+        }
+    }
+    numInstruments_ = numInstruments;
+
+    fifoBuffer_.setSize(numInstruments * 2, kFifoSize);
+    fifoBuffer_.clear();
+    fifo_.reset();
+    primed_ = false;
+
+    setProcess(client, &JackStemPorts::onProcess, this);
+    onShutdownFn(client, &JackStemPorts::onShutdown, this);
+    if (activate(client) != 0)
+    {
+        close();
+        return false;
+    }
+
+    open_.store(true, std::memory_order_release);
+    DBG("JACK stem ports: " << numInstruments << " instruments");
+    return true;
+}
+
+void JackStemPorts::close()
+{
+    open_.store(false, std::memory_order_release);
+
+    // Closing deactivates the client and waits out its process callback
+    if (client_)
+    {
+        if (auto closeFn = reinterpret_cast<ClientCloseFn>(library_.getFunction("jack_client_close")))
+            closeFn(static_cast<jack_client_t*>(client_));
+        client_ = nullptr;
+    }
+    ports_.clear();
+    numInstruments_ = 0;
+    library_.close();
+}
+
+int JackStemPorts::onProcess(jack_nframes_t numFrames, void* arg)
+{
+    static_cast<JackStemPorts*>(arg)->process(static_cast<int>(numFrames));
+    return 0;
+}
+
+void JackStemPorts::process(int numFrames)
+{
+    auto getBuffer = reinterpret_cast<PortGetBufferFn>(getBufferFn_);
+
+    // Hold a period back before starting (and again after running dry), and
+    // drop anything beyond two periods, so the lag stays bounded whichever
+    // client the server runs first
+    int ready = fifo_.getNumReady();
+    if (ready > 3 * numFrames)
+    {
+        fifo_.finishedRead(ready - 2 * numFrames);
+        ready = 2 * numFrames;
+    }
+    if (!primed_ && ready >= 2 * numFrames)
+        primed_ = true;
+
+    int start1 = 0, size1 = 0, start2 = 0, size2 = 0;
+    if (primed_)
+        fifo_.prepareToRead(numFrames, start1, size1, start2, size2);
+
+    for (size_t ch = 0; ch < ports_.size(); ++ch)
+    {
+        auto* out = static_cast<float*>(getBuffer(static_cast<jack_port_t*>(ports_[ch]),
+                                                  static_cast<jack_nframes_t>(numFrames)));
+        const auto channel = static_cast<int>(ch);
+        juce::FloatVectorOperations::copy(out, fifoBuffer_.getReadPointer(channel, start1), size1);
+        juce::FloatVectorOperations::copy(out + size1, fifoBuffer_.getReadPointer(channel, start2), size2);
+        juce::FloatVectorOperations::clear(out + size1 + size2, numFrames - size1 - size2);
+    }
+
+    if (!primed_)
+        return;
+    fifo_.finishedRead(size1 + size2);
+    if (size1 + size2 < numFrames)
+        primed_ = false;  // Ran dry (the engine stopped) - re-prime
+}
+
+void JackStemPorts::onShutdown(void* arg)
+{
+    // Server went away: the client handle is dead
+    static_cast<JackStemPorts*>(arg)->open_.store(false, std::memory_order_release);
+}
+
+#else
+
+bool JackStemPorts::open(int) { return false; }
+void JackStemPorts::close() {}
+int JackStemPorts::onProcess(uint32_t, void*) { return 0; }
+void JackStemPorts::process(int) {}
+void JackStemPorts::onShutdown(void*) {}
+
+#endif
+
+} // namespace audio
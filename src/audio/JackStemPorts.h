@@ -0,0 +1,58 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+#include <vector>
+
+namespace audio {
+
+// Per-instrument stem outputs as ports of their own JACK client
+// ("Vitracker Stems:inst_00_L", ...), independent of how many physical ports
+// the server has. They are never connected - patch them where you need them.
+//
+// The engine renders stems in JUCE's JACK callback and hands them over with
+// write(); this client's process callback plays them out of a FIFO. The two
+// clients may run in either order within a cycle, so stems are held back to
+// keep them steady: they lag the main outputs by one to two periods.
+// Always unavailable on platforms without JACK.
+class JackStemPorts
+{
+public:
+    JackStemPorts() = default;
+    ~JackStemPorts();
+
+    // Message thread. Registers a port pair per instrument. False if libjack
+    // or a running server isn't found
+    bool open(int numInstruments);
+    void close();  // Only once the audio callback is gone
+
+    bool isOpen() const { return open_.load(std::memory_order_acquire); }
+    int getNumInstruments() const { return numInstruments_; }
+
+    // Real-time safe (audio thread, a single writer). Channels are L/R per
+    // instrument, as many as getNumInstruments() * 2. Dropped if the ports
+    // have fallen more than the FIFO behind
+    void write(const juce::AudioBuffer<float>& stems, int numSamples);
+
+    static constexpr int kFifoSize = 16384;  // Frames, several periods at any size
+
+private:
+    static int onProcess(uint32_t numFrames, void* arg);
+    static void onShutdown(void* arg);
+    void process(int numFrames);
+
+    juce::DynamicLibrary library_;
+    void* client_ = nullptr;
+    void* getBufferFn_ = nullptr;  // jack_port_get_buffer
+    std::vector<void*> ports_;     // L/R per instrument
+    int numInstruments_ = 0;
+
+    juce::AbstractFifo fifo_{kFifoSize};
+    juce::AudioBuffer<float> fifoBuffer_;
+    bool primed_ = false;  // JACK thread only. Holding a period back
+    std::atomic<bool> open_{false};
+
+    JUCE_DECLARE_NON_COPYABLE(JackStemPorts)
+};
+
+} // namespace audio
@@ -0,0 +1,107 @@
+#include "JackTransport.h"
+
+#if JUCE_LINUX && JUCE_JACK
+#include <jack/jack.h>
+#include <jack/transport.h>
+#endif
+
+namespace audio {
+
+JackTransport::~JackTransport()
+{
+    disconnect();
+}
+
+#if JUCE_LINUX && JUCE_JACK
+
+namespace {
+
+using ClientOpenFn = jack_client_t* (*)(const char*, jack_options_t, jack_status_t*, ...);
+using ClientCloseFn = int (*)(jack_client_t*);
+using ActivateFn = int (*)(jack_client_t*);
+using OnShutdownFn = void (*)(jack_client_t*, JackShutdownCallback, void*);
+using TransportQueryFn = jack_transport_state_t (*)(const jack_client_t*, jack_position_t*);
+
+} // anonymous namespace
+
+bool JackTransport::connect()
+{
+    if (isConnected())
+        return true;
+
+    if (!library_.open("libjack.so.0") && !library_.open("libjack.so"))
+        return false;
+
+    auto clientOpen = reinterpret_cast<ClientOpenFn>(library_.getFunction("jack_client_open"));
+    auto activate = reinterpret_cast<ActivateFn>(library_.getFunction("jack_activate"));
+    auto onShutdownFn = reinterpret_cast<OnShutdownFn>(library_.getFunction("jack_on_shutdown"));
+    queryFn_ = library_.getFunction("jack_transport_query");
+    if (!clientOpen || !activate || !onShutdownFn || !queryFn_)
+    {
+        library_.close();
+        return false;
+    }
+
+    // Never start a server just to read its transport
+    jack_status_t status;
+    auto* client = clientOpen("Vitracker Transport", JackNoStartServer, &status);
+    if (!client)
+    {
+        library_.close();
+        return false;
+    }
+
+    onShutdownFn(client, &JackTransport::onShutdown, this);
+    if (activate(client) != 0)
+    {
+        if (auto close = reinterpret_cast<ClientCloseFn>(library_.getFunction("jack_client_close")))
+            close(client);
+        library_.close();
+        return false;
+    }
+
+    client_ = client;
+    connected_.store(true, std::memory_order_release);
+    DBG("Following JACK transport");
+    return true;
+}
+
+void JackTransport::disconnect()
+{
+    connected_.store(false, std::memory_order_release);
+
+    if (client_)
+    {
+        if (auto close = reinterpret_cast<ClientCloseFn>(library_.getFunction("jack_client_close")))
+            close(static_cast<jack_client_t*>(client_));
+        client_ = nullptr;
+    }
+    library_.close();
+}
+
+bool JackTransport::isRolling() const
+{
+    if (!isConnected())
+        return false;
+
+    // jack_transport_query only reads server shared memory - safe in a process callback
+    auto query = reinterpret_cast<TransportQueryFn>(queryFn_);
+    return query(static_cast<const jack_client_t*>(client_), nullptr) == JackTransportRolling;
+}
+
+void JackTransport::onShutdown(void* arg)
+{
+    // Server went away: stop following, the client handle is dead
+    static_cast<JackTransport*>(arg)->connected_.store(false, std::memory_order_release);
+}
+
+#else
+
+bool JackTransport::connect() { return false; }
+void JackTransport::disconnect() {}
+bool JackTransport::isRolling() const { return false; }
+void JackTransport::onShutdown(void*) {}
+
+#endif
+
+} // namespace audio
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+
+namespace audio {
+
+// Follows the JACK transport so Vitracker starts and stops with the other
+// applications on the server. Uses its own small JACK client (libjack is
+// loaded at runtime, as JUCE's JACK backend does), so it works whichever
+// audio device is open. Always unavailable on platforms without JACK.
+class JackTransport
+{
+public:
+    JackTransport() = default;
+    ~JackTransport();
+
+    // Message thread. False if libjack or a running server isn't found
+    bool connect();
+    void disconnect();  // Only once the audio callback is gone
+
+    bool isConnected() const { return connected_.load(std::memory_order_acquire); }
+
+    // Real-time safe (audio thread). False when not connected
+    bool isRolling() const;
+
+private:
+    static void onShutdown(void* arg);
+
+    juce::DynamicLibrary library_;
+    void* client_ = nullptr;
+    void* queryFn_ = nullptr;  // jack_transport_query
+    std::atomic<bool> connected_{false};
+
+    JUCE_DECLARE_NON_COPYABLE(JackTransport)
+};
+
+} // namespace audio
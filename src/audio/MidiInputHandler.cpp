@@ -0,0 +1,224 @@
+#include "MidiInputHandler.h"
+#include <algorithm>
+#include <cmath>
+
+namespace audio {
+
+namespace {
+
+// Audio thread is the only writer, so a plain load/store is enough
+void storeMax(std::atomic<double>& target, double value)
+{
+    if (value > target.load(std::memory_order_relaxed))
+        target.store(value, std::memory_order_relaxed);
+}
+
+} // anonymous namespace
+
+MidiInputHandler::MidiInputHandler()
+{
+    for (auto& instrument : portInstruments_)
+        instrument.store(kFollowSelected, std::memory_order_relaxed);
+}
+
+MidiInputHandler::~MidiInputHandler()
+{
+    detach();
+}
+
+void MidiInputHandler::attach(juce::AudioDeviceManager& deviceManager)
+{
+    detach();
+    deviceManager_ = &deviceManager;
+
+    // A tracker wants whatever keyboard is plugged in - enable every input.
+    // Ports can still be switched off in the Audio/MIDI settings.
+    for (const auto& device : juce::MidiInput::getAvailableDevices())
+        deviceManager.setMidiInputDeviceEnabled(device.identifier, true);
+    deviceManager.addMidiInputDeviceCallback({}, this);
+
+#if JUCE_LINUX || JUCE_MAC
+    // Virtual port so other applications (or aconnect) can play us directly
+    virtualInput_ = juce::MidiInput::createNewDevice("Vitracker", this);
+    if (virtualInput_)
+        virtualInput_->start();
+#endif
+}
+
+void MidiInputHandler::detach()
+{
+    if (virtualInput_)
+    {
+        virtualInput_->stop();
+        virtualInput_.reset();
+    }
+
+    if (deviceManager_)
+    {
+        deviceManager_->removeMidiInputDeviceCallback({}, this);
+        deviceManager_ = nullptr;
+    }
+}
+
+void MidiInputHandler::handleIncomingMidiMessage(juce::MidiInput* source, const juce::MidiMessage& message)
+{
+    // Channel voice messages plus transport; clock, sensing and SysEx are dropped
+    const auto size = message.getRawDataSize();
+    const auto* data = message.getRawData();
+    if (size < 1 || size > 3)
+        return;
+    if (data[0] >= 0xF0 && data[0] != 0xFA && data[0] != 0xFB && data[0] != 0xFC)
+        return;
+
+    const juce::SpinLock::ScopedLockType lock(producerLock_);
+
+    int port = findOrAddPort(source);
+    if (port < 0)
+        return;
+
+    int start1, size1, start2, size2;
+    fifo_.prepareToWrite(1, start1, size1, start2, size2);
+    if (size1 + size2 == 0)
+        return;  // Audio thread stalled; dropping beats blocking the MIDI thread
+
+    auto& event = buffer_[static_cast<size_t>(size1 > 0 ? start1 : start2)];
+    event.time = message.getTimeStamp();
+    event.port = port;
+    for (int i = 0; i < 3; ++i)
+        event.bytes[i] = i < size ? data[i] : 0;
+
+    fifo_.finishedWrite(1);
+}
+
+void MidiInputHandler::injectNote(int note, int velocity)
+{
+    auto message = velocity > 0
+        ? juce::MidiMessage::noteOn(1, note, static_cast<juce::uint8>(velocity))
+        : juce::MidiMessage::noteOff(1, note);
+    message.setTimeStamp(juce::Time::getMillisecondCounterHiRes() * 0.001);
+    handleIncomingMidiMessage(nullptr, message);
+}
+
+int MidiInputHandler::findOrAddPort(juce::MidiInput* source)
+{
+    // Called with producerLock_ held
+    int count = numPorts_.load(std::memory_order_relaxed);
+    for (int i = 0; i < count; ++i)
+    {
+        if (portSources_[static_cast<size_t>(i)] == source)
+            return i;
+    }
+
+    if (count >= kMaxPorts)
+        return -1;
+
+    portSources_[static_cast<size_t>(count)] = source;
+    portNames_[static_cast<size_t>(count)] = source ? source->getName() : juce::String("Computer Keyboard");
+    numPorts_.store(count + 1, std::memory_order_release);
+    return count;
+}
+
+int MidiInputHandler::popEvents(Event* out, int maxEvents, int numSamples, double sampleRate)
+{
+    const double now = juce::Time::getMillisecondCounterHiRes() * 0.001;
+    const double blockSeconds = numSamples / sampleRate;
+
+    if (resetRequested_.exchange(false, std::memory_order_relaxed))
+    {
+        statEvents_.store(0, std::memory_order_relaxed);
+        statLate_.store(0, std::memory_order_relaxed);
+        statLateSumMs_.store(0.0, std::memory_order_relaxed);
+        statMaxLateMs_.store(0.0, std::memory_order_relaxed);
+        statMaxCallbackJitterMs_.store(0.0, std::memory_order_relaxed);
+    }
+
+    if (lastCallbackTime_ > 0.0)
+        storeMax(statMaxCallbackJitterMs_, std::abs((now - lastCallbackTime_) - blockSeconds) * 1000.0);
+    lastCallbackTime_ = now;
+    statLatencyMs_.store(blockSeconds * 1000.0, std::memory_order_relaxed);
+
+    // This block stands for the period that ended 'now'; an event received at
+    // time t goes at the same position it had within that period.
+    const double blockStart = now - blockSeconds;
+
+    int start1, size1, start2, size2;
+    fifo_.prepareToRead(std::min(maxEvents, fifo_.getNumReady()), start1, size1, start2, size2);
+
+    int count = 0;
+    auto convert = [&](int start, int size) {
+        for (int i = 0; i < size; ++i)
+        {
+            const auto& raw = buffer_[static_cast<size_t>(start + i)];
+            auto& event = out[count++];
+
+            double position = (raw.time - blockStart) * sampleRate;
+            if (position < 0.0)
+            {
+                // Missed its slot (late callback or a slow driver): play it now
+                double lateMs = -position / sampleRate * 1000.0;
+                statLate_.store(statLate_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                statLateSumMs_.store(statLateSumMs_.load(std::memory_order_relaxed) + lateMs,
+                                     std::memory_order_relaxed);
+                storeMax(statMaxLateMs_, lateMs);
+                position = 0.0;
+            }
+
+            event.offset = std::min(numSamples - 1, static_cast<int>(position));
+            event.port = raw.port;
+            event.status = raw.bytes[0];
+            event.data1 = raw.bytes[1];
+            event.data2 = raw.bytes[2];
+        }
+    };
+    convert(start1, size1);
+    convert(start2, size2);
+    fifo_.finishedRead(size1 + size2);
+
+    statEvents_.store(statEvents_.load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+
+    // Timestamps from different ports may interleave - keep the block in time order
+    std::stable_sort(out, out + count, [](const Event& a, const Event& b) { return a.offset < b.offset; });
+    return count;
+}
+
+void MidiInputHandler::setPortInstrument(int port, int instrumentIndex)
+{
+    if (port >= 0 && port < kMaxPorts)
+        portInstruments_[static_cast<size_t>(port)].store(instrumentIndex, std::memory_order_relaxed);
+}
+
+int MidiInputHandler::getPortInstrument(int port) const
+{
+    if (port < 0 || port >= kMaxPorts)
+        return kFollowSelected;
+    return portInstruments_[static_cast<size_t>(port)].load(std::memory_order_relaxed);
+}
+
+int MidiInputHandler::resolveInstrument(int port) const
+{
+    int instrument = getPortInstrument(port);
+    return instrument >= 0 ? instrument : selectedInstrument_.load(std::memory_order_relaxed);
+}
+
+juce::String MidiInputHandler::getPortName(int port) const
+{
+    if (port < 0 || port >= getNumPorts())
+        return {};
+    return portNames_[static_cast<size_t>(port)];
+}
+
+MidiInputHandler::JitterStats MidiInputHandler::getStats() const
+{
+    JitterStats stats;
+    stats.events = statEvents_.load(std::memory_order_relaxed);
+    stats.lateEvents = statLate_.load(std::memory_order_relaxed);
+    stats.latencyMs = statLatencyMs_.load(std::memory_order_relaxed);
+    stats.meanLateMs = stats.lateEvents > 0
+        ? statLateSumMs_.load(std::memory_order_relaxed) / stats.lateEvents
+        : 0.0;
+    stats.maxLateMs = statMaxLateMs_.load(std::memory_order_relaxed);
+    stats.maxCallbackJitterMs = statMaxCallbackJitterMs_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+} // namespace audio
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace audio {
+
+// Receives MIDI from hardware ports (and a virtual "Vitracker" port where the
+// platform supports one) and hands timestamped events to the audio thread.
+//
+// MIDI threads push into a fixed-size FIFO; the audio thread pops once per
+// block and converts each device timestamp to a sample offset. Events are
+// placed with a constant latency of one block, so timing between notes is
+// kept exactly unless the audio callback itself runs late.
+class MidiInputHandler : public juce::MidiInputCallback
+{
+public:
+    static constexpr int kMaxPorts = 16;
+    static constexpr int kFifoSize = 1024;
+    static constexpr int kFollowSelected = -1;  // Port plays the selected instrument
+
+    struct Event
+    {
+        int offset = 0;   // Sample offset within the audio block
+        int port = 0;
+        uint8_t status = 0;
+        uint8_t data1 = 0;
+        uint8_t data2 = 0;
+    };
+
+    struct JitterStats
+    {
+        int events = 0;
+        int lateEvents = 0;              // Arrived after their slot had been rendered
+        double latencyMs = 0.0;          // Constant scheduling latency (one block)
+        double meanLateMs = 0.0;         // How late, on average, late events were
+        double maxLateMs = 0.0;
+        double maxCallbackJitterMs = 0.0; // Worst audio callback deviation from the nominal period
+    };
+
+    MidiInputHandler();
+    ~MidiInputHandler() override;
+
+    // Message thread. Enables every hardware input on the device manager and
+    // opens the virtual port. Call detach() before the device manager goes away.
+    void attach(juce::AudioDeviceManager& deviceManager);
+    void detach();
+
+    // Audio thread. Pops events received up to 'now' and writes their offsets
+    // within a block of numSamples. Returns the number of events written.
+    int popEvents(Event* out, int maxEvents, int numSamples, double sampleRate);
+
+    // Per-port instrument routing (kFollowSelected = the instrument being edited)
+    void setPortInstrument(int port, int instrumentIndex);
+    int getPortInstrument(int port) const;
+    void setSelectedInstrument(int instrumentIndex) { selectedInstrument_.store(instrumentIndex, std::memory_order_relaxed); }
+    int resolveInstrument(int port) const;
+
+    int getNumPorts() const { return numPorts_.load(std::memory_order_acquire); }
+    juce::String getPortName(int port) const;
+
+    // Message thread. Stats accumulated since the last reset
+    JitterStats getStats() const;
+    void resetStats() { resetRequested_.store(true, std::memory_order_relaxed); }
+
+    // Message thread. Queues a note from the computer keyboard as if it came
+    // from a port of its own, so it is played and recorded like MIDI input.
+    void injectNote(int note, int velocity);  // velocity 0 = note off
+
+    // juce::MidiInputCallback (MIDI threads)
+    void handleIncomingMidiMessage(juce::MidiInput* source, const juce::MidiMessage& message) override;
+
+private:
+    struct RawEvent
+    {
+        double time = 0.0;  // Seconds, juce::Time::getMillisecondCounterHiRes() base
+        int port = 0;
+        uint8_t bytes[3] = {};
+    };
+
+    int findOrAddPort(juce::MidiInput* source);
+
+    juce::AudioDeviceManager* deviceManager_ = nullptr;
+    std::unique_ptr<juce::MidiInput> virtualInput_;
+
+    // Single consumer (audio thread) is lock-free; the spin lock only
+    // serialises MIDI threads when several devices deliver at once.
+    juce::AbstractFifo fifo_{kFifoSize};
+    std::array<RawEvent, kFifoSize> buffer_;
+    juce::SpinLock producerLock_;
+
+    // Ports are appended under producerLock_ and never removed
+    std::array<juce::MidiInput*, kMaxPorts> portSources_{};
+    std::array<juce::String, kMaxPorts> portNames_;
+    std::atomic<int> numPorts_{0};
+    std::array<std::atomic<int>, kMaxPorts> portInstruments_;
+    std::atomic<int> selectedInstrument_{0};
+
+    // Audio thread only
+    double lastCallbackTime_ = 0.0;
+
+    // Written by the audio thread, read by the UI
+    std::atomic<int> statEvents_{0};
+    std::atomic<int> statLate_{0};
+    std::atomic<double> statLatencyMs_{0.0};
+    std::atomic<double> statLateSumMs_{0.0};
+    std::atomic<double> statMaxLateMs_{0.0};
+    std::atomic<double> statMaxCallbackJitterMs_{0.0};
+    std::atomic<bool> resetRequested_{false};
+
+    JUCE_DECLARE_NON_COPYABLE(MidiInputHandler)
+};
+
+} // namespace audio
@@ -1,9 +1,61 @@
 #include "MultibandOTT.h"
+#include "BiquadFilter.h"
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <algorithm>
 
 namespace audio {
 
+namespace {
+
+// Thresholds per band - more aggressive for pronounced OTT effect
+// Lower up thresholds = more upward boost, lower down thresholds = more squashing
+constexpr float kUpThresholds[3] = {0.25f, 0.2f, 0.15f};    // Low, mid, high
+constexpr float kDownThresholds[3] = {0.4f, 0.35f, 0.3f};
+
+constexpr float kMaxBoostLog2 = 3.321928f;   // Limit boost to ~20dB for extreme effect
+constexpr float kMinGainLog2 = -3.321928f;   // Limit reduction to ~-20dB
+constexpr float kSilence = 0.00001f;         // Don't boost the noise floor
+
+// log2 to within ~0.005 - plenty for a level detector
+inline float fastLog2(float x) {
+    int32_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    float exponent = static_cast<float>(((bits >> 23) & 0xff) - 128);
+    bits = (bits & 0x007fffff) | 0x3f800000;  // Mantissa in [1, 2)
+    float m;
+    std::memcpy(&m, &bits, sizeof(m));
+    return exponent + (-0.34484843f * m + 2.02466578f) * m - 0.67487759f;
+}
+
+// 2^x to ~1e-4 relative, for x well inside the float exponent range
+inline float fastExp2(float x) {
+    float whole = std::floor(x);
+    float f = x - whole;
+    float p = 1.0f + f * (0.6960656f + f * (0.2244510f + f * 0.0794081f));
+    int32_t bits = (static_cast<int32_t>(whole) + 127) << 23;
+    float scale;
+    std::memcpy(&scale, &bits, sizeof(scale));
+    return p * scale;
+}
+
+} // anonymous namespace
+
+void MultibandOTT::Biquad4::process(std::array<float, 4>& x) {
+    for (size_t i = 0; i < 4; ++i) {
+        float output = b0[i] * x[i] + z1[i];
+        z1[i] = b1[i] * x[i] - a1[i] * output + z2[i];
+        z2[i] = b2[i] * x[i] - a2[i] * output;
+        x[i] = output;
+    }
+}
+
+void MultibandOTT::Biquad4::reset() {
+    z1.fill(0.0f);
+    z2.fill(0.0f);
+}
+
 void MultibandOTT::prepare(double sampleRate, int /*samplesPerBlock*/) {
     sampleRate_ = sampleRate;
 
@@ -12,25 +64,30 @@ void MultibandOTT::prepare(double sampleRate, int /*samplesPerBlock*/) {
     const float highXover = 3000.0f;
     const float q = 0.707f;  // Butterworth
 
-    // Low band LP filters (cascaded for LR4 = 24dB/oct)
-    lowpassL1_.setSampleRate(sampleRate);
-    lowpassL2_.setSampleRate(sampleRate);
-    lowpassR1_.setSampleRate(sampleRate);
-    lowpassR2_.setSampleRate(sampleRate);
-    lowpassL1_.setLowpass(lowXover, q);
-    lowpassL2_.setLowpass(lowXover, q);
-    lowpassR1_.setLowpass(lowXover, q);
-    lowpassR2_.setLowpass(lowXover, q);
-
-    // High band HP filters (cascaded for LR4)
-    highpassL1_.setSampleRate(sampleRate);
-    highpassL2_.setSampleRate(sampleRate);
-    highpassR1_.setSampleRate(sampleRate);
-    highpassR2_.setSampleRate(sampleRate);
-    highpassL1_.setHighpass(highXover, q);
-    highpassL2_.setHighpass(highXover, q);
-    highpassR1_.setHighpass(highXover, q);
-    highpassR2_.setHighpass(highXover, q);
+    // Both cascaded stages are the same Butterworth pair (LR4 = 24dB/oct)
+    BiquadFilter lowpass, highpass;
+    lowpass.setSampleRate(sampleRate);
+    highpass.setSampleRate(sampleRate);
+    lowpass.setLowpass(lowXover, q);
+    highpass.setHighpass(highXover, q);
+    auto lp = lowpass.getCoefficients();
+    auto hp = highpass.getCoefficients();
+
+    for (Biquad4* stage : {&crossover1_, &crossover2_}) {
+        for (size_t lane = 0; lane < 4; ++lane) {
+            const auto& c = lane < 2 ? lp : hp;
+            stage->b0[lane] = c.b0;
+            stage->b1[lane] = c.b1;
+            stage->b2[lane] = c.b2;
+            stage->a1[lane] = c.a1;
+            stage->a2[lane] = c.a2;
+        }
+    }
+
+    for (size_t lane = 0; lane < kLanes; ++lane) {
+        upThreshold_[lane] = std::log2(kUpThresholds[lane % kBands]);
+        downThreshold_[lane] = std::log2(kDownThresholds[lane % kBands]);
+    }
 
     reset();
     setParams(lowDepth_, midDepth_, highDepth_, mix_);
@@ -42,6 +99,12 @@ void MultibandOTT::setParams(float lowDepth, float midDepth, float highDepth, fl
     highDepth_ = std::clamp(highDepth, 0.0f, 1.0f);
     mix_ = std::clamp(mix, 0.0f, 1.0f);
 
+    for (size_t channel = 0; channel < 2; ++channel) {
+        depth_[channel * kBands + 0] = lowDepth_;
+        depth_[channel * kBands + 1] = midDepth_;
+        depth_[channel * kBands + 2] = highDepth_;
+    }
+
     // Fixed attack/release times for classic OTT character (medium-fast)
     float attackMs = 15.0f;
     float releaseMs = 150.0f;
@@ -50,99 +113,98 @@ void MultibandOTT::setParams(float lowDepth, float midDepth, float highDepth, fl
     releaseCoef_ = 1.0f - std::exp(-1.0f / (static_cast<float>(sampleRate_) * releaseMs * 0.001f));
 }
 
-void MultibandOTT::reset() {
-    for (auto& state : bandStatesL_) {
-        state.envUp = 0.0f;
-        state.envDown = 0.0f;
-    }
-    for (auto& state : bandStatesR_) {
-        state.envUp = 0.0f;
-        state.envDown = 0.0f;
-    }
-
-    lowpassL1_.reset(); lowpassL2_.reset();
-    lowpassR1_.reset(); lowpassR2_.reset();
-    highpassL1_.reset(); highpassL2_.reset();
-    highpassR1_.reset(); highpassR2_.reset();
+void MultibandOTT::setLinked(bool linked) {
+    linked_ = linked;
 }
 
-float MultibandOTT::compressBand(float input, BandState& state, float upThreshold, float downThreshold, float depth) {
-    float absInput = std::abs(input);
-
-    // Update envelope followers
-    float coef = (absInput > state.envUp) ? attackCoef_ : releaseCoef_;
-    state.envUp += coef * (absInput - state.envUp);
-
-    coef = (absInput > state.envDown) ? attackCoef_ : releaseCoef_;
-    state.envDown += coef * (absInput - state.envDown);
+void MultibandOTT::reset() {
+    envelope_.fill(0.0f);
+    gain_.fill(1.0f);
+    crossover1_.reset();
+    crossover2_.reset();
+}
 
-    float gain = 1.0f;
+bool MultibandOTT::isBypassed() const {
+    return lowDepth_ < 0.001f && midDepth_ < 0.001f && highDepth_ < 0.001f;
+}
 
-    // Upward compression: boost quiet signals aggressively
-    if (state.envUp < upThreshold && state.envUp > 0.00001f) {
-        float ratio = upThreshold / state.envUp;
-        // Full depth scaling - no 0.5f damping
-        gain *= 1.0f + (ratio - 1.0f) * depth;
-        gain = std::min(gain, 10.0f);  // Limit boost to ~20dB for extreme effect
+void MultibandOTT::process(float* left, float* right, int numSamples) {
+    // Bypass when all bands are off. The bands sum back to the input, so
+    // dropping out is seamless; starting from clean state makes coming back so too
+    if (isBypassed()) {
+        if (active_) {
+            reset();
+            active_ = false;
+        }
+        return;
     }
-
-    // Downward compression: squash loud signals hard
-    if (state.envDown > downThreshold) {
-        float ratio = downThreshold / state.envDown;
-        // Full depth scaling - more aggressive squashing
-        gain *= 1.0f - (1.0f - ratio) * depth;
-        gain = std::max(gain, 0.1f);  // Limit reduction to ~-20dB
+    active_ = true;
+
+    std::array<float, kLanes> envelope = envelope_;
+    std::array<std::array<float, kLanes>, kGainInterval> bands;
+    std::array<float, kLanes> level, target, step;
+
+    for (int start = 0; start < numSamples; start += kGainInterval) {
+        const int count = std::min(kGainInterval, numSamples - start);
+
+        for (int i = 0; i < count; ++i) {
+            const float dryL = left[start + i], dryR = right[start + i];
+
+            // Split into 3 bands: low = LR4 lowpass, high = LR4 highpass, mid = the rest
+            std::array<float, 4> split = {dryL, dryR, dryL, dryR};
+            crossover1_.process(split);
+            crossover2_.process(split);
+            auto& band = bands[static_cast<size_t>(i)];
+            band = {split[0], dryL - split[0] - split[2], split[2],
+                    split[1], dryR - split[1] - split[3], split[3]};
+
+            for (size_t lane = 0; lane < kLanes; ++lane)
+                level[lane] = std::abs(band[lane]);
+            if (linked_) {
+                for (size_t b = 0; b < kBands; ++b) {
+                    float linkedLevel = std::max(level[b], level[b + kBands]);
+                    level[b] = level[b + kBands] = linkedLevel;
+                }
+            }
+
+            // Envelope followers
+            for (size_t lane = 0; lane < kLanes; ++lane) {
+                float coef = level[lane] > envelope[lane] ? attackCoef_ : releaseCoef_;
+                envelope[lane] += coef * (level[lane] - envelope[lane]);
+            }
+        }
+
+        // Gain in log2 units from where the envelopes ended up: upward below
+        // upThreshold, downward above downThreshold, scaled by depth.
+        // The envelopes move slowly, so the gain is ramped to it over the interval
+        for (size_t lane = 0; lane < kLanes; ++lane) {
+            float env = std::max(envelope[lane], kSilence);
+            float envLog2 = fastLog2(env);
+            float up = std::min(std::max(upThreshold_[lane] - envLog2, 0.0f), kMaxBoostLog2);
+            up = envelope[lane] > kSilence ? up : 0.0f;
+            float down = std::max(envLog2 - downThreshold_[lane], 0.0f);
+            target[lane] = fastExp2(std::max(depth_[lane] * (up - down), kMinGainLog2));
+            step[lane] = (target[lane] - gain_[lane]) / static_cast<float>(count);
+        }
+
+        for (int i = 0; i < count; ++i) {
+            const auto& band = bands[static_cast<size_t>(i)];
+            for (size_t lane = 0; lane < kLanes; ++lane)
+                gain_[lane] += step[lane];
+
+            // Sum bands back together
+            float wetL = band[0] * gain_[0] + band[1] * gain_[1] + band[2] * gain_[2];
+            float wetR = band[3] * gain_[3] + band[4] * gain_[4] + band[5] * gain_[5];
+
+            // Mix dry/wet
+            const float dryL = left[start + i], dryR = right[start + i];
+            left[start + i] = dryL + (wetL - dryL) * mix_;
+            right[start + i] = dryR + (wetR - dryR) * mix_;
+        }
+        gain_ = target;
     }
 
-    return input * gain;
-}
-
-void MultibandOTT::process(float& left, float& right) {
-    // Bypass when all bands are off
-    if (lowDepth_ < 0.001f && midDepth_ < 0.001f && highDepth_ < 0.001f) return;
-
-    float dryL = left, dryR = right;
-
-    // Split into 3 bands using crossover filters
-    // Low band: cascaded lowpass at 100Hz
-    float lowL = lowpassL1_.process(left);
-    lowL = lowpassL2_.process(lowL);
-    float lowR = lowpassR1_.process(right);
-    lowR = lowpassR2_.process(lowR);
-
-    // High band: cascaded highpass at 3kHz
-    float highL = highpassL1_.process(left);
-    highL = highpassL2_.process(highL);
-    float highR = highpassR1_.process(right);
-    highR = highpassR2_.process(highR);
-
-    // Mid band: what's left (input - low - high)
-    float midL = left - lowL - highL;
-    float midR = right - lowR - highR;
-
-    // Thresholds per band - more aggressive for pronounced OTT effect
-    // Lower up thresholds = more upward boost, lower down thresholds = more squashing
-    const float lowUpThresh = 0.25f, lowDownThresh = 0.4f;
-    const float midUpThresh = 0.2f, midDownThresh = 0.35f;
-    const float highUpThresh = 0.15f, highDownThresh = 0.3f;
-
-    // Process each band with per-band depth control
-    lowL = compressBand(lowL, bandStatesL_[0], lowUpThresh, lowDownThresh, lowDepth_);
-    lowR = compressBand(lowR, bandStatesR_[0], lowUpThresh, lowDownThresh, lowDepth_);
-
-    midL = compressBand(midL, bandStatesL_[1], midUpThresh, midDownThresh, midDepth_);
-    midR = compressBand(midR, bandStatesR_[1], midUpThresh, midDownThresh, midDepth_);
-
-    highL = compressBand(highL, bandStatesL_[2], highUpThresh, highDownThresh, highDepth_);
-    highR = compressBand(highR, bandStatesR_[2], highUpThresh, highDownThresh, highDepth_);
-
-    // Sum bands back together
-    float wetL = lowL + midL + highL;
-    float wetR = lowR + midR + highR;
-
-    // Mix dry/wet
-    left = dryL + (wetL - dryL) * mix_;
-    right = dryR + (wetR - dryR) * mix_;
+    envelope_ = envelope;
 }
 
 } // namespace audio
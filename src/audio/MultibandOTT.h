@@ -1,6 +1,5 @@
 #pragma once
 
-#include "BiquadFilter.h"
 #include <array>
 
 namespace audio {
@@ -8,41 +7,53 @@ namespace audio {
 // 3-band OTT (Over The Top) multiband dynamics processor
 // Linkwitz-Riley crossovers at ~100Hz and ~3kHz
 // Each band has upward + downward compression
+//
+// Processes whole blocks. Both crossovers for both channels run as one
+// 4-lane biquad cascade, and the six band envelopes (band x channel) are
+// followed together. Gains are worked out in the log domain every
+// kGainInterval samples and ramped in between.
 class MultibandOTT {
 public:
     void prepare(double sampleRate, int samplesPerBlock);
     void setParams(float lowDepth, float midDepth, float highDepth, float mix);  // All 0-1
-    void process(float& left, float& right);
+    void setLinked(bool linked);  // One detector per band, shared by both channels
+    void process(float* left, float* right, int numSamples);
     void reset();
 
 private:
-    struct BandState {
-        float envUp = 0.0f;    // Upward compressor envelope
-        float envDown = 0.0f;  // Downward compressor envelope
+    static constexpr int kBands = 3;
+    static constexpr int kLanes = 2 * kBands;  // Low, mid, high for L, then for R
+    static constexpr int kGainInterval = 16;   // Samples between gain computations
+
+    // Four biquads side by side. Lanes: LP left, LP right, HP left, HP right
+    struct Biquad4 {
+        std::array<float, 4> b0{}, b1{}, b2{}, a1{}, a2{};
+        std::array<float, 4> z1{}, z2{};
+
+        void process(std::array<float, 4>& x);
+        void reset();
     };
 
-    float compressBand(float input, BandState& state, float upThreshold, float downThreshold, float depth);
+    bool isBypassed() const;
 
     double sampleRate_ = 44100.0;
     float lowDepth_ = 0.0f;
     float midDepth_ = 0.0f;
     float highDepth_ = 0.0f;
     float mix_ = 1.0f;
+    bool linked_ = false;
+    bool active_ = false;  // Processed last block; state is reset on the way into bypass
 
     // Crossover filters (Linkwitz-Riley = 2x Butterworth cascaded)
-    // Low band: below ~100Hz
-    BiquadFilter lowpassL1_, lowpassL2_;   // LP for low band extraction
-    BiquadFilter lowpassR1_, lowpassR2_;
-
-    // High band: above ~3kHz
-    BiquadFilter highpassL1_, highpassL2_; // HP for high band extraction
-    BiquadFilter highpassR1_, highpassR2_;
-
     // Mid band is derived: input - low - high
-
-    // Per-band envelope states (stereo linked)
-    std::array<BandState, 3> bandStatesL_;  // Low, Mid, High
-    std::array<BandState, 3> bandStatesR_;
+    Biquad4 crossover1_, crossover2_;
+
+    // Per-lane detector and gain curve. Thresholds are log2 of linear level
+    std::array<float, kLanes> envelope_{};
+    std::array<float, kLanes> gain_{};  // Linear, as applied at the end of the last interval
+    std::array<float, kLanes> upThreshold_{};
+    std::array<float, kLanes> downThreshold_{};
+    std::array<float, kLanes> depth_{};
 
     // Attack/release coefficients (fixed values for OTT character)
     float attackCoef_ = 0.0f, releaseCoef_ = 0.0f;
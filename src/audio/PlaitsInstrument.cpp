@@ -1,36 +1,16 @@
 #include "PlaitsInstrument.h"
-#include "Voice.h"
-#include "PlaitsVoice.h"
 #include <cmath>
 #include <cstring>
 #include <algorithm>
 
 namespace audio {
 
-std::unique_ptr<audio::Voice> PlaitsInstrument::createVoice() {
-    auto voice = std::make_unique<PlaitsVoice>();
-    voice->setSampleRate(sampleRate_);
-
-    // Build parameters from member variables
-    model::PlaitsParams params;
-    params.engine = engine_;
-    params.harmonics = harmonics_;
-    params.timbre = timbre_;
-    params.morph = morph_;
-    params.attack = attack_;
-    params.decay = decay_;
-    params.lpgColour = 0.5f;  // Default value
-
-    voice->updateParameters(params);
-    return voice;
+void PlaitsInstrument::initVoice(PlaitsVoice& voice) {
+    voice.setSampleRate(sampleRate_);
+    updateVoiceParameters(voice);
 }
 
-void PlaitsInstrument::updateVoiceParameters(audio::Voice* voice) {
-    if (!voice) return;
-
-    auto* plaitsVoice = dynamic_cast<PlaitsVoice*>(voice);
-    if (!plaitsVoice) return;
-
+void PlaitsInstrument::updateVoiceParameters(PlaitsVoice& voice) {
     // Build parameters from member variables
     model::PlaitsParams params;
     params.engine = engine_;
@@ -41,7 +21,7 @@ void PlaitsInstrument::updateVoiceParameters(audio::Voice* voice) {
     params.decay = decay_;
     params.lpgColour = 0.5f;  // Default value
 
-    plaitsVoice->updateParameters(params);
+    voice.updateParameters(params);
 }
 
 static const char* kEngineNames[16] = {
@@ -2,6 +2,7 @@
 
 #include "InstrumentProcessor.h"
 #include "UniversalTrackerFX.h"
+#include "PlaitsVoice.h"
 #include "../dsp/voice_allocator.h"
 #include "../dsp/modulation_matrix.h"
 #include "../dsp/moog_filter.h"
@@ -45,7 +46,7 @@ enum PlaitsParam {
 };
 
 // Full-featured Plaits instrument with modulation matrix and filter
-class PlaitsInstrument : public InstrumentProcessor
+class PlaitsInstrument final : public InstrumentProcessor
 {
 public:
     PlaitsInstrument();
@@ -55,9 +56,12 @@ public:
     void init(double sampleRate) override;
     void setSampleRate(double sampleRate) override;
 
-    // Voice-per-track interface
-    std::unique_ptr<audio::Voice> createVoice() override;
-    void updateVoiceParameters(audio::Voice* voice) override;
+    // Voice-per-track interface (see TrackVoice.h)
+    using VoiceType = PlaitsVoice;
+    // Prepares a freshly created track voice
+    void initVoice(PlaitsVoice& voice);
+    // Syncs a track voice with the current instrument params, once per block
+    void updateVoiceParameters(PlaitsVoice& voice);
 
     // Legacy methods
     void noteOn(int note, float velocity) override;
@@ -96,6 +100,9 @@ public:
     // Modulation access for UI
     const plaits::ModulationMatrix& getModMatrix() const { return modMatrix_; }
 
+    // Heap memory owned - the voices' Plaits buffers (see model/MemoryUsage.h)
+    size_t getAllocatedBytes() const { return voiceAllocator_.allocatedBytes(); }
+
     // Engine names
     static const char* getEngineName(int engine);
     static constexpr int kNumEngines = 16;
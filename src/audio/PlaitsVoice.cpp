@@ -65,10 +65,6 @@ void PlaitsVoice::process(float *outL, float *outR, int numSamples,
   }
 }
 
-bool PlaitsVoice::isActive() const { return plaitsVoiceWrapper_.active(); }
-
-int PlaitsVoice::getCurrentNote() const { return currentNote_; }
-
 void PlaitsVoice::updateParameters(const model::PlaitsParams &params) {
   params_ = params;
 }
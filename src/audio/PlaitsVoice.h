@@ -1,24 +1,24 @@
 #pragma once
 
-#include "Voice.h"
 #include "../dsp/voice.h"
 #include "../model/Instrument.h"
 
 namespace audio {
 
-class PlaitsVoice : public Voice {
+// Track voice for Plaits instruments (see TrackVoice.h)
+class PlaitsVoice {
 public:
     PlaitsVoice();
-    ~PlaitsVoice() override = default;
 
-    void setSampleRate(double sampleRate) override;
-    void noteOn(int note, float velocity) override;
-    void noteOff() override;
+    void setSampleRate(double sampleRate);
+    void noteOn(int note, float velocity);
+    void noteOff();
     void process(float* outL, float* outR, int numSamples,
-                float pitchMod, float cutoffMod, float volumeMod, float panMod) override;
+                float pitchMod, float cutoffMod, float volumeMod, float panMod);
 
-    bool isActive() const override;
-    int getCurrentNote() const override;
+    bool isActive() const { return plaitsVoiceWrapper_.active(); }
+    int getCurrentNote() const { return currentNote_; }
+    size_t getAllocatedBytes() const { return plaitsVoiceWrapper_.allocatedBytes(); }
 
     // Plaits-specific configuration
     void updateParameters(const model::PlaitsParams& params);
@@ -0,0 +1,309 @@
+#include "PresetPreviewRenderer.h"
+#include <algorithm>
+#include <cstring>
+
+namespace audio {
+
+namespace {
+
+// FNV-1a, fed field by field so struct padding never leaks into the key
+struct KeyHasher
+{
+    uint64_t hash = 14695981039346656037ull;
+
+    template <typename T>
+    void add(const T& value)
+    {
+        unsigned char bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        for (auto b : bytes)
+        {
+            hash ^= b;
+            hash *= 1099511628211ull;
+        }
+    }
+};
+
+// Same mapping AudioEngine::syncInstrumentParams uses for the live instruments
+void applyPlaitsParams(PlaitsInstrument& plaits, const model::PlaitsParams& params)
+{
+    plaits.setParameter(kParamEngine, static_cast<float>(params.engine) / 15.0f);
+    plaits.setParameter(kParamHarmonics, params.harmonics);
+    plaits.setParameter(kParamTimbre, params.timbre);
+    plaits.setParameter(kParamMorph, params.morph);
+    plaits.setParameter(kParamAttack, params.attack);
+    plaits.setParameter(kParamDecay, params.decay);
+    plaits.setParameter(kParamPolyphony, static_cast<float>(params.polyphony) / 16.0f);
+    plaits.setParameter(kParamCutoff, params.filter.cutoff);
+    plaits.setParameter(kParamResonance, params.filter.resonance);
+
+    plaits.setParameter(kParamLfo1Rate, static_cast<float>(params.lfo1.rate) / 15.0f);
+    plaits.setParameter(kParamLfo1Shape, static_cast<float>(params.lfo1.shape) / 4.0f);
+    plaits.setParameter(kParamLfo1Dest, static_cast<float>(params.lfo1.dest) / 8.0f);
+    plaits.setParameter(kParamLfo1Amount, static_cast<float>(params.lfo1.amount + 64) / 127.0f);
+
+    plaits.setParameter(kParamLfo2Rate, static_cast<float>(params.lfo2.rate) / 15.0f);
+    plaits.setParameter(kParamLfo2Shape, static_cast<float>(params.lfo2.shape) / 4.0f);
+    plaits.setParameter(kParamLfo2Dest, static_cast<float>(params.lfo2.dest) / 8.0f);
+    plaits.setParameter(kParamLfo2Amount, static_cast<float>(params.lfo2.amount + 64) / 127.0f);
+
+    plaits.setParameter(kParamEnv1Attack, params.env1.attack);
+    plaits.setParameter(kParamEnv1Decay, params.env1.decay);
+    plaits.setParameter(kParamEnv1Dest, static_cast<float>(params.env1.dest) / 8.0f);
+    plaits.setParameter(kParamEnv1Amount, static_cast<float>(params.env1.amount + 64) / 127.0f);
+
+    plaits.setParameter(kParamEnv2Attack, params.env2.attack);
+    plaits.setParameter(kParamEnv2Decay, params.env2.decay);
+    plaits.setParameter(kParamEnv2Dest, static_cast<float>(params.env2.dest) / 8.0f);
+    plaits.setParameter(kParamEnv2Amount, static_cast<float>(params.env2.amount + 64) / 127.0f);
+}
+
+} // anonymous namespace
+
+uint64_t PresetPreviewRenderer::Request::getKey() const
+{
+    KeyHasher h;
+    h.add(static_cast<int>(type));
+    h.add(note);
+    h.add(sampleRate);
+
+    if (type == model::InstrumentType::DXPreset)
+    {
+        for (auto b : dx7Patch)
+            h.add(b);
+    }
+    else
+    {
+        h.add(plaits.engine);
+        h.add(plaits.harmonics);
+        h.add(plaits.timbre);
+        h.add(plaits.morph);
+        h.add(plaits.attack);
+        h.add(plaits.decay);
+        h.add(plaits.polyphony);
+        h.add(plaits.filter.cutoff);
+        h.add(plaits.filter.resonance);
+        for (const auto* lfo : { &plaits.lfo1, &plaits.lfo2 })
+        {
+            h.add(lfo->rate);
+            h.add(lfo->shape);
+            h.add(lfo->dest);
+            h.add(lfo->amount);
+        }
+        for (const auto* env : { &plaits.env1, &plaits.env2 })
+        {
+            h.add(env->attack);
+            h.add(env->decay);
+            h.add(env->dest);
+            h.add(env->amount);
+        }
+    }
+
+    // 0 means "no key" internally
+    return h.hash != 0 ? h.hash : 1;
+}
+
+PresetPreviewRenderer::PresetPreviewRenderer()
+    : juce::Thread("Preset Preview")
+{
+}
+
+PresetPreviewRenderer::~PresetPreviewRenderer()
+{
+    signalThreadShouldExit();
+    notify();
+    stopThread(2000);
+}
+
+void PresetPreviewRenderer::audition(const Request& request, const std::vector<Request>& prefetch)
+{
+    auto key = request.getKey();
+    latestAuditionKey_ = key;
+    std::shared_ptr<const PreviewClip> cached;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        // A new audition supersedes everything still queued
+        queue_.clear();
+        cached = findCachedLocked(key);
+        pendingAuditionKey_ = cached ? 0 : key;
+        if (!cached)
+            queue_.push_back(request);
+
+        for (const auto& neighbour : prefetch)
+        {
+            if (!findCachedLocked(neighbour.getKey()))
+                queue_.push_back(neighbour);
+        }
+    }
+
+    if (cached)
+        deliver(std::move(cached));
+
+    if (!isThreadRunning())
+        startThread(juce::Thread::Priority::background);
+    notify();
+}
+
+void PresetPreviewRenderer::cancel()
+{
+    latestAuditionKey_ = 0;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    queue_.clear();
+    pendingAuditionKey_ = 0;
+}
+
+std::shared_ptr<const PreviewClip> PresetPreviewRenderer::findCachedLocked(uint64_t key)
+{
+    for (auto it = cache_.begin(); it != cache_.end(); ++it)
+    {
+        if ((*it)->key == key)
+        {
+            // Move to front (most recently used)
+            cache_.splice(cache_.begin(), cache_, it);
+            return cache_.front();
+        }
+    }
+    return nullptr;
+}
+
+void PresetPreviewRenderer::deliver(std::shared_ptr<const PreviewClip> clip)
+{
+    if (onClipReady)
+        onClipReady(std::move(clip));
+}
+
+void PresetPreviewRenderer::run()
+{
+    while (!threadShouldExit())
+    {
+        Request request;
+        bool haveRequest = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!queue_.empty())
+            {
+                request = queue_.front();
+                queue_.pop_front();
+                haveRequest = true;
+            }
+        }
+
+        if (!haveRequest)
+        {
+            wait(-1);
+            continue;
+        }
+
+        auto clip = render(request);
+        if (!clip || threadShouldExit())
+            continue;
+
+        bool play = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            cache_.push_front(clip);
+            while (static_cast<int>(cache_.size()) > kCacheSize)
+                cache_.pop_back();
+
+            if (clip->key == pendingAuditionKey_)
+            {
+                pendingAuditionKey_ = 0;
+                play = true;
+            }
+        }
+
+        if (play)
+        {
+            juce::WeakReference<PresetPreviewRenderer> weakThis(this);
+            juce::MessageManager::callAsync([weakThis, clip]() {
+                // Skip if the user has already moved on to another preset
+                auto* renderer = weakThis.get();
+                if (renderer && renderer->latestAuditionKey_ == clip->key)
+                    renderer->deliver(clip);
+            });
+        }
+    }
+}
+
+std::shared_ptr<const PreviewClip> PresetPreviewRenderer::render(const Request& request)
+{
+    const double sampleRate = request.sampleRate;
+    if (!plaits_ || sampleRate != instrumentSampleRate_)
+    {
+        plaits_ = std::make_unique<PlaitsInstrument>();
+        instrumentSampleRate_ = sampleRate;
+    }
+
+    // Re-initialise per clip so no release tail from the previous preset bleeds in
+    InstrumentProcessor* processor = nullptr;
+    if (request.type == model::InstrumentType::DXPreset)
+    {
+        // DX7 voices are only created by init(); a fresh instance is cheaper than
+        // waiting out long FM releases. init() also rewrites the shared msfa
+        // tables, with the same values the engine uses at this sample rate.
+        dx7_ = std::make_unique<DX7Instrument>();
+        dx7_->init(sampleRate);
+        dx7_->loadPackedPatch(request.dx7Patch.data());
+        processor = dx7_.get();
+    }
+    else if (request.type == model::InstrumentType::Plaits)
+    {
+        applyPlaitsParams(*plaits_, request.plaits);
+        plaits_->init(sampleRate);
+        processor = plaits_.get();
+    }
+    else
+    {
+        return nullptr;  // Sample-based instruments audition their own buffers
+    }
+
+    auto clip = std::make_shared<PreviewClip>();
+    clip->key = request.getKey();
+    clip->sampleRate = sampleRate;
+
+    const int totalSamples = static_cast<int>(kClipSeconds * sampleRate);
+    const int noteOffSample = static_cast<int>(kNoteSeconds * sampleRate);
+    clip->left.assign(static_cast<size_t>(totalSamples), 0.0f);
+    clip->right.assign(static_cast<size_t>(totalSamples), 0.0f);
+
+    processor->noteOn(request.note, 1.0f);
+
+    for (int pos = 0; pos < totalSamples; pos += kRenderBlockSize)
+    {
+        if (threadShouldExit())
+            return nullptr;
+
+        // Release on a block boundary, close enough for an audition
+        if (pos <= noteOffSample && noteOffSample < pos + kRenderBlockSize)
+            processor->noteOff(request.note);
+
+        int n = std::min(kRenderBlockSize, totalSamples - pos);
+        processor->process(clip->left.data() + pos, clip->right.data() + pos, n);
+    }
+
+    processor->allNotesOff();
+
+    // Short fade in/out so clips start and end without clicks
+    const int fadeIn = std::max(1, static_cast<int>(kFadeInSeconds * sampleRate));
+    const int fadeOut = std::max(1, static_cast<int>(kFadeOutSeconds * sampleRate));
+    for (int i = 0; i < std::min(fadeIn, totalSamples); ++i)
+    {
+        float gain = static_cast<float>(i) / static_cast<float>(fadeIn);
+        clip->left[static_cast<size_t>(i)] *= gain;
+        clip->right[static_cast<size_t>(i)] *= gain;
+    }
+    for (int i = 0; i < std::min(fadeOut, totalSamples); ++i)
+    {
+        float gain = static_cast<float>(i) / static_cast<float>(fadeOut);
+        auto index = static_cast<size_t>(totalSamples - 1 - i);
+        clip->left[index] *= gain;
+        clip->right[index] *= gain;
+    }
+
+    return clip;
+}
+
+} // namespace audio
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "PlaitsInstrument.h"
+#include "DX7Instrument.h"
+#include "../model/Instrument.h"
+#include <JuceHeader.h>
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace audio {
+
+// A rendered preset audition, played by AudioEngine's preview voice
+struct PreviewClip
+{
+    uint64_t key = 0;
+    double sampleRate = 0.0;
+    std::vector<float> left;
+    std::vector<float> right;
+};
+
+// Renders short audition clips of presets on a worker thread, using its own
+// Plaits/DX7 instances so browsing never touches the live instruments.
+// Clips are cached (LRU) and neighbouring presets are prefetched.
+class PresetPreviewRenderer : private juce::Thread
+{
+public:
+    struct Request
+    {
+        model::InstrumentType type = model::InstrumentType::Plaits;
+        model::PlaitsParams plaits;                             // type == Plaits
+        std::array<uint8_t, DX7_PATCH_SIZE_PACKED> dx7Patch{};  // type == DXPreset
+        int note = 60;
+        double sampleRate = 48000.0;
+
+        uint64_t getKey() const;
+    };
+
+    PresetPreviewRenderer();
+    ~PresetPreviewRenderer() override;
+
+    // Message thread. Plays the clip for 'request' via onClipReady - straight
+    // away if cached, otherwise once rendered. 'prefetch' is rendered after it.
+    void audition(const Request& request, const std::vector<Request>& prefetch = {});
+
+    // Message thread. Forget a pending audition (e.g. the browser was closed)
+    void cancel();
+
+    // Called on the message thread with the clip for the latest audition()
+    std::function<void(std::shared_ptr<const PreviewClip>)> onClipReady;
+
+    static constexpr int kCacheSize = 32;
+    static constexpr double kNoteSeconds = 0.8;     // Note held for
+    static constexpr double kClipSeconds = 1.3;     // Note + release tail
+    static constexpr double kFadeInSeconds = 0.002;
+    static constexpr double kFadeOutSeconds = 0.1;
+
+private:
+    static constexpr int kRenderBlockSize = 512;  // Instruments' max block size
+
+    void run() override;
+    std::shared_ptr<const PreviewClip> render(const Request& request);
+    std::shared_ptr<const PreviewClip> findCachedLocked(uint64_t key);
+    void deliver(std::shared_ptr<const PreviewClip> clip);
+
+    std::mutex mutex_;
+    std::deque<Request> queue_;                           // Front = audition, rest = prefetch
+    std::list<std::shared_ptr<const PreviewClip>> cache_; // Most recently used first
+    uint64_t pendingAuditionKey_ = 0;                     // 0 = nothing waiting to play
+    uint64_t latestAuditionKey_ = 0;                      // Message thread only
+
+    // Worker thread only
+    std::unique_ptr<PlaitsInstrument> plaits_;
+    std::unique_ptr<DX7Instrument> dx7_;
+    double instrumentSampleRate_ = 0.0;
+
+    JUCE_DECLARE_WEAK_REFERENCEABLE(PresetPreviewRenderer)
+    JUCE_DECLARE_NON_COPYABLE(PresetPreviewRenderer)
+};
+
+} // namespace audio
@@ -0,0 +1,140 @@
+#include "ProjectLoader.h"
+#include "../model/ProjectSerializer.h"
+
+namespace audio {
+
+namespace {
+
+// Share of the progress bar each stage ends at; the two prepare jobs split
+// what is left
+constexpr float kReadDone = 0.2f;
+constexpr float kParseDone = 0.4f;
+constexpr float kPrepareJobShare = (1.0f - kParseDone) / 2.0f;
+
+void addProgress(std::atomic<float>& progress, float amount)
+{
+    float value = progress.load();
+    while (!progress.compare_exchange_weak(value, value + amount))
+        ;
+}
+
+} // anonymous namespace
+
+ProjectLoader::~ProjectLoader()
+{
+    cancel();
+}
+
+void ProjectLoader::open(const juce::File& file, double sampleRate)
+{
+    cancel();
+
+    auto load = std::make_shared<Load>();
+    load->file = file;
+    load->sampleRate = sampleRate;
+    load->result.file = file;
+    load_ = load;
+
+    using Priority = model::JobScheduler::Priority;
+    using Token = model::JobScheduler::CancellationToken;
+
+    // Reading and parsing - into a project no one else can see yet
+    auto parsed = scheduler_->submit(Priority::Interactive, token_, [load](const Token& token) {
+        if (!load->file.existsAsFile())
+            return;
+        auto json = load->file.loadFileAsString();
+        load->progress.store(kReadDone);
+        if (token.isCancelled())
+            return;
+
+        load->stage.store(Stage::Parsing);
+        auto project = std::make_unique<model::Project>();
+        if (!model::ProjectSerializer::fromJson(*project, json))
+            return;
+        load->result.project = std::move(project);
+        load->progress.store(kParseDone);
+        load->stage.store(Stage::Preparing);
+    });
+
+    // Preparing - each job writes only its own part of the result. The
+    // reverb IR is the slow one
+    model::JobScheduler::Job impulse;
+    impulse.priority = Priority::Interactive;
+    impulse.token = token_;
+    impulse.after = {parsed};
+    impulse.work = [load](const Token& token) {
+        if (!load->result.project || token.isCancelled())
+            return;
+        const auto& mixer = load->result.project->getMixer();
+        if (!mixer.reverbImpulse.empty())
+        {
+            juce::File irFile(mixer.reverbImpulse);
+            auto ir = ConvolutionReverb::loadImpulse(irFile, load->sampleRate, mixer.reverbMaxTail);
+            if (ir.getNumSamples() > 0 && !token.isCancelled())
+            {
+                load->result.reverb = std::make_unique<ConvolutionReverb>(ir, load->sampleRate);
+                load->result.reverbFile = irFile;
+            }
+        }
+        addProgress(load->progress, kPrepareJobShare);
+    };
+    auto impulseId = scheduler_->submit(std::move(impulse));
+
+    // Built here so the first :usages or engine update after the swap is
+    // incremental. The project is still private to this load
+    model::JobScheduler::Job usage;
+    usage.priority = Priority::Interactive;
+    usage.token = token_;
+    usage.after = {parsed};
+    usage.work = [load](const Token& token) {
+        if (!load->result.project || token.isCancelled())
+            return;
+        load->result.project->getUsageIndex();
+        addProgress(load->progress, kPrepareJobShare);
+    };
+    auto usageId = scheduler_->submit(std::move(usage));
+
+    model::JobScheduler::Job done;
+    done.priority = Priority::Interactive;
+    done.token = token_;
+    done.after = {impulseId, usageId};
+    done.onComplete = [this, load]() { finish(load); };
+    scheduler_->submit(std::move(done));
+}
+
+void ProjectLoader::cancel()
+{
+    // Jobs still running finish their current step and drop what they built;
+    // no callback of a cancelled token is delivered
+    token_.cancel();
+    token_ = {};
+    load_.reset();
+}
+
+ProjectLoader::Stage ProjectLoader::getStage() const
+{
+    return load_ ? load_->stage.load() : Stage::Idle;
+}
+
+float ProjectLoader::getProgress() const
+{
+    return load_ ? load_->progress.load() : 0.0f;
+}
+
+juce::File ProjectLoader::getFile() const
+{
+    return load_ ? load_->file : juce::File();
+}
+
+void ProjectLoader::finish(const std::shared_ptr<Load>& load)
+{
+    // Delivered only while this load's token is live, so load_ is still it
+    jassert(load == load_);
+    load_.reset();
+    load->progress.store(1.0f);
+
+    if (onFinished)
+        onFinished(std::move(load->result));
+}
+
+} // namespace audio
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "ConvolutionReverb.h"
+#include "../model/JobScheduler.h"
+#include "../model/Project.h"
+#include <JuceHeader.h>
+#include <atomic>
+#include <functional>
+#include <memory>
+
+namespace audio {
+
+// Opens a project file off the message thread, in stages:
+//   Reading    load the file
+//   Parsing    JSON into a fresh model::Project (nothing shared yet)
+//   Preparing  independent asset jobs, in parallel once parsing is done:
+//              the reverb impulse response (read, resample, partition) and
+//              the project's usage index
+// The stages are a chain of jobs on the shared JobScheduler. The finished
+// project is handed to onFinished on the message thread, ready to be swapped
+// in whole. Cancelling at any point drops everything built.
+class ProjectLoader
+{
+public:
+    enum class Stage { Idle, Reading, Parsing, Preparing };
+
+    struct Result
+    {
+        juce::File file;
+        std::unique_ptr<model::Project> project;
+        std::unique_ptr<ConvolutionReverb> reverb;  // Null if the project has no IR
+        juce::File reverbFile;                      // Or it couldn't be read
+    };
+
+    ProjectLoader() = default;
+    ~ProjectLoader();
+
+    // Message thread. Starts opening 'file' (cancelling an open in progress).
+    // sampleRate is the rate assets are prepared at.
+    void open(const juce::File& file, double sampleRate);
+
+    // Message thread. Abandons the open in progress; onFinished isn't called
+    void cancel();
+
+    bool isBusy() const { return load_ != nullptr; }
+    Stage getStage() const;
+    float getProgress() const;  // 0..1
+    juce::File getFile() const;
+
+    // Message thread. A project that opened; nullptr project if it failed
+    std::function<void(Result)> onFinished;
+
+private:
+    // Shared with the jobs, which may outlive a cancelled open
+    struct Load
+    {
+        juce::File file;
+        double sampleRate = 48000.0;
+        std::atomic<Stage> stage{Stage::Reading};
+        std::atomic<float> progress{0.0f};
+        Result result;
+    };
+
+    void finish(const std::shared_ptr<Load>& load);
+
+    juce::SharedResourcePointer<model::JobScheduler> scheduler_;
+    model::JobScheduler::CancellationToken token_;
+    std::shared_ptr<Load> load_;  // Open in progress
+
+    JUCE_DECLARE_NON_COPYABLE(ProjectLoader)
+};
+
+} // namespace audio
@@ -0,0 +1,201 @@
+#include "RenderWorkers.h"
+#include <thread>
+
+#if JUCE_MAC || JUCE_IOS
+#include <dispatch/dispatch.h>
+#elif JUCE_WINDOWS
+#include <windows.h>
+#else
+#include <cerrno>
+#include <semaphore.h>
+#endif
+
+namespace audio {
+
+namespace {
+
+constexpr int kSpinBudget = 200;  // Yields before the audio thread sleeps
+
+} // anonymous namespace
+
+// The OS counting semaphore. Unlike juce::WaitableEvent (a mutex and a
+// condition variable), posting is an atomic increment and, only if a thread
+// is asleep on it, a wake-up call into the kernel
+class RenderWorkers::Semaphore
+{
+public:
+#if JUCE_MAC || JUCE_IOS
+    Semaphore() : sem_(dispatch_semaphore_create(0)) {}
+    ~Semaphore() { dispatch_release(sem_); }
+    void post() { dispatch_semaphore_signal(sem_); }
+    void wait() { dispatch_semaphore_wait(sem_, DISPATCH_TIME_FOREVER); }
+
+private:
+    dispatch_semaphore_t sem_;
+#elif JUCE_WINDOWS
+    Semaphore() : sem_(CreateSemaphoreW(nullptr, 0, LONG_MAX, nullptr)) {}
+    ~Semaphore() { CloseHandle(sem_); }
+    void post() { ReleaseSemaphore(sem_, 1, nullptr); }
+    void wait() { WaitForSingleObject(sem_, INFINITE); }
+
+private:
+    HANDLE sem_;
+#else
+    Semaphore() { sem_init(&sem_, 0, 0); }
+    ~Semaphore() { sem_destroy(&sem_); }
+    void post() { sem_post(&sem_); }
+    void wait()
+    {
+        while (sem_wait(&sem_) != 0 && errno == EINTR)
+            ;
+    }
+
+private:
+    sem_t sem_;
+#endif
+
+    JUCE_DECLARE_NON_COPYABLE(Semaphore)
+};
+
+class RenderWorkers::Worker : public juce::Thread
+{
+public:
+    Worker(RenderWorkers& owner, int index)
+        : juce::Thread("Render worker " + juce::String(index)), owner_(owner), index_(index)
+    {
+    }
+
+    void wake() { wake_.post(); }
+
+    void stopWorker()
+    {
+        signalThreadShouldExit();
+        wake_.post();
+        stopThread(1000);
+    }
+
+private:
+    void run() override
+    {
+        juce::ScopedNoDenormals noDenormals;
+        for (;;)
+        {
+            wake_.wait();
+            if (threadShouldExit())
+                break;
+            while (owner_.runNext(index_))
+                ;
+        }
+    }
+
+    RenderWorkers& owner_;
+    int index_;
+    Semaphore wake_;
+};
+
+RenderWorkers::RenderWorkers() : finished_(std::make_unique<Semaphore>()) {}
+
+RenderWorkers::~RenderWorkers()
+{
+    stop();
+}
+
+void RenderWorkers::start(int samplesPerBlock, double sampleRate)
+{
+    stop();
+
+    const int numWorkers = juce::jlimit(0, kMaxWorkers, juce::SystemStats::getNumPhysicalCpus() - 1);
+    const auto options = juce::Thread::RealtimeOptions{}
+                             .withApproximateAudioProcessingTime(juce::jmax(1, samplesPerBlock), sampleRate);
+    for (int i = 0; i < numWorkers; ++i)
+    {
+        auto worker = std::make_unique<Worker>(*this, i + 1);
+        // No realtime priority (sandboxed, or not permitted) - still worth
+        // having as a normal thread
+        if (!worker->startRealtimeThread(options))
+            worker->startThread(juce::Thread::Priority::highest);
+        workers_.push_back(std::move(worker));
+    }
+}
+
+void RenderWorkers::stop()
+{
+    for (auto& worker : workers_)
+        worker->stopWorker();
+    workers_.clear();
+}
+
+void RenderWorkers::run(Task& task, const int* items, int numItems)
+{
+    if (workers_.empty() || numItems <= 1)
+    {
+        for (int i = 0; i < numItems; ++i)
+            task.run(items[i], 0);
+        return;
+    }
+
+    // Published before the claim word, which is stored with release
+    task_ = &task;
+    items_ = items;
+    remaining_.store(numItems, std::memory_order_relaxed);
+    ++generation_;
+    work_.store(static_cast<uint64_t>(generation_) << 32 | static_cast<uint64_t>(numItems) << 16,
+                std::memory_order_release);
+
+    // The audio thread takes an item too, so wake one helper fewer
+    const int toWake = juce::jmin(getNumWorkers(), numItems - 1);
+    for (int i = 0; i < toWake; ++i)
+        workers_[static_cast<size_t>(i)]->wake();
+
+    while (runNext(0))
+        ;
+    waitForRemaining();
+}
+
+void RenderWorkers::waitForRemaining()
+{
+    // Nothing is left unclaimed by now; the helpers' last items are usually
+    // nearly done, so spin briefly first
+    for (int spin = 0; spin < kSpinBudget; ++spin)
+    {
+        if (remaining_.load(std::memory_order_acquire) == 0)
+            return;
+        std::this_thread::yield();
+    }
+
+    // Then sleep until the helper that finishes the last item posts. The flag
+    // goes up before the re-check, so that post can't be missed
+    audioWaiting_.store(true, std::memory_order_seq_cst);
+    if (remaining_.load(std::memory_order_seq_cst) > 0)
+    {
+        finished_->wait();
+        return;
+    }
+
+    // Done after all - but a helper may have seen the flag and posted anyway
+    if (!audioWaiting_.exchange(false, std::memory_order_seq_cst))
+        finished_->wait();  // Takes that post, without blocking
+}
+
+bool RenderWorkers::runNext(int thread)
+{
+    uint64_t work = work_.load(std::memory_order_acquire);
+    uint32_t next;
+    do
+    {
+        next = static_cast<uint32_t>(work & 0xffff);
+        const auto numItems = static_cast<uint32_t>((work >> 16) & 0xffff);
+        if (next >= numItems)
+            return false;
+    } while (!work_.compare_exchange_weak(work, work + 1, std::memory_order_acq_rel, std::memory_order_acquire));
+
+    // The run this item belongs to can't finish (and task_ can't change)
+    // until remaining_ counts it
+    task_->run(items_[next], thread);
+    if (remaining_.fetch_sub(1, std::memory_order_seq_cst) == 1 &&
+        audioWaiting_.exchange(false, std::memory_order_seq_cst))
+        finished_->post();
+    return true;
+}
+
+} // namespace audio
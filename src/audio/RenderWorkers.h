@@ -0,0 +1,73 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace audio {
+
+// Helper threads that render independent parts of an audio block alongside
+// the audio thread - in practice the nodes of one RoutingGraph level.
+//
+// The helpers are realtime threads, started with the device and parked on
+// an OS semaphore between blocks (posting one takes no lock). run() hands out
+// items one at a time: the audio thread and every woken helper claim the next
+// item until none are left, so a helper that is slow to wake just leaves its
+// share to the audio thread. Then the audio thread waits for the items still
+// being rendered - spinning for a while, then sleeping until the last helper
+// posts it. No allocation once started. Not the JobScheduler: that is for
+// background work that may take seconds, this is for work due within the
+// block.
+class RenderWorkers
+{
+public:
+    static constexpr int kMaxWorkers = 3;
+    static constexpr int kMaxThreads = kMaxWorkers + 1;  // Including the audio thread, index 0
+
+    struct Task
+    {
+        virtual ~Task() = default;
+        // Called once per item, on any of the threads (0 = the audio thread)
+        virtual void run(int item, int thread) = 0;
+    };
+
+    RenderWorkers();
+    ~RenderWorkers();
+
+    // Message thread. Starts one helper per spare physical core, up to
+    // kMaxWorkers; the audio thread's own core isn't counted
+    void start(int samplesPerBlock, double sampleRate);
+    void stop();
+
+    int getNumWorkers() const { return static_cast<int>(workers_.size()); }
+
+    // Audio thread. Runs task for each of the items and returns when all are
+    // done. With no helpers (or one item) it simply runs them in order
+    void run(Task& task, const int* items, int numItems);
+
+private:
+    class Semaphore;
+    class Worker;
+
+    bool runNext(int thread);
+    void waitForRemaining();
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+
+    // generation << 32 | numItems << 16 | next item. Claiming an item is one
+    // compare-and-swap; a new generation stops stale claims from helpers
+    // that are late for the previous run
+    std::atomic<uint64_t> work_{0};
+    uint32_t generation_ = 0;
+    Task* task_ = nullptr;
+    const int* items_ = nullptr;
+    std::atomic<int> remaining_{0};
+
+    // Set while the audio thread sleeps on finished_; whoever clears it posts
+    std::atomic<bool> audioWaiting_{false};
+    std::unique_ptr<Semaphore> finished_;
+};
+
+} // namespace audio
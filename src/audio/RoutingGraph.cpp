@@ -0,0 +1,249 @@
+#include "RoutingGraph.h"
+#include "../model/MemoryUsage.h"
+#include <algorithm>
+
+namespace audio {
+
+namespace {
+
+// Below this a send is off, and its source isn't wired to the return
+constexpr float kSendThreshold = 0.001f;
+
+constexpr int kKeyBit = 1 << RoutingGraph::NumReturns;
+constexpr int kDuckBit = kKeyBit << 1;
+
+int sendBits(const model::SendLevels& sends)
+{
+    return (sends.reverb > kSendThreshold ? 1 << RoutingGraph::ReverbReturn : 0)
+         | (sends.delay > kSendThreshold ? 1 << RoutingGraph::DelayReturn : 0)
+         | (sends.chorus > kSendThreshold ? 1 << RoutingGraph::ChorusReturn : 0)
+         | (sends.sidechainKey > kSendThreshold ? kKeyBit : 0)
+         | (sends.sidechainDuck > kSendThreshold ? kDuckBit : 0);
+}
+
+} // anonymous namespace
+
+RoutingGraph::Key RoutingGraph::makeKey(const model::Project& project)
+{
+    const auto& mixer = project.getMixer();
+    const int numInstruments = project.getInstrumentCount();
+    const int numBuses = static_cast<int>(mixer.buses.size());
+
+    Key key;
+    key.reserve(static_cast<size_t>(3 + 2 * (numInstruments + numBuses)));
+    key.push_back(numInstruments);
+    key.push_back(numBuses);
+    for (int i = 0; i < numInstruments; ++i)
+    {
+        const auto* instrument = project.getInstrument(i);
+        key.push_back(instrument->getOutput());
+        key.push_back(sendBits(instrument->getSends()));
+    }
+    for (const auto& bus : mixer.buses)
+    {
+        key.push_back(bus.output);
+        key.push_back(sendBits(bus.sends));
+    }
+    return key;
+}
+
+std::unique_ptr<RoutingGraph> RoutingGraph::compile(const model::Project& project)
+{
+    std::unique_ptr<RoutingGraph> graph(new RoutingGraph());
+    graph->key_ = makeKey(project);
+
+    const auto& mixer = project.getMixer();
+    const int numInstruments = project.getInstrumentCount();
+    const int numBuses = static_cast<int>(mixer.buses.size());
+    graph->numInstruments_ = numInstruments;
+    graph->numBuses_ = numBuses;
+
+    auto& nodes = graph->nodes_;
+    nodes.resize(static_cast<size_t>(numInstruments + numBuses + NumReturns + 2));
+    const int master = graph->getMasterNode();
+    const int key = graph->getKeyNode();
+
+    // Outputs, made safe: the project refuses bad routes, but a graph must
+    // never have a loop whatever it is given
+    auto outputNode = [&](int output) {
+        return output >= 0 && output < numBuses ? graph->getBusNode(output) : master;
+    };
+    std::vector<int> busOutputs(static_cast<size_t>(numBuses));
+    for (int b = 0; b < numBuses; ++b)
+    {
+        int output = mixer.buses[static_cast<size_t>(b)].output;
+        if (output >= 0 && project.feedsBus(output, b))
+            output = -1;
+        busOutputs[static_cast<size_t>(b)] = output;
+    }
+
+    // A channel mixed into a bus that keys the sidechain can't be ducked by
+    // it - the key would wait on itself
+    auto feedsKey = [&](int output) {
+        for (int steps = 0; output >= 0 && output < numBuses && steps < numBuses; ++steps)
+        {
+            if (sendBits(mixer.buses[static_cast<size_t>(output)].sends) & kKeyBit)
+                return true;
+            output = busOutputs[static_cast<size_t>(output)];
+        }
+        return false;
+    };
+
+    auto connect = [&](int source, int output, const model::SendLevels& sends) {
+        nodes[static_cast<size_t>(outputNode(output))].inputs.push_back(source);
+        const int bits = sendBits(sends);
+        for (int r = 0; r < NumReturns; ++r)
+        {
+            if (bits & (1 << r))
+                nodes[static_cast<size_t>(graph->getReturnNode(r))].inputs.push_back(source);
+        }
+        if (bits & kKeyBit)
+            nodes[static_cast<size_t>(key)].inputs.push_back(source);
+        nodes[static_cast<size_t>(source)].ducked = (bits & kDuckBit) && !feedsKey(output);
+    };
+
+    for (int i = 0; i < numInstruments; ++i)
+    {
+        auto& node = nodes[static_cast<size_t>(i)];
+        node.type = NodeType::Instrument;
+        node.index = i;
+        const auto* instrument = project.getInstrument(i);
+        connect(i, instrument->getOutput(), instrument->getSends());
+    }
+    for (int b = 0; b < numBuses; ++b)
+    {
+        const int id = graph->getBusNode(b);
+        nodes[static_cast<size_t>(id)].type = NodeType::Bus;
+        nodes[static_cast<size_t>(id)].index = b;
+        connect(id, busOutputs[static_cast<size_t>(b)], mixer.buses[static_cast<size_t>(b)].sends);
+    }
+    for (int r = 0; r < NumReturns; ++r)
+    {
+        auto& node = nodes[static_cast<size_t>(graph->getReturnNode(r))];
+        node.type = NodeType::Return;
+        node.index = r;
+        nodes[static_cast<size_t>(master)].inputs.push_back(graph->getReturnNode(r));
+    }
+    nodes[static_cast<size_t>(key)].type = NodeType::Key;
+    nodes[static_cast<size_t>(master)].type = NodeType::Master;
+
+    // Levels: after every input, and after the key for a ducked input (the
+    // key reads its inputs as they are, so it has no such wait). Instruments
+    // are level 0 and everything else at least 1. Ids aren't in dependency
+    // order (a bus can be fed by a later bus), so repeat until nothing moves
+    // - the graph has no loops, so that takes at most one pass per node
+    auto levelOf = [&](int id) {
+        const auto& node = nodes[static_cast<size_t>(id)];
+        int level = 1;
+        for (int input : node.inputs)
+        {
+            const auto& source = nodes[static_cast<size_t>(input)];
+            level = std::max(level, source.level + 1);
+            if (source.ducked && id != key)
+                level = std::max(level, nodes[static_cast<size_t>(key)].level + 1);
+        }
+        return level;
+    };
+    for (bool changed = true; changed;)
+    {
+        changed = false;
+        for (int id = numInstruments; id < static_cast<int>(nodes.size()); ++id)
+        {
+            const int level = levelOf(id);
+            changed = changed || level != nodes[static_cast<size_t>(id)].level;
+            nodes[static_cast<size_t>(id)].level = level;
+        }
+    }
+
+    graph->levels_.resize(static_cast<size_t>(nodes[static_cast<size_t>(master)].level));
+    for (int id = 0; id < master; ++id)
+        graph->levels_[static_cast<size_t>(nodes[static_cast<size_t>(id)].level)].push_back(id);
+
+    graph->assignBuffers();
+    graph->active_.assign(nodes.size(), 0);
+    return graph;
+}
+
+void RoutingGraph::assignBuffers()
+{
+    // Last level each node is read at (the key is only read by itself)
+    std::vector<int> lastUse(nodes_.size(), 0);
+    for (const auto& node : nodes_)
+    {
+        for (int input : node.inputs)
+            lastUse[static_cast<size_t>(input)] = std::max(lastUse[static_cast<size_t>(input)], node.level);
+    }
+    const int key = getKeyNode();
+    lastUse[static_cast<size_t>(key)] = nodes_[static_cast<size_t>(key)].level;
+
+    // Level by level, hand back the buffers of nodes no longer read, then
+    // give each node of the level a free one
+    std::vector<int> free;
+    std::vector<int> owners;  // Node holding each buffer
+    numBuffers_ = 0;
+    for (int level = 0; level < getNumLevels(); ++level)
+    {
+        for (int buffer = 0; buffer < numBuffers_; ++buffer)
+        {
+            int& owner = owners[static_cast<size_t>(buffer)];
+            if (owner >= 0 && lastUse[static_cast<size_t>(owner)] < level)
+            {
+                owner = -1;
+                free.push_back(buffer);
+            }
+        }
+        for (int id : levels_[static_cast<size_t>(level)])
+        {
+            int buffer;
+            if (free.empty())
+            {
+                buffer = numBuffers_++;
+                owners.push_back(id);
+            }
+            else
+            {
+                buffer = free.back();
+                free.pop_back();
+                owners[static_cast<size_t>(buffer)] = id;
+            }
+            nodes_[static_cast<size_t>(id)].buffer = buffer;
+        }
+    }
+
+    pool_.assign(static_cast<size_t>(numBuffers_) * 2 * kMaxBlockSize, 0.0f);
+}
+
+int RoutingGraph::getInstrumentNode(int instrument) const
+{
+    return instrument >= 0 && instrument < numInstruments_ ? instrument : -1;
+}
+
+int RoutingGraph::getBusNode(int bus) const
+{
+    return bus >= 0 && bus < numBuses_ ? numInstruments_ + bus : -1;
+}
+
+float* RoutingGraph::getChannel(int node, int channel)
+{
+    const int buffer = nodes_[static_cast<size_t>(node)].buffer;
+    return pool_.data() + (static_cast<size_t>(buffer) * 2 + static_cast<size_t>(channel)) * kMaxBlockSize;
+}
+
+const float* RoutingGraph::getChannel(int node, int channel) const
+{
+    const int buffer = nodes_[static_cast<size_t>(node)].buffer;
+    return pool_.data() + (static_cast<size_t>(buffer) * 2 + static_cast<size_t>(channel)) * kMaxBlockSize;
+}
+
+size_t RoutingGraph::getAllocatedBytes() const
+{
+    size_t bytes = model::bytesOf(key_) + model::bytesOf(nodes_) + model::bytesOf(levels_)
+                 + model::bytesOf(pool_) + model::bytesOf(active_);
+    for (const auto& node : nodes_)
+        bytes += model::bytesOf(node.inputs);
+    for (const auto& level : levels_)
+        bytes += model::bytesOf(level);
+    return bytes;
+}
+
+} // namespace audio
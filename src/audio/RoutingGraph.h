@@ -0,0 +1,95 @@
+#pragma once
+
+#include "../model/Project.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace audio {
+
+// The mixer's signal flow, compiled for the audio thread.
+//
+// Nodes are instrument channels, group buses, the effect returns, the
+// sidechain key and the master. Instruments and buses go to one bus or the
+// master, and to each return (and the key) they have a send to. Channels
+// with a sidechain duck amount are ducked where they are mixed in, so their
+// readers come after the key. The compiled graph is a schedule of levels:
+// every node reads only nodes of lower levels, so the nodes of one level can
+// render in parallel. Each node writes one stereo buffer; buffers are shared
+// between nodes whose lifetimes (from the level that writes to the last
+// level that reads) don't overlap, and all of them are allocated here.
+//
+// Compiled on the message thread and immutable afterwards. Levels (volume,
+// pan, send amounts) are read from the project as the graph renders; only a
+// change of routing needs a new graph, see makeKey().
+class RoutingGraph
+{
+public:
+    static constexpr int kMaxBlockSize = 512;
+
+    enum class NodeType { Instrument, Bus, Return, Key, Master };
+    enum Return { ReverbReturn, DelayReturn, ChorusReturn, NumReturns };
+
+    struct Node
+    {
+        NodeType type = NodeType::Instrument;
+        int index = 0;            // Instrument, bus or Return
+        int level = 0;
+        int buffer = -1;          // None for the master, which renders into the output
+        std::vector<int> inputs;  // Nodes summed into this one
+        bool ducked = false;      // Readers apply the sidechain gain
+    };
+
+    using Key = std::vector<int>;
+
+    // What the graph depends on: each channel's output and which sends
+    // (including the sidechain key and duck) are non-zero. Cheap to compare
+    // every tick
+    static Key makeKey(const model::Project& project);
+
+    static std::unique_ptr<RoutingGraph> compile(const model::Project& project);
+
+    const Key& getKey() const { return key_; }
+
+    const std::vector<Node>& getNodes() const { return nodes_; }
+    const Node& getNode(int node) const { return nodes_[static_cast<size_t>(node)]; }
+
+    // Node indices of instruments and buses, -1 where there is none
+    int getInstrumentNode(int instrument) const;
+    int getBusNode(int bus) const;
+    int getReturnNode(int ret) const { return numInstruments_ + numBuses_ + ret; }
+    int getKeyNode() const { return numInstruments_ + numBuses_ + NumReturns; }
+    int getMasterNode() const { return static_cast<int>(nodes_.size()) - 1; }
+
+    // Every level except the master's, which is always last
+    int getNumLevels() const { return static_cast<int>(levels_.size()); }
+    const std::vector<int>& getLevel(int level) const { return levels_[static_cast<size_t>(level)]; }
+
+    float* getChannel(int node, int channel);
+    const float* getChannel(int node, int channel) const;
+    int getNumBuffers() const { return numBuffers_; }
+
+    // Node lists and the buffer pool (see model/MemoryUsage.h)
+    size_t getAllocatedBytes() const;
+
+    // Whether a node made any sound this block, so readers can skip it.
+    // Written by the node's own render, from whichever thread ran it
+    void setActive(int node, bool active) { active_[static_cast<size_t>(node)] = active ? 1 : 0; }
+    bool isActive(int node) const { return active_[static_cast<size_t>(node)] != 0; }
+
+private:
+    RoutingGraph() = default;
+
+    void assignBuffers();
+
+    Key key_;
+    std::vector<Node> nodes_;
+    std::vector<std::vector<int>> levels_;
+    int numInstruments_ = 0;
+    int numBuses_ = 0;
+    int numBuffers_ = 0;
+    std::vector<float> pool_;  // numBuffers_ x 2 channels x kMaxBlockSize
+    std::vector<uint8_t> active_;  // Not vector<bool>: nodes set theirs concurrently
+};
+
+} // namespace audio
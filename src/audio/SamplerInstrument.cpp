@@ -1,21 +1,10 @@
 #include "SamplerInstrument.h"
-#include "Voice.h"
 #include "../dsp/AudioAnalysis.h"
 #include <cmath>
 #include <algorithm>
 
 namespace audio {
 
-std::unique_ptr<audio::Voice> SamplerInstrument::createVoice() {
-    // TODO: Implement SamplerVoice as Voice subclass
-    return nullptr;
-}
-
-void SamplerInstrument::updateVoiceParameters(audio::Voice* voice) {
-    // TODO: Implement parameter update for SamplerVoice
-    (void)voice;
-}
-
 // Map 0-1 to milliseconds for attack (1ms to 2000ms, exponential)
 static float mapAttackMs(float normalized) {
     return 1.0f + std::pow(normalized, 2.0f) * 1999.0f;
@@ -27,11 +16,14 @@ static float mapDecayMs(float normalized) {
 }
 
 SamplerInstrument::SamplerInstrument() {
-    formatManager_.registerBasicFormats();
     tempBufferL_.fill(0.0f);
     tempBufferR_.fill(0.0f);
 }
 
+SamplerInstrument::~SamplerInstrument() {
+    loadToken_.cancel();
+}
+
 void SamplerInstrument::init(double sampleRate) {
     sampleRate_ = sampleRate;
     for (auto& voice : voices_) {
@@ -187,9 +179,12 @@ int64_t SamplerInstrument::getPlayheadPosition() const {
     return -1;  // No active voice
 }
 
-bool SamplerInstrument::loadSample(const juce::File& file) {
+bool SamplerInstrument::decodeSample(const juce::File& file, DecodedSample& decoded,
+                                     const model::JobScheduler::CancellationToken* token) {
+    juce::AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
     std::unique_ptr<juce::AudioFormatReader> reader(
-        formatManager_.createReaderFor(file)
+        formatManager.createReaderFor(file)
     );
 
     if (!reader) {
@@ -197,7 +192,7 @@ bool SamplerInstrument::loadSample(const juce::File& file) {
         return false;
     }
 
-    loadedSampleRate_ = static_cast<int>(reader->sampleRate);
+    decoded.sampleRate = static_cast<int>(reader->sampleRate);
     const int numChannels = static_cast<int>(reader->numChannels);
     const juce::int64 numSamples = reader->lengthInSamples;
 
@@ -207,10 +202,57 @@ bool SamplerInstrument::loadSample(const juce::File& file) {
         DBG("Warning: Large sample file (" << (dataSize / (1024 * 1024)) << " MB)");
     }
 
-    sampleBuffer_.setSize(numChannels, static_cast<int>(numSamples));
-    reader->read(&sampleBuffer_, 0, static_cast<int>(numSamples), 0, true, true);
+    decoded.buffer.setSize(numChannels, static_cast<int>(numSamples));
+    reader->read(&decoded.buffer, 0, static_cast<int>(numSamples), 0, true, true);
+    if (token != nullptr && token->isCancelled())
+        return false;
 
-    // Update instrument's sample ref and detect pitch
+    // Detect pitch for auto-repitch
+    decoded.detectedPitch = dsp::AudioAnalysis::detectPitch(
+        decoded.buffer.getReadPointer(0),
+        static_cast<size_t>(numSamples),
+        decoded.sampleRate
+    );
+    return true;
+}
+
+bool SamplerInstrument::loadSample(const juce::File& file) {
+    DecodedSample decoded;
+    if (!decodeSample(file, decoded, nullptr))
+        return false;
+
+    installSample(file, std::move(decoded));
+    return true;
+}
+
+void SamplerInstrument::loadSampleAsync(const juce::File& file, std::function<void(bool)> onLoaded) {
+    // A newer load replaces one still in flight
+    loadToken_.cancel();
+    loadToken_ = {};
+
+    auto decoded = std::make_shared<DecodedSample>();
+    auto ok = std::make_shared<bool>(false);
+    scheduler_->submit(
+        model::JobScheduler::Priority::Interactive, loadToken_,
+        [file, decoded, ok](const model::JobScheduler::CancellationToken& token) {
+            *ok = decodeSample(file, *decoded, &token);
+        },
+        // Not called once cancelled, which the destructor does
+        [this, file, decoded, ok, onLoaded = std::move(onLoaded)]() {
+            if (*ok)
+                installSample(file, std::move(*decoded));
+            if (onLoaded)
+                onLoaded(*ok);
+        });
+}
+
+void SamplerInstrument::installSample(const juce::File& file, DecodedSample&& decoded) {
+    sampleBuffer_ = std::move(decoded.buffer);
+    loadedSampleRate_ = decoded.sampleRate;
+    const int numChannels = sampleBuffer_.getNumChannels();
+    const int numSamples = sampleBuffer_.getNumSamples();
+
+    // Update instrument's sample ref and detected pitch
     if (instrument_) {
         auto& params = instrument_->getSamplerParams();
         auto& sampleRef = params.sample;
@@ -219,13 +261,7 @@ bool SamplerInstrument::loadSample(const juce::File& file) {
         sampleRef.sampleRate = loadedSampleRate_;
         sampleRef.numSamples = static_cast<size_t>(numSamples);
 
-        // Detect pitch for auto-repitch
-        float detectedPitch = dsp::AudioAnalysis::detectPitch(
-            sampleBuffer_.getReadPointer(0),
-            static_cast<size_t>(numSamples),
-            loadedSampleRate_
-        );
-
+        const float detectedPitch = decoded.detectedPitch;
         if (detectedPitch > 0.0f) {
             params.detectedPitchHz = detectedPitch;
             params.detectedMidiNote = dsp::AudioAnalysis::frequencyToMidiNote(detectedPitch);
@@ -269,8 +305,6 @@ bool SamplerInstrument::loadSample(const juce::File& file) {
         << " (" << numChannels << " ch, "
         << loadedSampleRate_ << " Hz, "
         << numSamples << " samples)");
-
-    return true;
 }
 
 void SamplerInstrument::setTempo(double bpm) {
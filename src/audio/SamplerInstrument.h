@@ -3,29 +3,27 @@
 #include "InstrumentProcessor.h"
 #include "SamplerVoice.h"
 #include "../model/Instrument.h"
+#include "../model/JobScheduler.h"
 #include "../dsp/sampler_modulation.h"
 #include <JuceHeader.h>
 #include <array>
+#include <functional>
 #include <memory>
 
 namespace audio {
 
-class SamplerInstrument : public InstrumentProcessor {
+class SamplerInstrument final : public InstrumentProcessor {
 public:
     static constexpr int NUM_VOICES = 8;
     static constexpr int kMaxBlockSize = 512;
 
     SamplerInstrument();
-    ~SamplerInstrument() override = default;
+    ~SamplerInstrument() override;
 
     // InstrumentProcessor interface
     void init(double sampleRate) override;
     void setSampleRate(double sampleRate) override;
 
-    // Voice-per-track interface
-    std::unique_ptr<audio::Voice> createVoice() override;
-    void updateVoiceParameters(audio::Voice* voice) override;
-
     // Legacy methods
     void noteOn(int note, float velocity) override;
     void noteOff(int note) override;
@@ -46,7 +44,12 @@ public:
     void setInstrument(model::Instrument* instrument) { instrument_ = instrument; }
     model::Instrument* getInstrument() const { return instrument_; }
 
+    // Decodes and analyses on the calling thread
     bool loadSample(const juce::File& file);
+    // Same, as a background job. The sample is installed on the message
+    // thread, then onLoaded is called (false if the file couldn't be read).
+    // A newer load replaces one still in flight
+    void loadSampleAsync(const juce::File& file, std::function<void(bool)> onLoaded);
     bool hasSample() const { return sampleBuffer_.getNumSamples() > 0; }
 
     // For waveform display
@@ -68,6 +71,17 @@ public:
     void setTempo(double bpm);
 
 private:
+    struct DecodedSample {
+        juce::AudioBuffer<float> buffer;
+        int sampleRate = 44100;
+        float detectedPitch = 0.0f;  // Hz, 0 if none
+    };
+
+    // Any thread
+    static bool decodeSample(const juce::File& file, DecodedSample& decoded,
+                             const model::JobScheduler::CancellationToken* token);
+    void installSample(const juce::File& file, DecodedSample&& decoded);
+
     SamplerVoice* findFreeVoice();
     SamplerVoice* findVoiceToSteal();
     void updateModulationParams();
@@ -82,7 +96,8 @@ private:
     juce::AudioBuffer<float> sampleBuffer_;
     int loadedSampleRate_ = 44100;
 
-    juce::AudioFormatManager formatManager_;
+    juce::SharedResourcePointer<model::JobScheduler> scheduler_;
+    model::JobScheduler::CancellationToken loadToken_;
     dsp::SamplerModulationMatrix modMatrix_;
 
     // Temporary buffers for processing
@@ -1,5 +1,4 @@
 #include "SlicerInstrument.h"
-#include "Voice.h"
 #include "../dsp/AudioAnalysis.h"
 #include <rubberband/RubberBandStretcher.h>
 #include <algorithm>
@@ -7,22 +6,17 @@
 
 namespace audio {
 
-std::unique_ptr<audio::Voice> SlicerInstrument::createVoice() {
-    // TODO: Implement SlicerVoice as Voice subclass
-    return nullptr;
-}
-
-void SlicerInstrument::updateVoiceParameters(audio::Voice* voice) {
-    // TODO: Implement parameter update for SlicerVoice
-    (void)voice;
-}
-
 SlicerInstrument::SlicerInstrument() {
-    formatManager_.registerBasicFormats();
     tempBufferL_.fill(0.0f);
     tempBufferR_.fill(0.0f);
 }
 
+SlicerInstrument::~SlicerInstrument() {
+    loadToken_.cancel();
+    chopToken_.cancel();
+    stretchToken_.cancel();
+}
+
 void SlicerInstrument::init(double sampleRate) {
     sampleRate_ = sampleRate;
     for (auto& voice : voices_) {
@@ -228,9 +222,12 @@ SlicerVoice* SlicerInstrument::findVoiceToSteal() {
     return &voices_[0];
 }
 
-bool SlicerInstrument::loadSample(const juce::File& file) {
+bool SlicerInstrument::decodeSample(const juce::File& file, DecodedSample& decoded,
+                                    const model::JobScheduler::CancellationToken* token) {
+    juce::AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
     std::unique_ptr<juce::AudioFormatReader> reader(
-        formatManager_.createReaderFor(file)
+        formatManager.createReaderFor(file)
     );
 
     if (!reader) {
@@ -238,7 +235,7 @@ bool SlicerInstrument::loadSample(const juce::File& file) {
         return false;
     }
 
-    loadedSampleRate_ = static_cast<int>(reader->sampleRate);
+    decoded.sampleRate = static_cast<int>(reader->sampleRate);
     const int numChannels = static_cast<int>(reader->numChannels);
     const juce::int64 numSamples = reader->lengthInSamples;
 
@@ -248,10 +245,70 @@ bool SlicerInstrument::loadSample(const juce::File& file) {
         DBG("Warning: Large sample file (" << (dataSize / (1024 * 1024)) << " MB)");
     }
 
-    sampleBuffer_.setSize(numChannels, static_cast<int>(numSamples));
-    reader->read(&sampleBuffer_, 0, static_cast<int>(numSamples), 0, true, true);
+    decoded.buffer.setSize(numChannels, static_cast<int>(numSamples));
+    reader->read(&decoded.buffer, 0, static_cast<int>(numSamples), 0, true, true);
+    if (token != nullptr && token->isCancelled())
+        return false;
+
+    // Detect BPM
+    decoded.detectedBPM = dsp::AudioAnalysis::detectBPM(
+        decoded.buffer.getReadPointer(0),
+        static_cast<size_t>(numSamples),
+        decoded.sampleRate
+    );
+    if (token != nullptr && token->isCancelled())
+        return false;
 
-    // Update instrument's sample ref and detect BPM
+    // Also detect pitch (optional, for display)
+    decoded.detectedPitch = dsp::AudioAnalysis::detectPitch(
+        decoded.buffer.getReadPointer(0),
+        static_cast<size_t>(numSamples),
+        decoded.sampleRate
+    );
+    return true;
+}
+
+bool SlicerInstrument::loadSample(const juce::File& file) {
+    DecodedSample decoded;
+    if (!decodeSample(file, decoded, nullptr))
+        return false;
+
+    installSample(file, std::move(decoded));
+    return true;
+}
+
+void SlicerInstrument::loadSampleAsync(const juce::File& file, std::function<void(bool)> onLoaded) {
+    // A newer load replaces one still in flight
+    loadToken_.cancel();
+    loadToken_ = {};
+
+    auto decoded = std::make_shared<DecodedSample>();
+    auto ok = std::make_shared<bool>(false);
+    scheduler_->submit(
+        model::JobScheduler::Priority::Interactive, loadToken_,
+        [file, decoded, ok](const model::JobScheduler::CancellationToken& token) {
+            *ok = decodeSample(file, *decoded, &token);
+        },
+        // Not called once cancelled, which the destructor does
+        [this, file, decoded, ok, onLoaded = std::move(onLoaded)]() {
+            if (*ok)
+                installSample(file, std::move(*decoded));
+            if (onLoaded)
+                onLoaded(*ok);
+        });
+}
+
+void SlicerInstrument::installSample(const juce::File& file, DecodedSample&& decoded) {
+    // Analysis of the previous sample no longer applies
+    chopToken_.cancel();
+    stretchToken_.cancel();
+
+    sampleBuffer_ = std::move(decoded.buffer);
+    loadedSampleRate_ = decoded.sampleRate;
+    const int numChannels = sampleBuffer_.getNumChannels();
+    const int numSamples = sampleBuffer_.getNumSamples();
+
+    // Update instrument's sample ref and detected BPM
     if (instrument_) {
         auto& params = instrument_->getSlicerParams();
         auto& sampleRef = params.sample;
@@ -260,13 +317,7 @@ bool SlicerInstrument::loadSample(const juce::File& file) {
         sampleRef.sampleRate = loadedSampleRate_;
         sampleRef.numSamples = static_cast<size_t>(numSamples);
 
-        // Detect BPM
-        float detectedBPM = dsp::AudioAnalysis::detectBPM(
-            sampleBuffer_.getReadPointer(0),
-            static_cast<size_t>(numSamples),
-            loadedSampleRate_
-        );
-
+        const float detectedBPM = decoded.detectedBPM;
         if (detectedBPM > 0.0f) {
             params.detectedBPM = detectedBPM;
             // Initialize speed to 1.0 and targetBPM to match detected (no stretching by default)
@@ -288,13 +339,7 @@ bool SlicerInstrument::loadSample(const juce::File& file) {
             DBG("No BPM detected in sample");
         }
 
-        // Also detect pitch (optional, for display)
-        float detectedPitch = dsp::AudioAnalysis::detectPitch(
-            sampleBuffer_.getReadPointer(0),
-            static_cast<size_t>(numSamples),
-            loadedSampleRate_
-        );
-
+        const float detectedPitch = decoded.detectedPitch;
         if (detectedPitch > 0.0f) {
             params.pitchHz = detectedPitch;
             params.detectedRootNote = dsp::AudioAnalysis::frequencyToMidiNote(detectedPitch);
@@ -317,8 +362,6 @@ bool SlicerInstrument::loadSample(const juce::File& file) {
         << " (" << numChannels << " ch, "
         << loadedSampleRate_ << " Hz, "
         << numSamples << " samples)");
-
-    return true;
 }
 
 void SlicerInstrument::chopIntoDivisions(int numDivisions) {
@@ -339,41 +382,59 @@ void SlicerInstrument::chopIntoDivisions(int numDivisions) {
     }
 }
 
-void SlicerInstrument::chopByTransients(float sensitivity) {
+void SlicerInstrument::chopByTransients(float sensitivity, std::function<void()> onChopped) {
     if (!instrument_ || sampleBuffer_.getNumSamples() == 0) return;
 
     auto& params = instrument_->getSlicerParams();
-    params.slicePoints.clear();
     params.transientSensitivity = sensitivity;
     params.chopMode = model::ChopMode::Transients;
 
-    // Use the first channel for transient detection
-    const float* data = sampleBuffer_.getReadPointer(0);
-    size_t numSamples = static_cast<size_t>(sampleBuffer_.getNumSamples());
-
-    // Detect transients
-    auto transients = dsp::AudioAnalysis::detectTransients(
-        data, numSamples, loadedSampleRate_, sensitivity
-    );
-
-    // Always include start position (0) as first slice
-    params.slicePoints.push_back(0);
-
-    // Add detected transients, snapping to zero crossings
-    for (size_t transientPos : transients) {
-        // Skip if too close to start
-        if (transientPos < 1000) continue;
-
-        size_t snappedPos = findNearestZeroCrossing(transientPos);
-        params.slicePoints.push_back(snappedPos);
-    }
+    // Detection runs as a background job on a copy of the first channel; a
+    // newer chop replaces one still in flight
+    chopToken_.cancel();
+    chopToken_ = {};
+
+    auto data = std::make_shared<std::vector<float>>(
+        sampleBuffer_.getReadPointer(0),
+        sampleBuffer_.getReadPointer(0) + sampleBuffer_.getNumSamples());
+    auto slicePoints = std::make_shared<std::vector<size_t>>();
+    scheduler_->submit(
+        model::JobScheduler::Priority::Interactive, chopToken_,
+        [data, slicePoints, sampleRate = loadedSampleRate_, sensitivity](
+            const model::JobScheduler::CancellationToken& token) {
+            // Detect transients
+            auto transients = dsp::AudioAnalysis::detectTransients(
+                data->data(), data->size(), sampleRate, sensitivity
+            );
+            if (token.isCancelled())
+                return;
+
+            // Always include start position (0) as first slice
+            slicePoints->push_back(0);
+
+            // Add detected transients, snapping to zero crossings
+            for (size_t transientPos : transients) {
+                // Skip if too close to start
+                if (transientPos < 1000) continue;
+
+                slicePoints->push_back(nearestZeroCrossing(data->data(), data->size(), transientPos));
+            }
 
-    // Remove duplicates (from zero-crossing snapping) and sort
-    std::sort(params.slicePoints.begin(), params.slicePoints.end());
-    auto last = std::unique(params.slicePoints.begin(), params.slicePoints.end());
-    params.slicePoints.erase(last, params.slicePoints.end());
+            // Remove duplicates (from zero-crossing snapping) and sort
+            std::sort(slicePoints->begin(), slicePoints->end());
+            auto last = std::unique(slicePoints->begin(), slicePoints->end());
+            slicePoints->erase(last, slicePoints->end());
+        },
+        // Not called once cancelled, which the destructor and a new sample do
+        [this, instrument = instrument_, slicePoints, sensitivity, onChopped = std::move(onChopped)]() {
+            if (instrument_ != instrument) return;  // Switched project meanwhile
 
-    DBG("Transient detection found " << params.slicePoints.size() << " slices with sensitivity " << sensitivity);
+            instrument_->getSlicerParams().slicePoints = std::move(*slicePoints);
+            DBG("Transient detection found " << instrument_->getSlicerParams().slicePoints.size()
+                << " slices with sensitivity " << sensitivity);
+            if (onChopped)
+                onChopped();
+        });
 }
 
 int SlicerInstrument::addSliceAtPosition(size_t samplePosition) {
@@ -419,9 +480,11 @@ int SlicerInstrument::getNumSlices() const {
 size_t SlicerInstrument::findNearestZeroCrossing(size_t position) const {
     if (sampleBuffer_.getNumSamples() == 0) return position;
 
-    const float* data = sampleBuffer_.getReadPointer(0);
-    const size_t numSamples = static_cast<size_t>(sampleBuffer_.getNumSamples());
+    return nearestZeroCrossing(sampleBuffer_.getReadPointer(0),
+                               static_cast<size_t>(sampleBuffer_.getNumSamples()), position);
+}
 
+size_t SlicerInstrument::nearestZeroCrossing(const float* data, size_t numSamples, size_t position) {
     // Search window: +/- 1024 samples
     const size_t searchRadius = 1024;
     size_t start = (position > searchRadius) ? position - searchRadius : 0;
@@ -599,6 +662,7 @@ void SlicerInstrument::setRepitch(bool enabled) {
     if (enabled) {
         params.pitchSemitones = static_cast<int>(std::round(12.0 * std::log2(params.speed)));
         // Clear stretched buffer since we'll use variable speed playback
+        stretchToken_.cancel();
         stretchedBuffer_.setSize(0, 0);
         stretchedBufferReady_ = false;
     } else {
@@ -671,6 +735,7 @@ void SlicerInstrument::regenerateStretchedBuffer() {
 
     // If repitch is enabled, we don't need the stretched buffer
     if (params.repitch) {
+        stretchToken_.cancel();
         stretchedBuffer_.setSize(0, 0);
         stretchedBufferReady_ = false;
         lastStretchSpeed_ = params.speed;
@@ -682,6 +747,10 @@ void SlicerInstrument::regenerateStretchedBuffer() {
         return;
     }
 
+    // A newer stretch replaces one still in flight
+    stretchToken_.cancel();
+    stretchToken_ = {};
+
     // Stop all voices before regenerating - they hold raw pointers to the buffer
     // which would become invalid after reallocation
     allNotesOff();
@@ -708,20 +777,44 @@ void SlicerInstrument::regenerateStretchedBuffer() {
         return;
     }
 
-    int numChannels = sampleBuffer_.getNumChannels();
-    size_t numInputSamples = static_cast<size_t>(sampleBuffer_.getNumSamples());
+    // RubberBand runs as a background job on a copy of the sample. Until it
+    // is done, voices play the original
+    auto input = std::make_shared<juce::AudioBuffer<float>>(sampleBuffer_);
+    auto output = std::make_shared<juce::AudioBuffer<float>>();
+    scheduler_->submit(
+        model::JobScheduler::Priority::Interactive, stretchToken_,
+        [input, output, sampleRate = loadedSampleRate_, timeRatio](
+            const model::JobScheduler::CancellationToken& token) {
+            *output = stretch(*input, sampleRate, timeRatio, token);
+        },
+        // Not called once cancelled, which the destructor and a new sample do
+        [this, output]() {
+            if (output->getNumSamples() == 0) {
+                DBG("Failed to generate stretched buffer");
+                return;
+            }
+            allNotesOff();
+            stretchedBuffer_ = std::move(*output);
+            stretchedBufferReady_ = true;
+        });
+}
+
+juce::AudioBuffer<float> SlicerInstrument::stretch(const juce::AudioBuffer<float>& input, int sampleRate,
+                                                   double timeRatio,
+                                                   const model::JobScheduler::CancellationToken& token) {
+    int numChannels = input.getNumChannels();
+    size_t numInputSamples = static_cast<size_t>(input.getNumSamples());
 
     // Estimate output size
     size_t estimatedOutputSamples = static_cast<size_t>(numInputSamples * timeRatio) + 1024;
 
-    DBG("Regenerating stretched buffer: speed=" << params.speed
-        << " timeRatio=" << timeRatio
+    DBG("Regenerating stretched buffer: timeRatio=" << timeRatio
         << " inputSamples=" << numInputSamples
         << " estimatedOutput=" << estimatedOutputSamples);
 
     // Create RubberBand stretcher in offline mode for best quality
     RubberBand::RubberBandStretcher stretcher(
-        static_cast<size_t>(loadedSampleRate_),
+        static_cast<size_t>(sampleRate),
         static_cast<size_t>(numChannels),
         RubberBand::RubberBandStretcher::OptionProcessOffline |
         RubberBand::RubberBandStretcher::OptionEngineFiner |
@@ -736,12 +829,15 @@ void SlicerInstrument::regenerateStretchedBuffer() {
     // Prepare input pointers for each channel
     std::vector<const float*> inputPtrs(static_cast<size_t>(numChannels));
     for (int ch = 0; ch < numChannels; ++ch) {
-        inputPtrs[static_cast<size_t>(ch)] = sampleBuffer_.getReadPointer(ch);
+        inputPtrs[static_cast<size_t>(ch)] = input.getReadPointer(ch);
     }
 
     // First pass: study
     size_t pos = 0;
     while (pos < numInputSamples) {
+        if (token.isCancelled())
+            return {};
+
         size_t remaining = numInputSamples - pos;
         size_t thisBlock = std::min(blockSize, remaining);
         bool final = (pos + thisBlock >= numInputSamples);
@@ -770,6 +866,9 @@ void SlicerInstrument::regenerateStretchedBuffer() {
     }
 
     while (pos < numInputSamples) {
+        if (token.isCancelled())
+            return {};
+
         size_t remaining = numInputSamples - pos;
         size_t thisBlock = std::min(blockSize, remaining);
         bool final = (pos + thisBlock >= numInputSamples);
@@ -803,23 +902,20 @@ void SlicerInstrument::regenerateStretchedBuffer() {
         }
     }
 
-    // Copy to JUCE buffer
+    // Copy to JUCE buffer (empty on failure)
+    juce::AudioBuffer<float> stretched;
     if (!outputChannels.empty() && !outputChannels[0].empty()) {
         int outputSamples = static_cast<int>(outputChannels[0].size());
-        stretchedBuffer_.setSize(numChannels, outputSamples);
+        stretched.setSize(numChannels, outputSamples);
 
         for (int ch = 0; ch < numChannels; ++ch) {
-            stretchedBuffer_.copyFrom(ch, 0, outputChannels[static_cast<size_t>(ch)].data(), outputSamples);
+            stretched.copyFrom(ch, 0, outputChannels[static_cast<size_t>(ch)].data(), outputSamples);
         }
 
-        stretchedBufferReady_ = true;
         DBG("Stretched buffer ready: " << outputSamples << " samples (ratio: "
             << (static_cast<float>(outputSamples) / numInputSamples) << ")");
-    } else {
-        DBG("Failed to generate stretched buffer");
-        stretchedBuffer_.setSize(0, 0);
-        stretchedBufferReady_ = false;
     }
+    return stretched;
 }
 
 // ============================================================================
@@ -3,30 +3,28 @@
 #include "InstrumentProcessor.h"
 #include "SlicerVoice.h"
 #include "../model/Instrument.h"
+#include "../model/JobScheduler.h"
 #include "../dsp/sampler_modulation.h"
 #include <JuceHeader.h>
 #include <array>
 #include <atomic>
+#include <functional>
 
 namespace audio {
 
-class SlicerInstrument : public InstrumentProcessor {
+class SlicerInstrument final : public InstrumentProcessor {
 public:
     static constexpr int NUM_VOICES = 8;
     static constexpr int BASE_NOTE = 12;  // C-1 (tracker notation) = slice 0
     static constexpr int kMaxBlockSize = 512;
 
     SlicerInstrument();
-    ~SlicerInstrument() override = default;
+    ~SlicerInstrument() override;
 
     // InstrumentProcessor interface
     void init(double sampleRate) override;
     void setSampleRate(double sampleRate) override;
 
-    // Voice-per-track interface
-    std::unique_ptr<audio::Voice> createVoice() override;
-    void updateVoiceParameters(audio::Voice* voice) override;
-
     // Legacy methods
     void noteOn(int note, float velocity) override;
     void noteOff(int note) override;
@@ -47,12 +45,19 @@ public:
     void setInstrument(model::Instrument* instrument) { instrument_ = instrument; }
     model::Instrument* getInstrument() const { return instrument_; }
 
+    // Decodes and analyses (BPM, pitch) on the calling thread
     bool loadSample(const juce::File& file);
+    // Same, as a background job. The sample is installed on the message
+    // thread, then onLoaded is called (false if the file couldn't be read).
+    // A newer load replaces one still in flight
+    void loadSampleAsync(const juce::File& file, std::function<void(bool)> onLoaded);
     bool hasSample() const { return sampleBuffer_.getNumSamples() > 0; }
 
     // Slice management
     void chopIntoDivisions(int numDivisions);
-    void chopByTransients(float sensitivity);  // Auto-detect transients and create slices
+    // Auto-detect transients and create slices. Detection is a background
+    // job; the slices are replaced, then onChopped called, on the message thread
+    void chopByTransients(float sensitivity, std::function<void()> onChopped = {});
     int addSliceAtPosition(size_t samplePosition);  // Returns index of new slice
     void removeSlice(int sliceIndex);
     void clearSlices();
@@ -68,7 +73,9 @@ public:
     // Time-stretched buffer (when repitch=false)
     const juce::AudioBuffer<float>& getStretchedBuffer() const { return stretchedBuffer_; }
     bool hasStretchedBuffer() const { return stretchedBuffer_.getNumSamples() > 0; }
-    void regenerateStretchedBuffer();  // Call when speed changes and repitch=false
+    // Call when speed changes and repitch=false. RubberBand runs as a
+    // background job; voices play the original until it's ready
+    void regenerateStretchedBuffer();
 
     // Three-way dependency editing (Original BPM/Bars, Target BPM, Speed/Pitch)
     // Call these when user edits a value - they handle dependency recalculation
@@ -99,6 +106,22 @@ public:
     void setTempo(double bpm);
 
 private:
+    struct DecodedSample {
+        juce::AudioBuffer<float> buffer;
+        int sampleRate = 44100;
+        float detectedBPM = 0.0f;    // 0 if none
+        float detectedPitch = 0.0f;  // Hz, 0 if none
+    };
+
+    // Any thread
+    static bool decodeSample(const juce::File& file, DecodedSample& decoded,
+                             const model::JobScheduler::CancellationToken* token);
+    static size_t nearestZeroCrossing(const float* data, size_t numSamples, size_t position);
+    static juce::AudioBuffer<float> stretch(const juce::AudioBuffer<float>& input, int sampleRate,
+                                            double timeRatio,
+                                            const model::JobScheduler::CancellationToken& token);
+    void installSample(const juce::File& file, DecodedSample&& decoded);
+
     void updateModulationParams();
     void applyModulation(float* outL, float* outR, int numSamples);
     // Three-way dependency helpers
@@ -122,7 +145,11 @@ private:
     float lastStretchSpeed_ = 1.0f;  // Track when regeneration is needed
     std::atomic<bool> stretchedBufferReady_{false};
 
-    juce::AudioFormatManager formatManager_;
+    // Background decode, transient detection and time-stretching
+    juce::SharedResourcePointer<model::JobScheduler> scheduler_;
+    model::JobScheduler::CancellationToken loadToken_;
+    model::JobScheduler::CancellationToken chopToken_;
+    model::JobScheduler::CancellationToken stretchToken_;
 
     // Lazy chop preview state
     bool lazyChopPlaying_ = false;
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "PlaitsVoice.h"
+#include "VASynthVoice.h"
+#include "DX7Voice.h"
+#include <variant>
+
+namespace audio {
+
+// The voice a track is playing, held inline in the Track. The alternative
+// is the instrument type (monostate until the track first plays a note), so
+// rendering dispatches on it once per block and everything below is direct,
+// inlinable calls - no virtuals, no casts.
+//
+// Each voice type has the same members:
+//   void noteOn(int note, float velocity);
+//   void noteOff();
+//   void process(float* outL, float* outR, int numSamples,
+//                float pitchMod, float cutoffMod, float volumeMod, float panMod);
+//     pitchMod: semitones offset from current note (for POR/VIB)
+//     cutoffMod: 0-1 normalized (for CUT command, ignored if no filter)
+//     volumeMod: 0-1 normalized (for VOL command)
+//     panMod: 0-1 normalized, 0=left, 0.5=center, 1=right (for PAN command)
+//   bool isActive() const;
+//   int getCurrentNote() const;
+//   void setSampleRate(double sampleRate);
+//   size_t getAllocatedBytes() const;  // See model/MemoryUsage.h
+//
+// and its instrument names it as VoiceType, with initVoice() and
+// updateVoiceParameters() taking it by reference.
+//
+// Voice owns synthesis state (envelopes, oscillator phase, internal LFOs)
+// Track owns sequencing state (TrackerFX, modulation calculation)
+using TrackVoice = std::variant<std::monostate, PlaitsVoice, VASynthVoice, DX7Voice>;
+
+} // namespace audio
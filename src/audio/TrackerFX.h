@@ -12,7 +12,7 @@ namespace audio {
 class TrackerFX
 {
 public:
-    static constexpr int TICKS_PER_ROW = 6;
+    static constexpr int TICKS_PER_ROW = model::TICKS_PER_ROW;
 
     void setSampleRate(double sampleRate) {
         sampleRate_ = sampleRate;
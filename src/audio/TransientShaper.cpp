@@ -8,12 +8,15 @@ void TransientShaper::prepare(double sampleRate) {
     sampleRate_ = sampleRate;
 
     // Fast envelope: ~0.5ms attack, ~5ms release - very snappy for punch
-    fastAttack_ = 1.0f - std::exp(-1.0f / (static_cast<float>(sampleRate) * 0.0005f));
-    fastRelease_ = 1.0f - std::exp(-1.0f / (static_cast<float>(sampleRate) * 0.005f));
+    float fastAttack = 1.0f - std::exp(-1.0f / (static_cast<float>(sampleRate) * 0.0005f));
+    float fastRelease = 1.0f - std::exp(-1.0f / (static_cast<float>(sampleRate) * 0.005f));
 
     // Slow envelope: ~30ms attack, ~300ms release - bigger difference for more punch
-    slowAttack_ = 1.0f - std::exp(-1.0f / (static_cast<float>(sampleRate) * 0.03f));
-    slowRelease_ = 1.0f - std::exp(-1.0f / (static_cast<float>(sampleRate) * 0.3f));
+    float slowAttack = 1.0f - std::exp(-1.0f / (static_cast<float>(sampleRate) * 0.03f));
+    float slowRelease = 1.0f - std::exp(-1.0f / (static_cast<float>(sampleRate) * 0.3f));
+
+    attack_ = {fastAttack, fastAttack, slowAttack, slowAttack};
+    release_ = {fastRelease, fastRelease, slowRelease, slowRelease};
 
     reset();
 }
@@ -23,45 +26,52 @@ void TransientShaper::setAmount(float amount) {
 }
 
 void TransientShaper::reset() {
-    fastEnvL_ = fastEnvR_ = 0.0f;
-    slowEnvL_ = slowEnvR_ = 0.0f;
+    env_.fill(0.0f);
+    currentAmount_ = amount_;
 }
 
-void TransientShaper::process(float& left, float& right) {
-    if (amount_ < 0.001f) return;  // Bypass when off
-
-    // Rectify input
-    float absL = std::abs(left);
-    float absR = std::abs(right);
-
-    // Update fast envelope
-    float fastCoefL = (absL > fastEnvL_) ? fastAttack_ : fastRelease_;
-    float fastCoefR = (absR > fastEnvR_) ? fastAttack_ : fastRelease_;
-    fastEnvL_ += fastCoefL * (absL - fastEnvL_);
-    fastEnvR_ += fastCoefR * (absR - fastEnvR_);
-
-    // Update slow envelope
-    float slowCoefL = (absL > slowEnvL_) ? slowAttack_ : slowRelease_;
-    float slowCoefR = (absR > slowEnvR_) ? slowAttack_ : slowRelease_;
-    slowEnvL_ += slowCoefL * (absL - slowEnvL_);
-    slowEnvR_ += slowCoefR * (absR - slowEnvR_);
-
-    // Transient = difference between fast and slow envelopes
-    float transientL = std::max(0.0f, fastEnvL_ - slowEnvL_);
-    float transientR = std::max(0.0f, fastEnvR_ - slowEnvR_);
-
-    // Amplify transient signal for more pronounced detection
-    transientL = std::min(transientL * 2.0f, 1.0f);
-    transientR = std::min(transientR * 2.0f, 1.0f);
-
-    // Apply gain boost to transient portion (amount controls intensity)
-    // Scale: amount=0 -> 1x, amount=1 -> 8x boost for heavy punch
-    float boost = 1.0f + amount_ * 7.0f;
-    float gainL = 1.0f + transientL * (boost - 1.0f);
-    float gainR = 1.0f + transientR * (boost - 1.0f);
-
-    left *= gainL;
-    right *= gainR;
+void TransientShaper::process(float* left, float* right, int numSamples) {
+    // Bypass when off, and only once a fade-out has finished
+    if (amount_ < 0.001f && currentAmount_ < 0.001f) {
+        if (active_) {
+            reset();
+            active_ = false;
+        }
+        return;
+    }
+    active_ = true;
+    if (numSamples <= 0) return;
+
+    // Scale: amount=0 -> 1x, amount=1 -> 8x boost for heavy punch.
+    // Ramped from the last block's value so automation doesn't click
+    const float fromBoost = currentAmount_ * 7.0f;
+    const float boostStep = (amount_ * 7.0f - fromBoost) / static_cast<float>(numSamples);
+    currentAmount_ = amount_;
+
+    std::array<float, kLanes> env = env_;
+    for (int i = 0; i < numSamples; ++i) {
+        // Rectify input, same value into the fast and slow lane of a side
+        const float absL = std::abs(left[i]);
+        const float absR = std::abs(right[i]);
+        const float in[kLanes] = {absL, absR, absL, absR};
+
+        // All four followers in one pass
+        for (int lane = 0; lane < kLanes; ++lane) {
+            const float coef = (in[lane] > env[lane]) ? attack_[lane] : release_[lane];
+            env[lane] += coef * (in[lane] - env[lane]);
+        }
+
+        // Transient = difference between fast and slow envelopes,
+        // amplified for more pronounced detection
+        const float transientL = std::min(std::max(0.0f, env[0] - env[2]) * 2.0f, 1.0f);
+        const float transientR = std::min(std::max(0.0f, env[1] - env[3]) * 2.0f, 1.0f);
+
+        // Apply gain boost to transient portion (amount controls intensity)
+        const float boost = fromBoost + boostStep * static_cast<float>(i + 1);
+        left[i] *= 1.0f + transientL * boost;
+        right[i] *= 1.0f + transientR * boost;
+    }
+    env_ = env;
 }
 
 } // namespace audio
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <array>
+
 namespace audio {
 
 // Transient shaper using dual envelope followers
@@ -9,20 +11,26 @@ class TransientShaper {
 public:
     void prepare(double sampleRate);
     void setAmount(float amount);  // 0-1
-    void process(float& left, float& right);
+
+    // In place. Amount changes are ramped across the block; fully off is a
+    // true bypass (followers reset so re-enabling starts clean)
+    void process(float* left, float* right, int numSamples);
     void reset();
 
 private:
+    // Follower lanes: fast L, fast R, slow L, slow R
+    static constexpr int kLanes = 4;
+
     double sampleRate_ = 44100.0;
     float amount_ = 0.0f;
+    float currentAmount_ = 0.0f;  // Where the last block's ramp ended
+    bool active_ = false;
 
-    // Envelope followers (stereo)
-    float fastEnvL_ = 0.0f, fastEnvR_ = 0.0f;
-    float slowEnvL_ = 0.0f, slowEnvR_ = 0.0f;
+    std::array<float, kLanes> env_{};
 
-    // Attack/release coefficients
-    float fastAttack_ = 0.0f, fastRelease_ = 0.0f;
-    float slowAttack_ = 0.0f, slowRelease_ = 0.0f;
+    // Attack/release coefficients per lane
+    std::array<float, kLanes> attack_{};
+    std::array<float, kLanes> release_{};
 };
 
 } // namespace audio
@@ -13,7 +13,7 @@ namespace audio {
 class UniversalTrackerFX
 {
 public:
-    static constexpr int TICKS_PER_ROW = 6;
+    static constexpr int TICKS_PER_ROW = model::TICKS_PER_ROW;
 
     // Callbacks for instrument control
     using NoteCallback = std::function<void(int note, float velocity)>;
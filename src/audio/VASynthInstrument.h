@@ -12,7 +12,7 @@
 
 namespace audio {
 
-class VASynthInstrument : public InstrumentProcessor {
+class VASynthInstrument final : public InstrumentProcessor {
 public:
     static constexpr int NUM_VOICES = 16;
     static constexpr int kMaxBlockSize = 512;
@@ -24,9 +24,12 @@ public:
     void init(double sampleRate) override;
     void setSampleRate(double sampleRate) override;
 
-    // Voice-per-track interface
-    std::unique_ptr<Voice> createVoice() override;
-    void updateVoiceParameters(Voice* voice) override;
+    // Voice-per-track interface (see TrackVoice.h)
+    using VoiceType = VASynthVoice;
+    // Prepares a freshly created track voice
+    void initVoice(VASynthVoice& voice);
+    // Syncs a track voice with the current instrument params, once per block
+    void updateVoiceParameters(VASynthVoice& voice);
 
     // Legacy methods
     void noteOn(int note, float velocity) override;
@@ -3,7 +3,6 @@
 
 #pragma once
 
-#include "Voice.h"
 #include "../dsp/va_oscillator.h"
 #include "../dsp/va_filter.h"
 #include "../model/VAParams.h"
@@ -11,22 +10,23 @@
 
 namespace audio {
 
-class VASynthVoice : public Voice {
+// Track voice for VA synth instruments (see TrackVoice.h)
+class VASynthVoice {
 public:
     VASynthVoice() = default;
-    ~VASynthVoice() override = default;
 
-    // Voice interface implementation
-    void noteOn(int note, float velocity) override;
-    void noteOff() override;
+    // Track voice members
+    void noteOn(int note, float velocity);
+    void noteOff();
     void process(float* outL, float* outR, int numSamples,
                 float pitchMod = 0.0f,
                 float cutoffMod = 0.0f,
                 float volumeMod = 1.0f,
-                float panMod = 0.5f) override;
-    bool isActive() const override;
-    int getCurrentNote() const override { return note_; }
-    void setSampleRate(double sampleRate) override;
+                float panMod = 0.5f);
+    bool isActive() const;
+    int getCurrentNote() const { return note_; }
+    void setSampleRate(double sampleRate);
+    size_t getAllocatedBytes() const { return 0; }
 
     // VASynth-specific interface for parameter updates
     void updateParameters(const model::VAParams& params);
@@ -1,4 +1,5 @@
 #include "AudioAnalysis.h"
+#include "RealFFT.h"
 #include <cmath>
 #include <numeric>
 
@@ -63,22 +64,24 @@ float AudioAnalysis::autocorrelationBPM(const std::vector<float>& envelope, int
         return 0.0f;
     }
 
+    // Autocorrelation of the whole envelope at once, by FFT. Zero padding to
+    // twice the length keeps the circular correlation from wrapping
+    int fftSize = nextFftSize(2 * envelope.size());
+    auto fft = RealFFT::forSize(fftSize);
+    std::vector<float> spectrum(static_cast<size_t>(fftSize), 0.0f);
+    std::copy(envelope.begin(), envelope.end(), spectrum.begin());
+    fft->forward(spectrum.data());
+    RealFFT::multiplyConjugate(spectrum.data(), spectrum.data(), spectrum.data(), fftSize);
+    fft->inverse(spectrum.data());
+
     // Find peak in autocorrelation
     float maxCorr = 0.0f;
     int bestLag = minLag;
 
     for (int lag = minLag; lag <= maxLag; ++lag) {
-        float corr = 0.0f;
-        int count = 0;
-
-        for (size_t i = 0; i < envelope.size() - static_cast<size_t>(lag); ++i) {
-            corr += envelope[i] * envelope[i + static_cast<size_t>(lag)];
-            ++count;
-        }
-
-        if (count > 0) {
-            corr /= static_cast<float>(count);
-        }
+        // Mean over the overlapping frames, as the unscaled inverse is n times
+        int count = static_cast<int>(envelope.size()) - lag;
+        float corr = spectrum[static_cast<size_t>(lag)] / (static_cast<float>(fftSize) * static_cast<float>(count));
 
         if (corr > maxCorr) {
             maxCorr = corr;
@@ -130,16 +133,7 @@ float AudioAnalysis::yinDetect(const float* data, size_t numSamples, int sampleR
 
     // Step 1 & 2: Difference function and cumulative mean normalized difference
     std::vector<float> yinBuffer(windowSize);
-
-    // Compute difference function
-    for (size_t tau = 0; tau < windowSize; ++tau) {
-        float sum = 0.0f;
-        for (size_t i = 0; i < windowSize; ++i) {
-            float delta = data[i] - data[i + tau];
-            sum += delta * delta;
-        }
-        yinBuffer[tau] = sum;
-    }
+    differenceFunction(data, windowSize, yinBuffer.data());
 
     // Cumulative mean normalized difference function
     yinBuffer[0] = 1.0f;
@@ -205,6 +199,48 @@ float AudioAnalysis::yinDetect(const float* data, size_t numSamples, int sampleR
     return frequency;
 }
 
+void AudioAnalysis::differenceFunction(const float* data, size_t windowSize, float* out) {
+    // d(tau) = sum (x[i] - x[i + tau])^2 over the window
+    //        = e(0) + e(tau) - 2 r(tau)
+    // where e(tau) is the energy of the window starting at tau and r the
+    // correlation of the first window with the signal. r comes from one FFT
+    // pair instead of windowSize^2 multiplies
+    int fftSize = nextFftSize(2 * windowSize);
+    auto fft = RealFFT::forSize(fftSize);
+
+    std::vector<float> window(static_cast<size_t>(fftSize), 0.0f);
+    std::vector<float> signal(static_cast<size_t>(fftSize), 0.0f);
+    std::copy(data, data + windowSize, window.begin());
+    std::copy(data, data + 2 * windowSize, signal.begin());
+    fft->forward(window.data());
+    fft->forward(signal.data());
+    RealFFT::multiplyConjugate(window.data(), signal.data(), window.data(), fftSize);
+    fft->inverse(window.data());
+
+    double firstEnergy = 0.0;
+    for (size_t i = 0; i < windowSize; ++i) {
+        firstEnergy += static_cast<double>(data[i]) * data[i];
+    }
+
+    const double scale = 1.0 / fftSize;
+    double energy = firstEnergy;
+    for (size_t tau = 0; tau < windowSize; ++tau) {
+        double correlation = window[tau] * scale;
+        // Rounding can take a near-perfect match just below zero
+        out[tau] = static_cast<float>(std::max(0.0, firstEnergy + energy - 2.0 * correlation));
+        energy += static_cast<double>(data[tau + windowSize]) * data[tau + windowSize]
+                - static_cast<double>(data[tau]) * data[tau];
+    }
+}
+
+int AudioAnalysis::nextFftSize(size_t minimumSize) {
+    int size = 4;
+    while (static_cast<size_t>(size) < minimumSize) {
+        size *= 2;
+    }
+    return size;
+}
+
 int AudioAnalysis::frequencyToMidiNote(float frequency) {
     if (frequency <= 0.0f) {
         return -1;
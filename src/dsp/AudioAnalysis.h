@@ -8,11 +8,11 @@ namespace dsp {
 
 class AudioAnalysis {
 public:
-    // BPM detection using onset detection + autocorrelation
+    // BPM detection using onset detection + autocorrelation (by FFT)
     // Returns detected BPM in range 60-180, or 0 if detection fails
     static float detectBPM(const float* data, size_t numSamples, int sampleRate);
 
-    // Pitch detection using YIN algorithm
+    // Pitch detection using YIN algorithm (difference function by FFT)
     // Returns detected frequency in Hz, or 0 if detection fails
     static float detectPitch(const float* data, size_t numSamples, int sampleRate);
 
@@ -41,6 +41,10 @@ private:
 
     // Internal helpers for YIN pitch detection
     static float yinDetect(const float* data, size_t numSamples, int sampleRate);
+    static void differenceFunction(const float* data, size_t windowSize, float* out);
+
+    // Smallest power-of-two FFT size holding minimumSize samples
+    static int nextFftSize(size_t minimumSize);
 };
 
 } // namespace dsp
@@ -0,0 +1,243 @@
+#include "RealFFT.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <map>
+#include <mutex>
+
+namespace dsp {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+uint32_t reverseBits(uint32_t value, int numBits) {
+    uint32_t result = 0;
+    for (int b = 0; b < numBits; ++b) {
+        result = (result << 1) | (value & 1u);
+        value >>= 1;
+    }
+    return result;
+}
+
+} // anonymous namespace
+
+std::shared_ptr<const RealFFT> RealFFT::forSize(int size) {
+    static std::mutex mutex;
+    static std::map<int, std::shared_ptr<const RealFFT>> plans;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& plan = plans[size];
+    if (!plan) {
+        plan = std::make_shared<const RealFFT>(size);
+    }
+    return plan;
+}
+
+bool RealFFT::isValidSize(int size) {
+    return size >= 4 && (size & (size - 1)) == 0;
+}
+
+RealFFT::RealFFT(int size) : size_(size), half_(size / 2) {
+    assert(isValidSize(size));
+
+    // Butterfly twiddles e^(-i pi k / h), one run per stage
+    stageCos_.resize(static_cast<size_t>(half_ - 1));
+    stageSin_.resize(static_cast<size_t>(half_ - 1));
+    for (int h = 1; h < half_; h *= 2) {
+        for (int k = 0; k < h; ++k) {
+            double angle = kPi * k / h;
+            stageCos_[static_cast<size_t>(h - 1 + k)] = static_cast<float>(std::cos(angle));
+            stageSin_[static_cast<size_t>(h - 1 + k)] = static_cast<float>(-std::sin(angle));
+        }
+    }
+
+    const int quarter = half_ / 2;
+    splitCos_.resize(static_cast<size_t>(quarter + 1));
+    splitSin_.resize(static_cast<size_t>(quarter + 1));
+    for (int k = 0; k <= quarter; ++k) {
+        double angle = 2.0 * kPi * k / size_;
+        splitCos_[static_cast<size_t>(k)] = static_cast<float>(std::cos(angle));
+        splitSin_[static_cast<size_t>(k)] = static_cast<float>(-std::sin(angle));
+    }
+
+    // Real samples x[2j], x[2j+1] become the complex z[j], stored split (re
+    // then im) at z's bit-reversed position, ready for the butterflies
+    int numBits = 0;
+    while ((1 << numBits) < half_) {
+        ++numBits;
+    }
+    std::vector<uint32_t> source(static_cast<size_t>(size_));
+    for (int p = 0; p < half_; ++p) {
+        uint32_t j = reverseBits(static_cast<uint32_t>(p), numBits);
+        source[static_cast<size_t>(p)] = 2 * j;
+        source[static_cast<size_t>(half_ + p)] = 2 * j + 1;
+    }
+
+    // Each cycle d <- source[d] <- source[source[d]] ... as a run of swaps
+    std::vector<bool> visited(static_cast<size_t>(size_), false);
+    for (uint32_t start = 0; start < static_cast<uint32_t>(size_); ++start) {
+        if (visited[start]) {
+            continue;
+        }
+        visited[start] = true;
+        for (uint32_t d = start, s = source[start]; s != start; d = s, s = source[s]) {
+            swaps_.emplace_back(d, s);
+            visited[s] = true;
+        }
+    }
+}
+
+void RealFFT::forward(const float* in, float* out) const {
+    std::copy(in, in + size_, out);
+    forward(out);
+}
+
+void RealFFT::inverse(const float* in, float* out) const {
+    std::copy(in, in + size_, out);
+    inverse(out);
+}
+
+void RealFFT::forward(float* data) const {
+    permute(data);
+    float* re = data;
+    float* im = data + half_;
+    butterfliesForward(re, im);
+
+    // Split the half-size spectrum Z into the real spectrum X, pairing bins
+    // k and half - k. Results land in the slots they were read from
+    const float dc = re[0] + im[0];
+    const float nyquist = re[0] - im[0];
+    re[0] = dc;
+    im[0] = nyquist;  // Which is re[half] in the packed layout
+
+    const int quarter = half_ / 2;
+    for (int k = 1; k <= quarter; ++k) {
+        const int j = half_ - k;
+        const float ar = re[k], ai = im[k];
+        const float br = re[j], bi = im[j];
+
+        const float er = 0.5f * (ar + br), ei = 0.5f * (ai - bi);
+        const float orr = 0.5f * (ai + bi), oi = -0.5f * (ar - br);
+        const float c = splitCos_[static_cast<size_t>(k)], s = splitSin_[static_cast<size_t>(k)];
+
+        re[k] = er + c * orr - s * oi;
+        im[k] = ei + c * oi + s * orr;
+        re[j] = er - c * orr + s * oi;
+        im[j] = -ei + c * oi + s * orr;
+    }
+}
+
+void RealFFT::inverse(float* data) const {
+    float* re = data;
+    float* im = data + half_;
+
+    // Rebuild the (doubled) half-size spectrum from the real one
+    const float dc = re[0];
+    const float nyquist = im[0];
+    re[0] = dc + nyquist;
+    im[0] = dc - nyquist;
+
+    const int quarter = half_ / 2;
+    for (int k = 1; k <= quarter; ++k) {
+        const int j = half_ - k;
+        const float ar = re[k], ai = im[k];
+        const float br = re[j], bi = im[j];
+
+        const float er = ar + br, ei = ai - bi;
+        const float dr = ar - br, di = ai + bi;
+        const float c = splitCos_[static_cast<size_t>(k)], s = splitSin_[static_cast<size_t>(k)];
+
+        const float okr = dr * c + di * s, oki = di * c - dr * s;
+        const float ojr = dr * c + di * s, oji = dr * s - di * c;
+
+        re[k] = er - oki;
+        im[k] = ei + okr;
+        re[j] = er - oji;
+        im[j] = -ei + ojr;
+    }
+
+    butterfliesInverse(re, im);
+    permuteInverse(data);
+}
+
+void RealFFT::multiplyAccumulate(const float* x, const float* h, float* acc, int size) {
+    const int half = size / 2;
+    acc[0] += x[0] * h[0];
+    acc[half] += x[half] * h[half];
+    for (int k = 1; k < half; ++k) {
+        const float xr = x[k], xi = x[half + k];
+        const float hr = h[k], hi = h[half + k];
+        acc[k] += xr * hr - xi * hi;
+        acc[half + k] += xr * hi + xi * hr;
+    }
+}
+
+void RealFFT::multiplyConjugate(const float* x, const float* h, float* out, int size) {
+    const int half = size / 2;
+    out[0] = x[0] * h[0];
+    out[half] = x[half] * h[half];
+    for (int k = 1; k < half; ++k) {
+        const float xr = x[k], xi = x[half + k];
+        const float hr = h[k], hi = h[half + k];
+        out[k] = xr * hr + xi * hi;
+        out[half + k] = xr * hi - xi * hr;
+    }
+}
+
+void RealFFT::permute(float* data) const {
+    for (const auto& [a, b] : swaps_) {
+        std::swap(data[a], data[b]);
+    }
+}
+
+void RealFFT::permuteInverse(float* data) const {
+    for (auto it = swaps_.rbegin(); it != swaps_.rend(); ++it) {
+        std::swap(data[it->first], data[it->second]);
+    }
+}
+
+void RealFFT::butterfliesForward(float* re, float* im) const {
+    for (int h = 1; h < half_; h *= 2) {
+        const float* wr = &stageCos_[static_cast<size_t>(h - 1)];
+        const float* wi = &stageSin_[static_cast<size_t>(h - 1)];
+        for (int group = 0; group < half_; group += 2 * h) {
+            float* ar = re + group;
+            float* ai = im + group;
+            float* br = ar + h;
+            float* bi = ai + h;
+            for (int k = 0; k < h; ++k) {
+                const float tr = wr[k] * br[k] - wi[k] * bi[k];
+                const float ti = wr[k] * bi[k] + wi[k] * br[k];
+                br[k] = ar[k] - tr;
+                bi[k] = ai[k] - ti;
+                ar[k] += tr;
+                ai[k] += ti;
+            }
+        }
+    }
+}
+
+void RealFFT::butterfliesInverse(float* re, float* im) const {
+    // Conjugate twiddles, so the stored sine is negated
+    for (int h = half_ / 2; h >= 1; h /= 2) {
+        const float* wr = &stageCos_[static_cast<size_t>(h - 1)];
+        const float* wi = &stageSin_[static_cast<size_t>(h - 1)];
+        for (int group = 0; group < half_; group += 2 * h) {
+            float* ar = re + group;
+            float* ai = im + group;
+            float* br = ar + h;
+            float* bi = ai + h;
+            for (int k = 0; k < h; ++k) {
+                const float dr = ar[k] - br[k];
+                const float di = ai[k] - bi[k];
+                ar[k] += br[k];
+                ai[k] += bi[k];
+                br[k] = wr[k] * dr + wi[k] * di;
+                bi[k] = wr[k] * di - wi[k] * dr;
+            }
+        }
+    }
+}
+
+} // namespace dsp
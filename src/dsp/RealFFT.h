@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace dsp {
+
+// Real-input FFT of a power-of-two size (at least 4), shared by analysis,
+// convolution and display code.
+//
+// Spectra use the packed layout of stmlib's ShyFFT: re[0..n/2] in the first
+// half plus one, im[1..n/2-1] from n/2+1 on (im[0] and im[n/2] are always
+// zero). The inverse is unscaled: inverse(forward(x)) == n * x.
+//
+// A plan holds the twiddles and the input reordering for one size and is
+// immutable, so one plan can be used from any number of threads at once. Get
+// plans with forSize(), which builds each size once and keeps it. The
+// transforms themselves never allocate.
+class RealFFT {
+public:
+    static std::shared_ptr<const RealFFT> forSize(int size);
+
+    explicit RealFFT(int size);
+
+    int getSize() const { return size_; }
+
+    // Out-of-place; in and out must not overlap
+    void forward(const float* in, float* out) const;
+    void inverse(const float* in, float* out) const;
+
+    // In-place
+    void forward(float* data) const;
+    void inverse(float* data) const;
+
+    // Spectrum arithmetic in the packed layout (size = transform size)
+    static void multiplyAccumulate(const float* x, const float* h, float* acc, int size);  // acc += x * h
+    static void multiplyConjugate(const float* x, const float* h, float* out, int size);   // out = conj(x) * h
+
+    static bool isValidSize(int size);
+
+private:
+    void permute(float* data) const;
+    void permuteInverse(float* data) const;
+    void butterfliesForward(float* re, float* im) const;   // Decimation in time
+    void butterfliesInverse(float* re, float* im) const;   // Decimation in frequency
+
+    int size_;
+    int half_;  // Size of the complex transform underneath
+
+    // Per stage of the half-size complex FFT, contiguous so the butterfly
+    // loops vectorise: stage with span 2h uses [h - 1, 2h - 1)
+    std::vector<float> stageCos_, stageSin_;
+
+    // e^(-2 pi i k / size) for splitting the half-size result, k in [0, size/4]
+    std::vector<float> splitCos_, splitSin_;
+
+    // Interleaved real input -> bit-reversed split complex, as swaps
+    std::vector<std::pair<uint32_t, uint32_t>> swaps_;
+};
+
+} // namespace dsp
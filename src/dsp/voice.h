@@ -38,6 +38,9 @@ public:
     bool active() const { return active_; }
     int note() const { return note_; }
 
+    // Heap memory owned (the Plaits engines' working buffer)
+    size_t allocatedBytes() const { return voiceBuffer_ ? kVoiceBufferSize : 0; }
+
 private:
     // Maps UI engine selection (0-15) to actual Plaits engine index
     // Plaits has 24 engines, we expose the classic 16 (indices 8-23)
@@ -112,6 +112,16 @@ int VoiceAllocator::activeVoiceCount() const
     return count;
 }
 
+size_t VoiceAllocator::allocatedBytes() const
+{
+    // Every voice keeps its buffer, whatever the polyphony
+    size_t bytes = 0;
+    for (const auto& voice : voices_) {
+        bytes += voice.allocatedBytes();
+    }
+    return bytes;
+}
+
 Voice* VoiceAllocator::findFreeVoice()
 {
     for (size_t i = 0; i < static_cast<size_t>(polyphony_); ++i) {
@@ -37,6 +37,7 @@ public:
 
     // State queries
     int activeVoiceCount() const;
+    size_t allocatedBytes() const;
 
 private:
     Voice* findFreeVoice();
@@ -1,5 +1,6 @@
 #include "KeyHandler.h"
 #include <iostream>  // For debug output in Release builds
+#include <sstream>
 
 namespace input {
 
@@ -136,7 +137,7 @@ bool KeyHandler::handleNormalMode(const juce::KeyPress& key)
         (textChar >= '0' && textChar <= '9') ||
         textChar == '.' || textChar == ',' ||
         textChar == '+' || textChar == '=' || textChar == '-' ||
-        textChar == ':')
+        textChar == ':' || textChar == '/')
     {
         if (onEditKey && onEditKey(key)) return true;
         // Fall through to mode switches/actions below if not consumed
@@ -452,6 +453,74 @@ void KeyHandler::executeCommand(const std::string& command)
         }
         if (onChop) onChop(divisions);
     }
+    else if (command.length() > 9 && command.substr(0, 9) == "quantize ")
+    {
+        try {
+            int rows = std::stoi(command.substr(9));
+            if (onQuantize) onQuantize(rows);
+        } catch (...) {}
+    }
+    else if (command.length() > 11 && command.substr(0, 11) == "midi-route ")
+    {
+        // Parse :midi-route PORT INST (instrument in hex as displayed, - to follow selection)
+        std::istringstream args(command.substr(11));
+        std::string portArg, instrumentArg;
+        args >> portArg >> instrumentArg;
+        try {
+            int port = std::stoi(portArg);
+            int instrument = (instrumentArg.empty() || instrumentArg == "-")
+                ? -1
+                : std::stoi(instrumentArg, nullptr, 16);
+            if (onMidiRoute) onMidiRoute(port, instrument);
+        } catch (...) {}
+    }
+    else if (command == "disk-rec" || command.substr(0, 9) == "disk-rec ")
+    {
+        if (onDiskRecord) onDiskRecord(command.length() > 9 ? command.substr(9) : "");
+    }
+    else if (command == "disk-stop")
+    {
+        if (onDiskStop) onDiskStop();
+    }
+    else if (command == "import-take" || command.substr(0, 12) == "import-take ")
+    {
+        if (onImportTake) onImportTake(command.length() > 12 ? command.substr(12) : "");
+    }
+    else if (command == "reverb-ir" || command.substr(0, 10) == "reverb-ir ")
+    {
+        if (onReverbImpulse) onReverbImpulse(command.length() > 10 ? command.substr(10) : "");
+    }
+    else if (command.length() > 12 && command.substr(0, 12) == "reverb-tail ")
+    {
+        try {
+            float seconds = std::stof(command.substr(12));
+            if (onReverbTail) onReverbTail(seconds);
+        } catch (...) {}
+    }
+    else if (command == "usages")
+    {
+        if (onUsages) onUsages();
+    }
+    else if (command == "bus" || command.substr(0, 4) == "bus ")
+    {
+        if (onBus) onBus(command.length() > 4 ? command.substr(4) : "");
+    }
+    else if (command.length() > 6 && command.substr(0, 6) == "route ")
+    {
+        if (onRoute) onRoute(command.substr(6));
+    }
+    else if (command.length() > 5 && command.substr(0, 5) == "send ")
+    {
+        if (onSend) onSend(command.substr(5));
+    }
+    else if (command == "scope" || command.substr(0, 6) == "scope ")
+    {
+        if (onScope) onScope(command.length() > 6 ? command.substr(6) : "");
+    }
+    else if (command == "memory")
+    {
+        if (onMemory) onMemory();
+    }
 
     if (onCommand) onCommand(command);
 }
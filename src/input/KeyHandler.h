@@ -50,6 +50,19 @@ public:
     std::function<void()> onCreateSampler;  // :sampler
     std::function<void()> onCreateSlicer;  // :slicer
     std::function<void(int)> onChop;  // Takes number of divisions
+    std::function<void(int, int)> onMidiRoute;  // :midi-route port instrument (-1 = selected)
+    std::function<void(int)> onQuantize;  // :quantize N (rows, 0 = off)
+    std::function<void(const std::string&)> onDiskRecord;  // :disk-rec [flac] [16] [fx] [stems]
+    std::function<void()> onDiskStop;  // :disk-stop
+    std::function<void(const std::string&)> onImportTake;  // :import-take [slicer] [master|fx|II]
+    std::function<void(const std::string&)> onReverbImpulse;  // :reverb-ir [file|off]
+    std::function<void(float)> onReverbTail;  // :reverb-tail seconds
+    std::function<void()> onUsages;  // :usages
+    std::function<void(const std::string&)> onBus;  // :bus name
+    std::function<void(const std::string&)> onRoute;  // :route source master|bN
+    std::function<void(const std::string&)> onSend;  // :send source reverb|delay|chorus|key|duck percent
+    std::function<void(const std::string&)> onScope;  // :scope [source|master|off]
+    std::function<void()> onMemory;  // :memory
 
 private:
     bool handleNormalMode(const juce::KeyPress& key);
@@ -1,5 +1,6 @@
 #include <JuceHeader.h>
 #include "App.h"
+#include "model/StartupProfile.h"
 
 class VitrackerApplication : public juce::JUCEApplication
 {
@@ -12,8 +13,12 @@ public:
 
     void initialise(const juce::String& commandLine) override
     {
-        juce::ignoreUnused(commandLine);
+        // --profile-startup prints how long each startup phase took
+        if (juce::StringArray::fromTokens(commandLine, true).contains("--profile-startup"))
+            model::StartupProfile::instance().setEnabled(true);
+
         mainWindow = std::make_unique<MainWindow>(getApplicationName());
+        model::StartupProfile::instance().markReady();
     }
 
     void shutdown() override
@@ -25,6 +25,7 @@ void Chain::addPattern(int patternIndex)
     entry.patternIndex = patternIndex;
     entry.transpose = 0;
     entries_.push_back(entry);
+    revision_ = nextRevision();
 }
 
 void Chain::removePattern(int position)
@@ -32,6 +33,7 @@ void Chain::removePattern(int position)
     if (position >= 0 && position < static_cast<int>(entries_.size()))
     {
         entries_.erase(entries_.begin() + position);
+        revision_ = nextRevision();
     }
 }
 
@@ -40,6 +42,7 @@ void Chain::setPattern(int position, int patternIndex)
     if (position >= 0 && position < static_cast<int>(entries_.size()))
     {
         entries_[static_cast<size_t>(position)].patternIndex = patternIndex;
+        revision_ = nextRevision();
     }
 }
 
@@ -57,6 +60,7 @@ void Chain::setTranspose(int position, int transpose)
     if (position >= 0 && position < static_cast<int>(entries_.size()))
     {
         entries_[static_cast<size_t>(position)].transpose = transpose;
+        revision_ = nextRevision();
     }
 }
 
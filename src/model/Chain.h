@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Revision.h"
 #include <string>
 #include <vector>
 
@@ -37,10 +38,14 @@ public:
     void setTranspose(int position, int transpose);
     int getTranspose(int position) const;
 
+    // Changes whenever the chain is edited
+    uint64_t getRevision() const { return revision_; }
+
 private:
     std::string name_;
     std::string scaleLock_;  // e.g., "C minor", empty = no lock
     std::vector<ChainEntry> entries_;
+    uint64_t revision_ = nextRevision();
 
     static const ChainEntry emptyEntry_;
 };
@@ -1,9 +1,12 @@
 #include "DX7PresetBank.h"
+#include "JobScheduler.h"
+#include "MemoryUsage.h"
 #include <JuceHeader.h>
 #include <fstream>
 #include <algorithm>
 #include <cctype>
 #include <filesystem>
+#include <thread>
 
 namespace fs = std::filesystem;
 
@@ -11,6 +14,8 @@ namespace model {
 
 DX7PresetBank::DX7PresetBank() = default;
 DX7PresetBank::~DX7PresetBank() = default;
+DX7PresetBank::DX7PresetBank(DX7PresetBank&&) noexcept = default;
+DX7PresetBank& DX7PresetBank::operator=(DX7PresetBank&&) noexcept = default;
 
 bool DX7PresetBank::validateSysexHeader(const uint8_t* data, size_t size)
 {
@@ -79,7 +84,7 @@ std::string DX7PresetBank::extractPatchName(const uint8_t* packedData)
     return name;
 }
 
-bool DX7PresetBank::loadSysexFile(const std::string& filePath)
+bool DX7PresetBank::parseSysexFile(const std::string& filePath, CachedBank& bank)
 {
     std::ifstream file(filePath, std::ios::binary);
     if (!file) {
@@ -101,59 +106,336 @@ bool DX7PresetBank::loadSysexFile(const std::string& filePath)
         return false;
     }
 
-    // Get bank name from filename
-    std::string bankName = getFileBasename(filePath);
-
     // Extract 32 patches
     const uint8_t* patchData = data.data() + DX7_SYSEX_HEADER_SIZE;
+    bank.patches.clear();
 
     for (int i = 0; i < DX7_PATCHES_PER_BANK; ++i) {
         const uint8_t* patch = patchData + (i * DX7_PACKED_PATCH_SIZE);
 
+        // Skip empty/init patches (heuristic: all zeros or default name)
+        std::string name = sanitizePatchName(extractPatchName(patch));
+        if (name.empty() || name == "INIT VOICE") {
+            continue;
+        }
+
+        std::array<uint8_t, DX7_PACKED_PATCH_SIZE> packed;
+        std::copy(patch, patch + DX7_PACKED_PATCH_SIZE, packed.begin());
+        bank.patches.emplace_back(i, packed);
+    }
+
+    return true;
+}
+
+bool DX7PresetBank::loadSysexFile(const std::string& filePath)
+{
+    CachedBank bank;
+    if (!parseSysexFile(filePath, bank)) {
+        return false;
+    }
+
+    // Get bank name from filename
+    addBank(getFileBasename(filePath), bank);
+    return true;
+}
+
+void DX7PresetBank::addBank(const std::string& bankName, const CachedBank& bank)
+{
+    for (const auto& [patchIndex, packed] : bank.patches) {
         DX7Preset preset;
-        preset.name = sanitizePatchName(extractPatchName(patch));
+        preset.name = sanitizePatchName(extractPatchName(packed.data()));
         preset.bankName = bankName;
-        preset.patchIndex = i;
+        preset.patchIndex = patchIndex;
+        preset.packedData = packed;
+        addPreset(std::move(preset));
+    }
+}
 
-        // Copy packed data
-        std::copy(patch, patch + DX7_PACKED_PATCH_SIZE, preset.packedData.begin());
+uint64_t DX7PresetBank::hashPatch(const uint8_t* packedData)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (int i = 0; i < DX7_PACKED_PATCH_SIZE; ++i) {
+        hash ^= packedData[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
 
-        // Skip empty/init patches (heuristic: all zeros or default name)
-        if (!preset.name.empty() && preset.name != "INIT VOICE") {
-            presets_.push_back(std::move(preset));
+uint32_t DX7PresetBank::gramKey(const char* text, size_t length)
+{
+    // Length in the top byte keeps "a", "a\0" etc. distinct
+    uint32_t key = static_cast<uint32_t>(length) << 24;
+    for (size_t i = 0; i < length; ++i) {
+        key |= static_cast<uint32_t>(static_cast<uint8_t>(text[i])) << (16 - 8 * i);
+    }
+    return key;
+}
+
+bool DX7PresetBank::addPreset(DX7Preset&& preset)
+{
+    // Many cartridges in the wild are re-dumps of the same factory ROMs -
+    // only keep the first copy of each byte-identical patch
+    auto& sameHash = patchHashes_[hashPatch(preset.packedData.data())];
+    for (int existing : sameHash) {
+        if (presets_[static_cast<size_t>(existing)].packedData == preset.packedData) {
+            ++duplicateCount_;
+            return false;
+        }
+    }
+
+    int index = static_cast<int>(presets_.size());
+    sameHash.push_back(index);
+
+    std::string lowerName = preset.name;
+    std::transform(lowerName.begin(), lowerName.end(), lowerName.begin(), ::tolower);
+
+    // Index every 1, 2 and 3 character gram of the name. Names are at most
+    // 10 chars, so this is under 30 postings per preset.
+    for (size_t length = 1; length <= 3; ++length) {
+        for (size_t pos = 0; pos + length <= lowerName.size(); ++pos) {
+            auto& postings = nameGrams_[gramKey(lowerName.data() + pos, length)];
+            if (postings.empty() || postings.back() != index) {
+                postings.push_back(index);
+            }
         }
     }
 
+    lowerNames_.push_back(std::move(lowerName));
+    presets_.push_back(std::move(preset));
     return true;
 }
 
+// Whether a scan of dirPath would have listed filePath. Compares whole path
+// components, so /cache/foobar/a.syx is not under /cache/foo
+static bool isInScannedDirectory(const std::string& filePath, const std::string& dirPath, bool recursive)
+{
+    auto dir = fs::path(dirPath).lexically_normal();
+    if (!dir.has_filename()) {
+        dir = dir.parent_path();  // Trailing separator
+    }
+    const auto parent = fs::path(filePath).lexically_normal().parent_path();
+    if (!recursive) {
+        return parent == dir;
+    }
+
+    const auto relative = parent.lexically_relative(dir);
+    return !relative.empty() && *relative.begin() != "..";
+}
+
 void DX7PresetBank::scanDirectory(const std::string& dirPath, bool recursive)
 {
+    std::vector<std::string> files;
+
+    auto addIfSysex = [&files](const fs::directory_entry& entry) {
+        if (entry.is_regular_file()) {
+            std::string ext = entry.path().extension().string();
+            std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+            if (ext == ".syx") {
+                files.push_back(entry.path().string());
+            }
+        }
+    };
+
     try {
         if (recursive) {
             for (const auto& entry : fs::recursive_directory_iterator(dirPath)) {
-                if (entry.is_regular_file()) {
-                    std::string ext = entry.path().extension().string();
-                    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
-                    if (ext == ".syx") {
-                        loadSysexFile(entry.path().string());
-                    }
-                }
+                addIfSysex(entry);
             }
         } else {
             for (const auto& entry : fs::directory_iterator(dirPath)) {
-                if (entry.is_regular_file()) {
-                    std::string ext = entry.path().extension().string();
-                    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
-                    if (ext == ".syx") {
-                        loadSysexFile(entry.path().string());
-                    }
-                }
+                addIfSysex(entry);
             }
         }
     } catch (const fs::filesystem_error&) {
         // Ignore filesystem errors (directory doesn't exist, permissions, etc.)
     }
+
+    // Sort files alphabetically for consistent ordering (and stable dedup winners)
+    std::sort(files.begin(), files.end());
+
+    bool useCache = !indexCachePath_.empty();
+    if (useCache && !indexCacheRead_) {
+        readIndexCache();
+    }
+
+    // Resolve each file to a cached bank, or queue it for parsing
+    std::vector<const CachedBank*> banks(files.size(), nullptr);
+    std::vector<size_t> toParse;
+    std::vector<CachedBank> parsed;
+
+    for (size_t i = 0; i < files.size(); ++i) {
+        std::error_code ec;
+        auto modTime = static_cast<int64_t>(fs::last_write_time(files[i], ec).time_since_epoch().count());
+        auto fileSize = static_cast<int64_t>(fs::file_size(files[i], ec));
+
+        if (useCache) {
+            auto it = indexCache_.find(files[i]);
+            if (it != indexCache_.end() && it->second.modTime == modTime && it->second.fileSize == fileSize) {
+                banks[i] = &it->second;
+                continue;
+            }
+        }
+
+        CachedBank bank;
+        bank.modTime = modTime;
+        bank.fileSize = fileSize;
+        parsed.push_back(std::move(bank));
+        toParse.push_back(i);
+    }
+
+    // Parse new/changed files in parallel. Invalid files keep an empty patch
+    // list so they're cached too and not re-read on every start.
+    if (!toParse.empty()) {
+        juce::SharedResourcePointer<JobScheduler> scheduler;
+        scheduler->parallelFor(static_cast<int>(toParse.size()), JobScheduler::Priority::Prefetch,
+                               [&](int j) { parseSysexFile(files[toParse[j]], parsed[j]); });
+
+        for (size_t j = 0; j < toParse.size(); ++j) {
+            banks[toParse[j]] = &parsed[j];
+        }
+    }
+
+    // Merge serially in path order so indices are deterministic
+    for (size_t i = 0; i < files.size(); ++i) {
+        addBank(getFileBasename(files[i]), *banks[i]);
+    }
+
+    if (!useCache) {
+        return;
+    }
+
+    // Update the cache: drop files that vanished from this directory, store new parses
+    bool cacheChanged = !toParse.empty();
+    for (auto it = indexCache_.begin(); it != indexCache_.end();) {
+        if (isInScannedDirectory(it->first, dirPath, recursive)
+            && !std::binary_search(files.begin(), files.end(), it->first)) {
+            it = indexCache_.erase(it);
+            cacheChanged = true;
+        } else {
+            ++it;
+        }
+    }
+
+    for (size_t j = 0; j < toParse.size(); ++j) {
+        indexCache_[files[toParse[j]]] = std::move(parsed[j]);
+    }
+
+    if (cacheChanged) {
+        writeIndexCache();
+    }
+}
+
+// ===== INDEX CACHE =====
+// Layout: magic, version, bank count, then per bank:
+//   path (u32 length + bytes), modTime (i64), fileSize (i64),
+//   patch count (u32), per patch: index (u8) + 128 packed bytes
+
+namespace {
+
+constexpr uint32_t kIndexMagic = 0x49375844;  // "DX7I"
+constexpr uint32_t kIndexVersion = 1;
+
+template <typename T>
+void writePod(std::ostream& out, const T& value)
+{
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool readPod(std::istream& in, T& value)
+{
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+} // anonymous namespace
+
+void DX7PresetBank::readIndexCache()
+{
+    indexCacheRead_ = true;
+    indexCache_.clear();
+
+    std::ifstream in(indexCachePath_, std::ios::binary);
+    if (!in) {
+        return;
+    }
+
+    uint32_t magic = 0, version = 0, bankCount = 0;
+    if (!readPod(in, magic) || !readPod(in, version) || !readPod(in, bankCount)
+        || magic != kIndexMagic || version != kIndexVersion) {
+        return;
+    }
+
+    std::map<std::string, CachedBank> cache;
+    for (uint32_t b = 0; b < bankCount; ++b) {
+        uint32_t pathLength = 0;
+        if (!readPod(in, pathLength) || pathLength > 4096) {
+            return;
+        }
+
+        std::string path(pathLength, '\0');
+        CachedBank bank;
+        uint32_t patchCount = 0;
+        if (!in.read(&path[0], pathLength) || !readPod(in, bank.modTime) || !readPod(in, bank.fileSize)
+            || !readPod(in, patchCount) || patchCount > DX7_PATCHES_PER_BANK) {
+            return;
+        }
+
+        bank.patches.resize(patchCount);
+        for (auto& [patchIndex, packed] : bank.patches) {
+            uint8_t index = 0;
+            if (!readPod(in, index)
+                || !in.read(reinterpret_cast<char*>(packed.data()), DX7_PACKED_PATCH_SIZE)) {
+                return;
+            }
+            patchIndex = index;
+        }
+
+        cache.emplace(std::move(path), std::move(bank));
+    }
+
+    indexCache_ = std::move(cache);
+}
+
+void DX7PresetBank::writeIndexCache() const
+{
+    std::error_code ec;
+    fs::path target(indexCachePath_);
+    if (target.has_parent_path()) {
+        fs::create_directories(target.parent_path(), ec);
+    }
+
+    // Write to a temp file and rename so an interrupted write can't corrupt the
+    // cache. One temp file per thread: the startup load runs in the background
+    // and the UI may load its own bank meanwhile
+    fs::path temp = target;
+    temp += ".tmp" + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    {
+        std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            return;
+        }
+
+        writePod(out, kIndexMagic);
+        writePod(out, kIndexVersion);
+        writePod(out, static_cast<uint32_t>(indexCache_.size()));
+        for (const auto& [path, bank] : indexCache_) {
+            writePod(out, static_cast<uint32_t>(path.size()));
+            out.write(path.data(), static_cast<std::streamsize>(path.size()));
+            writePod(out, bank.modTime);
+            writePod(out, bank.fileSize);
+            writePod(out, static_cast<uint32_t>(bank.patches.size()));
+            for (const auto& [patchIndex, packed] : bank.patches) {
+                writePod(out, static_cast<uint8_t>(patchIndex));
+                out.write(reinterpret_cast<const char*>(packed.data()), DX7_PACKED_PATCH_SIZE);
+            }
+        }
+
+        if (!out) {
+            return;
+        }
+    }
+
+    fs::rename(temp, target, ec);
 }
 
 const DX7Preset* DX7PresetBank::getPreset(int index) const
@@ -164,6 +446,21 @@ const DX7Preset* DX7PresetBank::getPreset(int index) const
     return &presets_[index];
 }
 
+int DX7PresetBank::findPreset(const uint8_t* packedData) const
+{
+    auto it = patchHashes_.find(hashPatch(packedData));
+    if (it == patchHashes_.end()) {
+        return -1;
+    }
+    for (int index : it->second) {
+        const auto& packed = presets_[static_cast<size_t>(index)].packedData;
+        if (std::equal(packed.begin(), packed.end(), packedData)) {
+            return index;
+        }
+    }
+    return -1;
+}
+
 std::vector<int> DX7PresetBank::searchPresets(const std::string& query) const
 {
     std::vector<int> results;
@@ -172,12 +469,38 @@ std::vector<int> DX7PresetBank::searchPresets(const std::string& query) const
     std::string lowerQuery = query;
     std::transform(lowerQuery.begin(), lowerQuery.end(), lowerQuery.begin(), ::tolower);
 
-    for (size_t i = 0; i < presets_.size(); ++i) {
-        std::string lowerName = presets_[i].name;
-        std::transform(lowerName.begin(), lowerName.end(), lowerName.begin(), ::tolower);
+    if (lowerQuery.empty()) {
+        results.resize(presets_.size());
+        for (size_t i = 0; i < presets_.size(); ++i) {
+            results[i] = static_cast<int>(i);
+        }
+        return results;
+    }
 
-        if (lowerName.find(lowerQuery) != std::string::npos) {
-            results.push_back(static_cast<int>(i));
+    // Short queries are grams themselves - the posting list is the answer
+    if (lowerQuery.size() <= 3) {
+        auto it = nameGrams_.find(gramKey(lowerQuery.data(), lowerQuery.size()));
+        if (it != nameGrams_.end()) {
+            results = it->second;
+        }
+        return results;
+    }
+
+    // Longer queries: walk the rarest trigram's postings and verify each candidate
+    const std::vector<int>* candidates = nullptr;
+    for (size_t pos = 0; pos + 3 <= lowerQuery.size(); ++pos) {
+        auto it = nameGrams_.find(gramKey(lowerQuery.data() + pos, 3));
+        if (it == nameGrams_.end()) {
+            return results;  // Some trigram never occurs - no matches
+        }
+        if (!candidates || it->second.size() < candidates->size()) {
+            candidates = &it->second;
+        }
+    }
+
+    for (int index : *candidates) {
+        if (lowerNames_[static_cast<size_t>(index)].find(lowerQuery) != std::string::npos) {
+            results.push_back(index);
         }
     }
 
@@ -267,6 +590,54 @@ void DX7PresetBank::unpackPatch(const uint8_t* packed, uint8_t* unpacked)
 void DX7PresetBank::clear()
 {
     presets_.clear();
+    lowerNames_.clear();
+    patchHashes_.clear();
+    nameGrams_.clear();
+    duplicateCount_ = 0;
+}
+
+size_t DX7PresetBank::getAllocatedBytes() const
+{
+    size_t bytes = bytesOf(presets_) + bytesOf(lowerNames_) + bytesOf(patchHashes_)
+                 + bytesOf(nameGrams_) + bytesOf(indexCachePath_) + bytesOf(indexCache_);
+    for (const auto& preset : presets_) {
+        bytes += bytesOf(preset.name) + bytesOf(preset.bankName);
+    }
+    for (const auto& name : lowerNames_) {
+        bytes += bytesOf(name);
+    }
+    for (const auto& [hash, indices] : patchHashes_) {
+        bytes += bytesOf(indices);
+    }
+    for (const auto& [gram, indices] : nameGrams_) {
+        bytes += bytesOf(indices);
+    }
+    for (const auto& [path, bank] : indexCache_) {
+        bytes += bytesOf(path) + bytesOf(bank.patches);
+    }
+    return bytes;
+}
+
+void DX7PresetBank::ensureLoaded()
+{
+    if (loaded_) {
+        return;
+    }
+    loaded_ = true;
+
+    juce::File vitrackerDir = juce::File::getSpecialLocation(juce::File::userHomeDirectory)
+        .getChildFile(".vitracker");
+    if (indexCachePath_.empty()) {
+        indexCachePath_ = vitrackerDir.getChildFile("dx7_index.bin").getFullPathName().toStdString();
+    }
+
+    loadBundledPresets();
+
+    // User cartridge library (~/.vitracker/dx7, scanned recursively)
+    juce::File userDir = vitrackerDir.getChildFile("dx7");
+    if (userDir.isDirectory()) {
+        scanDirectory(userDir.getFullPathName().toStdString(), true);
+    }
 }
 
 void DX7PresetBank::loadBundledPresets()
@@ -288,17 +659,8 @@ void DX7PresetBank::loadBundledPresets()
         return;
     }
 
-    // Find all .syx files in the resources directory
-    juce::Array<juce::File> syxFiles;
-    resourcesDir.findChildFiles(syxFiles, juce::File::findFiles, false, "*.syx");
-
-    // Sort files alphabetically for consistent ordering
-    syxFiles.sort();
-
-    // Load each sysex file
-    for (const auto& file : syxFiles) {
-        loadSysexFile(file.getFullPathName().toStdString());
-    }
+    // Load all .syx files in the resources directory
+    scanDirectory(resourcesDir.getFullPathName().toStdString(), false);
 
     // If no presets were loaded, fall back to built-in presets
     if (presets_.empty()) {
@@ -498,7 +860,7 @@ void DX7PresetBank::loadBuiltInPresets()
         preset.bankName = "Factory";
         preset.patchIndex = static_cast<int>(presets_.size());
         std::copy(patch.data, patch.data + DX7_PACKED_PATCH_SIZE, preset.packedData.begin());
-        presets_.push_back(std::move(preset));
+        addPreset(std::move(preset));
     }
 }
 
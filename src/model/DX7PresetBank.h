@@ -5,6 +5,8 @@
 #include <memory>
 #include <cstdint>
 #include <array>
+#include <map>
+#include <unordered_map>
 
 namespace model {
 
@@ -28,12 +30,24 @@ public:
     DX7PresetBank();
     ~DX7PresetBank();
 
+    // Movable, so a bank loaded on a background thread can be handed over
+    DX7PresetBank(DX7PresetBank&&) noexcept;
+    DX7PresetBank& operator=(DX7PresetBank&&) noexcept;
+
     // Load a single sysex file (32 patches)
     bool loadSysexFile(const std::string& filePath);
 
-    // Scan a directory for all .syx files
+    // Scan a directory for all .syx files. Files are parsed in parallel, and banks
+    // whose size/mtime match the index cache (see setIndexCachePath) aren't re-read.
     void scanDirectory(const std::string& dirPath, bool recursive = true);
 
+    // Binary cache of parsed banks, keyed by file path. Empty = no caching.
+    void setIndexCachePath(const std::string& path) { indexCachePath_ = path; }
+
+    // Load bundled + user library banks on first use (no-op afterwards)
+    void ensureLoaded();
+    bool isLoaded() const { return loaded_; }
+
     // Get all loaded presets
     const std::vector<DX7Preset>& getPresets() const { return presets_; }
 
@@ -43,9 +57,24 @@ public:
     // Get preset count
     int getPresetCount() const { return static_cast<int>(presets_.size()); }
 
-    // Search presets by name (case-insensitive substring match)
+    // Search presets by name (case-insensitive substring match).
+    // Answered from an n-gram index, so cost scales with matches, not library size.
     std::vector<int> searchPresets(const std::string& query) const;
 
+    // Index of the preset with exactly this packed patch, -1 if none. Indices
+    // move as the library (and what it de-duplicates) changes; the patch is
+    // what identifies a preset
+    int findPreset(const uint8_t* packedData) const;
+
+    // Patches skipped because an identical one was already loaded
+    int getDuplicateCount() const { return duplicateCount_; }
+
+    // Presets, search indexes and the index cache (see MemoryUsage.h)
+    size_t getAllocatedBytes() const;
+
+    // 64-bit FNV-1a over the whole packed patch (name included)
+    static uint64_t hashPatch(const uint8_t* packedData);
+
     // Unpack a 128-byte packed patch to 156-byte unpacked format
     static void unpackPatch(const uint8_t* packed, uint8_t* unpacked);
 
@@ -62,11 +91,35 @@ public:
     void loadBuiltInPresets();
 
 private:
-    std::vector<DX7Preset> presets_;
+    // Parsed contents of one .syx file, as stored in the index cache
+    struct CachedBank {
+        int64_t modTime = 0;
+        int64_t fileSize = 0;
+        std::vector<std::pair<int, std::array<uint8_t, DX7_PACKED_PATCH_SIZE>>> patches;
+    };
 
-    bool validateSysexHeader(const uint8_t* data, size_t size);
-    std::string sanitizePatchName(const std::string& name);
-    std::string getFileBasename(const std::string& path);
+    std::vector<DX7Preset> presets_;
+    std::vector<std::string> lowerNames_;                           // Parallel to presets_
+    std::unordered_map<uint64_t, std::vector<int>> patchHashes_;    // Hash -> preset indices
+    std::unordered_map<uint32_t, std::vector<int>> nameGrams_;      // 1-3 char gram -> sorted preset indices
+    int duplicateCount_ = 0;
+
+    std::string indexCachePath_;
+    std::map<std::string, CachedBank> indexCache_;
+    bool indexCacheRead_ = false;
+    bool loaded_ = false;
+
+    bool addPreset(DX7Preset&& preset);
+    void addBank(const std::string& bankName, const CachedBank& bank);
+    void readIndexCache();
+    void writeIndexCache() const;
+
+    static bool parseSysexFile(const std::string& filePath, CachedBank& bank);
+    static uint32_t gramKey(const char* text, size_t length);
+
+    static bool validateSysexHeader(const uint8_t* data, size_t size);
+    static std::string sanitizePatchName(const std::string& name);
+    static std::string getFileBasename(const std::string& path);
 };
 
 } // namespace model
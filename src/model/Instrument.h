@@ -59,7 +59,8 @@ struct SendLevels
     float reverb = 0.0f;
     float delay = 0.0f;
     float chorus = 0.0f;
-    float sidechainDuck = 0.0f;
+    float sidechainDuck = 0.0f;  // How far the sidechain ducks this channel (times the mixer amount)
+    float sidechainKey = 0.0f;   // Level into the sidechain key (0 = not a key)
 };
 
 // Channel strip parameters (per-instrument insert processing)
@@ -93,6 +94,7 @@ struct ChannelStripParams {
     float ottMidDepth = 0.0f;   // 0-1 mid band depth (0 = bypass)
     float ottHighDepth = 0.0f;  // 0-1 high band depth (0 = bypass)
     float ottMix = 1.0f;        // 0-1 wet/dry
+    bool ottLink = false;       // Stereo-linked detection
 };
 
 class Instrument
@@ -138,6 +140,11 @@ public:
     bool isSoloed() const { return soloed_; }
     void setSoloed(bool s) { soloed_ = s; }
 
+    // Where the channel goes: a group bus index, or -1 for the master.
+    // Set through Project::setInstrumentOutput, which checks the bus exists
+    int getOutput() const { return output_; }
+    void setOutput(int output) { output_ = output; }
+
     InstrumentType getType() const { return type_; }
     void setType(InstrumentType type) { type_ = type; }
 
@@ -156,6 +163,7 @@ private:
     float pan_ = 0.0f;       // -1.0 (left) to +1.0 (right)
     bool muted_ = false;
     bool soloed_ = false;
+    int output_ = -1;
 
     InstrumentType type_ = InstrumentType::Plaits;
 };
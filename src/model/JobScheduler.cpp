@@ -0,0 +1,221 @@
+#include "JobScheduler.h"
+
+namespace model {
+
+namespace {
+
+constexpr int kFreeCores = 2;  // Audio callback plus the message thread
+constexpr int kStopTimeoutMs = 10000;
+
+} // anonymous namespace
+
+class JobScheduler::Worker : public juce::Thread
+{
+public:
+    Worker(JobScheduler& owner, int index)
+        : juce::Thread("Job Worker " + juce::String(index)),
+          owner_(owner)
+    {
+    }
+
+    void run() override { owner_.workerLoop(); }
+
+private:
+    JobScheduler& owner_;
+};
+
+JobScheduler::JobScheduler()
+{
+    self_ = this;
+
+    const int numWorkers = juce::jlimit(1, kMaxWorkers, juce::SystemStats::getNumCpus() - kFreeCores);
+    for (int i = 0; i < numWorkers; ++i)
+    {
+        workers_.push_back(std::make_unique<Worker>(*this, i + 1));
+        workers_.back()->startThread(juce::Thread::Priority::low);
+    }
+}
+
+JobScheduler::~JobScheduler()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        // Running jobs wind down at their next check; the rest never start
+        for (auto& [id, entry] : jobs_)
+            entry.job.token.cancel();
+    }
+    wake_.notify_all();
+
+    for (auto& worker : workers_)
+        worker->stopThread(kStopTimeoutMs);
+}
+
+JobScheduler::JobId JobScheduler::submit(Job job)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    const JobId id = ++nextId_;
+
+    // Dependencies that have already finished don't count
+    Entry entry;
+    for (JobId dependency : job.after)
+    {
+        auto it = jobs_.find(dependency);
+        if (it != jobs_.end())
+        {
+            it->second.dependents.push_back(id);
+            ++entry.waitingOn;
+        }
+    }
+
+    const auto priority = static_cast<size_t>(job.priority);
+    entry.job = std::move(job);
+    const bool ready = entry.waitingOn == 0;
+    jobs_.emplace(id, std::move(entry));
+
+    if (ready)
+    {
+        ready_[priority].push_back(id);
+        wake_.notify_one();
+    }
+    return id;
+}
+
+JobScheduler::JobId JobScheduler::submit(Priority priority, CancellationToken token,
+                                         std::function<void(const CancellationToken&)> work,
+                                         std::function<void()> onComplete)
+{
+    Job job;
+    job.priority = priority;
+    job.token = std::move(token);
+    job.work = std::move(work);
+    job.onComplete = std::move(onComplete);
+    return submit(std::move(job));
+}
+
+void JobScheduler::parallelFor(int count, Priority priority, const std::function<void(int)>& fn)
+{
+    // Shared with the helper jobs, which may start after this returns. Those
+    // find no index left and never touch fn
+    struct Batch
+    {
+        const std::function<void(int)>* fn = nullptr;
+        int count = 0;
+        std::atomic<int> next{0};
+        int done = 0;  // mutex held
+        std::mutex mutex;
+        std::condition_variable allDone;
+
+        void run()
+        {
+            int ran = 0;
+            for (int i = next++; i < count; i = next++, ++ran)
+                (*fn)(i);
+            if (ran == 0)
+                return;
+
+            std::lock_guard<std::mutex> lock(mutex);
+            done += ran;
+            if (done == count)
+                allDone.notify_all();
+        }
+    };
+
+    if (count <= 0)
+        return;
+
+    auto batch = std::make_shared<Batch>();
+    batch->fn = &fn;
+    batch->count = count;
+
+    const int numHelpers = juce::jmin(getNumWorkers(), count - 1);
+    for (int h = 0; h < numHelpers; ++h)
+        submit(priority, {}, [batch](const CancellationToken&) { batch->run(); });
+    batch->run();
+
+    std::unique_lock<std::mutex> lock(batch->mutex);
+    batch->allDone.wait(lock, [&] { return batch->done == count; });
+}
+
+int JobScheduler::getNumPending() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<int>(jobs_.size());
+}
+
+void JobScheduler::workerLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stopping_)
+    {
+        JobId id = 0;
+        Job job;
+        if (!popReady(id, job))
+        {
+            wake_.wait(lock);
+            continue;
+        }
+        lock.unlock();
+
+        // A job cancelled before it started still releases its dependents
+        if (!job.token.isCancelled())
+        {
+            if (job.work)
+                job.work(job.token);
+
+            if (job.onComplete && !job.token.isCancelled())
+            {
+                juce::MessageManager::callAsync([self = self_, token = job.token,
+                                                 onComplete = std::move(job.onComplete)]() {
+                    // Checked again here: the owner may have cancelled since
+                    if (self.get() != nullptr && !token.isCancelled())
+                        onComplete();
+                });
+            }
+        }
+
+        // The job's captures are released here, off the message thread
+        job = Job();
+
+        lock.lock();
+        finished(id);
+    }
+}
+
+bool JobScheduler::popReady(JobId& id, Job& job)
+{
+    for (auto& queue : ready_)
+    {
+        if (queue.empty())
+            continue;
+
+        id = queue.front();
+        queue.pop_front();
+        // The entry keeps the token, so the destructor can still cancel it
+        auto& entry = jobs_[id];
+        job = std::move(entry.job);
+        entry.job.token = job.token;
+        return true;
+    }
+    return false;
+}
+
+void JobScheduler::finished(JobId id)
+{
+    auto it = jobs_.find(id);
+    if (it == jobs_.end())
+        return;
+
+    for (JobId dependent : it->second.dependents)
+    {
+        auto& entry = jobs_[dependent];
+        if (--entry.waitingOn == 0)
+        {
+            ready_[static_cast<size_t>(entry.job.priority)].push_back(dependent);
+            wake_.notify_one();
+        }
+    }
+    jobs_.erase(it);
+}
+
+} // namespace model
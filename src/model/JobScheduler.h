@@ -0,0 +1,107 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <juce_events/juce_events.h>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace model {
+
+// One shared pool of worker threads for the app's non-realtime work (sample
+// decode and analysis, time-stretching, preset scans, project loads, autosave).
+// Get it with juce::SharedResourcePointer<JobScheduler>; the pool lives while
+// anything holds one.
+//
+// - Ready jobs run highest priority first, oldest first within a priority.
+// - A job can wait for other jobs (submitted earlier) to finish first.
+// - Cancellation is cooperative: a job's work polls its token between steps.
+//   Cancelled jobs that haven't started are skipped, and a cancelled job's
+//   onComplete is never called. Jobs that depend on each other usually share
+//   a token, so cancelling one cancels the chain.
+// - onComplete runs on the message thread, after the work.
+//
+// Workers run below normal priority and the pool leaves two cores free, so the
+// audio callback never competes with it.
+class JobScheduler
+{
+public:
+    enum class Priority { Interactive, Prefetch, Housekeeping };  // Highest first
+
+    class CancellationToken
+    {
+    public:
+        void cancel() const { cancelled_->store(true, std::memory_order_relaxed); }
+        bool isCancelled() const { return cancelled_->load(std::memory_order_relaxed); }
+
+    private:
+        std::shared_ptr<std::atomic<bool>> cancelled_ = std::make_shared<std::atomic<bool>>(false);
+    };
+
+    using JobId = uint64_t;
+
+    struct Job
+    {
+        Priority priority = Priority::Prefetch;
+        CancellationToken token;
+        std::vector<JobId> after;                                // Runs once these are done
+        std::function<void(const CancellationToken&)> work;      // Worker thread
+        std::function<void()> onComplete;                        // Message thread
+    };
+
+    static constexpr int kMaxWorkers = 4;
+
+    JobScheduler();
+    ~JobScheduler();
+
+    // Any thread. Returns an id later jobs can wait for
+    JobId submit(Job job);
+    JobId submit(Priority priority, CancellationToken token,
+                 std::function<void(const CancellationToken&)> work,
+                 std::function<void()> onComplete = {});
+
+    // Any thread but the audio thread. Calls fn(i) for i in [0, count) on the
+    // workers and returns once every call has. The calling thread takes
+    // indices too and never waits on a job that hasn't started, so this is
+    // safe from inside a job even with every worker busy
+    void parallelFor(int count, Priority priority, const std::function<void(int)>& fn);
+
+    int getNumWorkers() const { return static_cast<int>(workers_.size()); }
+    int getNumPending() const;  // Queued, waiting or running
+
+private:
+    class Worker;
+
+    struct Entry
+    {
+        Job job;
+        int waitingOn = 0;
+        std::vector<JobId> dependents;
+    };
+
+    void workerLoop();
+    bool popReady(JobId& id, Job& job);  // mutex_ held
+    void finished(JobId id);             // mutex_ held
+
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    bool stopping_ = false;
+    JobId nextId_ = 0;
+    std::map<JobId, Entry> jobs_;                   // Every job not yet finished
+    std::array<std::deque<JobId>, 3> ready_;        // Per priority
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    juce::WeakReference<JobScheduler> self_;        // Made on the message thread, copied by workers
+
+    JUCE_DECLARE_WEAK_REFERENCEABLE(JobScheduler)
+    JUCE_DECLARE_NON_COPYABLE(JobScheduler)
+};
+
+} // namespace model
@@ -0,0 +1,161 @@
+#include "LiveRecorder.h"
+#include <algorithm>
+#include <cmath>
+
+namespace model {
+
+void LiveRecorder::RecordPassAction::undo()
+{
+    for (auto it = changes_.rbegin(); it != changes_.rend(); ++it)
+        pattern_->setStep(it->track, it->row, it->before);
+}
+
+void LiveRecorder::RecordPassAction::redo()
+{
+    for (const auto& change : changes_)
+        pattern_->setStep(change.track, change.row, change.after);
+}
+
+void LiveRecorder::begin(Pattern* pattern, int firstTrack)
+{
+    end();
+    pattern_ = pattern;
+    firstTrack_ = std::clamp(firstTrack, 0, Pattern::NUM_TRACKS - 1);
+}
+
+void LiveRecorder::end()
+{
+    // Notes still held when recording stops simply ring on
+    held_.clear();
+
+    if (pattern_ && !changes_.empty())
+    {
+        UndoManager::instance().push(
+            std::make_unique<RecordPassAction>(pattern_, std::move(changes_)));
+    }
+
+    changes_.clear();
+    pattern_ = nullptr;
+}
+
+void LiveRecorder::noteOn(double rowPosition, int note, int velocity, int instrument, int port)
+{
+    if (!pattern_ || note < 0 || note > 127)
+        return;
+
+    int row = 0;
+    int ticks = 0;
+    if (quantizeRows_ == 0)
+    {
+        double start = std::floor(rowPosition);
+        row = static_cast<int>(start);
+        ticks = static_cast<int>(std::lround((rowPosition - start) * TICKS_PER_ROW));
+        if (ticks >= TICKS_PER_ROW)
+        {
+            ++row;
+            ticks = 0;
+        }
+    }
+    else
+    {
+        row = static_cast<int>(std::lround(rowPosition / quantizeRows_)) * quantizeRows_;
+    }
+    row = wrapRow(row);
+
+    // A retrigger of a held key stays on its track; otherwise take the first
+    // track (from the cursor) that isn't holding a recorded note
+    int track = -1;
+    for (auto it = held_.begin(); it != held_.end(); ++it)
+    {
+        if (it->note == note && it->port == port)
+        {
+            track = it->track;
+            held_.erase(it);
+            break;
+        }
+    }
+    if (track < 0)
+        track = findFreeTrack();
+
+    Step step;
+    step.note = static_cast<int8_t>(note);
+    step.instrument = static_cast<int16_t>(instrument);
+    step.volume = velocity >= 127 ? 0xFF : static_cast<uint8_t>(std::max(0, velocity) * 2);
+    if (ticks > 0)
+    {
+        step.fx1.type = FXType::DLY;
+        step.fx1.value = static_cast<uint8_t>(ticks);
+    }
+    writeStep(track, row, step);
+
+    held_.push_back({note, port, track, row});
+}
+
+void LiveRecorder::noteOff(double rowPosition, int note, int port)
+{
+    if (!pattern_)
+        return;
+
+    auto it = std::find_if(held_.begin(), held_.end(), [&](const HeldNote& h) {
+        return h.note == note && h.port == port;
+    });
+    if (it == held_.end())
+        return;
+
+    HeldNote heldNote = *it;
+    held_.erase(it);
+
+    // Releases snap to the nearest row (or grid line); NOTE_OFF has no DLY
+    int grid = std::max(1, quantizeRows_);
+    int row = wrapRow(static_cast<int>(std::lround(rowPosition / grid)) * grid);
+
+    // Shorter than the grid, or the cell already holds something - leave it ringing
+    if (row == heldNote.row)
+        return;
+    const Pattern& pattern = *pattern_;
+    if (pattern.getStep(heldNote.track, row).note != Step::NOTE_EMPTY)
+        return;
+
+    Step step = pattern.getStep(heldNote.track, row);
+    step.note = Step::NOTE_OFF;
+    writeStep(heldNote.track, row, step);
+}
+
+void LiveRecorder::writeStep(int track, int row, const Step& step)
+{
+    const Pattern& pattern = *pattern_;
+    const Step& before = pattern.getStep(track, row);
+
+    auto it = std::find_if(changes_.begin(), changes_.end(), [&](const Change& c) {
+        return c.track == track && c.row == row;
+    });
+    if (it != changes_.end())
+        it->after = step;
+    else
+        changes_.push_back({track, row, before, step});
+
+    pattern_->setStep(track, row, step);
+}
+
+int LiveRecorder::wrapRow(int row) const
+{
+    int length = pattern_->getLength();
+    row %= length;
+    return row < 0 ? row + length : row;
+}
+
+int LiveRecorder::findFreeTrack() const
+{
+    for (int i = 0; i < Pattern::NUM_TRACKS; ++i)
+    {
+        int track = (firstTrack_ + i) % Pattern::NUM_TRACKS;
+        bool busy = std::any_of(held_.begin(), held_.end(), [track](const HeldNote& h) {
+            return h.track == track;
+        });
+        if (!busy)
+            return track;
+    }
+    return firstTrack_;  // More keys held than tracks - overwrite the first
+}
+
+} // namespace model
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "Pattern.h"
+#include "UndoManager.h"
+#include <vector>
+
+namespace model {
+
+// Writes notes played while the pattern loops into its steps.
+//
+// Positions arrive in rows (fractional, measured on the audio clock). With
+// quantise off, notes land on the row they were played in and the remainder
+// is kept as a DLY command in ticks (TICKS_PER_ROW, see Step.h); with a grid
+// of N rows they snap to the nearest grid line. Everything written between
+// begin() and end() is undone as a single step.
+class LiveRecorder
+{
+public:
+    // Message thread only
+    void begin(Pattern* pattern, int firstTrack);
+    void end();
+    bool isRecording() const { return pattern_ != nullptr; }
+
+    // 0 = off (row + DLY micro-timing), N = snap to every N rows
+    void setQuantize(int rows) { quantizeRows_ = rows < 0 ? 0 : rows; }
+    int getQuantize() const { return quantizeRows_; }
+
+    void noteOn(double rowPosition, int note, int velocity, int instrument, int port);
+    void noteOff(double rowPosition, int note, int port);
+
+private:
+    struct HeldNote
+    {
+        int note;
+        int port;
+        int track;
+        int row;
+    };
+
+    struct Change
+    {
+        int track;
+        int row;
+        Step before;
+        Step after;
+    };
+
+    // One record pass, undone/redone as a whole
+    class RecordPassAction : public Action
+    {
+    public:
+        RecordPassAction(Pattern* pattern, std::vector<Change> changes)
+            : pattern_(pattern), changes_(std::move(changes)) {}
+
+        void undo() override;
+        void redo() override;
+        std::string getDescription() const override { return "Record"; }
+        size_t getMemoryUsage() const override { return sizeof(*this) + bytesOf(changes_); }
+
+    private:
+        Pattern* pattern_;
+        std::vector<Change> changes_;
+    };
+
+    void writeStep(int track, int row, const Step& step);
+    int wrapRow(int row) const;
+    int findFreeTrack() const;
+
+    Pattern* pattern_ = nullptr;
+    int firstTrack_ = 0;
+    int quantizeRows_ = 0;
+    std::vector<HeldNote> held_;
+    std::vector<Change> changes_;  // First 'before' per cell, latest 'after'
+};
+
+} // namespace model
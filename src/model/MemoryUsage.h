@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace model {
+
+// Memory accounting. Owners of large allocations report them with
+//   size_t getAllocatedBytes() const
+// - the heap memory they own, not counting themselves, so an object embedded
+// in another is counted once, in sizeof its owner. Polymorphic objects that
+// only ever live on the heap (undo actions) report getMemoryUsage() instead,
+// themselves included.
+//
+// The figures are what was asked for: allocator overhead is estimated for
+// containers and not counted for anything else, and memory shared between
+// owners (FFT plans, tuning tables) is left out.
+
+// Heap bytes of a string - none while it fits the small-string buffer
+inline size_t bytesOf(const std::string& text)
+{
+    const auto data = reinterpret_cast<uintptr_t>(text.data());
+    const auto self = reinterpret_cast<uintptr_t>(&text);
+    return data >= self && data < self + sizeof(text) ? 0 : text.capacity() + 1;
+}
+
+// Containers count their own storage only; callers add what elements own
+template<typename T>
+size_t bytesOf(const std::vector<T>& values)
+{
+    return values.capacity() * sizeof(T);
+}
+
+// Tree nodes: the value plus colour, parent and two child links
+template<typename K, typename V, typename C>
+size_t bytesOf(const std::map<K, V, C>& values)
+{
+    return values.size() * (sizeof(typename std::map<K, V, C>::value_type) + 4 * sizeof(void*));
+}
+
+// Bucket array plus one linked node (value, next link, cached hash) per entry
+template<typename K, typename V, typename H>
+size_t bytesOf(const std::unordered_map<K, V, H>& values)
+{
+    return values.bucket_count() * sizeof(void*)
+         + values.size() * (sizeof(typename std::unordered_map<K, V, H>::value_type) + 2 * sizeof(void*));
+}
+
+// Bytes per subsystem, in the order first reported
+class MemoryReport
+{
+public:
+    struct Entry
+    {
+        std::string subsystem;
+        size_t bytes = 0;
+    };
+
+    // Adds to the subsystem's entry, creating it if this is its first report
+    void add(const std::string& subsystem, size_t bytes)
+    {
+        for (auto& entry : entries_)
+        {
+            if (entry.subsystem == subsystem)
+            {
+                entry.bytes += bytes;
+                return;
+            }
+        }
+        entries_.push_back({subsystem, bytes});
+    }
+
+    const std::vector<Entry>& getEntries() const { return entries_; }
+    bool has(const std::string& subsystem) const
+    {
+        for (const auto& entry : entries_)
+        {
+            if (entry.subsystem == subsystem)
+                return true;
+        }
+        return false;
+    }
+    size_t get(const std::string& subsystem) const
+    {
+        for (const auto& entry : entries_)
+        {
+            if (entry.subsystem == subsystem)
+                return entry.bytes;
+        }
+        return 0;
+    }
+    size_t getTotal() const
+    {
+        size_t total = 0;
+        for (const auto& entry : entries_)
+            total += entry.bytes;
+        return total;
+    }
+
+private:
+    std::vector<Entry> entries_;
+};
+
+} // namespace model
@@ -16,6 +16,7 @@ Pattern::Pattern(const std::string& name) : name_(name)
 void Pattern::setLength(int length)
 {
     length_ = std::clamp(length, 1, MAX_LENGTH);
+    revision_ = nextRevision();
 }
 
 Step& Pattern::getStep(int track, int row)
@@ -28,6 +29,12 @@ const Step& Pattern::getStep(int track, int row) const
     return tracks_[track][row];
 }
 
+void Pattern::setStep(int track, int row, const Step& step)
+{
+    tracks_[track][row] = step;
+    revision_ = nextRevision();
+}
+
 void Pattern::clear()
 {
     for (auto& track : tracks_)
@@ -37,6 +44,7 @@ void Pattern::clear()
             step.clear();
         }
     }
+    revision_ = nextRevision();
 }
 
 } // namespace model
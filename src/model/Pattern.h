@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Step.h"
+#include "Revision.h"
 #include <string>
 #include <vector>
 #include <array>
@@ -23,15 +24,23 @@ public:
     int getLength() const { return length_; }
     void setLength(int length);
 
+    // Writing through the non-const getStep() isn't seen as an edit: call
+    // markEdited() once done, or use setStep(). Read through a const Pattern
     Step& getStep(int track, int row);
     const Step& getStep(int track, int row) const;
+    void setStep(int track, int row, const Step& step);
 
     void clear();
 
+    // Changes with every edit (setLength, setStep, clear, markEdited)
+    uint64_t getRevision() const { return revision_; }
+    void markEdited() { revision_ = nextRevision(); }
+
 private:
     std::string name_;
     int length_ = DEFAULT_LENGTH;
     std::array<std::vector<Step>, NUM_TRACKS> tracks_;
+    uint64_t revision_ = nextRevision();
 };
 
 } // namespace model
@@ -1,5 +1,9 @@
 #include "PresetManager.h"
+#include "MemoryUsage.h"
+#include "StartupProfile.h"
 #include <juce_core/juce_core.h>
+#include <juce_events/juce_events.h>
+#include <algorithm>
 
 namespace model {
 
@@ -69,18 +73,167 @@ Preset makePresetWithMod(const std::string& name, int engine,
     return p;
 }
 
+// User preset index file header ("VTPI") and format version
+constexpr int kIndexMagic = 0x49505456;
+constexpr int kIndexVersion = 1;
+
+// Split "<engine>_<name>.json" into its parts
+bool parsePresetFileName(const juce::File& file, int& engine, std::string& name)
+{
+    auto filename = file.getFileNameWithoutExtension();
+    int underscorePos = filename.indexOf("_");
+    if (underscorePos <= 0)
+        return false;
+
+    engine = filename.substring(0, underscorePos).getIntValue();
+    if (engine < 0 || engine >= 16)
+        return false;
+
+    name = filename.substring(underscorePos + 1).toStdString();
+    return true;
+}
+
+void readLfo(const juce::var& json, LfoParams& lfo)
+{
+    if (auto* obj = json.getDynamicObject())
+    {
+        lfo.rate = static_cast<int>(obj->getProperty("rate"));
+        lfo.shape = static_cast<int>(obj->getProperty("shape"));
+        lfo.dest = static_cast<int>(obj->getProperty("dest"));
+        lfo.amount = static_cast<int>(obj->getProperty("amount"));
+    }
+}
+
+void readEnv(const juce::var& json, EnvModParams& env)
+{
+    if (auto* obj = json.getDynamicObject())
+    {
+        env.attack = static_cast<float>(obj->getProperty("attack"));
+        env.decay = static_cast<float>(obj->getProperty("decay"));
+        env.dest = static_cast<int>(obj->getProperty("dest"));
+        env.amount = static_cast<int>(obj->getProperty("amount"));
+    }
+}
+
+bool parsePresetJson(const juce::var& json, int engine, PlaitsParams& params)
+{
+    auto* obj = json.getDynamicObject();
+    if (!json.isObject() || !obj)
+        return false;
+
+    params.engine = engine;
+    params.harmonics = static_cast<float>(obj->getProperty("harmonics"));
+    params.timbre = static_cast<float>(obj->getProperty("timbre"));
+    params.morph = static_cast<float>(obj->getProperty("morph"));
+    params.attack = static_cast<float>(obj->getProperty("attack"));
+    params.decay = static_cast<float>(obj->getProperty("decay"));
+    params.polyphony = static_cast<int>(obj->getProperty("polyphony"));
+
+    if (auto* filter = obj->getProperty("filter").getDynamicObject())
+    {
+        params.filter.cutoff = static_cast<float>(filter->getProperty("cutoff"));
+        params.filter.resonance = static_cast<float>(filter->getProperty("resonance"));
+    }
+
+    readLfo(obj->getProperty("lfo1"), params.lfo1);
+    readLfo(obj->getProperty("lfo2"), params.lfo2);
+    readEnv(obj->getProperty("env1"), params.env1);
+    readEnv(obj->getProperty("env2"), params.env2);
+    return true;
+}
+
+// Binary params layout for the index - keep in sync with kIndexVersion
+void writeParams(juce::OutputStream& out, const PlaitsParams& params)
+{
+    out.writeInt(params.engine);
+    out.writeFloat(params.harmonics);
+    out.writeFloat(params.timbre);
+    out.writeFloat(params.morph);
+    out.writeFloat(params.attack);
+    out.writeFloat(params.decay);
+    out.writeInt(params.polyphony);
+    out.writeFloat(params.filter.cutoff);
+    out.writeFloat(params.filter.resonance);
+    for (const auto* lfo : { &params.lfo1, &params.lfo2 })
+    {
+        out.writeInt(lfo->rate);
+        out.writeInt(lfo->shape);
+        out.writeInt(lfo->dest);
+        out.writeInt(lfo->amount);
+    }
+    for (const auto* env : { &params.env1, &params.env2 })
+    {
+        out.writeFloat(env->attack);
+        out.writeFloat(env->decay);
+        out.writeInt(env->dest);
+        out.writeInt(env->amount);
+    }
+}
+
+void readParams(juce::InputStream& in, PlaitsParams& params)
+{
+    params.engine = in.readInt();
+    params.harmonics = in.readFloat();
+    params.timbre = in.readFloat();
+    params.morph = in.readFloat();
+    params.attack = in.readFloat();
+    params.decay = in.readFloat();
+    params.polyphony = in.readInt();
+    params.filter.cutoff = in.readFloat();
+    params.filter.resonance = in.readFloat();
+    for (auto* lfo : { &params.lfo1, &params.lfo2 })
+    {
+        lfo->rate = in.readInt();
+        lfo->shape = in.readInt();
+        lfo->dest = in.readInt();
+        lfo->amount = in.readInt();
+    }
+    for (auto* env : { &params.env1, &params.env2 })
+    {
+        env->attack = in.readFloat();
+        env->decay = in.readFloat();
+        env->dest = in.readInt();
+        env->amount = in.readInt();
+    }
+}
+
+size_t presetListBytes(const std::vector<Preset>& presets)
+{
+    size_t bytes = bytesOf(presets);
+    for (const auto& preset : presets)
+        bytes += bytesOf(preset.name);
+    return bytes;
+}
+
+// A juce::String's text follows a reference count and its allocated size
+size_t stringBytes(const juce::String& text)
+{
+    return text.isEmpty() ? 0 : 2 * sizeof(size_t) + text.getNumBytesAsUTF8() + 1;
+}
+
 } // anonymous namespace
 
 PresetManager::PresetManager()
 {
 }
 
+PresetManager::~PresetManager()
+{
+    rescanToken_.cancel();
+}
+
 void PresetManager::initialize()
 {
-    loadFactoryPresets();
-    scanUserPresets();
-    for (int i = 0; i < NUM_ENGINES; ++i)
-        rebuildPresetList(i);
+    {
+        StartupProfile::Phase phase("Factory presets");
+        loadFactoryPresets();
+        rebuildUserPresets();
+    }
+
+    // User presets follow from the background: the cached index is read
+    // there, and the rescan only re-parses JSON files whose size or mtime
+    // changed since
+    startRescan();
 }
 
 const char* PresetManager::getEngineName(int engine)
@@ -371,107 +524,217 @@ juce::File PresetManager::getPresetFile(int engine, const std::string& name) con
     return dir.getChildFile(filename);
 }
 
-void PresetManager::scanUserPresets()
+juce::File PresetManager::getIndexFile() const
 {
-    auto presetsDir = getUserPresetsDirectory();
-    if (!presetsDir.exists())
-        return;
+    return getUserPresetsDirectory().getChildFile(".index");
+}
 
-    for (int engine = 0; engine < NUM_ENGINES; ++engine)
-        userPresets_[engine].clear();
+// ===== USER PRESET INDEX =====
 
-    for (const auto& file : presetsDir.findChildFiles(juce::File::findFiles, false, "*.json"))
-    {
-        auto filename = file.getFileNameWithoutExtension();
-        int underscorePos = filename.indexOf("_");
-        if (underscorePos <= 0)
-            continue;
+bool PresetManager::readIndex(const juce::File& file, PresetIndex& index)
+{
+    juce::FileInputStream in(file);
+    if (!in.openedOk())
+        return false;
 
-        int engine = filename.substring(0, underscorePos).getIntValue();
-        if (engine < 0 || engine >= NUM_ENGINES)
-            continue;
+    if (in.readInt() != kIndexMagic || in.readInt() != kIndexVersion)
+        return false;
 
-        auto name = filename.substring(underscorePos + 1).toStdString();
+    int count = in.readInt();
+    if (count < 0)
+        return false;
 
-        // Parse JSON
-        auto json = juce::JSON::parse(file);
-        if (!json.isObject())
-            continue;
+    PresetIndex result;
+    for (int i = 0; i < count; ++i)
+    {
+        if (in.isExhausted())
+            return false;
 
-        auto* obj = json.getDynamicObject();
-        if (!obj)
-            continue;
+        auto fileName = in.readString();
+        PresetIndexEntry entry;
+        entry.modTime = in.readInt64();
+        entry.fileSize = in.readInt64();
+        entry.preset.name = in.readString().toStdString();
+        entry.preset.isFactory = false;
+        readParams(in, entry.preset.params);
+        result[fileName] = std::move(entry);
+    }
 
-        Preset preset;
-        preset.name = name;
-        preset.isFactory = false;
-        preset.params.engine = engine;
-        preset.params.harmonics = static_cast<float>(obj->getProperty("harmonics"));
-        preset.params.timbre = static_cast<float>(obj->getProperty("timbre"));
-        preset.params.morph = static_cast<float>(obj->getProperty("morph"));
-        preset.params.attack = static_cast<float>(obj->getProperty("attack"));
-        preset.params.decay = static_cast<float>(obj->getProperty("decay"));
-        preset.params.polyphony = static_cast<int>(obj->getProperty("polyphony"));
-
-        if (obj->hasProperty("filter"))
-        {
-            auto* filter = obj->getProperty("filter").getDynamicObject();
-            if (filter)
-            {
-                preset.params.filter.cutoff = static_cast<float>(filter->getProperty("cutoff"));
-                preset.params.filter.resonance = static_cast<float>(filter->getProperty("resonance"));
-            }
-        }
+    index = std::move(result);
+    return true;
+}
 
-        if (obj->hasProperty("lfo1"))
-        {
-            auto* lfo = obj->getProperty("lfo1").getDynamicObject();
-            if (lfo)
-            {
-                preset.params.lfo1.rate = static_cast<int>(lfo->getProperty("rate"));
-                preset.params.lfo1.shape = static_cast<int>(lfo->getProperty("shape"));
-                preset.params.lfo1.dest = static_cast<int>(lfo->getProperty("dest"));
-                preset.params.lfo1.amount = static_cast<int>(lfo->getProperty("amount"));
-            }
-        }
+bool PresetManager::writeIndex(const juce::File& file, const PresetIndex& index)
+{
+    // Write to a temp file and swap so a crash never leaves a truncated index
+    juce::TemporaryFile temp(file);
+    {
+        juce::FileOutputStream out(temp.getFile());
+        if (!out.openedOk())
+            return false;
 
-        if (obj->hasProperty("lfo2"))
+        out.writeInt(kIndexMagic);
+        out.writeInt(kIndexVersion);
+        out.writeInt(static_cast<int>(index.size()));
+        for (const auto& [fileName, entry] : index)
         {
-            auto* lfo = obj->getProperty("lfo2").getDynamicObject();
-            if (lfo)
-            {
-                preset.params.lfo2.rate = static_cast<int>(lfo->getProperty("rate"));
-                preset.params.lfo2.shape = static_cast<int>(lfo->getProperty("shape"));
-                preset.params.lfo2.dest = static_cast<int>(lfo->getProperty("dest"));
-                preset.params.lfo2.amount = static_cast<int>(lfo->getProperty("amount"));
-            }
+            out.writeString(fileName);
+            out.writeInt64(entry.modTime);
+            out.writeInt64(entry.fileSize);
+            out.writeString(juce::String(entry.preset.name));
+            writeParams(out, entry.preset.params);
         }
+        out.flush();
+        if (out.getStatus().failed())
+            return false;
+    }
+    return temp.overwriteTargetFileWithTemporary();
+}
 
-        if (obj->hasProperty("env1"))
-        {
-            auto* env = obj->getProperty("env1").getDynamicObject();
-            if (env)
-            {
-                preset.params.env1.attack = static_cast<float>(env->getProperty("attack"));
-                preset.params.env1.decay = static_cast<float>(env->getProperty("decay"));
-                preset.params.env1.dest = static_cast<int>(env->getProperty("dest"));
-                preset.params.env1.amount = static_cast<int>(env->getProperty("amount"));
-            }
-        }
+PresetIndex PresetManager::scanDirectory(const juce::File& dir, const PresetIndex& previous,
+                                         const JobScheduler::CancellationToken* token)
+{
+    PresetIndex result;
+    if (!dir.exists())
+        return result;
 
-        if (obj->hasProperty("env2"))
+    for (const auto& file : dir.findChildFiles(juce::File::findFiles, false, "*.json"))
+    {
+        if (token != nullptr && token->isCancelled())
+            break;
+
+        auto fileName = file.getFileName();
+        auto modTime = file.getLastModificationTime().toMilliseconds();
+        auto fileSize = file.getSize();
+
+        // Unchanged since the last scan - reuse the indexed params
+        auto it = previous.find(fileName);
+        if (it != previous.end() && it->second.modTime == modTime && it->second.fileSize == fileSize)
         {
-            auto* env = obj->getProperty("env2").getDynamicObject();
-            if (env)
-            {
-                preset.params.env2.attack = static_cast<float>(env->getProperty("attack"));
-                preset.params.env2.decay = static_cast<float>(env->getProperty("decay"));
-                preset.params.env2.dest = static_cast<int>(env->getProperty("dest"));
-                preset.params.env2.amount = static_cast<int>(env->getProperty("amount"));
-            }
+            result[fileName] = it->second;
+            continue;
         }
 
-        userPresets_[engine].push_back(preset);
+        int engine = 0;
+        std::string name;
+        if (!parsePresetFileName(file, engine, name))
+            continue;
+
+        PresetIndexEntry entry;
+        entry.modTime = modTime;
+        entry.fileSize = fileSize;
+        entry.preset.name = name;
+        entry.preset.isFactory = false;
+        if (!parsePresetJson(juce::JSON::parse(file), engine, entry.preset.params))
+            continue;
+
+        result[fileName] = std::move(entry);
+    }
+
+    return result;
+}
+
+namespace {
+
+bool indexesMatch(const PresetIndex& a, const PresetIndex& b)
+{
+    if (a.size() != b.size())
+        return false;
+    for (auto itA = a.begin(), itB = b.begin(); itA != a.end(); ++itA, ++itB)
+    {
+        if (itA->first != itB->first
+            || itA->second.modTime != itB->second.modTime
+            || itA->second.fileSize != itB->second.fileSize)
+            return false;
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+void PresetManager::startRescan()
+{
+    // The previous scan stops at its next file. This one waits for it to wind
+    // down, so two scans never write the index at once
+    rescanToken_.cancel();
+    rescanToken_ = {};
+
+    editedSinceRescan_.clear();
+    rescanPending_ = true;
+
+    struct Scan
+    {
+        PresetIndex previous;
+        PresetIndex result;
+        bool changed = false;
+        std::unique_ptr<StartupProfile::Phase> startupPhase;  // Until the UI has the result
+    };
+    auto scan = std::make_shared<Scan>();
+    if (rescanJob_ == 0)
+        scan->startupPhase = std::make_unique<StartupProfile::Phase>("User presets (background)");
+
+    JobScheduler::Job job;
+    job.priority = JobScheduler::Priority::Prefetch;
+    job.token = rescanToken_;
+    if (rescanJob_ != 0)
+        job.after = {rescanJob_};
+    job.work = [scan, dir = getUserPresetsDirectory(), indexFile = getIndexFile()](
+                   const JobScheduler::CancellationToken& token) {
+        // The index saves and deletes have kept current
+        if (!readIndex(indexFile, scan->previous))
+            scan->previous.clear();
+
+        scan->result = scanDirectory(dir, scan->previous, &token);
+        if (token.isCancelled())
+            return;
+
+        scan->changed = !indexesMatch(scan->result, scan->previous);
+        if (scan->changed && dir.exists())
+            writeIndex(indexFile, scan->result);
+    };
+    // Not called once cancelled, which the destructor does
+    job.onComplete = [this, scan]() {
+        applyRescanResult(std::make_shared<PresetIndex>(std::move(scan->result)));
+        scan->startupPhase.reset();
+    };
+    rescanJob_ = scheduler_->submit(std::move(job));
+}
+
+void PresetManager::applyRescanResult(std::shared_ptr<PresetIndex> result)
+{
+    rescanPending_ = false;
+
+    // Saves/deletes made while the scan was running win over what it saw on disk
+    for (const auto& fileName : editedSinceRescan_)
+    {
+        auto local = index_.find(fileName);
+        if (local != index_.end())
+            (*result)[fileName] = local->second;
+        else
+            result->erase(fileName);
+    }
+
+    if (!editedSinceRescan_.empty())
+        writeIndex(getIndexFile(), *result);
+    editedSinceRescan_.clear();
+
+    index_ = std::move(*result);
+    rebuildUserPresets();
+
+    if (onPresetsChanged)
+        onPresetsChanged();
+}
+
+void PresetManager::rebuildUserPresets()
+{
+    for (int engine = 0; engine < NUM_ENGINES; ++engine)
+        userPresets_[engine].clear();
+
+    for (const auto& [fileName, entry] : index_)
+    {
+        int engine = entry.preset.params.engine;
+        if (engine >= 0 && engine < NUM_ENGINES)
+            userPresets_[engine].push_back(entry.preset);
     }
 
     // Sort user presets by name
@@ -479,6 +742,7 @@ void PresetManager::scanUserPresets()
     {
         std::sort(userPresets_[engine].begin(), userPresets_[engine].end(),
             [](const Preset& a, const Preset& b) { return a.name < b.name; });
+        rebuildPresetList(engine);
     }
 }
 
@@ -541,6 +805,23 @@ bool PresetManager::isFactoryPreset(int engine, int index) const
     return allPresets_[engine][static_cast<size_t>(index)].isFactory;
 }
 
+size_t PresetManager::getAllocatedBytes() const
+{
+    size_t bytes = 0;
+    for (int engine = 0; engine < NUM_ENGINES; ++engine)
+    {
+        bytes += presetListBytes(factoryPresets_[engine]) + presetListBytes(userPresets_[engine])
+               + presetListBytes(allPresets_[engine]);
+    }
+    bytes += bytesOf(index_);
+    for (const auto& [fileName, entry] : index_)
+        bytes += stringBytes(fileName) + bytesOf(entry.preset.name);
+    bytes += bytesOf(editedSinceRescan_);
+    for (const auto& fileName : editedSinceRescan_)
+        bytes += stringBytes(fileName);
+    return bytes;
+}
+
 bool PresetManager::saveUserPreset(const std::string& name, int engine, const PlaitsParams& params)
 {
     if (name.empty() || engine < 0 || engine >= NUM_ENGINES)
@@ -605,9 +886,20 @@ bool PresetManager::saveUserPreset(const std::string& name, int engine, const Pl
     if (!file.replaceWithText(jsonString))
         return false;
 
-    // Reload user presets
-    scanUserPresets();
-    rebuildPresetList(engine);
+    // Update just this entry rather than rescanning the whole folder
+    PresetIndexEntry entry;
+    entry.modTime = file.getLastModificationTime().toMilliseconds();
+    entry.fileSize = file.getSize();
+    entry.preset.name = name;
+    entry.preset.isFactory = false;
+    entry.preset.params = params;
+    entry.preset.params.engine = engine;
+
+    index_[file.getFileName()] = entry;
+    if (rescanPending_)
+        editedSinceRescan_.push_back(file.getFileName());
+    writeIndex(getIndexFile(), index_);
+    rebuildUserPresets();
 
     return true;
 }
@@ -624,9 +916,11 @@ bool PresetManager::deleteUserPreset(const std::string& name, int engine)
     if (!file.deleteFile())
         return false;
 
-    // Reload user presets
-    scanUserPresets();
-    rebuildPresetList(engine);
+    index_.erase(file.getFileName());
+    if (rescanPending_)
+        editedSinceRescan_.push_back(file.getFileName());
+    writeIndex(getIndexFile(), index_);
+    rebuildUserPresets();
 
     return true;
 }
@@ -1,6 +1,10 @@
 #pragma once
 
 #include "Instrument.h"
+#include "JobScheduler.h"
+#include <functional>
+#include <map>
+#include <memory>
 #include <string>
 #include <vector>
 #include <juce_core/juce_core.h>
@@ -14,15 +18,32 @@ struct Preset
     PlaitsParams params;
 };
 
+// User preset index entry - mirrors one <engine>_<name>.json file on disk.
+// modTime/fileSize let the rescan skip files that haven't changed.
+struct PresetIndexEntry
+{
+    juce::int64 modTime = 0;
+    juce::int64 fileSize = 0;
+    Preset preset;
+};
+
+// Keyed by preset filename (e.g. "3_Vowel Pad.json")
+using PresetIndex = std::map<juce::String, PresetIndexEntry>;
+
 class PresetManager
 {
 public:
     PresetManager();
-    ~PresetManager() = default;
+    ~PresetManager();
 
-    // Initialize - call on startup
+    // Initialize - call on startup. Loads factory presets, then reads the cached
+    // user preset index and rescans the presets folder as a background job;
+    // onPresetsChanged is called when the user presets are in.
     void initialize();
 
+    // Called on the message thread when a background load or rescan changed the user presets
+    std::function<void()> onPresetsChanged;
+
     // Get presets for an engine
     const std::vector<Preset>& getPresetsForEngine(int engine) const;
     int getPresetCount(int engine) const;
@@ -36,6 +57,9 @@ public:
     bool deleteUserPreset(const std::string& name, int engine);
     bool isFactoryPreset(int engine, int index) const;
 
+    // Message thread. Preset lists and the user preset index (see MemoryUsage.h)
+    size_t getAllocatedBytes() const;
+
     // Get user presets directory
     juce::File getUserPresetsDirectory() const;
 
@@ -44,15 +68,31 @@ public:
 
 private:
     void loadFactoryPresets();
-    void scanUserPresets();
+    void rebuildUserPresets();
     void rebuildPresetList(int engine);
+    void startRescan();
+    void applyRescanResult(std::shared_ptr<PresetIndex> result);
 
     juce::File getPresetFile(int engine, const std::string& name) const;
+    juce::File getIndexFile() const;
+
+    // Binary index (de)serialization - used from both the message and rescan threads
+    static bool readIndex(const juce::File& file, PresetIndex& index);
+    static bool writeIndex(const juce::File& file, const PresetIndex& index);
+    static PresetIndex scanDirectory(const juce::File& dir, const PresetIndex& previous,
+                                     const JobScheduler::CancellationToken* token);
 
     static constexpr int NUM_ENGINES = 16;
     std::vector<Preset> factoryPresets_[NUM_ENGINES];
     std::vector<Preset> userPresets_[NUM_ENGINES];
     std::vector<Preset> allPresets_[NUM_ENGINES];  // Combined, factory first
+
+    PresetIndex index_;                             // Message thread only
+    std::vector<juce::String> editedSinceRescan_;   // Saves/deletes made while a rescan runs
+    bool rescanPending_ = false;                    // Result not yet applied
+    juce::SharedResourcePointer<JobScheduler> scheduler_;
+    JobScheduler::CancellationToken rescanToken_;
+    JobScheduler::JobId rescanJob_ = 0;             // The latest rescan, which the next one waits for
 };
 
 } // namespace model
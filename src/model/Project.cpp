@@ -78,4 +78,59 @@ const Chain* Project::getChain(int index) const
     return chains_[index].get();
 }
 
+int Project::addBus(const std::string& name)
+{
+    if (mixer_.buses.size() >= MAX_BUSES) return -1;
+    Bus bus;
+    bus.name = name;
+    mixer_.buses.push_back(bus);
+    return static_cast<int>(mixer_.buses.size()) - 1;
+}
+
+bool Project::removeBus(int index)
+{
+    if (index < 0 || index >= static_cast<int>(mixer_.buses.size())) return false;
+
+    // Feeds of the removed bus go to the master; later buses move down one
+    auto reroute = [index](int output) {
+        if (output == index) return -1;
+        return output > index ? output - 1 : output;
+    };
+    for (auto& instrument : instruments_)
+        instrument->setOutput(reroute(instrument->getOutput()));
+    mixer_.buses.erase(mixer_.buses.begin() + index);
+    for (auto& bus : mixer_.buses)
+        bus.output = reroute(bus.output);
+    return true;
+}
+
+bool Project::feedsBus(int bus, int target) const
+{
+    // Each bus has one output, so follow the chain (at most one step per bus)
+    const int numBuses = static_cast<int>(mixer_.buses.size());
+    for (int steps = 0; bus >= 0 && bus < numBuses && steps <= numBuses; ++steps)
+    {
+        if (bus == target) return true;
+        bus = mixer_.buses[static_cast<size_t>(bus)].output;
+    }
+    return false;
+}
+
+bool Project::setBusOutput(int bus, int output)
+{
+    const int numBuses = static_cast<int>(mixer_.buses.size());
+    if (bus < 0 || bus >= numBuses || output < -1 || output >= numBuses) return false;
+    if (output >= 0 && feedsBus(output, bus)) return false;  // Would loop
+    mixer_.buses[static_cast<size_t>(bus)].output = output;
+    return true;
+}
+
+bool Project::setInstrumentOutput(int instrument, int output)
+{
+    auto* inst = getInstrument(instrument);
+    if (!inst || output < -1 || output >= static_cast<int>(mixer_.buses.size())) return false;
+    inst->setOutput(output);
+    return true;
+}
+
 } // namespace model
@@ -4,6 +4,7 @@
 #include "Pattern.h"
 #include "Chain.h"
 #include "Song.h"
+#include "UsageIndex.h"
 #include <string>
 #include <vector>
 #include <memory>
@@ -53,6 +54,14 @@ public:
     Song& getSong() { return song_; }
     const Song& getSong() const { return song_; }
 
+    // Where instruments, patterns and chains are used. Brought up to date on
+    // each call (only edited patterns/chains are rescanned). Message thread
+    const UsageIndex& getUsageIndex() const
+    {
+        usage_.refresh(*this);
+        return usage_;
+    }
+
     // Per-track groove
     int getTrackGroove(int track) const {
         if (track >= 0 && track < 16) return trackGrooves_[static_cast<size_t>(track)];
@@ -62,6 +71,21 @@ public:
         if (track >= 0 && track < 16) trackGrooves_[static_cast<size_t>(track)] = grooveIndex;
     }
 
+    // Group bus: a mix of instrument channels (and other buses) with its
+    // own channel strip, fader and sends
+    struct Bus
+    {
+        std::string name;
+        float volume = 1.0f;           // 0.0-1.0
+        float pan = 0.0f;              // Balance, -1.0 (left) to +1.0 (right)
+        bool muted = false;
+        int output = -1;               // Bus index, -1 = master
+        SendLevels sends;              // Reverb, delay and chorus returns
+        ChannelStripParams channelStrip;
+    };
+
+    static constexpr int MAX_BUSES = 8;
+
     // Mixer state
     struct MixerState
     {
@@ -76,17 +100,22 @@ public:
         // Reverb
         float reverbSize = 0.7f;      // Room size (0-1)
         float reverbDamping = 0.3f;   // High frequency damping (0-1)
+        int reverbType = 1;           // 0 = Schroeder, 1 = FDN
+        std::string reverbImpulse;    // Impulse response file (empty = algorithmic reverb)
+        float reverbMaxTail = 4.0f;   // IR length limit in seconds
 
         // Delay
         float delayTime = 0.65f;      // Time (maps to note divisions, 0.65 = dotted crotchet)
         float delayFeedback = 0.55f;  // Feedback amount (0-1)
+        bool delayPingPong = false;   // Repeats alternate left/right
 
         // Chorus
         float chorusRate = 0.4f;      // LFO rate (0-1)
         float chorusDepth = 0.6f;     // Modulation depth (0-1)
+        bool chorusEnsemble = false;  // String-ensemble (BBD-style) voicing
 
-        // Sidechain compressor
-        int sidechainSource = -1;     // Instrument index (-1 = none)
+        // Sidechain compressor. Keyed by every instrument/bus with a key
+        // send, ducking each by its own sidechainDuck
         float sidechainAttack = 0.005f;   // Attack time (0.001-0.05)
         float sidechainRelease = 0.2f;    // Release time (0.05-1.0)
         float sidechainRatio = 0.7f;      // Compression amount (0-1, 0=off, 1=full duck)
@@ -98,12 +127,23 @@ public:
         float limiterThreshold = 0.95f;   // 0.1-1.0, threshold level
         float limiterRelease = 0.1f;      // 0.01-1.0, release time
 
+        // Group buses, in the order they were added
+        std::vector<Bus> buses;
+
         MixerState();
     };
 
     MixerState& getMixer() { return mixer_; }
     const MixerState& getMixer() const { return mixer_; }
 
+    // Routing. Outputs are a bus index or -1 for the master. Buses can feed
+    // buses, but never in a loop: those routes are refused
+    int addBus(const std::string& name);  // -1 when there are MAX_BUSES already
+    bool removeBus(int index);            // Whatever fed it goes to the master
+    bool setBusOutput(int bus, int output);
+    bool setInstrumentOutput(int instrument, int output);
+    bool feedsBus(int bus, int target) const;  // Whether bus reaches target
+
 private:
     std::string name_;
     float tempo_ = 120.0f;
@@ -115,6 +155,7 @@ private:
     std::vector<std::unique_ptr<Chain>> chains_;
     Song song_;
     MixerState mixer_;
+    mutable UsageIndex usage_;
 };
 
 } // namespace model
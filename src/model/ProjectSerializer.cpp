@@ -71,6 +71,29 @@ juce::String ProjectSerializer::toJson(const Project& project)
     mixer->setProperty("trackMutes", trackMutes);
     mixer->setProperty("trackSolos", trackSolos);
     mixer->setProperty("masterVolume", m.masterVolume);
+    mixer->setProperty("reverbType", m.reverbType);
+    mixer->setProperty("reverbImpulse", juce::String(m.reverbImpulse));
+    mixer->setProperty("delayPingPong", m.delayPingPong);
+    mixer->setProperty("chorusEnsemble", m.chorusEnsemble);
+    mixer->setProperty("reverbMaxTail", m.reverbMaxTail);
+    mixer->setProperty("sidechainAttack", m.sidechainAttack);
+    mixer->setProperty("sidechainRelease", m.sidechainRelease);
+    mixer->setProperty("sidechainRatio", m.sidechainRatio);
+
+    juce::Array<juce::var> buses;
+    for (const auto& bus : m.buses)
+    {
+        juce::DynamicObject::Ptr busObj = new juce::DynamicObject();
+        busObj->setProperty("name", juce::String(bus.name));
+        busObj->setProperty("volume", bus.volume);
+        busObj->setProperty("pan", bus.pan);
+        busObj->setProperty("muted", bus.muted);
+        busObj->setProperty("output", bus.output);
+        busObj->setProperty("sends", sendsToVar(bus.sends));
+        busObj->setProperty("channelStrip", channelStripToVar(bus.channelStrip));
+        buses.add(juce::var(busObj.get()));
+    }
+    mixer->setProperty("buses", buses);
     root->setProperty("mixer", juce::var(mixer.get()));
 
     return juce::JSON::toString(juce::var(root.get()));
@@ -162,6 +185,55 @@ bool ProjectSerializer::fromJson(Project& project, const juce::String& json)
                 m.trackSolos[i] = static_cast<bool>((*solos)[i]);
         }
         m.masterVolume = static_cast<float>(mixerObj->getProperty("masterVolume"));
+        if (mixerObj->hasProperty("reverbType"))
+            m.reverbType = std::clamp(static_cast<int>(mixerObj->getProperty("reverbType")), 0, 1);
+        m.reverbImpulse = mixerObj->getProperty("reverbImpulse").toString().toStdString();
+        if (mixerObj->hasProperty("reverbMaxTail"))
+            m.reverbMaxTail = static_cast<float>(mixerObj->getProperty("reverbMaxTail"));
+        m.delayPingPong = static_cast<bool>(mixerObj->getProperty("delayPingPong"));
+        m.chorusEnsemble = static_cast<bool>(mixerObj->getProperty("chorusEnsemble"));
+        if (mixerObj->hasProperty("sidechainAttack"))
+            m.sidechainAttack = static_cast<float>(mixerObj->getProperty("sidechainAttack"));
+        if (mixerObj->hasProperty("sidechainRelease"))
+            m.sidechainRelease = static_cast<float>(mixerObj->getProperty("sidechainRelease"));
+        if (mixerObj->hasProperty("sidechainRatio"))
+            m.sidechainRatio = static_cast<float>(mixerObj->getProperty("sidechainRatio"));
+
+        if (auto* buses = mixerObj->getProperty("buses").getArray())
+        {
+            for (const auto& busVar : *buses)
+            {
+                auto* busObj = busVar.getDynamicObject();
+                int index = busObj ? project.addBus(busObj->getProperty("name").toString().toStdString()) : -1;
+                if (index < 0)
+                    continue;
+                auto& bus = m.buses[static_cast<size_t>(index)];
+                bus.volume = static_cast<float>(busObj->getProperty("volume"));
+                bus.pan = static_cast<float>(busObj->getProperty("pan"));
+                bus.muted = static_cast<bool>(busObj->getProperty("muted"));
+                bus.output = static_cast<int>(busObj->getProperty("output"));
+                varToSends(bus.sends, busObj->getProperty("sends"));
+                varToChannelStrip(bus.channelStrip, busObj->getProperty("channelStrip"));
+            }
+        }
+
+        // Routes a hand-edited file gets wrong (missing buses, loops) fall
+        // back to the master
+        const int numBuses = static_cast<int>(m.buses.size());
+        for (int b = 0; b < numBuses; ++b)
+        {
+            auto& bus = m.buses[static_cast<size_t>(b)];
+            const int output = bus.output;
+            bus.output = -1;
+            project.setBusOutput(b, output);
+        }
+    }
+
+    for (int i = 0; i < project.getInstrumentCount(); ++i)
+    {
+        auto* inst = project.getInstrument(i);
+        if (!project.setInstrumentOutput(i, inst->getOutput()))
+            inst->setOutput(-1);
     }
 
     return true;
@@ -220,40 +292,15 @@ juce::var ProjectSerializer::instrumentToVar(const Instrument& inst)
     env2->setProperty("amount", p.env2.amount);
     obj->setProperty("env2", juce::var(env2.get()));
 
-    const auto& s = inst.getSends();
-    juce::DynamicObject::Ptr sends = new juce::DynamicObject();
-    sends->setProperty("reverb", s.reverb);
-    sends->setProperty("delay", s.delay);
-    sends->setProperty("chorus", s.chorus);
-    sends->setProperty("sidechainDuck", s.sidechainDuck);
-    obj->setProperty("sends", juce::var(sends.get()));
-
-    // Channel strip parameters
-    const auto& cs = inst.getChannelStrip();
-    juce::DynamicObject::Ptr channelStrip = new juce::DynamicObject();
-    channelStrip->setProperty("hpfFreq", cs.hpfFreq);
-    channelStrip->setProperty("hpfSlope", cs.hpfSlope);
-    channelStrip->setProperty("lowShelfGain", cs.lowShelfGain);
-    channelStrip->setProperty("lowShelfFreq", cs.lowShelfFreq);
-    channelStrip->setProperty("midFreq", cs.midFreq);
-    channelStrip->setProperty("midGain", cs.midGain);
-    channelStrip->setProperty("midQ", cs.midQ);
-    channelStrip->setProperty("highShelfGain", cs.highShelfGain);
-    channelStrip->setProperty("highShelfFreq", cs.highShelfFreq);
-    channelStrip->setProperty("driveAmount", cs.driveAmount);
-    channelStrip->setProperty("driveTone", cs.driveTone);
-    channelStrip->setProperty("punchAmount", cs.punchAmount);
-    channelStrip->setProperty("ottLowDepth", cs.ottLowDepth);
-    channelStrip->setProperty("ottMidDepth", cs.ottMidDepth);
-    channelStrip->setProperty("ottHighDepth", cs.ottHighDepth);
-    channelStrip->setProperty("ottMix", cs.ottMix);
-    obj->setProperty("channelStrip", juce::var(channelStrip.get()));
+    obj->setProperty("sends", sendsToVar(inst.getSends()));
+    obj->setProperty("channelStrip", channelStripToVar(inst.getChannelStrip()));
 
     // Per-instrument mixer controls
     obj->setProperty("volume", inst.getVolume());
     obj->setProperty("pan", inst.getPan());
     obj->setProperty("muted", inst.isMuted());
     obj->setProperty("soloed", inst.isSoloed());
+    obj->setProperty("output", inst.getOutput());
 
     return juce::var(obj.get());
 }
@@ -326,22 +373,75 @@ void ProjectSerializer::varToInstrument(Instrument& inst, const juce::var& v)
         p.env2.amount = static_cast<int>(env2Obj->getProperty("amount"));
     }
 
-    auto sendsVar = obj->getProperty("sends");
-    if (auto* sendsObj = sendsVar.getDynamicObject())
+    varToSends(inst.getSends(), obj->getProperty("sends"));
+
+    // Channel strip parameters (defaults for old files without channelStrip)
+    varToChannelStrip(inst.getChannelStrip(), obj->getProperty("channelStrip"));
+
+    // Per-instrument mixer controls (defaults for old files)
+    if (obj->hasProperty("volume"))
+        inst.setVolume(static_cast<float>(obj->getProperty("volume")));
+    if (obj->hasProperty("pan"))
+        inst.setPan(static_cast<float>(obj->getProperty("pan")));
+    if (obj->hasProperty("muted"))
+        inst.setMuted(static_cast<bool>(obj->getProperty("muted")));
+    if (obj->hasProperty("soloed"))
+        inst.setSoloed(static_cast<bool>(obj->getProperty("soloed")));
+    if (obj->hasProperty("output"))
+        inst.setOutput(static_cast<int>(obj->getProperty("output")));
+}
+
+juce::var ProjectSerializer::sendsToVar(const SendLevels& s)
+{
+    juce::DynamicObject::Ptr sends = new juce::DynamicObject();
+    sends->setProperty("reverb", s.reverb);
+    sends->setProperty("delay", s.delay);
+    sends->setProperty("chorus", s.chorus);
+    sends->setProperty("sidechainDuck", s.sidechainDuck);
+    sends->setProperty("sidechainKey", s.sidechainKey);
+    return juce::var(sends.get());
+}
+
+void ProjectSerializer::varToSends(SendLevels& s, const juce::var& v)
+{
+    if (auto* sendsObj = v.getDynamicObject())
     {
-        auto& s = inst.getSends();
         s.reverb = static_cast<float>(sendsObj->getProperty("reverb"));
         s.delay = static_cast<float>(sendsObj->getProperty("delay"));
         s.chorus = static_cast<float>(sendsObj->getProperty("chorus"));
         s.sidechainDuck = static_cast<float>(sendsObj->getProperty("sidechainDuck"));
+        s.sidechainKey = static_cast<float>(sendsObj->getProperty("sidechainKey"));
         // Note: drive removed from sends - now per-instrument in ChannelStrip
     }
+}
 
-    // Channel strip parameters (defaults for old files without channelStrip)
-    auto channelStripVar = obj->getProperty("channelStrip");
-    if (auto* csObj = channelStripVar.getDynamicObject())
+juce::var ProjectSerializer::channelStripToVar(const ChannelStripParams& cs)
+{
+    juce::DynamicObject::Ptr channelStrip = new juce::DynamicObject();
+    channelStrip->setProperty("hpfFreq", cs.hpfFreq);
+    channelStrip->setProperty("hpfSlope", cs.hpfSlope);
+    channelStrip->setProperty("lowShelfGain", cs.lowShelfGain);
+    channelStrip->setProperty("lowShelfFreq", cs.lowShelfFreq);
+    channelStrip->setProperty("midFreq", cs.midFreq);
+    channelStrip->setProperty("midGain", cs.midGain);
+    channelStrip->setProperty("midQ", cs.midQ);
+    channelStrip->setProperty("highShelfGain", cs.highShelfGain);
+    channelStrip->setProperty("highShelfFreq", cs.highShelfFreq);
+    channelStrip->setProperty("driveAmount", cs.driveAmount);
+    channelStrip->setProperty("driveTone", cs.driveTone);
+    channelStrip->setProperty("punchAmount", cs.punchAmount);
+    channelStrip->setProperty("ottLowDepth", cs.ottLowDepth);
+    channelStrip->setProperty("ottMidDepth", cs.ottMidDepth);
+    channelStrip->setProperty("ottHighDepth", cs.ottHighDepth);
+    channelStrip->setProperty("ottMix", cs.ottMix);
+    channelStrip->setProperty("ottLink", cs.ottLink);
+    return juce::var(channelStrip.get());
+}
+
+void ProjectSerializer::varToChannelStrip(ChannelStripParams& cs, const juce::var& v)
+{
+    if (auto* csObj = v.getDynamicObject())
     {
-        auto& cs = inst.getChannelStrip();
         cs.hpfFreq = static_cast<float>(csObj->getProperty("hpfFreq"));
         cs.hpfSlope = static_cast<int>(csObj->getProperty("hpfSlope"));
         cs.lowShelfGain = static_cast<float>(csObj->getProperty("lowShelfGain"));
@@ -358,17 +458,8 @@ void ProjectSerializer::varToInstrument(Instrument& inst, const juce::var& v)
         cs.ottMidDepth = static_cast<float>(csObj->getProperty("ottMidDepth"));
         cs.ottHighDepth = static_cast<float>(csObj->getProperty("ottHighDepth"));
         cs.ottMix = static_cast<float>(csObj->getProperty("ottMix"));
+        cs.ottLink = static_cast<bool>(csObj->getProperty("ottLink"));
     }
-
-    // Per-instrument mixer controls (defaults for old files)
-    if (obj->hasProperty("volume"))
-        inst.setVolume(static_cast<float>(obj->getProperty("volume")));
-    if (obj->hasProperty("pan"))
-        inst.setPan(static_cast<float>(obj->getProperty("pan")));
-    if (obj->hasProperty("muted"))
-        inst.setMuted(static_cast<bool>(obj->getProperty("muted")));
-    if (obj->hasProperty("soloed"))
-        inst.setSoloed(static_cast<bool>(obj->getProperty("soloed")));
 }
 
 juce::var ProjectSerializer::patternToVar(const Pattern& pattern)
@@ -467,6 +558,8 @@ void ProjectSerializer::varToPattern(Pattern& pattern, const juce::var& v)
             }
         }
     }
+
+    pattern.markEdited();
 }
 
 juce::var ProjectSerializer::chainToVar(const Chain& chain)
@@ -18,6 +18,12 @@ private:
     static juce::var instrumentToVar(const Instrument& inst);
     static void varToInstrument(Instrument& inst, const juce::var& v);
 
+    // Shared by instruments and group buses
+    static juce::var sendsToVar(const SendLevels& sends);
+    static void varToSends(SendLevels& sends, const juce::var& v);
+    static juce::var channelStripToVar(const ChannelStripParams& strip);
+    static void varToChannelStrip(ChannelStripParams& strip, const juce::var& v);
+
     static juce::var patternToVar(const Pattern& pattern);
     static void varToPattern(Pattern& pattern, const juce::var& v);
 
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace model {
+
+// Edit stamps for model objects. Every edit takes a fresh value from one
+// process-wide counter, so a stamp is never reused - not by another object,
+// nor by a reloaded project - and an unchanged stamp means unchanged content.
+inline uint64_t nextRevision()
+{
+    static std::atomic<uint64_t> counter{0};
+    return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+} // namespace model
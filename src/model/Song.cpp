@@ -23,6 +23,7 @@ void Song::setChain(int trackIndex, int position, int chainIndex)
         track.push_back(-1);
     }
     track[position] = chainIndex;
+    revision_ = nextRevision();
 }
 
 void Song::addChain(int trackIndex, int chainIndex)
@@ -30,6 +31,7 @@ void Song::addChain(int trackIndex, int chainIndex)
     if (trackIndex >= 0 && trackIndex < NUM_TRACKS)
     {
         tracks_[trackIndex].push_back(chainIndex);
+        revision_ = nextRevision();
     }
 }
 
@@ -41,6 +43,7 @@ void Song::removeChain(int trackIndex, int position)
     if (position >= 0 && position < static_cast<int>(track.size()))
     {
         track.erase(track.begin() + position);
+        revision_ = nextRevision();
     }
 }
 
@@ -71,6 +74,7 @@ void Song::setLength(int length)
             track.resize(static_cast<size_t>(length));
         }
     }
+    revision_ = nextRevision();
 }
 
 void Song::clear()
@@ -79,6 +83,7 @@ void Song::clear()
     {
         track.clear();
     }
+    revision_ = nextRevision();
 }
 
 } // namespace model
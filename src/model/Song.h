@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Revision.h"
 #include <array>
 #include <vector>
 
@@ -23,8 +24,12 @@ public:
 
     void clear();
 
+    // Changes whenever the song is edited
+    uint64_t getRevision() const { return revision_; }
+
 private:
     std::array<std::vector<int>, NUM_TRACKS> tracks_;
+    uint64_t revision_ = nextRevision();
 };
 
 } // namespace model
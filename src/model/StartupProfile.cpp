@@ -0,0 +1,96 @@
+#include "StartupProfile.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace model {
+
+namespace {
+
+// Taken while static objects are constructed, before main()
+const StartupProfile::Clock::time_point processStart = StartupProfile::Clock::now();
+
+double msSinceStart(StartupProfile::Clock::time_point time)
+{
+    return std::chrono::duration<double, std::milli>(time - processStart).count();
+}
+
+} // anonymous namespace
+
+StartupProfile& StartupProfile::instance()
+{
+    static StartupProfile profile;
+    return profile;
+}
+
+void StartupProfile::setEnabled(bool enabled)
+{
+    enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+StartupProfile::Phase::Phase(const char* name)
+{
+    auto& profile = instance();
+    if (!profile.isEnabled())
+        return;
+
+    name_ = name;
+    start_ = Clock::now();
+    profile.begin();
+}
+
+void StartupProfile::Phase::end()
+{
+    if (name_ == nullptr)
+        return;
+
+    instance().end(name_, start_, Clock::now());
+    name_ = nullptr;
+}
+
+void StartupProfile::begin()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++open_;
+}
+
+void StartupProfile::end(const char* name, Clock::time_point start, Clock::time_point finish)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    --open_;
+    if (printed_)
+        return;
+
+    records_.push_back({name, msSinceStart(start), msSinceStart(finish) - msSinceStart(start)});
+    printIfDone();
+}
+
+void StartupProfile::markReady()
+{
+    if (!isEnabled())
+        return;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    readyMs_ = msSinceStart(Clock::now());
+    printIfDone();
+}
+
+void StartupProfile::printIfDone()
+{
+    if (printed_ || readyMs_ < 0.0 || open_ > 0)
+        return;
+
+    printed_ = true;
+    enabled_.store(false, std::memory_order_relaxed);
+
+    std::stable_sort(records_.begin(), records_.end(),
+                     [](const Record& a, const Record& b) { return a.startMs < b.startMs; });
+
+    std::printf("Startup (ms since launch)\n%9s %9s  %s\n", "start", "duration", "phase");
+    for (const auto& record : records_)
+        std::printf("%9.1f %9.1f  %s\n", record.startMs, record.durationMs, record.name.c_str());
+    std::printf("Window ready at %.1f ms, everything loaded at %.1f ms\n",
+                readyMs_, msSinceStart(Clock::now()));
+    std::fflush(stdout);
+}
+
+} // namespace model
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace model {
+
+// Startup phase timings, printed to stdout when the app is started with
+// --profile-startup. Times are from process start.
+//
+// - A Phase times itself from construction to end() (or destruction), on any
+//   thread. Phases may nest and overlap.
+// - Background work (preset scans, cartridge loads) is timed from when it is
+//   asked for to when its results are in the UI, so the phase is created on
+//   the message thread and ended in the job's onComplete.
+// - The report is printed once markReady() has been called and every phase
+//   started before then has ended. Nothing is recorded after that.
+//
+// Disabled (the default), a Phase costs a flag check.
+class StartupProfile
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static StartupProfile& instance();
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+    class Phase
+    {
+    public:
+        explicit Phase(const char* name);
+        ~Phase() { end(); }
+
+        void end();
+
+    private:
+        const char* name_ = nullptr;  // Null when disabled or already ended
+        Clock::time_point start_;
+
+        Phase(const Phase&) = delete;
+        Phase& operator=(const Phase&) = delete;
+    };
+
+    // Message thread. The window is up; background phases may still be running
+    void markReady();
+
+private:
+    StartupProfile() = default;
+
+    struct Record
+    {
+        std::string name;
+        double startMs = 0.0;
+        double durationMs = 0.0;
+    };
+
+    void begin();
+    void end(const char* name, Clock::time_point start, Clock::time_point finish);
+    void printIfDone();  // mutex_ held
+
+    std::atomic<bool> enabled_{false};
+    std::mutex mutex_;
+    std::vector<Record> records_;
+    int open_ = 0;             // Phases started and not yet ended
+    double readyMs_ = -1.0;    // When markReady() was called
+    bool printed_ = false;
+};
+
+} // namespace model
@@ -6,6 +6,10 @@
 
 namespace model {
 
+// Tracker FX ticks per row. DLY, RET, CUT and OFF values count in these, and
+// live recording quantises to them, so playback and recording share it
+constexpr int TICKS_PER_ROW = 6;
+
 enum class FXType : uint8_t
 {
     None = 0,
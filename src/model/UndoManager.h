@@ -1,5 +1,6 @@
 #pragma once
 
+#include "MemoryUsage.h"
 #include <functional>
 #include <vector>
 #include <memory>
@@ -14,6 +15,8 @@ public:
     virtual void undo() = 0;
     virtual void redo() = 0;
     virtual std::string getDescription() const = 0;
+    // Bytes held, this action included (see MemoryUsage.h)
+    virtual size_t getMemoryUsage() const = 0;
 };
 
 template<typename T>
@@ -26,6 +29,7 @@ public:
     void undo() override { *target_ = oldValue_; }
     void redo() override { *target_ = newValue_; }
     std::string getDescription() const override { return description_; }
+    size_t getMemoryUsage() const override { return sizeof(*this) + bytesOf(description_); }
 
 private:
     T* target_;
@@ -84,6 +88,14 @@ public:
         currentIndex_ = -1;
     }
 
+    // The history, redo steps included
+    size_t getAllocatedBytes() const {
+        size_t bytes = bytesOf(actions_);
+        for (const auto& action : actions_)
+            bytes += action->getMemoryUsage();
+        return bytes;
+    }
+
     std::function<void()> onStateChanged;
 
 private:
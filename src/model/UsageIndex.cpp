@@ -0,0 +1,233 @@
+#include "UsageIndex.h"
+#include "Project.h"
+
+namespace model {
+
+static_assert(UsageIndex::MAX_INSTRUMENTS == Project::MAX_INSTRUMENTS, "UsageIndex instrument limit");
+static_assert(UsageIndex::MAX_PATTERNS == Project::MAX_PATTERNS, "UsageIndex pattern limit");
+static_assert(UsageIndex::MAX_CHAINS == Project::MAX_CHAINS, "UsageIndex chain limit");
+
+void UsageIndex::refresh(const Project& project)
+{
+    bool changed = false;
+    lastRescanCount_ = 0;
+
+    // Patterns: rescan the ones whose revision moved
+    const int numPatterns = project.getPatternCount();
+    if (static_cast<int>(patterns_.size()) != numPatterns)
+    {
+        for (int i = numPatterns; i < static_cast<int>(patterns_.size()); ++i)
+            indexPattern(i, nullptr);
+        patterns_.resize(static_cast<size_t>(numPatterns));
+        changed = true;
+    }
+    for (int i = 0; i < numPatterns; ++i)
+    {
+        const Pattern* pattern = project.getPattern(i);
+        if (pattern && pattern->getRevision() != patterns_[static_cast<size_t>(i)].revision)
+        {
+            indexPattern(i, pattern);
+            ++lastRescanCount_;
+            changed = true;
+        }
+    }
+
+    // Chains
+    const int numChains = project.getChainCount();
+    if (static_cast<int>(chains_.size()) != numChains)
+    {
+        for (int i = numChains; i < static_cast<int>(chains_.size()); ++i)
+            indexChain(i, nullptr);
+        chains_.resize(static_cast<size_t>(numChains));
+        changed = true;
+    }
+    for (int i = 0; i < numChains; ++i)
+    {
+        const Chain* chain = project.getChain(i);
+        if (chain && chain->getRevision() != chains_[static_cast<size_t>(i)].revision)
+        {
+            indexChain(i, chain);
+            ++lastRescanCount_;
+            changed = true;
+        }
+    }
+
+    // Song: small enough to rebuild outright
+    const Song& song = project.getSong();
+    if (song.getRevision() != songRevision_)
+    {
+        songRevision_ = song.getRevision();
+        for (auto& positions : chainPositions_)
+            positions.clear();
+        for (int track = 0; track < Song::NUM_TRACKS; ++track)
+        {
+            const auto& cells = song.getTrack(track);
+            for (int row = 0; row < static_cast<int>(cells.size()); ++row)
+            {
+                int chain = cells[static_cast<size_t>(row)];
+                if (chain >= 0 && chain < MAX_CHAINS)
+                    chainPositions_[static_cast<size_t>(chain)].push_back({track, row});
+            }
+        }
+        changed = true;
+    }
+
+    if (!changed)
+        return;
+
+    // Song reachability follows from the three levels above
+    songInstruments_.reset();
+    for (int chain = 0; chain < static_cast<int>(chains_.size()); ++chain)
+    {
+        if (chainPositions_[static_cast<size_t>(chain)].empty())
+            continue;
+        const auto& patterns = chains_[static_cast<size_t>(chain)].patterns;
+        for (int pattern = 0; pattern < static_cast<int>(patterns_.size()); ++pattern)
+        {
+            if (patterns.test(static_cast<size_t>(pattern)))
+                songInstruments_ |= patterns_[static_cast<size_t>(pattern)].instruments;
+        }
+    }
+    ++revision_;
+}
+
+void UsageIndex::indexPattern(int index, const Pattern* pattern)
+{
+    auto& entry = patterns_[static_cast<size_t>(index)];
+
+    for (int instrument = 0; instrument < MAX_INSTRUMENTS; ++instrument)
+    {
+        if (entry.instruments.test(static_cast<size_t>(instrument)))
+            instrumentPatterns_[static_cast<size_t>(instrument)].reset(static_cast<size_t>(index));
+    }
+    entry.instruments.reset();
+    entry.steps.clear();
+    entry.revision = 0;
+
+    if (!pattern)
+        return;
+
+    entry.revision = pattern->getRevision();
+    const int length = pattern->getLength();
+    for (int track = 0; track < Pattern::NUM_TRACKS; ++track)
+    {
+        for (int row = 0; row < length; ++row)
+        {
+            int instrument = pattern->getStep(track, row).instrument;
+            if (instrument < 0 || instrument >= MAX_INSTRUMENTS)
+                continue;
+            entry.steps.push_back({instrument, track, row});
+            entry.instruments.set(static_cast<size_t>(instrument));
+        }
+    }
+
+    for (int instrument = 0; instrument < MAX_INSTRUMENTS; ++instrument)
+    {
+        if (entry.instruments.test(static_cast<size_t>(instrument)))
+            instrumentPatterns_[static_cast<size_t>(instrument)].set(static_cast<size_t>(index));
+    }
+}
+
+void UsageIndex::indexChain(int index, const Chain* chain)
+{
+    auto& entry = chains_[static_cast<size_t>(index)];
+
+    for (int pattern = 0; pattern < MAX_PATTERNS; ++pattern)
+    {
+        if (entry.patterns.test(static_cast<size_t>(pattern)))
+            patternChains_[static_cast<size_t>(pattern)].reset(static_cast<size_t>(index));
+    }
+    entry.patterns.reset();
+    entry.revision = 0;
+
+    if (!chain)
+        return;
+
+    entry.revision = chain->getRevision();
+    for (const auto& chainEntry : chain->getEntries())
+    {
+        if (chainEntry.patternIndex >= 0 && chainEntry.patternIndex < MAX_PATTERNS)
+        {
+            entry.patterns.set(static_cast<size_t>(chainEntry.patternIndex));
+            patternChains_[static_cast<size_t>(chainEntry.patternIndex)].set(static_cast<size_t>(index));
+        }
+    }
+}
+
+std::vector<int> UsageIndex::getPatternsUsingInstrument(int instrument) const
+{
+    std::vector<int> result;
+    if (instrument < 0 || instrument >= MAX_INSTRUMENTS)
+        return result;
+
+    const auto& patterns = instrumentPatterns_[static_cast<size_t>(instrument)];
+    for (int pattern = 0; pattern < static_cast<int>(patterns_.size()); ++pattern)
+    {
+        if (patterns.test(static_cast<size_t>(pattern)))
+            result.push_back(pattern);
+    }
+    return result;
+}
+
+std::vector<UsageIndex::StepRef> UsageIndex::getStepsUsingInstrument(int instrument) const
+{
+    std::vector<StepRef> result;
+    for (int pattern : getPatternsUsingInstrument(instrument))
+    {
+        for (const auto& step : patterns_[static_cast<size_t>(pattern)].steps)
+        {
+            if (step.instrument == instrument)
+                result.push_back({pattern, step.track, step.row});
+        }
+    }
+    return result;
+}
+
+bool UsageIndex::isInstrumentUsed(int instrument) const
+{
+    return instrument >= 0 && instrument < MAX_INSTRUMENTS &&
+           instrumentPatterns_[static_cast<size_t>(instrument)].any();
+}
+
+UsageIndex::InstrumentSet UsageIndex::getInstrumentsInPattern(int pattern) const
+{
+    if (pattern < 0 || pattern >= static_cast<int>(patterns_.size()))
+        return {};
+    return patterns_[static_cast<size_t>(pattern)].instruments;
+}
+
+std::vector<int> UsageIndex::getChainsUsingPattern(int pattern) const
+{
+    std::vector<int> result;
+    if (pattern < 0 || pattern >= MAX_PATTERNS)
+        return result;
+
+    const auto& chains = patternChains_[static_cast<size_t>(pattern)];
+    for (int chain = 0; chain < static_cast<int>(chains_.size()); ++chain)
+    {
+        if (chains.test(static_cast<size_t>(chain)))
+            result.push_back(chain);
+    }
+    return result;
+}
+
+bool UsageIndex::isPatternUsed(int pattern) const
+{
+    return pattern >= 0 && pattern < MAX_PATTERNS &&
+           patternChains_[static_cast<size_t>(pattern)].any();
+}
+
+std::vector<UsageIndex::SongPosition> UsageIndex::getSongPositionsOfChain(int chain) const
+{
+    if (chain < 0 || chain >= MAX_CHAINS)
+        return {};
+    return chainPositions_[static_cast<size_t>(chain)];
+}
+
+bool UsageIndex::isChainUsed(int chain) const
+{
+    return chain >= 0 && chain < MAX_CHAINS &&
+           !chainPositions_[static_cast<size_t>(chain)].empty();
+}
+
+} // namespace model
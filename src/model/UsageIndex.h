@@ -0,0 +1,108 @@
+#pragma once
+
+#include <bitset>
+#include <cstdint>
+#include <vector>
+
+namespace model {
+
+class Chain;
+class Pattern;
+class Project;
+
+// Where instruments, patterns and chains are used:
+//   instrument -> patterns (and the rows within them)
+//   pattern    -> chains
+//   chain      -> song positions
+//
+// Kept current by refresh(), which compares each pattern's, chain's and the
+// song's revision with the one it last indexed and rescans only what changed,
+// so calling it after every edit (or on a UI timer) is cheap. Message thread
+// only; the audio engine gets the results it needs as plain bitsets.
+class UsageIndex
+{
+public:
+    static constexpr int MAX_INSTRUMENTS = 128;  // Project::MAX_INSTRUMENTS
+    static constexpr int MAX_PATTERNS = 256;     // Project::MAX_PATTERNS
+    static constexpr int MAX_CHAINS = 128;       // Project::MAX_CHAINS
+
+    using InstrumentSet = std::bitset<MAX_INSTRUMENTS>;
+
+    struct StepRef
+    {
+        int pattern = -1;
+        int track = 0;
+        int row = 0;
+    };
+
+    struct SongPosition
+    {
+        int track = 0;
+        int row = 0;
+    };
+
+    void refresh(const Project& project);
+
+    // Bumped by refresh() whenever anything it indexes changed
+    uint64_t getRevision() const { return revision_; }
+    // Patterns plus chains the last refresh() rescanned
+    int getLastRescanCount() const { return lastRescanCount_; }
+
+    // Instruments (only rows inside the pattern length count)
+    std::vector<int> getPatternsUsingInstrument(int instrument) const;
+    std::vector<StepRef> getStepsUsingInstrument(int instrument) const;
+    bool isInstrumentUsed(int instrument) const;
+    InstrumentSet getInstrumentsInPattern(int pattern) const;
+
+    // Patterns and chains
+    std::vector<int> getChainsUsingPattern(int pattern) const;
+    bool isPatternUsed(int pattern) const;  // By any chain
+    std::vector<SongPosition> getSongPositionsOfChain(int chain) const;
+    bool isChainUsed(int chain) const;      // Anywhere in the song
+
+    // Everything the song can play: instruments in patterns of chains placed
+    // in the song
+    const InstrumentSet& getInstrumentsInSong() const { return songInstruments_; }
+
+private:
+    struct StepUse
+    {
+        int instrument;
+        int track;
+        int row;
+    };
+
+    struct PatternEntry
+    {
+        uint64_t revision = 0;
+        InstrumentSet instruments;
+        std::vector<StepUse> steps;  // Track-major, rows ascending
+    };
+
+    struct ChainEntry
+    {
+        uint64_t revision = 0;
+        std::bitset<MAX_PATTERNS> patterns;
+    };
+
+    void indexPattern(int index, const Pattern* pattern);
+    void indexChain(int index, const Chain* chain);
+
+    std::vector<PatternEntry> patterns_;
+    std::vector<ChainEntry> chains_;
+    uint64_t songRevision_ = 0;
+
+    // Reverse maps, updated as entries are rescanned
+    std::vector<std::bitset<MAX_PATTERNS>> instrumentPatterns_ =
+        std::vector<std::bitset<MAX_PATTERNS>>(MAX_INSTRUMENTS);
+    std::vector<std::bitset<MAX_CHAINS>> patternChains_ =
+        std::vector<std::bitset<MAX_CHAINS>>(MAX_PATTERNS);
+    std::vector<std::vector<SongPosition>> chainPositions_ =
+        std::vector<std::vector<SongPosition>>(MAX_CHAINS);
+
+    InstrumentSet songInstruments_;
+    uint64_t revision_ = 0;
+    int lastRescanCount_ = 0;
+};
+
+} // namespace model
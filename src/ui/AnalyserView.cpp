@@ -0,0 +1,264 @@
+#include "AnalyserView.h"
+#include "../audio/AudioEngine.h"
+#include <algorithm>
+#include <cmath>
+
+namespace ui {
+
+namespace {
+
+constexpr int kTitleHeight = 18;
+constexpr int kPadding = 6;
+
+} // anonymous namespace
+
+AnalyserView::AnalyserView(audio::AudioEngine& engine)
+    : engine_(engine),
+      history_(kHistorySize, 0.0f),
+      readLeft_(kHistorySize),
+      readRight_(kHistorySize),
+      fft_(dsp::RealFFT::forSize(kFftSize)),
+      window_(kFftSize),
+      fftData_(kFftSize),
+      levels_(kFftSize / 2 + 1, kMinDb),
+      scope_(kScopeSamples, 0.0f)
+{
+    // Hann window
+    for (int i = 0; i < kFftSize; ++i)
+        window_[static_cast<size_t>(i)] = 0.5f - 0.5f * std::cos(juce::MathConstants<float>::twoPi * static_cast<float>(i) / static_cast<float>(kFftSize));
+
+    setInterceptsMouseClicks(false, false);
+    setVisible(false);
+}
+
+AnalyserView::~AnalyserView()
+{
+    hide();
+}
+
+void AnalyserView::show(audio::AnalysisTap::Point point, int index, const juce::String& name)
+{
+    tap_ = std::make_shared<audio::AnalysisTap>(point, index);
+    engine_.setAnalysisTap(tap_);
+    name_ = name;
+
+    std::fill(history_.begin(), history_.end(), 0.0f);
+    std::fill(levels_.begin(), levels_.end(), kMinDb);
+    std::fill(scope_.begin(), scope_.end(), 0.0f);
+    buildSpectrumPath();
+    buildScopePath();
+
+    setVisible(true);
+    startTimerHz(kFrameRate);
+}
+
+void AnalyserView::hide()
+{
+    stopTimer();
+    if (tap_)
+    {
+        engine_.setAnalysisTap(nullptr);
+        tap_.reset();
+    }
+    setVisible(false);
+}
+
+void AnalyserView::timerCallback()
+{
+    if (!tap_)
+        return;
+
+    // Only the newest kHistorySize samples are kept anyway
+    const int numRead = tap_->read(readLeft_.data(), readRight_.data(), kHistorySize);
+    if (numRead == 0)
+        return;  // Nothing new (stopped device) - the paths stand
+
+    for (int i = 0; i < numRead; ++i)
+    {
+        history_[static_cast<size_t>(historyPos_)] = 0.5f * (readLeft_[static_cast<size_t>(i)] + readRight_[static_cast<size_t>(i)]);
+        historyPos_ = (historyPos_ + 1) & (kHistorySize - 1);
+    }
+
+    updateSpectrum();
+    updateScope();
+    buildSpectrumPath();
+    buildScopePath();
+    repaint();
+}
+
+float AnalyserView::historyAt(int i) const
+{
+    return history_[static_cast<size_t>((historyPos_ + i) & (kHistorySize - 1))];
+}
+
+void AnalyserView::updateSpectrum()
+{
+    // The newest kFftSize samples, windowed
+    const int start = kHistorySize - kFftSize;
+    for (int i = 0; i < kFftSize; ++i)
+        fftData_[static_cast<size_t>(i)] = historyAt(start + i) * window_[static_cast<size_t>(i)];
+    fft_->forward(fftData_.data());
+
+    // Packed spectrum: re[0..n/2], then im[1..n/2-1]. A full-scale sine
+    // peaks at n/4 through the Hann window, which is 0 dB here
+    constexpr int half = kFftSize / 2;
+    constexpr float scale = 16.0f / (static_cast<float>(kFftSize) * static_cast<float>(kFftSize));
+    for (int bin = 0; bin <= half; ++bin)
+    {
+        const float re = fftData_[static_cast<size_t>(bin)];
+        const float im = bin > 0 && bin < half ? fftData_[static_cast<size_t>(half + bin)] : 0.0f;
+        const float db = 10.0f * std::log10((re * re + im * im) * scale + 1.0e-12f);
+        float& level = levels_[static_cast<size_t>(bin)];
+        level = std::max(db, level - kFallDb);
+    }
+}
+
+void AnalyserView::updateScope()
+{
+    // Trigger on the newest rising zero crossing that still leaves a whole
+    // window after it; free-run on the newest window if there isn't one
+    int start = kHistorySize - kScopeSamples;
+    for (int i = start; i > kHistorySize - 2 * kScopeSamples; --i)
+    {
+        if (historyAt(i - 1) < 0.0f && historyAt(i) >= 0.0f)
+        {
+            start = i;
+            break;
+        }
+    }
+    for (int i = 0; i < kScopeSamples; ++i)
+        scope_[static_cast<size_t>(i)] = historyAt(start + i);
+}
+
+void AnalyserView::mapColumns()
+{
+    // Log frequency axis. Where a column spans several bins it shows their
+    // peak; where a bin spans several columns they repeat it
+    const double sampleRate = engine_.getSampleRate();
+    const int width = spectrumArea_.getWidth();
+    columnBins_.resize(static_cast<size_t>(std::max(0, width)));
+    columnsSampleRate_ = sampleRate;
+
+    const float range = std::log(kMaxFrequency / kMinFrequency);
+    const float binsPerHz = static_cast<float>(kFftSize / sampleRate);
+    for (int x = 0; x < width; ++x)
+    {
+        const float f0 = kMinFrequency * std::exp(range * static_cast<float>(x) / static_cast<float>(width));
+        const float f1 = kMinFrequency * std::exp(range * static_cast<float>(x + 1) / static_cast<float>(width));
+        const int first = std::clamp(static_cast<int>(std::lround(f0 * binsPerHz)), 0, kFftSize / 2);
+        const int last = std::clamp(static_cast<int>(std::ceil(f1 * binsPerHz)) - 1, first, kFftSize / 2);
+        columnBins_[static_cast<size_t>(x)] = {first, last};
+    }
+}
+
+void AnalyserView::buildSpectrumPath()
+{
+    if (columnsSampleRate_ != engine_.getSampleRate())
+        mapColumns();
+
+    spectrumPath_.clear();
+    const auto area = spectrumArea_.toFloat();
+    for (size_t x = 0; x < columnBins_.size(); ++x)
+    {
+        const auto [first, last] = columnBins_[x];
+        const float db = *std::max_element(levels_.begin() + first, levels_.begin() + last + 1);
+        const float y = juce::jmap(juce::jlimit(kMinDb, 0.0f, db), kMinDb, 0.0f, area.getBottom(), area.getY());
+        const float px = area.getX() + static_cast<float>(x);
+        if (x == 0)
+            spectrumPath_.startNewSubPath(px, y);
+        else
+            spectrumPath_.lineTo(px, y);
+    }
+}
+
+void AnalyserView::buildScopePath()
+{
+    // One min/max pair per column
+    scopePath_.clear();
+    const auto area = scopeArea_.toFloat();
+    const int width = scopeArea_.getWidth();
+    if (width <= 0)
+        return;
+
+    auto toY = [&](float sample) {
+        return juce::jmap(juce::jlimit(-1.0f, 1.0f, sample), -1.0f, 1.0f, area.getBottom(), area.getY());
+    };
+    for (int x = 0; x < width; ++x)
+    {
+        const int first = x * kScopeSamples / width;
+        const int last = std::max(first + 1, (x + 1) * kScopeSamples / width);
+        const auto range = std::minmax_element(scope_.begin() + first, scope_.begin() + last);
+        const float px = area.getX() + static_cast<float>(x);
+        if (x == 0)
+            scopePath_.startNewSubPath(px, toY(*range.second));
+        else
+            scopePath_.lineTo(px, toY(*range.second));
+        scopePath_.lineTo(px, toY(*range.first));
+    }
+}
+
+void AnalyserView::drawGrid(juce::Graphics& g)
+{
+    g.setColour(borderColor.withAlpha(0.5f));
+    g.setFont(juce::Font(10.0f));
+
+    // Spectrum: decades across, 30 dB steps down
+    const auto spectrum = spectrumArea_.toFloat();
+    const float range = std::log(kMaxFrequency / kMinFrequency);
+    for (float frequency : {100.0f, 1000.0f, 10000.0f})
+    {
+        const float x = spectrum.getX() + spectrum.getWidth() * std::log(frequency / kMinFrequency) / range;
+        g.drawVerticalLine(juce::roundToInt(x), spectrum.getY(), spectrum.getBottom());
+        g.drawText(frequency >= 1000.0f ? juce::String(juce::roundToInt(frequency / 1000.0f)) + "k"
+                                        : juce::String(juce::roundToInt(frequency)),
+                   juce::roundToInt(x) + 2, spectrumArea_.getBottom() - 12, 30, 12,
+                   juce::Justification::centredLeft);
+    }
+    for (float db = -30.0f; db > kMinDb; db -= 30.0f)
+    {
+        const float y = juce::jmap(db, kMinDb, 0.0f, spectrum.getBottom(), spectrum.getY());
+        g.drawHorizontalLine(juce::roundToInt(y), spectrum.getX(), spectrum.getRight());
+    }
+
+    // Scope: the zero line
+    const auto scope = scopeArea_.toFloat();
+    g.drawHorizontalLine(juce::roundToInt(scope.getCentreY()), scope.getX(), scope.getRight());
+}
+
+void AnalyserView::paint(juce::Graphics& g)
+{
+    auto bounds = getLocalBounds();
+    g.setColour(panelColor);
+    g.fillRoundedRectangle(bounds.toFloat(), 6.0f);
+    g.setColour(borderColor);
+    g.drawRoundedRectangle(bounds.toFloat().reduced(0.5f), 6.0f, 1.0f);
+
+    g.setColour(titleColor);
+    g.setFont(juce::Font(12.0f).boldened());
+    g.drawText("SCOPE  " + name_, bounds.reduced(kPadding, 0).removeFromTop(kTitleHeight),
+               juce::Justification::centredLeft);
+
+    g.setColour(bgColor);
+    g.fillRect(spectrumArea_);
+    g.fillRect(scopeArea_);
+    drawGrid(g);
+
+    g.setColour(traceColor);
+    g.strokePath(spectrumPath_, juce::PathStrokeType(1.2f));
+    g.strokePath(scopePath_, juce::PathStrokeType(1.0f));
+}
+
+void AnalyserView::resized()
+{
+    auto area = getLocalBounds().reduced(kPadding);
+    area.removeFromTop(kTitleHeight - kPadding);
+    spectrumArea_ = area.removeFromLeft(area.getWidth() * 2 / 3);
+    area.removeFromLeft(kPadding);
+    scopeArea_ = area;
+
+    mapColumns();
+    buildSpectrumPath();
+    buildScopePath();
+}
+
+} // namespace ui
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "../audio/AnalysisTap.h"
+#include "../dsp/RealFFT.h"
+#include <memory>
+#include <vector>
+
+namespace audio { class AudioEngine; }
+
+namespace ui {
+
+// Spectrum analyser and triggered oscilloscope for one mixer channel
+// (:scope), docked over the bottom corner of the screen so the channel strip
+// can be edited while watching it.
+//
+// The engine copies the channel into an AnalysisTap while the view is shown,
+// and nothing once it is hidden. The view drains the tap on a timer, keeps
+// the newest audio summed to mono, and rebuilds its paths only when new
+// audio has arrived - paint just strokes them. Both traces are reduced to
+// one point (or one min/max pair) per pixel column.
+class AnalyserView : public juce::Component,
+                     private juce::Timer
+{
+public:
+    explicit AnalyserView(audio::AudioEngine& engine);
+    ~AnalyserView() override;
+
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+
+    bool isShowing() const { return isVisible(); }
+    // Listens to the channel (instead of any other) and shows the view
+    void show(audio::AnalysisTap::Point point, int index, const juce::String& name);
+    // Removes the tap from the engine
+    void hide();
+
+    static constexpr int kWidth = 560;
+    static constexpr int kHeight = 200;
+
+private:
+    void timerCallback() override;
+    float historyAt(int i) const;  // 0 = oldest
+    void updateSpectrum();
+    void updateScope();
+    void mapColumns();
+    void buildSpectrumPath();
+    void buildScopePath();
+    void drawGrid(juce::Graphics& g);
+
+    static constexpr int kFrameRate = 30;
+    static constexpr int kFftSize = 4096;
+    static constexpr int kScopeSamples = 1024;   // ~21 ms at 48 kHz
+    static constexpr int kHistorySize = 8192;    // Power of two, at least kFftSize and 2 * kScopeSamples
+    static constexpr float kMinDb = -90.0f;
+    static constexpr float kFallDb = 3.0f;       // Per frame, so peaks decay rather than flicker
+    static constexpr float kMinFrequency = 20.0f;
+    static constexpr float kMaxFrequency = 20000.0f;
+
+    audio::AudioEngine& engine_;
+    std::shared_ptr<audio::AnalysisTap> tap_;
+    juce::String name_;
+
+    // Newest audio as a ring, mid (L+R)/2; historyPos_ is the oldest sample
+    std::vector<float> history_;
+    int historyPos_ = 0;
+    std::vector<float> readLeft_, readRight_;
+
+    std::shared_ptr<const dsp::RealFFT> fft_;
+    std::vector<float> window_;
+    std::vector<float> fftData_;
+    std::vector<float> levels_;   // dB per bin, smoothed
+
+    // First and last bin drawn in each spectrum column, for this width and rate
+    std::vector<std::pair<int, int>> columnBins_;
+    double columnsSampleRate_ = 0.0;
+
+    std::vector<float> scope_;    // The triggered window
+
+    juce::Rectangle<int> spectrumArea_, scopeArea_;
+    juce::Path spectrumPath_, scopePath_;
+
+    // Colors (matching app theme)
+    static inline const juce::Colour bgColor{0xff1a1a2e};
+    static inline const juce::Colour panelColor{0xff2a2a4e};
+    static inline const juce::Colour borderColor{0xff4a4a6e};
+    static inline const juce::Colour titleColor{0xff7c7cff};
+    static inline const juce::Colour traceColor{0xff44dd44};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AnalyserView)
+};
+
+} // namespace ui
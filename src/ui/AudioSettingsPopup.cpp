@@ -2,7 +2,8 @@
 
 namespace ui {
 
-AudioSettingsPopup::AudioSettingsPopup(juce::AudioDeviceManager& deviceManager)
+AudioSettingsPopup::AudioSettingsPopup(juce::AudioDeviceManager& deviceManager,
+                                       audio::MidiInputHandler* midiInput)
     : selector_(deviceManager,
                 0,      // minAudioInputChannels
                 2,      // maxAudioInputChannels
@@ -11,7 +12,8 @@ AudioSettingsPopup::AudioSettingsPopup(juce::AudioDeviceManager& deviceManager)
                 true,   // showMidiInputOptions
                 true,   // showMidiOutputSelector
                 false,  // showChannelsAsStereoPairs
-                false)  // hideAdvancedOptionsWithButton
+                false), // hideAdvancedOptionsWithButton
+      midiInput_(midiInput)
 {
     addAndMakeVisible(selector_);
     setVisible(false);
@@ -25,7 +27,7 @@ void AudioSettingsPopup::paint(juce::Graphics& g)
     // Calculate panel bounds
     auto bounds = getLocalBounds();
     int panelWidth = kWidth + kPadding * 2;
-    int panelHeight = kHeight + kPadding * 2 + kTitleHeight;
+    int panelHeight = kHeight + kPadding * 2 + kTitleHeight + kMidiStatusHeight;
     auto panelBounds = bounds.withSizeKeepingCentre(panelWidth, panelHeight);
 
     // Draw panel background
@@ -49,19 +51,70 @@ void AudioSettingsPopup::paint(juce::Graphics& g)
     g.drawText("Press ~ or Escape to close",
                panelBounds.removeFromBottom(20).reduced(kPadding, 0),
                juce::Justification::centredRight);
+
+    // MIDI input status sits between the selector and the hint
+    drawMidiStatus(g, panelBounds.removeFromBottom(kMidiStatusHeight).reduced(kPadding, 0));
+}
+
+void AudioSettingsPopup::drawMidiStatus(juce::Graphics& g, juce::Rectangle<int> area)
+{
+    if (!midiInput_)
+        return;
+
+    g.setColour(borderColor);
+    g.drawHorizontalLine(area.getY(), static_cast<float>(area.getX()),
+                         static_cast<float>(area.getRight()));
+    area.removeFromTop(6);
+
+    g.setFont(juce::Font(13.0f));
+    const int lineHeight = 16;
+
+    // Ports and where they are routed
+    g.setColour(titleColor);
+    g.drawText("MIDI Input", area.removeFromTop(lineHeight), juce::Justification::centredLeft);
+
+    g.setColour(juce::Colours::white);
+    int numPorts = midiInput_->getNumPorts();
+    if (numPorts == 0)
+    {
+        g.drawText("No MIDI received yet", area.removeFromTop(lineHeight),
+                   juce::Justification::centredLeft);
+    }
+    for (int port = 0; port < numPorts && area.getHeight() >= lineHeight * 2; ++port)
+    {
+        int instrument = midiInput_->getPortInstrument(port);
+        juce::String route = instrument >= 0
+            ? "Instrument " + juce::String::toHexString(instrument).toUpperCase().paddedLeft('0', 2)
+            : juce::String("Selected instrument");
+        g.drawText(juce::String(port) + ": " + midiInput_->getPortName(port) + "  ->  " + route,
+                   area.removeFromTop(lineHeight), juce::Justification::centredLeft);
+    }
+
+    // Scheduling latency and jitter since the popup was opened
+    auto stats = midiInput_->getStats();
+    g.setColour(juce::Colour(0xffaaaaaa));
+    g.drawText(juce::String::formatted("Events %d   Latency %.1f ms   Late %d (avg %.2f / max %.2f ms)   Callback jitter %.2f ms",
+                                       stats.events, stats.latencyMs, stats.lateEvents,
+                                       stats.meanLateMs, stats.maxLateMs, stats.maxCallbackJitterMs),
+               area.removeFromBottom(lineHeight), juce::Justification::centredLeft);
+}
+
+void AudioSettingsPopup::timerCallback()
+{
+    repaint();
 }
 
 void AudioSettingsPopup::resized()
 {
     auto bounds = getLocalBounds();
     int panelWidth = kWidth + kPadding * 2;
-    int panelHeight = kHeight + kPadding * 2 + kTitleHeight;
+    int panelHeight = kHeight + kPadding * 2 + kTitleHeight + kMidiStatusHeight;
     auto panelBounds = bounds.withSizeKeepingCentre(panelWidth, panelHeight);
 
-    // Position selector inside panel (below title, above hint)
+    // Position selector inside panel (below title, above MIDI status and hint)
     auto selectorBounds = panelBounds.reduced(kPadding);
     selectorBounds.removeFromTop(kTitleHeight);
-    selectorBounds.removeFromBottom(20);  // Space for hint text
+    selectorBounds.removeFromBottom(20 + kMidiStatusHeight);  // Space for MIDI status and hint text
     selector_.setBounds(selectorBounds);
 }
 
@@ -69,10 +122,17 @@ void AudioSettingsPopup::show()
 {
     setVisible(true);
     toFront(true);
+
+    if (midiInput_)
+    {
+        midiInput_->resetStats();
+        startTimerHz(4);
+    }
 }
 
 void AudioSettingsPopup::hide()
 {
+    stopTimer();
     setVisible(false);
 }
 
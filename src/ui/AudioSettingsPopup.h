@@ -1,13 +1,16 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "../audio/MidiInputHandler.h"
 
 namespace ui {
 
-class AudioSettingsPopup : public juce::Component
+class AudioSettingsPopup : public juce::Component,
+                           private juce::Timer
 {
 public:
-    AudioSettingsPopup(juce::AudioDeviceManager& deviceManager);
+    AudioSettingsPopup(juce::AudioDeviceManager& deviceManager,
+                       audio::MidiInputHandler* midiInput = nullptr);
     ~AudioSettingsPopup() override = default;
 
     void paint(juce::Graphics& g) override;
@@ -19,13 +22,18 @@ public:
     void toggle();
 
 private:
+    void timerCallback() override;  // Refresh MIDI stats while visible
+    void drawMidiStatus(juce::Graphics& g, juce::Rectangle<int> area);
+
     juce::AudioDeviceSelectorComponent selector_;
+    audio::MidiInputHandler* midiInput_ = nullptr;
 
     // Layout constants
     static constexpr int kWidth = 500;
     static constexpr int kHeight = 400;
     static constexpr int kPadding = 20;
     static constexpr int kTitleHeight = 30;
+    static constexpr int kMidiStatusHeight = 90;  // Ports, routing and jitter
 
     // Colors (matching app theme)
     static inline const juce::Colour bgColor{0xff1a1a2e};
@@ -176,7 +176,7 @@ void ChannelScreen::drawRow(juce::Graphics& g, juce::Rectangle<int> area, int ro
         }
 
         case ChannelRowType::OTT: {
-            // 3-band OTT: Low, Mid, High depths + Mix
+            // 3-band OTT: Low, Mid, High depths + Mix + stereo link
             juce::String lowText = juce::String(static_cast<int>(strip.ottLowDepth * 100)) + "%";
             drawField(0, strip.ottLowDepth, 0.0f, 1.0f, "L:" + lowText);
 
@@ -188,6 +188,8 @@ void ChannelScreen::drawRow(juce::Graphics& g, juce::Rectangle<int> area, int ro
 
             juce::String mixText = juce::String(static_cast<int>(strip.ottMix * 100)) + "%";
             drawField(3, strip.ottMix, 0.0f, 1.0f, mixText);
+
+            drawField(4, strip.ottLink ? 1.0f : 0.0f, 0.0f, 1.0f, strip.ottLink ? "LINK" : "L/R");
             break;
         }
 
@@ -226,8 +228,11 @@ void ChannelScreen::drawRow(juce::Graphics& g, juce::Rectangle<int> area, int ro
         }
 
         case ChannelRowType::Sidechain: {
-            juce::String text = juce::String(static_cast<int>(sends.sidechainDuck * 100)) + "%";
-            drawField(0, sends.sidechainDuck, 0.0f, 1.0f, text);
+            juce::String duckText = "DUCK " + juce::String(static_cast<int>(sends.sidechainDuck * 100)) + "%";
+            drawField(0, sends.sidechainDuck, 0.0f, 1.0f, duckText);
+
+            juce::String keyText = "KEY " + juce::String(static_cast<int>(sends.sidechainKey * 100)) + "%";
+            drawField(1, sends.sidechainKey, 0.0f, 1.0f, keyText);
             break;
         }
 
@@ -354,7 +359,8 @@ int ChannelScreen::getNumFieldsForRow(int row) const {
         case ChannelRowType::MidEQ:     return 3;  // gain, freq, Q
         case ChannelRowType::HighShelf: return 2;  // gain, freq
         case ChannelRowType::Drive:     return 2;  // amount, tone
-        case ChannelRowType::OTT:       return 4;  // low, mid, high, mix
+        case ChannelRowType::OTT:       return 5;  // low, mid, high, mix, link
+        case ChannelRowType::Sidechain: return 2;  // duck, key
         default:                        return 1;
     }
 }
@@ -439,8 +445,10 @@ void ChannelScreen::adjustParam(int row, int field, float delta) {
                 strip.ottMidDepth = std::clamp(strip.ottMidDepth + delta * 0.01f, 0.0f, 1.0f);
             } else if (field == 2) {
                 strip.ottHighDepth = std::clamp(strip.ottHighDepth + delta * 0.01f, 0.0f, 1.0f);
-            } else {
+            } else if (field == 3) {
                 strip.ottMix = std::clamp(strip.ottMix + delta * 0.01f, 0.0f, 1.0f);
+            } else {
+                strip.ottLink = delta > 0;
             }
             break;
 
@@ -465,7 +473,11 @@ void ChannelScreen::adjustParam(int row, int field, float delta) {
             break;
 
         case ChannelRowType::Sidechain:
-            sends.sidechainDuck = std::clamp(sends.sidechainDuck + delta * 0.01f, 0.0f, 1.0f);
+            if (field == 0) {
+                sends.sidechainDuck = std::clamp(sends.sidechainDuck + delta * 0.01f, 0.0f, 1.0f);
+            } else {
+                sends.sidechainKey = std::clamp(sends.sidechainKey + delta * 0.01f, 0.0f, 1.0f);
+            }
             break;
 
         default:
@@ -18,7 +18,7 @@ enum class ChannelRowType {
     Reverb,        // reverb send
     Delay,         // delay send
     Chorus,        // chorus send
-    Sidechain,     // sidechain duck
+    Sidechain,     // sidechain duck, key
     NumRows
 };
 
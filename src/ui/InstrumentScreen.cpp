@@ -187,8 +187,9 @@ InstrumentScreen::InstrumentScreen(model::Project& project, input::ModeManager&
     samplerWaveformDisplay_ = std::make_unique<WaveformDisplay>();
     addChildComponent(samplerWaveformDisplay_.get());
 
-    // Load DX7 presets from bundled resources (or fall back to built-in presets)
-    dxPresetBank_.loadBundledPresets();
+    // DX7 presets load in the background at startup (adoptDXPresetBank), so
+    // large cartridge libraries don't slow it. Only without that load does the
+    // screen load them itself, on demand (ensureDXPresetBank)
 
     // Start playhead update timer (30Hz for smooth animation)
     startTimer(33);
@@ -199,10 +200,28 @@ void InstrumentScreen::setAudioEngine(audio::AudioEngine* engine)
     audioEngine_ = engine;
 }
 
+void InstrumentScreen::adoptDXPresetBank(model::DX7PresetBank&& bank)
+{
+    dxPresetBankExpected_ = false;
+    if (dxPresetBank_.isLoaded())
+        return;
+
+    dxPresetBank_ = std::move(bank);
+
+    // A DX7 instrument shown while the bank was loading is still waiting
+    auto* instrument = project_.getInstrument(currentInstrument_);
+    if (instrument && instrument->getType() == model::InstrumentType::DXPreset)
+        initDXInstrument(currentInstrument_);
+    repaint();
+}
+
 void InstrumentScreen::timerCallback()
 {
     if (!audioEngine_) return;
 
+    if (dxPatchSyncCountdown_ > 0 && --dxPatchSyncCountdown_ == 0)
+        syncPendingDXPatch();
+
     auto* instrument = project_.getInstrument(currentInstrument_);
     if (!instrument) return;
 
@@ -838,6 +857,24 @@ void InstrumentScreen::navigate(int dx, int dy)
 
     // Handle DX Preset navigation
     if (instrument && instrument->getType() == model::InstrumentType::DXPreset) {
+        // Up/Down move through search results while searching
+        if (dxSearchActive_) {
+            if (dy != 0 && !dxSearchResults_.empty()) {
+                dxSearchCursor_ = std::clamp(dxSearchCursor_ + dy, 0,
+                                             static_cast<int>(dxSearchResults_.size()) - 1);
+
+                // Audition the highlighted result, prefetching the ones either side
+                std::vector<int> neighbours;
+                for (int offset : {1, -1, 2, -2}) {
+                    int i = dxSearchCursor_ + offset;
+                    if (i >= 0 && i < static_cast<int>(dxSearchResults_.size()))
+                        neighbours.push_back(dxSearchResults_[static_cast<size_t>(i)]);
+                }
+                auditionDXPreset(dxSearchResults_[static_cast<size_t>(dxSearchCursor_)], neighbours);
+            }
+            repaint();
+            return;
+        }
         if (dy != 0) {
             dxPresetCursorRow_ = std::clamp(dxPresetCursorRow_ + dy, 0, kNumDXPresetRows - 1);
         }
@@ -878,7 +915,7 @@ void InstrumentScreen::navigate(int dx, int dy)
 input::InputContext InstrumentScreen::getInputContext() const
 {
     // Text editing mode takes priority
-    if (editingName_)
+    if (editingName_ || dxSearchActive_)
         return input::InputContext::TextEdit;
 
     // Check instrument type for different UI layouts
@@ -938,7 +975,7 @@ bool InstrumentScreen::handleEditKey(const juce::KeyPress& key)
     // Skip jump key handling if we're in name editing mode (let text input work)
     // Also check for jump keys DIRECTLY from raw keypress (before translateKey filters them)
     // This allows keys like d,f,m,o,p,s,u,y to work as jump keys on instrument screens
-    if (!editingName_ && !key.getModifiers().isAltDown() && !key.getModifiers().isCtrlDown() &&
+    if (!editingName_ && !dxSearchActive_ && !key.getModifiers().isAltDown() && !key.getModifiers().isCtrlDown() &&
         !key.getModifiers().isCommandDown() && isJumpKey(static_cast<char>(textChar)))
     {
         auto* inst = project_.getInstrument(currentInstrument_);
@@ -1563,8 +1600,11 @@ void InstrumentScreen::loadPreset(int presetIndex)
         }
     }
 
-    // Preview the sound
-    if (onNotePreview)
+    // Preview the sound - off-thread clip when available, so fast scrolling
+    // doesn't retrigger the live instrument on every step
+    if (previewRenderer_)
+        auditionPlaitsPreset(presetIndex);
+    else if (onNotePreview)
         onNotePreview(60, currentInstrument_);
 
     repaint();
@@ -1739,11 +1779,13 @@ bool InstrumentScreen::handleSamplerKey(const juce::KeyPress& key, bool /*isEdit
                         {
                             auto* inst = project_.getInstrument(currentInstrument_);
                             sampler->setInstrument(inst);
-                            if (sampler->loadSample(file))
-                            {
-                                updateSamplerDisplay();
-                                repaint();
-                            }
+                            sampler->loadSampleAsync(file, [screen = SafePointer<InstrumentScreen>(this)](bool loaded) {
+                                if (screen && loaded)
+                                {
+                                    screen->updateSamplerDisplay();
+                                    screen->repaint();
+                                }
+                            });
                         }
                     }
                 }
@@ -2118,6 +2160,15 @@ void InstrumentScreen::paintSamplerUI(juce::Graphics& g) {
     g.drawText("o: load   Enter: audition   +/-: zoom   Tab: change type", contentArea.removeFromTop(20), juce::Justification::centredLeft);
 }
 
+std::function<void()> InstrumentScreen::slicerRefresher() {
+    return [screen = SafePointer<InstrumentScreen>(this)]() {
+        if (screen) {
+            screen->updateSlicerDisplay();
+            screen->repaint();
+        }
+    };
+}
+
 void InstrumentScreen::updateSlicerDisplay() {
     if (!audioEngine_) return;
 
@@ -2598,7 +2649,7 @@ bool InstrumentScreen::handleSlicerKey(const juce::KeyPress& key, bool /*isEditM
         } else if (params.chopMode == model::ChopMode::Transients && slicer) {
             float sensStep = isCoarse ? 0.02f : 0.1f;
             params.transientSensitivity = std::clamp(params.transientSensitivity + delta * sensStep, 0.0f, 1.0f);
-            slicer->chopByTransients(params.transientSensitivity);
+            slicer->chopByTransients(params.transientSensitivity, slicerRefresher());
             updateSlicerDisplay();
             repaint();
             return true;
@@ -2657,7 +2708,7 @@ bool InstrumentScreen::handleSlicerKey(const juce::KeyPress& key, bool /*isEditM
                         updateSlicerDisplay();
                     } else if (params.chopMode == model::ChopMode::Transients && slicer) {
                         params.transientSensitivity = std::clamp(params.transientSensitivity + delta * 0.05f, 0.0f, 1.0f);
-                        slicer->chopByTransients(params.transientSensitivity);
+                        slicer->chopByTransients(params.transientSensitivity, slicerRefresher());
                         updateSlicerDisplay();
                     }
                 } else {
@@ -2674,7 +2725,7 @@ bool InstrumentScreen::handleSlicerKey(const juce::KeyPress& key, bool /*isEditM
                                 slicer->chopIntoDivisions(params.numDivisions);
                                 break;
                             case model::ChopMode::Transients:
-                                slicer->chopByTransients(params.transientSensitivity);
+                                slicer->chopByTransients(params.transientSensitivity, slicerRefresher());
                                 break;
                             case model::ChopMode::Lazy:
                                 // Don't auto-chop for Lazy mode - user adds slices manually
@@ -2760,9 +2811,7 @@ bool InstrumentScreen::handleSlicerKey(const juce::KeyPress& key, bool /*isEditM
                 if (file.existsAsFile() && audioEngine_) {
                     if (auto* slicer = audioEngine_->getSlicerProcessor(currentInstrument_)) {
                         slicer->setInstrument(project_.getInstrument(currentInstrument_));
-                        slicer->loadSample(file);
-                        updateSlicerDisplay();
-                        repaint();
+                        slicer->loadSampleAsync(file, [refresh = slicerRefresher()](bool) { refresh(); });
                     }
                 }
             }
@@ -2914,29 +2963,15 @@ void InstrumentScreen::cycleInstrumentType(bool reverse) {
     }
 
     // Initialize DX7 processor with first preset when switching to DXPreset type
-    if (newType == model::InstrumentType::DXPreset && audioEngine_) {
-        auto& dxParams = instrument->getDXParams();
-        if (dxPresetBank_.getPresetCount() > 0 && dxParams.presetIndex < 0) {
-            dxParams.presetIndex = 0;  // Start with first preset
-        }
-        // Load the preset into the DX7 processor
-        auto* dx7 = audioEngine_->getDX7Processor(currentInstrument_);
-        if (dx7 && dxParams.presetIndex >= 0) {
-            const auto* preset = dxPresetBank_.getPreset(dxParams.presetIndex);
-            if (preset) {
-                // Copy preset data into DXParams for persistence
-                std::copy(preset->packedData.begin(), preset->packedData.end(),
-                         dxParams.packedPatch.begin());
-                dx7->loadPackedPatch(preset->packedData.data());
-                dx7->setPolyphony(dxParams.polyphony);
-            }
-        }
+    if (newType == model::InstrumentType::DXPreset) {
+        initDXInstrument(currentInstrument_);
     }
 
     repaint();
 }
 
 void InstrumentScreen::setCurrentInstrument(int index) {
+    syncPendingDXPatch();
     currentInstrument_ = index;
 
     auto* inst = project_.getInstrument(index);
@@ -2960,24 +2995,8 @@ void InstrumentScreen::setCurrentInstrument(int index) {
         }
 
         // Sync DX7 processor with preset when switching to a DXPreset instrument
-        if (type == model::InstrumentType::DXPreset && audioEngine_) {
-            auto& dxParams = inst->getDXParams();
-            // Ensure a preset is selected
-            if (dxPresetBank_.getPresetCount() > 0 && dxParams.presetIndex < 0) {
-                dxParams.presetIndex = 0;
-            }
-            // Load the preset into the DX7 processor
-            auto* dx7 = audioEngine_->getDX7Processor(index);
-            if (dx7 && dxParams.presetIndex >= 0) {
-                const auto* preset = dxPresetBank_.getPreset(dxParams.presetIndex);
-                if (preset) {
-                    // Copy preset data into DXParams for persistence
-                    std::copy(preset->packedData.begin(), preset->packedData.end(),
-                             dxParams.packedPatch.begin());
-                    dx7->loadPackedPatch(preset->packedData.data());
-                    dx7->setPolyphony(dxParams.polyphony);
-                }
-            }
+        if (type == model::InstrumentType::DXPreset) {
+            initDXInstrument(index);
         }
     }
     repaint();
@@ -3590,18 +3609,18 @@ void InstrumentScreen::filesDropped(const juce::StringArray& files, int /*x*/, i
     if (type == model::InstrumentType::Sampler) {
         if (auto* sampler = audioEngine_->getSamplerProcessor(currentInstrument_)) {
             sampler->setInstrument(inst);
-            if (sampler->loadSample(audioFile)) {
-                updateSamplerDisplay();
-                repaint();
-            }
+            sampler->loadSampleAsync(audioFile, [screen = SafePointer<InstrumentScreen>(this)](bool loaded) {
+                if (screen && loaded) {
+                    screen->updateSamplerDisplay();
+                    screen->repaint();
+                }
+            });
         }
     }
     else if (type == model::InstrumentType::Slicer) {
         if (auto* slicer = audioEngine_->getSlicerProcessor(currentInstrument_)) {
             slicer->setInstrument(inst);
-            slicer->loadSample(audioFile);
-            updateSlicerDisplay();
-            repaint();
+            slicer->loadSampleAsync(audioFile, [refresh = slicerRefresher()](bool) { refresh(); });
         }
     }
 }
@@ -3657,6 +3676,14 @@ std::vector<HelpSection> InstrumentScreen::getHelpContent() const
             {":chop N", "Divide into N equal slices"},
         }});
     }
+    else if (type == model::InstrumentType::DXPreset) {
+        sections.push_back({"DX7", {
+            {"+/- or L/R", "Change cartridge / preset"},
+            {"/", "Search presets by name"},
+            {"Up/Down", "Select search result"},
+            {"Enter / Esc", "Load result / cancel search"},
+        }});
+    }
 
     // Modulation - common to all
     sections.push_back({"Modulation (LFO/ENV)", {
@@ -3688,6 +3715,7 @@ void InstrumentScreen::paintDXPresetUI(juce::Graphics& g) {
     auto* inst = project_.getInstrument(currentInstrument_);
     if (!inst || inst->getType() != model::InstrumentType::DXPreset) return;
 
+    ensureDXPresetBank();  // Empty until the background load is in
     const auto& dxParams = inst->getDXParams();
     auto& sends = inst->getSends();
 
@@ -3796,6 +3824,39 @@ void InstrumentScreen::paintDXPresetUI(juce::Graphics& g) {
     g.setFont(12.0f);
     g.drawText("Total presets: " + juce::String(static_cast<int>(presets.size())),
                area.removeFromTop(16), juce::Justification::centredLeft);
+
+    // Incremental search results
+    if (dxSearchActive_) {
+        area.removeFromTop(10);
+        g.setColour(cursorColor);
+        g.setFont(14.0f);
+        g.drawText("/" + juce::String(dxSearchQuery_) + "_  (" + juce::String(static_cast<int>(dxSearchResults_.size()))
+                       + " matches)",
+                   area.removeFromTop(kRowH), juce::Justification::centredLeft);
+
+        // Keep the cursor in view
+        const int visibleRows = std::max(1, area.getHeight() / 20);
+        const int numResults = static_cast<int>(dxSearchResults_.size());
+        int first = std::clamp(dxSearchCursor_ - visibleRows / 2, 0, std::max(0, numResults - visibleRows));
+
+        for (int i = first; i < std::min(numResults, first + visibleRows); ++i) {
+            const auto* preset = dxPresetBank_.getPreset(dxSearchResults_[static_cast<size_t>(i)]);
+            if (!preset) continue;
+
+            auto rowArea = area.removeFromTop(20);
+            bool isSelected = (i == dxSearchCursor_);
+            if (isSelected) {
+                g.setColour(highlightColor.withAlpha(0.3f));
+                g.fillRect(rowArea);
+            }
+            g.setColour(isSelected ? cursorColor : fgColor);
+            g.setFont(13.0f);
+            g.drawText(juce::String(preset->name), rowArea.removeFromLeft(kLabelWidth + 40), juce::Justification::centredLeft);
+            g.setColour(fgColor.darker(0.3f));
+            g.drawText(juce::String(preset->bankName) + " #" + juce::String(preset->patchIndex + 1),
+                       rowArea, juce::Justification::centredLeft);
+        }
+    }
 }
 
 bool InstrumentScreen::handleDXPresetKey(const juce::KeyPress& key, bool /*isEditMode*/) {
@@ -3805,6 +3866,52 @@ bool InstrumentScreen::handleDXPresetKey(const juce::KeyPress& key, bool /*isEdi
     auto* instrument = project_.getInstrument(currentInstrument_);
     if (!instrument || instrument->getType() != model::InstrumentType::DXPreset) return false;
 
+    ensureDXPresetBank();
+
+    // Incremental preset search ('/'): results update on every keystroke,
+    // Up/Down pick a result (see navigate()), Enter loads it, Escape cancels
+    if (dxSearchActive_)
+    {
+        switch (action.action)
+        {
+            case input::KeyAction::TextAccept:
+                if (dxSearchCursor_ >= 0 && dxSearchCursor_ < static_cast<int>(dxSearchResults_.size()))
+                    applyDXPreset(dxSearchResults_[static_cast<size_t>(dxSearchCursor_)]);
+                dxSearchActive_ = false;
+                break;
+            case input::KeyAction::TextReject:
+                dxSearchActive_ = false;
+                break;
+            case input::KeyAction::TextBackspace:
+                if (!dxSearchQuery_.empty())
+                {
+                    dxSearchQuery_.pop_back();
+                    updateDXSearch();
+                }
+                break;
+            case input::KeyAction::TextChar:
+                if (dxSearchQuery_.length() < 10)  // DX7 names are 10 chars
+                {
+                    dxSearchQuery_ += action.charData;
+                    updateDXSearch();
+                }
+                break;
+            default:
+                break;
+        }
+        repaint();
+        return true;  // Consume all keys while searching
+    }
+
+    if (key.getTextCharacter() == '/')
+    {
+        dxSearchActive_ = true;
+        dxSearchQuery_.clear();
+        updateDXSearch();
+        repaint();
+        return true;
+    }
+
     // Handle actions from translateKey()
     switch (action.action)
     {
@@ -3922,24 +4029,10 @@ bool InstrumentScreen::handleDXPresetKey(const juce::KeyPress& key, bool /*isEdi
                         // Find first preset in new bank
                         for (int i = 0; i < numPresets; ++i) {
                             if (presets[static_cast<size_t>(i)].bankName == bankNames[static_cast<size_t>(bankIdx)]) {
-                                dxParams.presetIndex = i;
+                                applyDXPreset(i);
                                 break;
                             }
                         }
-
-                        // Update DX7Instrument with new patch and store in DXParams
-                        if (audioEngine_) {
-                            auto* dx7 = audioEngine_->getDX7Processor(currentInstrument_);
-                            if (dx7 && dxParams.presetIndex >= 0) {
-                                const auto* preset = dxPresetBank_.getPreset(dxParams.presetIndex);
-                                if (preset) {
-                                    // Copy preset data into DXParams for persistence
-                                    std::copy(preset->packedData.begin(), preset->packedData.end(),
-                                             dxParams.packedPatch.begin());
-                                    dx7->loadPackedPatch(preset->packedData.data());
-                                }
-                            }
-                        }
                     }
                 }
                 break;
@@ -3973,21 +4066,7 @@ bool InstrumentScreen::handleDXPresetKey(const juce::KeyPress& key, bool /*isEdi
                         // Navigate
                         int step = isCoarse ? 8 : 1;
                         posInBank = (posInBank + valueDelta * step + static_cast<int>(bankPresets.size())) % static_cast<int>(bankPresets.size());
-                        dxParams.presetIndex = bankPresets[static_cast<size_t>(posInBank)];
-
-                        // Update DX7Instrument with new patch and store in DXParams
-                        if (audioEngine_) {
-                            auto* dx7 = audioEngine_->getDX7Processor(currentInstrument_);
-                            if (dx7) {
-                                const auto* preset = dxPresetBank_.getPreset(dxParams.presetIndex);
-                                if (preset) {
-                                    // Copy preset data into DXParams for persistence
-                                    std::copy(preset->packedData.begin(), preset->packedData.end(),
-                                             dxParams.packedPatch.begin());
-                                    dx7->loadPackedPatch(preset->packedData.data());
-                                }
-                            }
-                        }
+                        applyDXPreset(bankPresets[static_cast<size_t>(posInBank)]);
                     }
                 }
                 break;
@@ -4012,4 +4091,142 @@ bool InstrumentScreen::handleDXPresetKey(const juce::KeyPress& key, bool /*isEdi
     return false;
 }
 
+void InstrumentScreen::applyDXPreset(int presetIndex) {
+    auto* instrument = project_.getInstrument(currentInstrument_);
+    const auto* preset = dxPresetBank_.getPreset(presetIndex);
+    if (!instrument || !preset) return;
+
+    auto& dxParams = instrument->getDXParams();
+    dxParams.presetIndex = presetIndex;
+
+    // Copy preset data into DXParams for persistence
+    std::copy(preset->packedData.begin(), preset->packedData.end(), dxParams.packedPatch.begin());
+
+    // Loading the live DX7Instrument decodes the patch under the engine lock -
+    // wait until browsing pauses, and audition through the preview renderer meanwhile
+    if (dxPatchSyncInstrument_ != currentInstrument_)
+        syncPendingDXPatch();
+    dxPatchSyncInstrument_ = currentInstrument_;
+    dxPatchSyncCountdown_ = kDXPatchSyncTicks;
+
+    std::vector<int> neighbours;
+    for (int offset : {1, -1, 2, -2}) {
+        if (dxPresetBank_.getPreset(presetIndex + offset))
+            neighbours.push_back(presetIndex + offset);
+    }
+    auditionDXPreset(presetIndex, neighbours);
+}
+
+void InstrumentScreen::syncPendingDXPatch() {
+    dxPatchSyncCountdown_ = 0;
+    if (dxPatchSyncInstrument_ < 0 || !audioEngine_) return;
+
+    auto* instrument = project_.getInstrument(dxPatchSyncInstrument_);
+    auto* dx7 = audioEngine_->getDX7Processor(dxPatchSyncInstrument_);
+    if (instrument && dx7 && instrument->getType() == model::InstrumentType::DXPreset)
+        dx7->loadPackedPatch(instrument->getDXParams().packedPatch.data());
+
+    dxPatchSyncInstrument_ = -1;
+}
+
+bool InstrumentScreen::ensureDXPresetBank() {
+    if (!dxPresetBank_.isLoaded() && !dxPresetBankExpected_)
+        dxPresetBank_.ensureLoaded();
+    return dxPresetBank_.isLoaded();
+}
+
+void InstrumentScreen::initDXInstrument(int instrumentIndex) {
+    auto* instrument = project_.getInstrument(instrumentIndex);
+    if (!instrument || !audioEngine_) return;
+
+    // Still loading in the background - adoptDXPresetBank() comes back here
+    if (!ensureDXPresetBank()) return;
+
+    auto& dxParams = instrument->getDXParams();
+    const auto& patch = dxParams.packedPatch;
+    const bool hasPatch = std::any_of(patch.begin(), patch.end(), [](uint8_t b) { return b != 0; });
+    if (hasPatch) {
+        // Keep the instrument's own patch; its index follows the patch, as
+        // indices move when the library (and what it de-duplicates) changes
+        const int found = dxPresetBank_.findPreset(patch.data());
+        if (found >= 0) {
+            dxParams.presetIndex = found;
+        }
+    } else if (dxPresetBank_.getPresetCount() > 0 && dxParams.presetIndex < 0) {
+        dxParams.presetIndex = 0;  // Start with first preset
+    }
+    // Load the preset into the DX7 processor
+    auto* dx7 = audioEngine_->getDX7Processor(instrumentIndex);
+    if (dx7 && dxParams.presetIndex >= 0) {
+        const auto* preset = hasPatch ? nullptr : dxPresetBank_.getPreset(dxParams.presetIndex);
+        if (preset) {
+            // Copy preset data into DXParams for persistence
+            std::copy(preset->packedData.begin(), preset->packedData.end(),
+                     dxParams.packedPatch.begin());
+        }
+        if (hasPatch || preset) {
+            dx7->loadPackedPatch(dxParams.packedPatch.data());
+            dx7->setPolyphony(dxParams.polyphony);
+        }
+    }
+}
+
+void InstrumentScreen::auditionPlaitsPreset(int presetIndex) {
+    auto* instrument = project_.getInstrument(currentInstrument_);
+    if (!previewRenderer_ || !presetManager_ || !audioEngine_ || !instrument) return;
+
+    int engine = instrument->getParams().engine;
+    auto makeRequest = [&](int index, audio::PresetPreviewRenderer::Request& request) {
+        const auto* preset = presetManager_->getPreset(engine, index);
+        if (!preset) return false;
+        request.type = model::InstrumentType::Plaits;
+        request.plaits = preset->params;
+        request.sampleRate = audioEngine_->getSampleRate();
+        return true;
+    };
+
+    audio::PresetPreviewRenderer::Request request;
+    if (!makeRequest(presetIndex, request)) return;
+
+    std::vector<audio::PresetPreviewRenderer::Request> prefetch;
+    int count = presetManager_->getPresetCount(engine);
+    for (int offset : {1, -1, 2, -2}) {
+        audio::PresetPreviewRenderer::Request neighbour;
+        if (count > 0 && makeRequest((presetIndex + offset + count) % count, neighbour))
+            prefetch.push_back(neighbour);
+    }
+
+    previewRenderer_->audition(request, prefetch);
+}
+
+void InstrumentScreen::auditionDXPreset(int presetIndex, const std::vector<int>& neighbours) {
+    if (!previewRenderer_ || !audioEngine_) return;
+
+    auto makeRequest = [&](int index, audio::PresetPreviewRenderer::Request& request) {
+        const auto* preset = dxPresetBank_.getPreset(index);
+        if (!preset) return false;
+        request.type = model::InstrumentType::DXPreset;
+        request.dx7Patch = preset->packedData;
+        request.sampleRate = audioEngine_->getSampleRate();
+        return true;
+    };
+
+    audio::PresetPreviewRenderer::Request request;
+    if (!makeRequest(presetIndex, request)) return;
+
+    std::vector<audio::PresetPreviewRenderer::Request> prefetch;
+    for (int index : neighbours) {
+        audio::PresetPreviewRenderer::Request neighbour;
+        if (makeRequest(index, neighbour))
+            prefetch.push_back(neighbour);
+    }
+
+    previewRenderer_->audition(request, prefetch);
+}
+
+void InstrumentScreen::updateDXSearch() {
+    dxSearchResults_ = dxPresetBank_.searchPresets(dxSearchQuery_);
+    dxSearchCursor_ = 0;
+}
+
 } // namespace ui
@@ -9,6 +9,7 @@
 #include "../audio/SlicerInstrument.h"
 #include "../audio/VASynthInstrument.h"
 #include "../audio/DX7Instrument.h"
+#include "../audio/PresetPreviewRenderer.h"
 #include "../model/DX7PresetBank.h"
 
 namespace ui {
@@ -138,14 +139,24 @@ public:
 
     void setAudioEngine(audio::AudioEngine* engine) override;
     void setPresetManager(model::PresetManager* manager) { presetManager_ = manager; }
+    void setPreviewRenderer(audio::PresetPreviewRenderer* renderer) { previewRenderer_ = renderer; }
 
     // Preset management
     void loadPreset(int presetIndex);
     int getCurrentPresetIndex() const { return currentPresetIndex_; }
     bool isPresetModified() const { return presetModified_; }
+    const model::DX7PresetBank& getDXPresetBank() const { return dxPresetBank_; }
+    // Cartridges loaded in the background at startup. Call
+    // expectDXPresetBank() when the load is scheduled: DX7 instruments shown
+    // before it's in then wait for it rather than loading the bank again
+    void expectDXPresetBank() { dxPresetBankExpected_ = true; }
+    void adoptDXPresetBank(model::DX7PresetBank&& bank);
 
     // Slicer UI update (called after :chop command)
     void updateSlicerDisplay();
+    // The same, for a background job to call once it's done (if the screen
+    // is still there)
+    std::function<void()> slicerRefresher();
 
     // Timer callback for playhead updates
     void timerCallback() override;
@@ -173,6 +184,17 @@ private:
     // DX Preset-specific methods
     bool handleDXPresetKey(const juce::KeyPress& key, bool isEditMode);
     void paintDXPresetUI(juce::Graphics& g);
+    void applyDXPreset(int presetIndex);   // Select, audition, and (deferred) load into the DX7 processor
+    void updateDXSearch();
+    void syncPendingDXPatch();
+    // False while the bank is still loading in the background; loads it here
+    // if nothing else will
+    bool ensureDXPresetBank();
+    void initDXInstrument(int instrumentIndex);  // First preset into the processor, once the bank is in
+
+    // Preset auditions via the off-thread preview renderer (neighbours are prefetched)
+    void auditionPlaitsPreset(int presetIndex);
+    void auditionDXPreset(int presetIndex, const std::vector<int>& neighbours);
 
     bool editingName_ = false;
     std::string nameBuffer_;
@@ -197,6 +219,7 @@ private:
 
     audio::AudioEngine* audioEngine_ = nullptr;
     model::PresetManager* presetManager_ = nullptr;
+    audio::PresetPreviewRenderer* previewRenderer_ = nullptr;
 
     // Per-engine preset tracking
     int currentPresetIndex_ = 0;
@@ -222,9 +245,21 @@ private:
 
     // DX7 preset bank
     model::DX7PresetBank dxPresetBank_;
+    bool dxPresetBankExpected_ = false;  // Loading in the background, see adoptDXPresetBank()
     int currentDXCartridge_ = -1;   // -1 = no cartridge loaded
     int currentDXPreset_ = 0;       // 0-31 within cartridge
 
+    // DX7 patch decodes are deferred until browsing pauses (timer ticks)
+    int dxPatchSyncCountdown_ = 0;
+    int dxPatchSyncInstrument_ = -1;
+    static constexpr int kDXPatchSyncTicks = 8;  // ~250ms at 33ms
+
+    // DX7 incremental search ('/')
+    bool dxSearchActive_ = false;
+    std::string dxSearchQuery_;
+    std::vector<int> dxSearchResults_;
+    int dxSearchCursor_ = 0;
+
     static constexpr int kNumRows = static_cast<int>(InstrumentRowType::NumRows);
     static constexpr int kNumSamplerRows = static_cast<int>(SamplerRowType::NumSamplerRows);
     static constexpr int kNumSlicerRows = static_cast<int>(SlicerRowType::NumSlicerRows);
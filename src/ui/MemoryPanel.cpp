@@ -0,0 +1,138 @@
+#include "MemoryPanel.h"
+#include <algorithm>
+
+#if JUCE_LINUX
+ #include <unistd.h>
+#elif JUCE_MAC
+ #include <mach/mach.h>
+#endif
+
+namespace ui {
+
+namespace {
+
+constexpr int kTitleHeight = 18;
+constexpr int kPadding = 6;
+
+} // anonymous namespace
+
+MemoryPanel::MemoryPanel(Collector collect)
+    : collect_(std::move(collect))
+{
+    setInterceptsMouseClicks(false, false);
+    setVisible(false);
+}
+
+MemoryPanel::~MemoryPanel()
+{
+    stopTimer();
+}
+
+void MemoryPanel::show()
+{
+    refresh();
+    setVisible(true);
+    startTimerHz(kRefreshHz);
+}
+
+void MemoryPanel::hide()
+{
+    stopTimer();
+    setVisible(false);
+}
+
+void MemoryPanel::timerCallback()
+{
+    refresh();
+}
+
+void MemoryPanel::refresh()
+{
+    const auto report = collect_ ? collect_() : model::MemoryReport();
+    entries_ = report.getEntries();
+    total_ = report.getTotal();
+    resident_ = getResidentBytes();
+
+    std::stable_sort(entries_.begin(), entries_.end(),
+                     [](const auto& a, const auto& b) { return a.bytes > b.bytes; });
+    if (entries_.size() > static_cast<size_t>(kMaxRows))
+    {
+        size_t other = 0;
+        for (size_t i = static_cast<size_t>(kMaxRows - 1); i < entries_.size(); ++i)
+            other += entries_[i].bytes;
+        entries_.resize(static_cast<size_t>(kMaxRows - 1));
+        entries_.push_back({"Other", other});
+    }
+    repaint();
+}
+
+size_t MemoryPanel::getResidentBytes()
+{
+#if JUCE_LINUX
+    // statm: total and resident sizes, in pages
+    juce::StringArray fields;
+    fields.addTokens(juce::File("/proc/self/statm").loadFileAsString(), " ", "");
+    if (fields.size() < 2)
+        return 0;
+    return static_cast<size_t>(fields[1].getLargeIntValue()) * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#elif JUCE_MAC
+    mach_task_basic_info info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) != KERN_SUCCESS)
+        return 0;
+    return static_cast<size_t>(info.resident_size);
+#else
+    return 0;
+#endif
+}
+
+void MemoryPanel::paint(juce::Graphics& g)
+{
+    auto bounds = getLocalBounds();
+    g.setColour(panelColor);
+    g.fillRoundedRectangle(bounds.toFloat(), 6.0f);
+    g.setColour(borderColor);
+    g.drawRoundedRectangle(bounds.toFloat().reduced(0.5f), 6.0f, 1.0f);
+
+    auto area = bounds.reduced(kPadding, 0);
+    g.setColour(titleColor);
+    g.setFont(juce::Font(12.0f).boldened());
+    g.drawText("MEMORY", area.removeFromTop(kTitleHeight), juce::Justification::centredLeft);
+
+    // Bars are relative to the largest subsystem
+    g.setFont(juce::Font(12.0f));
+    const size_t largest = entries_.empty() ? 0 : entries_.front().bytes;
+    for (const auto& entry : entries_)
+    {
+        auto row = area.removeFromTop(kRowHeight);
+        if (largest > 0)
+        {
+            const auto fraction = static_cast<float>(static_cast<double>(entry.bytes) / static_cast<double>(largest));
+            g.setColour(barColor);
+            g.fillRect(row.withWidth(juce::roundToInt(static_cast<float>(row.getWidth()) * fraction)).reduced(0, 2));
+        }
+        g.setColour(textColor);
+        g.drawText(entry.subsystem, row.reduced(2, 0), juce::Justification::centredLeft);
+        g.drawText(juce::File::descriptionOfSizeInBytes(static_cast<juce::int64>(entry.bytes)),
+                   row.reduced(2, 0), juce::Justification::centredRight);
+    }
+
+    area = bounds.reduced(kPadding).removeFromBottom(2 * kRowHeight);
+    g.setColour(borderColor);
+    g.drawHorizontalLine(area.getY(), static_cast<float>(area.getX()), static_cast<float>(area.getRight()));
+
+    g.setColour(titleColor);
+    auto row = area.removeFromTop(kRowHeight).reduced(2, 0);
+    g.drawText("Accounted", row, juce::Justification::centredLeft);
+    g.drawText(juce::File::descriptionOfSizeInBytes(static_cast<juce::int64>(total_)), row,
+               juce::Justification::centredRight);
+    if (resident_ > 0)
+    {
+        row = area.removeFromTop(kRowHeight).reduced(2, 0);
+        g.drawText("Resident", row, juce::Justification::centredLeft);
+        g.drawText(juce::File::descriptionOfSizeInBytes(static_cast<juce::int64>(resident_)), row,
+                   juce::Justification::centredRight);
+    }
+}
+
+} // namespace ui
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "../model/MemoryUsage.h"
+#include <functional>
+
+namespace ui {
+
+// Debug panel (:memory) listing where memory goes, largest subsystem first,
+// with the accounted total and - where the OS tells us - the process's
+// resident size, so anything unaccounted for shows as the gap between them.
+// Docked over the top corner of the screen; refreshed twice a second while
+// shown, from a report collected on the message thread.
+class MemoryPanel : public juce::Component,
+                    private juce::Timer
+{
+public:
+    using Collector = std::function<model::MemoryReport()>;
+
+    explicit MemoryPanel(Collector collect);
+    ~MemoryPanel() override;
+
+    void paint(juce::Graphics& g) override;
+
+    bool isShowing() const { return isVisible(); }
+    void show();
+    void hide();
+    void toggle()
+    {
+        if (isShowing())
+            hide();
+        else
+            show();
+    }
+
+    // Process resident set size in bytes, or 0 where it isn't available
+    static size_t getResidentBytes();
+
+    static constexpr int kWidth = 300;
+    static constexpr int kRowHeight = 16;
+    static constexpr int kMaxRows = 20;  // Subsystems past this are summed as "Other"
+    static constexpr int kHeight = 18 + (kMaxRows + 2) * kRowHeight + 6;  // Title, rows, total, resident
+
+private:
+    void timerCallback() override;
+    void refresh();
+
+    static constexpr int kRefreshHz = 2;
+
+    Collector collect_;
+    std::vector<model::MemoryReport::Entry> entries_;  // Largest first
+    size_t total_ = 0;
+    size_t resident_ = 0;
+
+    // Colors (matching app theme)
+    static inline const juce::Colour bgColor{0xff1a1a2e};
+    static inline const juce::Colour panelColor{0xff2a2a4e};
+    static inline const juce::Colour borderColor{0xff4a4a6e};
+    static inline const juce::Colour titleColor{0xff7c7cff};
+    static inline const juce::Colour textColor{0xffc0c0d0};
+    static inline const juce::Colour barColor{0xff3a3a6e};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MemoryPanel)
+};
+
+} // namespace ui
@@ -258,16 +258,23 @@ void MixerScreen::drawFxPanel(juce::Graphics& g, juce::Rectangle<int> area, int
         g.setColour(selectedParam == 0 ? cursorColor : juce::Colour(0xff4a9090));
         g.drawRect(sourceBox, 1);
 
-        // Get source instrument name
+        // Key channels: one by name, more as a count (set per channel on the
+        // Channel screen or with :send)
         juce::String sourceName = "None";
-        if (mixer.sidechainSource >= 0)
+        int numKeys = 0;
+        for (int i = 0; i < project_.getInstrumentCount(); ++i)
         {
-            auto* inst = project_.getInstrument(mixer.sidechainSource);
-            if (inst)
-                sourceName = juce::String(mixer.sidechainSource + 1) + ":" + juce::String(inst->getName()).substring(0, 3);
-            else
-                sourceName = juce::String(mixer.sidechainSource + 1);
+            auto* inst = project_.getInstrument(i);
+            if (inst->getSends().sidechainKey > 0.0f && ++numKeys == 1)
+                sourceName = juce::String(i + 1) + ":" + juce::String(inst->getName()).substring(0, 3);
+        }
+        for (size_t b = 0; b < mixer.buses.size(); ++b)
+        {
+            if (mixer.buses[b].sends.sidechainKey > 0.0f && ++numKeys == 1)
+                sourceName = "b" + juce::String(static_cast<int>(b));
         }
+        if (numKeys > 1)
+            sourceName = juce::String(numKeys) + " keys";
         g.setColour(fgColor);
         g.setFont(9.0f);
         g.drawText(sourceName, sourceBox, juce::Justification::centred);
@@ -415,7 +422,16 @@ void MixerScreen::drawFxPanel(juce::Graphics& g, juce::Rectangle<int> area, int
     // Effect name
     g.setFont(11.0f);
     g.setColour(isSelected ? cursorColor : fgColor);
-    g.drawText(fxNames[fxIndex], area.removeFromTop(16), juce::Justification::centred);
+    juce::String fxName = fxNames[fxIndex];
+    if (fxIndex == 0 && !mixer.reverbImpulse.empty())
+        fxName = "IR REVERB";  // Convolution replaces the algorithmic reverb
+    else if (fxIndex == 0)
+        fxName = mixer.reverbType == 0 ? "REVERB" : "FDN REVERB";
+    else if (fxIndex == 1 && mixer.delayPingPong)
+        fxName = "PING-PONG";
+    else if (fxIndex == 2 && mixer.chorusEnsemble)
+        fxName = "ENSEMBLE";
+    g.drawText(fxName, area.removeFromTop(16), juce::Justification::centred);
 
     area.removeFromTop(2);
 
@@ -609,11 +625,36 @@ bool MixerScreen::handleEditKey(const juce::KeyPress& key)
         {
             auto& mixer = project_.getMixer();
 
-            // Sidechain source is special - increment/decrement instrument index
+            // Sidechain source is special - steps through instruments as the
+            // only instrument key
             if (cursorFx_ == 3 && cursorFxParam_ == 0)
             {
                 int numInst = project_.getInstrumentCount();
-                mixer.sidechainSource = std::clamp(mixer.sidechainSource + valueDelta, -1, numInst - 1);
+                int source = -1;
+                for (int i = 0; i < numInst && source < 0; ++i)
+                {
+                    if (project_.getInstrument(i)->getSends().sidechainKey > 0.0f)
+                        source = i;
+                }
+                source = std::clamp(source + valueDelta, -1, numInst - 1);
+
+                bool anyDucked = false;
+                for (int i = 0; i < numInst; ++i)
+                {
+                    auto& sends = project_.getInstrument(i)->getSends();
+                    sends.sidechainKey = i == source ? 1.0f : 0.0f;
+                    anyDucked = anyDucked || sends.sidechainDuck > 0.0f;
+                }
+                // Nothing set to duck yet: duck everything else fully, as a
+                // single-source sidechain would
+                if (source >= 0 && !anyDucked)
+                {
+                    for (int i = 0; i < numInst; ++i)
+                    {
+                        if (i != source)
+                            project_.getInstrument(i)->getSends().sidechainDuck = 1.0f;
+                    }
+                }
                 repaint();
                 return false;
             }
@@ -659,6 +700,21 @@ bool MixerScreen::handleEditKey(const juce::KeyPress& key)
             return false;
         }
 
+        // Enter switches the reverb algorithm, the delay to ping-pong or
+        // the chorus to ensemble
+        if (action.action == input::KeyAction::Confirm && cursorFx_ <= 2)
+        {
+            auto& mixer = project_.getMixer();
+            if (cursorFx_ == 0)
+                mixer.reverbType = mixer.reverbType == 0 ? 1 : 0;
+            else if (cursorFx_ == 1)
+                mixer.delayPingPong = !mixer.delayPingPong;
+            else
+                mixer.chorusEnsemble = !mixer.chorusEnsemble;
+            repaint();
+            return false;
+        }
+
         return false;
     }
 
@@ -827,9 +883,9 @@ std::vector<HelpSection> MixerScreen::getHelpContent() const
             {"Tab", "Switch param 1 / param 2"},
         }},
         {"Master Effects", {
-            {"Reverb", "Size, Damping"},
-            {"Delay", "Time, Feedback"},
-            {"Chorus", "Rate, Depth"},
+            {"Reverb", "Size, Damping (Enter: FDN/Schroeder)"},
+            {"Delay", "Time, Feedback (Enter: ping-pong)"},
+            {"Chorus", "Rate, Depth (Enter: ensemble)"},
             {"Sidechain", "Source, Amount"},
             {"Filter", "LP/HP position"},
             {"Limiter", "Threshold, Release"},
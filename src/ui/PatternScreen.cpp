@@ -465,6 +465,7 @@ bool PatternScreen::handleEditKey(const juce::KeyPress& key)
                 }
             }
 
+            pattern->markEdited();
             repaint();
             return true;
         }
@@ -548,6 +549,7 @@ bool PatternScreen::handleEditKey(const juce::KeyPress& key)
                     }
                 }
             }
+            pattern->markEdited();
             repaint();
             return true;
         }
@@ -679,6 +681,7 @@ bool PatternScreen::handleEditKey(const juce::KeyPress& key)
             }
 
             if (onNotePreview) onNotePreview(step.note, step.instrument >= 0 ? step.instrument : 0);
+            pattern->markEdited();
             repaint();
             return true;  // Consumed
         }
@@ -713,6 +716,7 @@ bool PatternScreen::handleEditKey(const juce::KeyPress& key)
             }
 
             if (onNotePreview) onNotePreview(step.note, step.instrument >= 0 ? step.instrument : 0);
+            pattern->markEdited();
             repaint();
             return true;  // Consumed
         }
@@ -736,6 +740,7 @@ bool PatternScreen::handleEditKey(const juce::KeyPress& key)
             }
             if (onNotePreview) onNotePreview(step.note, step.instrument >= 0 ? step.instrument : 0);
             cursorRow_ = std::min(cursorRow_ + 1, pattern->getLength() - 1);
+            pattern->markEdited();
             repaint();
             return true;
         }
@@ -745,6 +750,7 @@ bool PatternScreen::handleEditKey(const juce::KeyPress& key)
         {
             step.note = model::Step::NOTE_OFF;
             cursorRow_ = std::min(cursorRow_ + 1, pattern->getLength() - 1);
+            pattern->markEdited();
             repaint();
             return false;
         }
@@ -776,6 +782,7 @@ bool PatternScreen::handleEditKey(const juce::KeyPress& key)
                 step.instrument = static_cast<int8_t>((step.instrument + delta + numInstruments) % numInstruments);
             }
             if (step.note >= 0 && onNotePreview) onNotePreview(step.note, step.instrument);
+            pattern->markEdited();
             repaint();
             return true;  // Consumed
         }
@@ -785,6 +792,7 @@ bool PatternScreen::handleEditKey(const juce::KeyPress& key)
         {
             int newInst = project_.addInstrument("Inst " + std::to_string(project_.getInstrumentCount() + 1));
             step.instrument = static_cast<int8_t>(newInst);
+            pattern->markEdited();
             repaint();
             return true;  // Consumed
         }
@@ -799,6 +807,7 @@ bool PatternScreen::handleEditKey(const juce::KeyPress& key)
                 step.instrument = static_cast<int8_t>(val);
                 if (step.note >= 0 && onNotePreview) onNotePreview(step.note, step.instrument);
             }
+            pattern->markEdited();
             repaint();
             return true;  // Consumed
         }
@@ -812,6 +821,7 @@ bool PatternScreen::handleEditKey(const juce::KeyPress& key)
             int delta = isEditDec ? -16 : 16;  // Coarse adjustment
             if (step.volume == 0xFF) step.volume = 0x80;  // Default to mid if empty
             step.volume = static_cast<uint8_t>(std::clamp(static_cast<int>(step.volume) + delta, 0, 0xFE));
+            pattern->markEdited();
             repaint();
             return true;  // Consumed
         }
@@ -822,6 +832,7 @@ bool PatternScreen::handleEditKey(const juce::KeyPress& key)
         {
             int val = (textChar >= '0' && textChar <= '9') ? textChar - '0' : (lc - 'a' + 10);
             step.volume = static_cast<uint8_t>(val * 16 + val);  // e.g., 'a' -> 0xAA
+            pattern->markEdited();
             repaint();
             return true;  // Consumed
         }
@@ -846,6 +857,7 @@ bool PatternScreen::handleEditKey(const juce::KeyPress& key)
                 int numTypes = 10;  // None + 9 types (ARP, POR, VIB, VOL, PAN, DLY, RET, CUT, OFF)
                 int newType = (currentType + delta + numTypes) % numTypes;
                 fx->type = static_cast<model::FXType>(newType);
+                pattern->markEdited();
                 repaint();
                 return true;  // Consumed
             }
@@ -859,6 +871,7 @@ bool PatternScreen::handleEditKey(const juce::KeyPress& key)
                 fx->value = static_cast<uint8_t>(std::clamp(newVal, 0, 255));
                 // Default to ARP if no type set
                 if (fx->type == model::FXType::None) fx->type = model::FXType::ARP;
+                pattern->markEdited();
                 repaint();
                 return true;  // Consumed
             }
@@ -871,6 +884,7 @@ bool PatternScreen::handleEditKey(const juce::KeyPress& key)
                 // Shift existing value and add new digit
                 fx->value = static_cast<uint8_t>(((fx->value & 0x0F) << 4) | val);
                 if (fx->type == model::FXType::None) fx->type = model::FXType::ARP;  // Default to ARP if no type
+                pattern->markEdited();
                 repaint();
                 return true;  // Consumed
             }
@@ -886,6 +900,7 @@ bool PatternScreen::handleEditKey(const juce::KeyPress& key)
         else if (cursorColumn_ == 3) step.fx1.clear();
         else if (cursorColumn_ == 4) step.fx2.clear();
         else if (cursorColumn_ == 5) step.fx3.clear();
+        pattern->markEdited();
         repaint();
         return true;  // Consumed
     }
@@ -957,7 +972,7 @@ void PatternScreen::drawTrackHeaders(juce::Graphics& g, juce::Rectangle<int> are
 
 void PatternScreen::drawGrid(juce::Graphics& g, juce::Rectangle<int> area)
 {
-    auto* pattern = project_.getPattern(currentPattern_);
+    const model::Pattern* pattern = project_.getPattern(currentPattern_);
     if (!pattern) return;
 
     int trackWidth = 0;
@@ -1109,7 +1124,7 @@ std::string PatternScreen::noteToString(int8_t note) const
 
 const model::Step* PatternScreen::findLastNonEmptyRowAbove(int track, int startRow) const
 {
-    auto* pattern = project_.getPattern(currentPattern_);
+    const model::Pattern* pattern = project_.getPattern(currentPattern_);
     if (!pattern) return nullptr;
 
     // Search upwards from startRow-1 to find last playable note in this track
@@ -1146,7 +1161,7 @@ void PatternScreen::yankSelection()
 {
     if (!hasSelection_) return;
 
-    auto* pattern = project_.getPattern(currentPattern_);
+    const model::Pattern* pattern = project_.getPattern(currentPattern_);
     if (!pattern) return;
 
     int minT = selection_.minTrack();
@@ -1186,7 +1201,7 @@ void PatternScreen::deleteSelection()
     {
         for (int r = minR; r <= maxR; ++r)
         {
-            pattern->getStep(t, r) = model::Step{};
+            pattern->setStep(t, r, model::Step{});
         }
     }
 
@@ -1210,7 +1225,7 @@ void PatternScreen::paste()
     {
         for (int r = 0; r < height && (cursorRow_ + r) < pattern->getLength(); ++r)
         {
-            pattern->getStep(cursorTrack_ + t, cursorRow_ + r) = data[static_cast<size_t>(t)][static_cast<size_t>(r)];
+            pattern->setStep(cursorTrack_ + t, cursorRow_ + r, data[static_cast<size_t>(t)][static_cast<size_t>(r)]);
         }
     }
 
@@ -1239,6 +1254,7 @@ void PatternScreen::transpose(int semitones)
         }
     }
 
+    pattern->markEdited();
     repaint();
 }
 
@@ -1275,6 +1291,7 @@ void PatternScreen::interpolate()
         }
     }
 
+    pattern->markEdited();
     repaint();
 }
 
@@ -1302,6 +1319,7 @@ void PatternScreen::randomize(int percent)
         }
     }
 
+    pattern->markEdited();
     repaint();
 }
 
@@ -1320,7 +1338,7 @@ void PatternScreen::doublePattern()
     {
         for (int r = 0; r < oldLength; ++r)
         {
-            pattern->getStep(t, r + oldLength) = pattern->getStep(t, r);
+            pattern->setStep(t, r + oldLength, pattern->getStep(t, r));
         }
     }
 
@@ -1339,7 +1357,7 @@ void PatternScreen::halvePattern()
 
 void PatternScreen::showChordPopup()
 {
-    auto* pattern = project_.getPattern(currentPattern_);
+    const model::Pattern* pattern = project_.getPattern(currentPattern_);
     if (!pattern) return;
 
     const auto& step = pattern->getStep(cursorTrack_, cursorRow_);
@@ -1367,6 +1385,7 @@ void PatternScreen::showChordPopup()
             step.note = static_cast<int8_t>(notes[i]);
             step.instrument = static_cast<int16_t>(instrument);
         }
+        pat->markEdited();
         repaint();
     };
 
@@ -1480,7 +1499,7 @@ int PatternScreen::moveNoteInScale(int currentNote, int direction, const std::st
 
 int PatternScreen::getInstrumentAtCursor() const
 {
-    auto* pattern = project_.getPattern(currentPattern_);
+    const model::Pattern* pattern = project_.getPattern(currentPattern_);
     if (!pattern) return -1;
 
     const auto& step = pattern->getStep(cursorTrack_, cursorRow_);
@@ -1527,6 +1546,12 @@ std::vector<HelpSection> PatternScreen::getHelpContent() const
             {"s", "Randomize populated values"},
             {"Alt+Up/Down", "Batch edit selection"},
         }},
+        {"Live Recording", {
+            {"Shift+Space", "Record into the playing pattern"},
+            {"z-m / q-p rows", "Play notes (plus MIDI input)"},
+            {"Esc / Shift+Space", "Finish pass (undo as one step)"},
+            {":quantize N", "Snap to N rows (0 = row + DLY)"},
+        }},
     };
 }
 
@@ -34,6 +34,7 @@ public:
     int getCurrentPatternIndex() const { return currentPattern_; }
     void setCurrentPattern(int index) { currentPattern_ = index; }
     int getInstrumentAtCursor() const;
+    int getCursorTrack() const { return cursorTrack_; }
 
     // Selection and clipboard operations
     void startSelection();
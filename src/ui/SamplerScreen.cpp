@@ -150,10 +150,12 @@ void SamplerScreen::loadSample() {
                 if (auto* sampler = audioEngine_->getSamplerProcessor(currentInstrument_)) {
                     if (auto* inst = project_.getInstrument(currentInstrument_)) {
                         sampler->setInstrument(inst);
-                        if (sampler->loadSample(file)) {
-                            updateWaveformDisplay();
-                            repaint();
-                        }
+                        sampler->loadSampleAsync(file, [screen = SafePointer<SamplerScreen>(this)](bool loaded) {
+                            if (screen && loaded) {
+                                screen->updateWaveformDisplay();
+                                screen->repaint();
+                            }
+                        });
                     }
                 }
             }
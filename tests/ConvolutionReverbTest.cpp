@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+#include <JuceHeader.h>
+#include "../src/audio/ConvolutionReverb.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iterator>
+#include <random>
+#include <thread>
+#include <vector>
+
+using audio::ConvolutionReverb;
+
+namespace {
+
+constexpr double kSampleRate = 48000.0;
+
+// Host block sizes, none a multiple of the partition sizes, cycled through
+// so partition boundaries land mid-block
+constexpr int kHostBlocks[] = {100, 37, 513, 1, 250, 127, 129};
+
+// A decaying noise IR with different left and right channels
+juce::AudioBuffer<float> makeImpulse(int length) {
+    std::mt19937 random(1234);
+    std::uniform_real_distribution<float> noise(-1.0f, 1.0f);
+    juce::AudioBuffer<float> impulse(2, length);
+    for (int ch = 0; ch < 2; ++ch) {
+        float* data = impulse.getWritePointer(ch);
+        for (int i = 0; i < length; ++i)
+            data[i] = noise(random) * std::exp(-3.0f * static_cast<float>(i) / static_cast<float>(length));
+    }
+    return impulse;
+}
+
+std::vector<float> makeInput(int length) {
+    std::mt19937 random(5678);
+    std::uniform_real_distribution<float> noise(-0.5f, 0.5f);
+    std::vector<float> input(static_cast<size_t>(length));
+    for (auto& sample : input)
+        sample = noise(random);
+    return input;
+}
+
+// y[n] = sum ir[k] x[n - k], in double
+std::vector<float> convolve(const std::vector<float>& input, const float* ir, int irLength) {
+    std::vector<float> output(input.size());
+    for (size_t n = 0; n < input.size(); ++n) {
+        double sum = 0.0;
+        const int taps = std::min(irLength, static_cast<int>(n) + 1);
+        for (int k = 0; k < taps; ++k)
+            sum += static_cast<double>(ir[k]) * input[n - static_cast<size_t>(k)];
+        output[n] = static_cast<float>(sum);
+    }
+    return output;
+}
+
+// Runs the input through in host-sized blocks, the same mono signal on both
+// sides. With realTime set, each block takes as long as it would play, so
+// the tail worker has the time it has in use
+void process(ConvolutionReverb& reverb, const std::vector<float>& input,
+             std::vector<float>& left, std::vector<float>& right, bool realTime) {
+    left.assign(input.size(), 0.0f);
+    right.assign(input.size(), 0.0f);
+    const int length = static_cast<int>(input.size());
+    for (int start = 0, block = 0; start < length; ++block) {
+        const int end = std::min(length, start + kHostBlocks[static_cast<size_t>(block) % std::size(kHostBlocks)]);
+        for (int i = start; i < end; ++i) {
+            float l = input[static_cast<size_t>(i)];
+            float r = input[static_cast<size_t>(i)];
+            reverb.process(l, r);
+            left[static_cast<size_t>(i)] = l;
+            right[static_cast<size_t>(i)] = r;
+        }
+        if (realTime) {
+            std::this_thread::sleep_for(std::chrono::duration<double>(
+                static_cast<double>(end - start) / kSampleRate));
+        }
+        start = end;
+    }
+}
+
+void expectMatches(const std::vector<float>& actual, const std::vector<float>& expected) {
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t i = 0; i < actual.size(); ++i)
+        ASSERT_NEAR(actual[i], expected[i], 1.0e-3f) << "sample " << i;
+}
+
+} // namespace
+
+// The first sample out is the first tap times the first sample in: no latency
+TEST(ConvolutionReverbTest, NoLatency) {
+    auto impulse = makeImpulse(1000);
+    impulse.setSample(0, 0, 0.6f);
+    impulse.setSample(1, 0, -0.3f);
+    ConvolutionReverb reverb(impulse, kSampleRate);
+
+    float left = 0.75f;
+    float right = 0.75f;
+    reverb.process(left, right);
+    EXPECT_FLOAT_EQ(left, 0.6f * 0.75f);
+    EXPECT_FLOAT_EQ(right, -0.3f * 0.75f);
+}
+
+// Head FIR and early partitions only
+TEST(ConvolutionReverbTest, ShortImpulseMatchesDirectConvolution) {
+    constexpr int kLength = 1000;
+    const auto impulse = makeImpulse(kLength);
+    ConvolutionReverb reverb(impulse, kSampleRate);
+    EXPECT_EQ(reverb.getCostEstimate().tailPartitions, 0);
+
+    const auto input = makeInput(4 * kLength);
+    std::vector<float> left, right;
+    process(reverb, input, left, right, false);
+
+    expectMatches(left, convolve(input, impulse.getReadPointer(0), kLength));
+    expectMatches(right, convolve(input, impulse.getReadPointer(1), kLength));
+}
+
+// An IR that ends partway into an early partition
+TEST(ConvolutionReverbTest, UnevenImpulseMatchesDirectConvolution) {
+    constexpr int kLength = ConvolutionReverb::kHeadSize * 5 + 17;
+    const auto impulse = makeImpulse(kLength);
+    ConvolutionReverb reverb(impulse, kSampleRate);
+
+    const auto input = makeInput(3000);
+    std::vector<float> left, right;
+    process(reverb, input, left, right, false);
+
+    expectMatches(left, convolve(input, impulse.getReadPointer(0), kLength));
+    expectMatches(right, convolve(input, impulse.getReadPointer(1), kLength));
+}
+
+// All three sections, the tail from the worker, played at real time
+TEST(ConvolutionReverbTest, LongImpulseMatchesDirectConvolution) {
+    constexpr int kLength = ConvolutionReverb::kTailStart + ConvolutionReverb::kTailBlockSize + 500;
+    const auto impulse = makeImpulse(kLength);
+    ConvolutionReverb reverb(impulse, kSampleRate);
+    EXPECT_EQ(reverb.getCostEstimate().tailPartitions, 2);
+
+    const auto input = makeInput(kLength + 3000);
+    std::vector<float> left, right;
+    process(reverb, input, left, right, true);
+    ASSERT_EQ(reverb.getCostEstimate().lateTailBlocks, 0);
+
+    expectMatches(left, convolve(input, impulse.getReadPointer(0), kLength));
+    expectMatches(right, convolve(input, impulse.getReadPointer(1), kLength));
+}
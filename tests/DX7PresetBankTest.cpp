@@ -0,0 +1,195 @@
+#include <gtest/gtest.h>
+#include <JuceHeader.h>
+#include "../src/model/DX7PresetBank.h"
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace model;
+namespace fs = std::filesystem;
+
+namespace {
+
+using Patch = std::array<uint8_t, DX7_PACKED_PATCH_SIZE>;
+
+constexpr int kNumBanks = 64;
+constexpr int kNumCopies = 4;  // The last banks, saved again under other names
+
+const char* const kWords[] = {"Brass", "Strings", "Piano", "E.Piano", "Bass",
+                              "Organ", "Bells", "Clav", "Flute", "Choir"};
+
+// Voice data from the seed, then the name space-padded to 10 chars
+Patch makePatch(const std::string& name, uint32_t seed) {
+    Patch patch{};
+    for (int i = 0; i < 118; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        patch[static_cast<size_t>(i)] = static_cast<uint8_t>((seed >> 24) % 100);
+    }
+    for (int i = 0; i < 10; ++i)
+        patch[static_cast<size_t>(118 + i)] = static_cast<uint8_t>(i < static_cast<int>(name.size()) ? name[static_cast<size_t>(i)] : ' ');
+    return patch;
+}
+
+void writeBank(const fs::path& path, const std::vector<Patch>& patches) {
+    std::vector<uint8_t> data = {0xF0, 0x43, 0x00, 0x09, 0x20, 0x00};
+    uint8_t sum = 0;
+    for (int i = 0; i < DX7_PATCHES_PER_BANK; ++i) {
+        const Patch patch = i < static_cast<int>(patches.size()) ? patches[static_cast<size_t>(i)]
+                                                                 : makePatch("INIT VOICE", 0);
+        for (uint8_t byte : patch) {
+            data.push_back(byte);
+            sum = static_cast<uint8_t>(sum + byte);
+        }
+    }
+    data.push_back(static_cast<uint8_t>((128 - (sum & 0x7F)) & 0x7F));
+    data.push_back(0xF7);
+
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+}
+
+// Bank b, patch p: "Brass 12" and the like, so names repeat across banks
+// while every patch is different
+std::vector<Patch> makeBank(int b) {
+    std::vector<Patch> patches;
+    for (int p = 0; p < DX7_PATCHES_PER_BANK; ++p) {
+        const int n = b * DX7_PATCHES_PER_BANK + p;
+        const std::string name = std::string(kWords[n % 10]) + " " + std::to_string(n % 97);
+        patches.push_back(makePatch(name.substr(0, 10), static_cast<uint32_t>(n + 1)));
+    }
+    return patches;
+}
+
+std::string toLower(std::string text) {
+    std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return text;
+}
+
+} // namespace
+
+// A library of kNumBanks cartridges, bank_00 to bank_63, the last
+// kNumCopies of them also saved as zz_copy_* (scanned after the originals)
+class DX7PresetBankTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        root = fs::temp_directory_path()
+             / ("vitracker_dx7_" + std::string(::testing::UnitTest::GetInstance()->current_test_info()->name()));
+        fs::remove_all(root);
+        fs::create_directories(root / "library" / "nested");
+        fs::create_directories(root / "user");
+
+        for (int b = 0; b < kNumBanks; ++b) {
+            char name[32];
+            std::snprintf(name, sizeof(name), "bank_%02d.syx", b);
+            // Some one level down, to exercise the recursive scan
+            writeBank(root / "library" / (b % 2 ? "nested" : "") / name, makeBank(b));
+        }
+        for (int c = 0; c < kNumCopies; ++c) {
+            writeBank(root / "library" / ("zz_copy_" + std::to_string(c) + ".syx"),
+                      makeBank(kNumBanks - kNumCopies + c));
+        }
+    }
+
+    void TearDown() override { fs::remove_all(root); }
+
+    std::string path(const char* child) const { return (root / child).string(); }
+
+    fs::path root;
+};
+
+TEST_F(DX7PresetBankTest, DeduplicatesCopiedBanks) {
+    DX7PresetBank bank;
+    bank.scanDirectory(path("library"));
+
+    EXPECT_EQ(bank.getPresetCount(), kNumBanks * DX7_PATCHES_PER_BANK);
+    EXPECT_EQ(bank.getDuplicateCount(), kNumCopies * DX7_PATCHES_PER_BANK);
+    for (const auto& preset : bank.getPresets())
+        EXPECT_EQ(preset.bankName.rfind("bank_", 0), 0u) << preset.bankName;
+}
+
+// Only byte-identical patches are duplicates: the name is part of the patch,
+// and init voices aren't loaded at all
+TEST_F(DX7PresetBankTest, RenamedPatchIsKept) {
+    const Patch patch = makePatch("Lead", 42);
+    Patch renamed = patch;
+    renamed[118] = 'l';
+    writeBank(root / "user" / "a.syx", {patch, patch, renamed});
+
+    DX7PresetBank bank;
+    ASSERT_TRUE(bank.loadSysexFile(path("user/a.syx")));
+    EXPECT_EQ(bank.getPresetCount(), 2);
+    EXPECT_EQ(bank.getDuplicateCount(), 1);
+    EXPECT_EQ(bank.getPreset(0)->name, "Lead");
+    EXPECT_EQ(bank.getPreset(1)->name, "lead");
+    EXPECT_EQ(bank.getPreset(1)->patchIndex, 2);
+}
+
+// The gram index answers exactly what a scan of every name would
+TEST_F(DX7PresetBankTest, SearchMatchesLinearScan) {
+    DX7PresetBank bank;
+    bank.scanDirectory(path("library"));
+
+    const char* const queries[] = {"", "a", "B", ".", " ", "br", "NO", "s 1", "ass", "piano",
+                                   "E.PIANO", "ings 4", "Choir 9", "bass 12", "clav 96", "zz", "xyzzy"};
+    for (const char* query : queries) {
+        std::vector<int> expected;
+        const std::string lowerQuery = toLower(query);
+        for (int i = 0; i < bank.getPresetCount(); ++i) {
+            if (toLower(bank.getPreset(i)->name).find(lowerQuery) != std::string::npos)
+                expected.push_back(i);
+        }
+        EXPECT_EQ(bank.searchPresets(query), expected) << '"' << query << '"';
+    }
+}
+
+// What a preset index points to doesn't change when more banks are added
+// later, as the user library is after the bundled banks. Duplicates in the
+// new banks resolve to the copy already loaded
+TEST_F(DX7PresetBankTest, IndicesStableWhenAppending) {
+    DX7PresetBank bank;
+    bank.scanDirectory(path("library"));
+    const std::vector<DX7Preset> before = bank.getPresets();
+
+    auto user = makeBank(kNumBanks);
+    user[0] = makeBank(3)[7];
+    writeBank(root / "user" / "mine.syx", user);
+    bank.scanDirectory(path("user"));
+
+    ASSERT_EQ(bank.getPresetCount(), static_cast<int>(before.size()) + DX7_PATCHES_PER_BANK - 1);
+    int original = -1;
+    for (size_t i = 0; i < before.size(); ++i) {
+        EXPECT_EQ(bank.getPresets()[i].packedData, before[i].packedData) << i;
+        EXPECT_EQ(bank.findPreset(before[i].packedData.data()), static_cast<int>(i));
+        if (before[i].packedData == user[0])
+            original = static_cast<int>(i);
+    }
+    ASSERT_GE(original, 0);
+    EXPECT_EQ(bank.findPreset(user[0].data()), original);
+    EXPECT_EQ(bank.findPreset(user[1].data()), static_cast<int>(before.size()));
+    EXPECT_EQ(bank.findPreset(makePatch("Unknown", 7).data()), -1);
+}
+
+// Banks read back from the index cache (unchanged paths, sizes and times)
+// load the same presets in the same order as parsing them did
+TEST_F(DX7PresetBankTest, IndexCacheLoadsSamePresets) {
+    const std::string cache = path("index.bin");
+    DX7PresetBank parsed;
+    parsed.setIndexCachePath(cache);
+    parsed.scanDirectory(path("library"));
+    ASSERT_TRUE(fs::exists(cache));
+
+    DX7PresetBank cached;
+    cached.setIndexCachePath(cache);
+    cached.scanDirectory(path("library"));
+
+    ASSERT_EQ(cached.getPresetCount(), parsed.getPresetCount());
+    EXPECT_EQ(cached.getDuplicateCount(), parsed.getDuplicateCount());
+    for (int i = 0; i < parsed.getPresetCount(); ++i) {
+        EXPECT_EQ(cached.getPreset(i)->packedData, parsed.getPreset(i)->packedData) << i;
+        EXPECT_EQ(cached.getPreset(i)->bankName, parsed.getPreset(i)->bankName) << i;
+    }
+    EXPECT_EQ(cached.searchPresets("piano"), parsed.searchPresets("piano"));
+}
@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+#include <JuceHeader.h>
+#include "../src/audio/AudioEngine.h"
+#include <jack/jack.h>
+#include <jack/transport.h>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+
+// Runs against a private jackd (VITRACKER_JACKD) with the dummy driver, so
+// no audio hardware or running server is needed. Only built where jackd and
+// libjack are installed.
+
+namespace {
+
+constexpr int kSampleRate = 48000;
+constexpr int kPeriod = 256;
+constexpr int kStemInstruments = 16;
+
+// Polls until done() or the timeout
+template <typename Done>
+bool waitFor(Done done, int timeoutMs = 5000) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    while (!done()) {
+        if (std::chrono::steady_clock::now() > deadline)
+            return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return true;
+}
+
+// Deactivates a client on scope exit, before the state its callback uses goes
+struct ScopedActivation {
+    jack_client_t* client;
+    ~ScopedActivation() { jack_deactivate(client); }
+};
+
+// Plays the engine from the test client's process callback, as JUCE's JACK
+// device would, and measures what arrives on the client's input
+struct EngineHarness {
+    audio::AudioEngine* engine = nullptr;
+    juce::AudioBuffer<float>* buffer = nullptr;
+    jack_port_t* input = nullptr;
+    std::atomic<float> peak{0.0f};
+
+    static int process(jack_nframes_t numFrames, void* arg) {
+        auto& harness = *static_cast<EngineHarness*>(arg);
+        const juce::AudioSourceChannelInfo info(harness.buffer, 0, static_cast<int>(numFrames));
+        harness.engine->getNextAudioBlock(info);
+
+        const auto* in = static_cast<const float*>(jack_port_get_buffer(harness.input, numFrames));
+        float peak = harness.peak.load(std::memory_order_relaxed);
+        for (jack_nframes_t i = 0; i < numFrames; ++i)
+            peak = std::max(peak, std::abs(in[i]));
+        harness.peak.store(peak, std::memory_order_relaxed);
+        return 0;
+    }
+};
+
+} // namespace
+
+class JackTest : public ::testing::Test {
+protected:
+    static void SetUpTestSuite() {
+        // A server of our own, found by name, so a running one is never used
+        const auto name = "vitracker-test-" + juce::String(juce::Time::currentTimeMillis());
+        setenv("JACK_DEFAULT_SERVER", name.toRawUTF8(), 1);
+        server_ = std::make_unique<juce::ChildProcess>();
+        server_->start(juce::StringArray{VITRACKER_JACKD, "--no-realtime", "-n", name,
+                                         "-d", "dummy", "-r", juce::String(kSampleRate),
+                                         "-p", juce::String(kPeriod)},
+                       0);
+    }
+
+    static void TearDownTestSuite() {
+        if (server_)
+            server_->kill();
+        server_.reset();
+    }
+
+    void SetUp() override {
+        ASSERT_TRUE(server_ && server_->isRunning());
+        ASSERT_TRUE(waitFor([this] {
+            client_ = jack_client_open("JackTest", JackNoStartServer, nullptr);
+            return client_ != nullptr;
+        }));
+    }
+
+    void TearDown() override {
+        if (client_)
+            jack_client_close(client_);
+    }
+
+    static inline std::unique_ptr<juce::ChildProcess> server_;
+    jack_client_t* client_ = nullptr;
+};
+
+// Every stem is a port of the stems client, whatever physical ports the
+// server has (the dummy driver here has none), and none is connected
+TEST_F(JackTest, StemPortsAreOwnAndUnconnected) {
+    audio::JackStemPorts stems;
+    ASSERT_TRUE(stems.open(kStemInstruments));
+
+    const char** ports = jack_get_ports(client_, "^Vitracker Stems:", JACK_DEFAULT_AUDIO_TYPE, JackPortIsOutput);
+    ASSERT_NE(ports, nullptr);
+    int count = 0;
+    for (; ports[count] != nullptr; ++count)
+        EXPECT_EQ(jack_port_connected(jack_port_by_name(client_, ports[count])), 0) << ports[count];
+    jack_free(ports);
+
+    EXPECT_EQ(count, audio::AudioEngine::getStemChannelCount(kStemInstruments) - 2);
+    EXPECT_NE(jack_port_by_name(client_, "Vitracker Stems:inst_00_L"), nullptr);
+    EXPECT_NE(jack_port_by_name(client_, "Vitracker Stems:inst_0F_R"), nullptr);
+}
+
+// An instrument's stem comes out of its stem port
+TEST_F(JackTest, EngineStemsReachPorts) {
+    model::Project project;
+    project.getInstrument(0)->setType(model::InstrumentType::Plaits);
+    audio::JackStemPorts stems;
+    ASSERT_TRUE(stems.open(kStemInstruments));
+
+    const int period = static_cast<int>(jack_get_buffer_size(client_));
+    audio::AudioEngine engine;
+    engine.setProject(&project);
+    engine.setJackStems(&stems);
+    engine.prepareToPlay(period, static_cast<double>(jack_get_sample_rate(client_)));
+    engine.triggerNote(0, 60, 0, 1.0f);
+
+    juce::AudioBuffer<float> buffer(2, period);
+    EngineHarness harness;
+    harness.engine = &engine;
+    harness.buffer = &buffer;
+    harness.input = jack_port_register(client_, "in", JACK_DEFAULT_AUDIO_TYPE, JackPortIsInput, 0);
+    ASSERT_NE(harness.input, nullptr);
+    jack_set_process_callback(client_, &EngineHarness::process, &harness);
+
+    ASSERT_EQ(jack_activate(client_), 0);
+    ScopedActivation activation{client_};
+    ASSERT_EQ(jack_connect(client_, "Vitracker Stems:inst_00_L", jack_port_name(harness.input)), 0);
+
+    EXPECT_TRUE(waitFor([&] { return harness.peak.load() > 1.0e-4f; }));
+}
+
+// Play and stop follow the JACK transport
+TEST_F(JackTest, PlaybackFollowsTransport) {
+    model::Project project;
+    audio::JackTransport transport;
+    ASSERT_TRUE(transport.connect());
+
+    audio::AudioEngine engine;
+    engine.setProject(&project);
+    engine.setJackTransport(&transport);
+    engine.prepareToPlay(kPeriod, kSampleRate);
+
+    juce::AudioBuffer<float> buffer(2, kPeriod);
+    const juce::AudioSourceChannelInfo info(&buffer, 0, kPeriod);
+    auto renderUntil = [&](bool playing) {
+        return waitFor([&] {
+            engine.getNextAudioBlock(info);
+            return engine.isPlaying() == playing;
+        });
+    };
+
+    ASSERT_EQ(jack_activate(client_), 0);
+    ScopedActivation activation{client_};
+
+    jack_transport_start(client_);
+    EXPECT_TRUE(renderUntil(true));
+    jack_transport_stop(client_);
+    EXPECT_TRUE(renderUntil(false));
+    engine.releaseResources();
+}
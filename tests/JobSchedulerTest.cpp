@@ -0,0 +1,202 @@
+#include <gtest/gtest.h>
+#include <JuceHeader.h>
+#include "../src/model/JobScheduler.h"
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+using model::JobScheduler;
+
+namespace {
+
+constexpr auto kTimeout = std::chrono::seconds(10);
+
+// A job that holds its worker until released, so the tests decide when
+// queued jobs get to run
+class Blocker {
+public:
+    explicit Blocker(JobScheduler& scheduler) {
+        scheduler.submit(JobScheduler::Priority::Interactive, {},
+                         [this](const JobScheduler::CancellationToken&) {
+                             started_.set_value();
+                             release_.get_future().wait();
+                         });
+    }
+
+    ~Blocker() { release(); }
+
+    bool waitUntilStarted() {
+        return started_.get_future().wait_for(kTimeout) == std::future_status::ready;
+    }
+
+    void release() {
+        if (!released_.exchange(true))
+            release_.set_value();
+    }
+
+private:
+    std::promise<void> started_;
+    std::promise<void> release_;
+    std::atomic<bool> released_{false};
+};
+
+} // namespace
+
+class JobSchedulerTest : public ::testing::Test {
+protected:
+    // Occupies every worker. Jobs submitted after this queue up
+    void blockAllWorkers() {
+        for (int i = 0; i < scheduler->getNumWorkers(); ++i)
+            blockers.push_back(std::make_unique<Blocker>(*scheduler));
+        for (auto& blocker : blockers)
+            ASSERT_TRUE(blocker->waitUntilStarted());
+    }
+
+    // Submits a job that runs after the given ones and waits for it
+    bool waitFor(std::vector<JobScheduler::JobId> jobs) {
+        auto done = std::make_shared<std::promise<void>>();
+        auto future = done->get_future();
+        JobScheduler::Job job;
+        job.priority = JobScheduler::Priority::Housekeeping;
+        job.after = std::move(jobs);
+        job.work = [done](const JobScheduler::CancellationToken&) { done->set_value(); };
+        scheduler->submit(std::move(job));
+        return future.wait_for(kTimeout) == std::future_status::ready;
+    }
+
+    void TearDown() override {
+        for (auto& blocker : blockers)
+            blocker->release();
+    }
+
+    juce::SharedResourcePointer<JobScheduler> scheduler;
+    std::vector<std::unique_ptr<Blocker>> blockers;
+};
+
+// With one worker free, queued jobs run highest priority first, oldest
+// first within a priority
+TEST_F(JobSchedulerTest, RunsByPriorityThenAge) {
+    blockAllWorkers();
+
+    std::mutex mutex;
+    std::vector<int> order;
+    auto record = [&](int tag) {
+        return [&, tag](const JobScheduler::CancellationToken&) {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(tag);
+        };
+    };
+    std::vector<JobScheduler::JobId> jobs;
+    jobs.push_back(scheduler->submit(JobScheduler::Priority::Housekeeping, {}, record(5)));
+    jobs.push_back(scheduler->submit(JobScheduler::Priority::Prefetch, {}, record(3)));
+    jobs.push_back(scheduler->submit(JobScheduler::Priority::Interactive, {}, record(1)));
+    jobs.push_back(scheduler->submit(JobScheduler::Priority::Prefetch, {}, record(4)));
+    jobs.push_back(scheduler->submit(JobScheduler::Priority::Interactive, {}, record(2)));
+
+    blockers.front()->release();
+    ASSERT_TRUE(waitFor(jobs));
+
+    std::lock_guard<std::mutex> lock(mutex);
+    EXPECT_EQ(order, (std::vector<int>{1, 2, 3, 4, 5}));
+}
+
+// A job cancelled while queued never runs, but still releases its dependents
+TEST_F(JobSchedulerTest, CancelledJobIsSkipped) {
+    blockAllWorkers();
+
+    std::atomic<bool> ran{false};
+    JobScheduler::CancellationToken token;
+    const auto id = scheduler->submit(JobScheduler::Priority::Interactive, token,
+                                      [&](const JobScheduler::CancellationToken&) { ran = true; });
+    token.cancel();
+
+    blockers.front()->release();
+    ASSERT_TRUE(waitFor({id}));
+    EXPECT_FALSE(ran.load());
+}
+
+// A job starts only once every job it waits for has finished
+TEST_F(JobSchedulerTest, DependentWaitsForDependencies) {
+    std::atomic<int> finished{0};
+    std::promise<void> gate;
+    auto gateFuture = gate.get_future().share();
+
+    std::vector<JobScheduler::JobId> dependencies;
+    for (int i = 0; i < 3; ++i) {
+        dependencies.push_back(scheduler->submit(JobScheduler::Priority::Prefetch, {},
+                                                 [&, gateFuture](const JobScheduler::CancellationToken&) {
+                                                     gateFuture.wait();
+                                                     ++finished;
+                                                 }));
+    }
+
+    std::atomic<int> seen{-1};
+    JobScheduler::Job dependent;
+    dependent.priority = JobScheduler::Priority::Interactive;
+    dependent.after = dependencies;
+    dependent.work = [&](const JobScheduler::CancellationToken&) { seen = finished.load(); };
+    const auto id = scheduler->submit(std::move(dependent));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(seen.load(), -1);
+
+    gate.set_value();
+    ASSERT_TRUE(waitFor({id}));
+    EXPECT_EQ(seen.load(), 3);
+}
+
+// Every index exactly once, with the calling thread taking a share
+TEST_F(JobSchedulerTest, ParallelForVisitsEachIndexOnce) {
+    constexpr int kCount = 1000;
+    std::vector<std::atomic<int>> visits(kCount);
+    std::mutex mutex;
+    std::set<std::thread::id> threads;
+
+    scheduler->parallelFor(kCount, JobScheduler::Priority::Interactive, [&](int i) {
+        ++visits[static_cast<size_t>(i)];
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+        std::lock_guard<std::mutex> lock(mutex);
+        threads.insert(std::this_thread::get_id());
+    });
+
+    for (int i = 0; i < kCount; ++i)
+        EXPECT_EQ(visits[static_cast<size_t>(i)].load(), 1) << i;
+    EXPECT_EQ(threads.count(std::this_thread::get_id()), 1u);
+}
+
+// With every worker busy the caller does all the work itself, rather than
+// waiting for helpers that can't start
+TEST_F(JobSchedulerTest, ParallelForRunsWithWorkersBusy) {
+    blockAllWorkers();
+
+    constexpr int kCount = 64;
+    std::vector<int> visits(kCount, 0);
+    scheduler->parallelFor(kCount, JobScheduler::Priority::Interactive,
+                           [&](int i) { ++visits[static_cast<size_t>(i)]; });
+
+    EXPECT_EQ(visits, std::vector<int>(kCount, 1));
+}
+
+// Nested inside jobs on every worker at once, as the DX7 catalogue load does
+TEST_F(JobSchedulerTest, ParallelForNestsInJobs) {
+    constexpr int kCount = 200;
+    const int numJobs = scheduler->getNumWorkers();
+    std::vector<std::atomic<int>> visits(static_cast<size_t>(kCount * numJobs));
+
+    std::vector<JobScheduler::JobId> jobs;
+    for (int job = 0; job < numJobs; ++job) {
+        jobs.push_back(scheduler->submit(JobScheduler::Priority::Prefetch, {},
+                                         [&, job](const JobScheduler::CancellationToken&) {
+                                             scheduler->parallelFor(kCount, JobScheduler::Priority::Prefetch,
+                                                                    [&](int i) { ++visits[static_cast<size_t>(job * kCount + i)]; });
+                                         }));
+    }
+    ASSERT_TRUE(waitFor(jobs));
+
+    for (size_t i = 0; i < visits.size(); ++i)
+        EXPECT_EQ(visits[i].load(), 1) << i;
+}
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include "../src/model/LiveRecorder.h"
+
+using namespace model;
+
+namespace {
+
+constexpr int kInstrument = 3;
+constexpr int kPort = 0;
+
+} // namespace
+
+class LiveRecorderTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        UndoManager::instance().clear();
+        recorder.begin(&pattern, 0);
+    }
+
+    void TearDown() override {
+        recorder.end();
+        UndoManager::instance().clear();
+    }
+
+    Pattern pattern;
+    LiveRecorder recorder;
+};
+
+// Unquantised, the fraction of a row becomes a DLY in tracker FX ticks
+TEST_F(LiveRecorderTest, RemainderBecomesDelayTicks) {
+    recorder.noteOn(4.5, 60, 100, kInstrument, kPort);
+
+    const auto& step = pattern.getStep(0, 4);
+    EXPECT_EQ(step.note, 60);
+    EXPECT_EQ(step.instrument, kInstrument);
+    EXPECT_EQ(step.fx1.type, FXType::DLY);
+    EXPECT_EQ(step.fx1.value, TICKS_PER_ROW / 2);
+}
+
+// A note on the row (or within half a tick of it) has no DLY
+TEST_F(LiveRecorderTest, OnTheRowHasNoDelay) {
+    recorder.noteOn(2.0 + 0.4 / TICKS_PER_ROW, 60, 100, kInstrument, kPort);
+
+    const auto& step = pattern.getStep(0, 2);
+    EXPECT_EQ(step.note, 60);
+    EXPECT_TRUE(step.fx1.isEmpty());
+}
+
+// Within half a tick of the next row rounds onto that row
+TEST_F(LiveRecorderTest, LastTickRoundsToNextRow) {
+    recorder.noteOn(5.0 - 0.4 / TICKS_PER_ROW, 60, 100, kInstrument, kPort);
+
+    EXPECT_EQ(pattern.getStep(0, 4).note, Step::NOTE_EMPTY);
+    EXPECT_EQ(pattern.getStep(0, 5).note, 60);
+    EXPECT_TRUE(pattern.getStep(0, 5).fx1.isEmpty());
+}
+
+// Positions past the end wrap into the looping pattern
+TEST_F(LiveRecorderTest, PositionsWrapAtPatternLength) {
+    const int length = pattern.getLength();
+    recorder.noteOn(length + 1.0, 60, 100, kInstrument, kPort);
+    recorder.noteOn(length - 0.01, 62, 100, kInstrument, kPort);
+
+    EXPECT_EQ(pattern.getStep(0, 1).note, 60);
+    EXPECT_EQ(pattern.getStep(1, 0).note, 62);
+}
+
+// With a grid, notes snap to the nearest grid line and keep no DLY
+TEST_F(LiveRecorderTest, QuantiseSnapsToGrid) {
+    recorder.setQuantize(4);
+    recorder.noteOn(5.9, 60, 100, kInstrument, kPort);
+    recorder.noteOn(6.1, 62, 100, kInstrument, kPort);
+
+    EXPECT_EQ(pattern.getStep(0, 4).note, 60);
+    EXPECT_TRUE(pattern.getStep(0, 4).fx1.isEmpty());
+    EXPECT_EQ(pattern.getStep(1, 8).note, 62);
+}
+
+// Releases write a note off on the note's track, at the nearest row
+TEST_F(LiveRecorderTest, ReleaseWritesNoteOff) {
+    recorder.noteOn(1.0, 60, 100, kInstrument, kPort);
+    recorder.noteOff(3.2, 60, kPort);
+
+    EXPECT_EQ(pattern.getStep(0, 3).note, Step::NOTE_OFF);
+}
+
+// A whole pass is undone as one step
+TEST_F(LiveRecorderTest, PassUndoesAsOne) {
+    recorder.noteOn(0.0, 60, 100, kInstrument, kPort);
+    recorder.noteOn(8.0, 62, 100, kInstrument, kPort);
+    recorder.end();
+
+    UndoManager::instance().undo();
+    EXPECT_EQ(pattern.getStep(0, 0).note, Step::NOTE_EMPTY);
+    EXPECT_EQ(pattern.getStep(1, 8).note, Step::NOTE_EMPTY);
+    EXPECT_FALSE(UndoManager::instance().canUndo());
+}
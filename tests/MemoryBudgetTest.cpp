@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+#include <JuceHeader.h>
+#include "../src/audio/AudioEngine.h"
+#include "../src/model/DX7PresetBank.h"
+#include "../src/model/UndoManager.h"
+#include "../tools/StressProject.h"
+#include <string>
+
+// Memory budgets. Each is a ceiling with some headroom over what the
+// subsystem holds today, so a failure means something grew: raise the
+// budget if that was the intent, in the same change.
+
+namespace {
+
+constexpr size_t KiB = 1024;
+constexpr size_t MiB = 1024 * KiB;
+
+constexpr int kBlockSize = 512;
+constexpr double kSampleRate = 48000.0;
+
+// The reference project: every track playing through four Plaits
+// instruments, with every strip stage, send and the sidechain on
+model::Project makeReferenceProject() {
+    stress::StressConfig config;
+    config.type = model::InstrumentType::Plaits;
+    config.tracks = model::Pattern::NUM_TRACKS;
+    config.polyphony = 4;
+    config.strip = true;
+    config.effects = true;
+    auto project = stress::makeStressProject(config);
+    const int bus = project.addBus("Drums");
+    project.setInstrumentOutput(0, bus);
+    return project;
+}
+
+// Prepares the engine for the project and plays it for a second
+void play(audio::AudioEngine& engine, model::Project& project) {
+    engine.setProject(&project);
+    engine.prepareToPlay(kBlockSize, kSampleRate);
+    engine.setPlayMode(audio::AudioEngine::PlayMode::Pattern);
+    engine.play();
+
+    juce::AudioBuffer<float> buffer(2, kBlockSize);
+    const juce::AudioSourceChannelInfo info(&buffer, 0, kBlockSize);
+    for (int block = 0; block < static_cast<int>(kSampleRate) / kBlockSize; ++block)
+        engine.getNextAudioBlock(info);
+}
+
+} // namespace
+
+TEST(MemoryBudgetTest, ReferenceProjectEngine) {
+    auto project = makeReferenceProject();
+    audio::AudioEngine engine;
+    play(engine, project);
+
+    model::MemoryReport report;
+    engine.reportMemoryUsage(report);
+    engine.releaseResources();
+
+    const std::pair<const char*, size_t> budgets[] = {
+        {"Engine", 1 * MiB},
+        // Every slot's processor, whatever its type: Plaits holds 16 voices
+        // with a 32 KiB engine buffer each
+        {"Plaits instruments", 100 * MiB},
+        {"Sampler instruments", 8 * MiB},
+        {"Slicer instruments", 8 * MiB},
+        {"VA instruments", 4 * MiB},
+        {"DX7 instruments", 4 * MiB},
+        {"Track voices", 2 * MiB},
+        {"Channel strips", 1 * MiB},
+        {"Effects", 4 * MiB},         // Delay lines at 48 kHz
+        {"Mixer graph", 1 * MiB},
+    };
+    for (const auto& [subsystem, budget] : budgets) {
+        EXPECT_TRUE(report.has(subsystem)) << subsystem;
+        EXPECT_LE(report.get(subsystem), budget) << subsystem;
+    }
+
+    // Nothing is held for assets the project doesn't have
+    EXPECT_EQ(report.get("Samples"), 0u);
+    EXPECT_EQ(report.get("Slicer stretch cache"), 0u);
+    EXPECT_EQ(report.get("Convolution reverb"), 0u);
+    EXPECT_EQ(report.get("Preview clips"), 0u);
+
+    EXPECT_GT(report.get("Track voices"), 0u);
+    EXPECT_LE(report.getTotal(), 128 * MiB);
+}
+
+// A loaded sample is reported at its decoded size
+TEST(MemoryBudgetTest, SamplesCounted) {
+    constexpr int kChannels = 2;
+    constexpr int kLength = 48000;
+    const auto file = juce::File::createTempFile(".wav");
+    {
+        juce::AudioBuffer<float> audio(kChannels, kLength);
+        audio.clear();
+        juce::WavAudioFormat wav;
+        std::unique_ptr<juce::AudioFormatWriter> writer(
+            wav.createWriterFor(new juce::FileOutputStream(file), kSampleRate, kChannels, 16, {}, 0));
+        ASSERT_NE(writer, nullptr);
+        writer->writeFromAudioSampleBuffer(audio, 0, kLength);
+    }
+
+    model::Project project;
+    auto* instrument = project.getInstrument(0);
+    instrument->setType(model::InstrumentType::Sampler);
+    audio::AudioEngine engine;
+    engine.setProject(&project);
+    engine.prepareToPlay(kBlockSize, kSampleRate);
+
+    model::MemoryReport before;
+    engine.reportMemoryUsage(before);
+
+    auto* sampler = engine.getSamplerProcessor(0);
+    sampler->setInstrument(instrument);
+    ASSERT_TRUE(sampler->loadSample(file));
+
+    model::MemoryReport after;
+    engine.reportMemoryUsage(after);
+    engine.releaseResources();
+    file.deleteFile();
+
+    EXPECT_EQ(after.get("Samples") - before.get("Samples"), kChannels * kLength * sizeof(float));
+}
+
+// The bundled cartridges, with their search indexes
+TEST(MemoryBudgetTest, DX7PresetBank) {
+    model::DX7PresetBank bank;
+    bank.scanDirectory(VITRACKER_DX7_DIR, false);
+    ASSERT_GT(bank.getPresetCount(), 0);
+    EXPECT_LE(bank.getAllocatedBytes(), static_cast<size_t>(bank.getPresetCount()) * KiB);
+}
+
+// History is capped, however many edits are made
+TEST(MemoryBudgetTest, UndoHistory) {
+    auto& undo = model::UndoManager::instance();
+    undo.clear();
+    int value = 0;
+    for (int i = 0; i < 10000; ++i)
+        model::recordChange(&value, i, "Edit value " + std::to_string(i) + " of the reference project");
+
+    EXPECT_GT(undo.getAllocatedBytes(), 0u);
+    EXPECT_LE(undo.getAllocatedBytes(), 32 * KiB);
+    undo.clear();
+}
@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+#include "../src/dsp/RealFFT.h"
+#include "../src/dsp/AudioAnalysis.h"
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace dsp;
+
+namespace {
+
+std::vector<float> randomSignal(int size, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    std::vector<float> signal(static_cast<size_t>(size));
+    for (auto& sample : signal) {
+        sample = dist(rng);
+    }
+    return signal;
+}
+
+} // namespace
+
+// Forward transform matches a direct DFT, in the packed layout
+TEST(RealFFTTest, ForwardMatchesDirectDFT) {
+    for (int size = 4; size <= 4096; size *= 2) {
+        auto fft = RealFFT::forSize(size);
+        auto input = randomSignal(size, static_cast<unsigned>(size));
+        std::vector<float> spectrum(static_cast<size_t>(size));
+        fft->forward(input.data(), spectrum.data());
+
+        const int half = size / 2;
+        double maxError = 0.0;
+        double maxMagnitude = 0.0;
+        for (int k = 0; k <= half; ++k) {
+            double re = 0.0, im = 0.0;
+            for (int t = 0; t < size; ++t) {
+                double angle = 2.0 * M_PI * k * t / size;
+                re += input[static_cast<size_t>(t)] * std::cos(angle);
+                im -= input[static_cast<size_t>(t)] * std::sin(angle);
+            }
+            double gotRe = spectrum[static_cast<size_t>(k)];
+            double gotIm = (k == 0 || k == half) ? 0.0 : spectrum[static_cast<size_t>(half + k)];
+            maxError = std::max(maxError, std::hypot(gotRe - re, gotIm - im));
+            maxMagnitude = std::max(maxMagnitude, std::hypot(re, im));
+        }
+
+        EXPECT_LT(maxError / maxMagnitude, 1e-5) << "size " << size;
+    }
+}
+
+// inverse(forward(x)) == n * x, in place and out of place alike
+TEST(RealFFTTest, RoundTrip) {
+    for (int size = 4; size <= 16384; size *= 2) {
+        auto fft = RealFFT::forSize(size);
+        auto input = randomSignal(size, 7u);
+
+        std::vector<float> spectrum(static_cast<size_t>(size));
+        std::vector<float> output(static_cast<size_t>(size));
+        fft->forward(input.data(), spectrum.data());
+        fft->inverse(spectrum.data(), output.data());
+
+        std::vector<float> inPlace = input;
+        fft->forward(inPlace.data());
+        fft->inverse(inPlace.data());
+
+        float maxError = 0.0f;
+        for (size_t i = 0; i < input.size(); ++i) {
+            EXPECT_EQ(output[i], inPlace[i]);
+            maxError = std::max(maxError, std::abs(output[i] / static_cast<float>(size) - input[i]));
+        }
+        EXPECT_LT(maxError, 1e-5f) << "size " << size;
+    }
+}
+
+// Plans are built once per size and shared
+TEST(RealFFTTest, PlansAreCached) {
+    auto first = RealFFT::forSize(1024);
+    auto second = RealFFT::forSize(1024);
+    EXPECT_EQ(first.get(), second.get());
+    EXPECT_NE(first.get(), RealFFT::forSize(2048).get());
+    EXPECT_EQ(first->getSize(), 1024);
+
+    EXPECT_FALSE(RealFFT::isValidSize(2));
+    EXPECT_FALSE(RealFFT::isValidSize(1000));
+    EXPECT_TRUE(RealFFT::isValidSize(4));
+}
+
+// Multiplying spectra is circular convolution
+TEST(RealFFTTest, MultiplyAccumulateConvolves) {
+    constexpr int size = 64;
+    auto fft = RealFFT::forSize(size);
+    auto x = randomSignal(size, 1u);
+    auto h = randomSignal(size, 2u);
+
+    std::vector<float> xs(size), hs(size), acc(size, 0.0f), result(size);
+    fft->forward(x.data(), xs.data());
+    fft->forward(h.data(), hs.data());
+    RealFFT::multiplyAccumulate(xs.data(), hs.data(), acc.data(), size);
+    fft->inverse(acc.data(), result.data());
+
+    for (int n = 0; n < size; ++n) {
+        double expected = 0.0;
+        for (int m = 0; m < size; ++m) {
+            expected += x[static_cast<size_t>(m)] * h[static_cast<size_t>((n - m + size) % size)];
+        }
+        EXPECT_NEAR(result[static_cast<size_t>(n)] / size, expected, 1e-4) << "n " << n;
+    }
+}
+
+// The FFT-based YIN still finds the pitch of a harmonic tone
+TEST(RealFFTTest, PitchDetection) {
+    constexpr int sampleRate = 44100;
+    for (float frequency : {55.0f, 220.0f, 440.0f, 1000.0f}) {
+        std::vector<float> tone(sampleRate / 2);
+        for (size_t i = 0; i < tone.size(); ++i) {
+            double t = static_cast<double>(i) / sampleRate;
+            tone[i] = static_cast<float>(0.6 * std::sin(2.0 * M_PI * frequency * t)
+                                       + 0.3 * std::sin(4.0 * M_PI * frequency * t));
+        }
+        float detected = AudioAnalysis::detectPitch(tone.data(), tone.size(), sampleRate);
+        EXPECT_NEAR(detected, frequency, frequency * 0.01f) << "frequency " << frequency;
+    }
+}
+
+// Records the cost of the sizes the convolution reverb runs on the audio and
+// worker threads, against a budget of a quarter of the time the half-size
+// block they process lasts at 48 kHz - generous, so only a gross slowdown
+// (or an unoptimised build on a slow machine) fails it
+TEST(RealFFTTest, Benchmark) {
+    constexpr double sampleRate = 48000.0;
+    for (int size : {256, 1024, 8192}) {
+        auto fft = RealFFT::forSize(size);
+        auto data = randomSignal(size, 3u);
+        const float scale = 1.0f / static_cast<float>(size);
+
+        constexpr int iterations = 2000;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            fft->forward(data.data());
+            fft->inverse(data.data());
+            for (auto& sample : data) {
+                sample *= scale;
+            }
+        }
+        double micros = std::chrono::duration<double, std::micro>(
+            std::chrono::steady_clock::now() - start).count() / iterations;
+
+        RecordProperty("size" + std::to_string(size) + "_ns", static_cast<int>(micros * 1000.0));
+        const double budgetMicros = 0.25 * (size / 2) / sampleRate * 1.0e6;
+        EXPECT_LT(micros, budgetMicros) << "size " << size;
+        EXPECT_TRUE(std::isfinite(data[0]));
+    }
+}
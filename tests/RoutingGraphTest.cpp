@@ -0,0 +1,263 @@
+#include <gtest/gtest.h>
+#include "../src/audio/RoutingGraph.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace model;
+using audio::RoutingGraph;
+
+namespace {
+
+constexpr int kNumInstruments = 8;
+constexpr int kNumSamples = 64;
+constexpr float kDuckGain = 0.5f;
+
+// Eight instruments. Instruments 0-3 go to the Drums bus, which feeds the
+// Group bus (added first, so a bus is fed by a later one) with 4 and 5;
+// 6 and 7 go straight to the master. Instrument 0 keys the sidechain, which
+// ducks Group and instrument 7. Sends: 1 to the reverb, 6 to the delay and
+// Drums to the chorus
+Project makeBusProject() {
+    Project project;
+    for (int i = 1; i < kNumInstruments; ++i)
+        project.addInstrument("Instrument " + std::to_string(i + 1));
+
+    const int group = project.addBus("Group");
+    const int drums = project.addBus("Drums");
+    project.setBusOutput(drums, group);
+    for (int i = 0; i < 4; ++i)
+        project.setInstrumentOutput(i, drums);
+    project.setInstrumentOutput(4, group);
+    project.setInstrumentOutput(5, group);
+
+    auto& buses = project.getMixer().buses;
+    buses[static_cast<size_t>(group)].sends.sidechainDuck = 1.0f;
+    buses[static_cast<size_t>(drums)].sends.chorus = 0.4f;
+    project.getInstrument(0)->getSends().sidechainKey = 1.0f;
+    project.getInstrument(1)->getSends().reverb = 0.5f;
+    project.getInstrument(6)->getSends().delay = 0.3f;
+    project.getInstrument(7)->getSends().sidechainDuck = 1.0f;
+    return project;
+}
+
+// Eight buses in a line, one instrument into each
+Project makeChainProject() {
+    Project project;
+    for (int i = 1; i < kNumInstruments; ++i)
+        project.addInstrument("Instrument " + std::to_string(i + 1));
+    for (int b = 0; b < Project::MAX_BUSES; ++b) {
+        project.addBus("Bus " + std::to_string(b + 1));
+        if (b > 0)
+            project.setBusOutput(b, b - 1);
+        project.setInstrumentOutput(b, b);
+        project.getInstrument(b)->getSends().reverb = 0.2f;
+    }
+    return project;
+}
+
+float sourceSample(int instrument, int sample) {
+    return std::sin(0.05f * static_cast<float>((instrument + 1) * (sample + 1)))
+         + static_cast<float>(instrument);
+}
+
+// Last level each node is read at: its own where nothing reads it, as for
+// the key
+std::vector<int> lastUses(const RoutingGraph& graph) {
+    const auto& nodes = graph.getNodes();
+    std::vector<int> lastUse(nodes.size());
+    for (size_t id = 0; id < nodes.size(); ++id)
+        lastUse[id] = nodes[id].level;
+    for (const auto& node : nodes) {
+        for (int input : node.inputs)
+            lastUse[static_cast<size_t>(input)] = std::max(lastUse[static_cast<size_t>(input)], node.level);
+    }
+    return lastUse;
+}
+
+float sendLevel(const Project& project, const RoutingGraph::Node& source, int ret) {
+    const SendLevels& sends = source.type == RoutingGraph::NodeType::Instrument
+                                  ? project.getInstrument(source.index)->getSends()
+                                  : project.getMixer().buses[static_cast<size_t>(source.index)].sends;
+    return ret == RoutingGraph::ReverbReturn ? sends.reverb
+         : ret == RoutingGraph::DelayReturn  ? sends.delay
+         : ret == RoutingGraph::ChorusReturn ? sends.chorus
+                                             : sends.sidechainKey;
+}
+
+// Renders the graph as the engine does, minus the processing: instruments
+// write their source, buses and returns sum their inputs at unit or send
+// gain, and a ducked input is mixed in at kDuckGain (except into the key).
+// Each node overwrites its buffer, so a buffer shared with a node still to
+// be read shows up as a wrong mix
+void render(RoutingGraph& graph, const Project& project, std::vector<float>& outL, std::vector<float>& outR) {
+    auto mix = [&](int input, float* left, float* right, float gain) {
+        const auto& source = graph.getNode(input);
+        if (source.ducked)
+            gain *= kDuckGain;
+        for (int i = 0; i < kNumSamples; ++i) {
+            left[i] += gain * graph.getChannel(input, 0)[i];
+            right[i] += gain * graph.getChannel(input, 1)[i];
+        }
+    };
+
+    for (int level = 0; level < graph.getNumLevels(); ++level) {
+        for (int id : graph.getLevel(level)) {
+            const auto& node = graph.getNode(id);
+            float* left = graph.getChannel(id, 0);
+            float* right = graph.getChannel(id, 1);
+            for (int i = 0; i < kNumSamples; ++i) {
+                left[i] = node.type == RoutingGraph::NodeType::Instrument ? sourceSample(node.index, i) : 0.0f;
+                right[i] = -left[i];
+            }
+            for (int input : node.inputs) {
+                if (node.type == RoutingGraph::NodeType::Bus)
+                    mix(input, left, right, 1.0f);
+                else if (node.type == RoutingGraph::NodeType::Return)
+                    mix(input, left, right, sendLevel(project, graph.getNode(input), node.index));
+                else if (node.type == RoutingGraph::NodeType::Key) {
+                    const float gain = sendLevel(project, graph.getNode(input), RoutingGraph::NumReturns);
+                    for (int i = 0; i < kNumSamples; ++i) {
+                        left[i] += gain * graph.getChannel(input, 0)[i];
+                        right[i] += gain * graph.getChannel(input, 1)[i];
+                    }
+                }
+            }
+        }
+    }
+
+    outL.assign(kNumSamples, 0.0f);
+    outR.assign(kNumSamples, 0.0f);
+    for (int input : graph.getNode(graph.getMasterNode()).inputs)
+        mix(input, outL.data(), outR.data(), 1.0f);
+}
+
+void expectLevelsFollowInputs(const RoutingGraph& graph) {
+    const auto& nodes = graph.getNodes();
+    const int master = graph.getMasterNode();
+    const int key = graph.getKeyNode();
+    for (int id = 0; id < static_cast<int>(nodes.size()); ++id) {
+        const auto& node = nodes[static_cast<size_t>(id)];
+        if (node.type == RoutingGraph::NodeType::Instrument) {
+            EXPECT_EQ(node.level, 0) << id;
+        }
+        for (int input : node.inputs) {
+            const auto& source = nodes[static_cast<size_t>(input)];
+            EXPECT_LT(source.level, node.level) << input << " -> " << id;
+            if (source.ducked && id != key) {
+                EXPECT_LT(graph.getNode(key).level, node.level) << input << " -> " << id;
+            }
+        }
+        if (id != master) {
+            EXPECT_LT(node.level, graph.getNode(master).level) << id;
+        }
+    }
+
+    // Every node but the master in exactly the level it names
+    std::vector<int> seen(nodes.size(), 0);
+    for (int level = 0; level < graph.getNumLevels(); ++level) {
+        for (int id : graph.getLevel(level)) {
+            EXPECT_EQ(graph.getNode(id).level, level) << id;
+            ++seen[static_cast<size_t>(id)];
+        }
+    }
+    for (int id = 0; id < master; ++id)
+        EXPECT_EQ(seen[static_cast<size_t>(id)], 1) << id;
+    EXPECT_EQ(seen[static_cast<size_t>(master)], 0);
+}
+
+void expectBuffersDontOverlap(const RoutingGraph& graph) {
+    const auto& nodes = graph.getNodes();
+    const auto lastUse = lastUses(graph);
+    const int master = graph.getMasterNode();
+    EXPECT_EQ(graph.getNode(master).buffer, -1);
+    for (int a = 0; a < master; ++a) {
+        const auto& first = nodes[static_cast<size_t>(a)];
+        ASSERT_GE(first.buffer, 0) << a;
+        ASSERT_LT(first.buffer, graph.getNumBuffers()) << a;
+        for (int b = a + 1; b < master; ++b) {
+            const auto& second = nodes[static_cast<size_t>(b)];
+            if (first.buffer != second.buffer)
+                continue;
+            const bool overlap = first.level <= lastUse[static_cast<size_t>(b)]
+                              && second.level <= lastUse[static_cast<size_t>(a)];
+            EXPECT_FALSE(overlap) << a << " and " << b << " share buffer " << first.buffer;
+        }
+    }
+}
+
+} // namespace
+
+TEST(RoutingGraphTest, LevelsFollowInputs) {
+    for (const auto& project : {Project(), makeBusProject(), makeChainProject()}) {
+        auto graph = RoutingGraph::compile(project);
+        expectLevelsFollowInputs(*graph);
+    }
+}
+
+TEST(RoutingGraphTest, BusProjectWiring) {
+    const auto project = makeBusProject();
+    auto graph = RoutingGraph::compile(project);
+
+    const int group = graph->getBusNode(0);
+    const int drums = graph->getBusNode(1);
+    EXPECT_EQ(graph->getNode(drums).inputs, (std::vector<int>{0, 1, 2, 3}));
+    EXPECT_EQ(graph->getNode(group).inputs, (std::vector<int>{4, 5, drums}));
+    EXPECT_EQ(graph->getNode(graph->getKeyNode()).inputs, std::vector<int>{0});
+    EXPECT_TRUE(graph->getNode(group).ducked);
+    EXPECT_TRUE(graph->getNode(7).ducked);
+    EXPECT_FALSE(graph->getNode(drums).ducked);
+
+    // Drums waits for its instruments, Group for Drums, the master for
+    // Group and the key both
+    EXPECT_EQ(graph->getNode(drums).level, 1);
+    EXPECT_EQ(graph->getNode(group).level, 2);
+    EXPECT_GT(graph->getNode(graph->getMasterNode()).level, graph->getNode(group).level);
+}
+
+TEST(RoutingGraphTest, BuffersDontOverlap) {
+    for (const auto& project : {Project(), makeBusProject(), makeChainProject()}) {
+        auto graph = RoutingGraph::compile(project);
+        expectBuffersDontOverlap(*graph);
+    }
+
+    // The buses in a line each free the one before: fewer buffers than nodes
+    auto graph = RoutingGraph::compile(makeChainProject());
+    EXPECT_LT(graph->getNumBuffers(), graph->getMasterNode());
+}
+
+// Through the buses, with buffers shared, the master hears what it would
+// with every channel mixed in directly
+TEST(RoutingGraphTest, BusRendersAsFlatMix) {
+    const auto project = makeBusProject();
+    auto graph = RoutingGraph::compile(project);
+    std::vector<float> left, right;
+    render(*graph, project, left, right);
+
+    for (int i = 0; i < kNumSamples; ++i) {
+        float s[kNumInstruments];
+        for (int n = 0; n < kNumInstruments; ++n)
+            s[n] = sourceSample(n, i);
+
+        const float dry = kDuckGain * (s[0] + s[1] + s[2] + s[3] + s[4] + s[5]) + s[6] + kDuckGain * s[7];
+        const float reverb = 0.5f * s[1];
+        const float delay = 0.3f * s[6];
+        const float chorus = 0.4f * (s[0] + s[1] + s[2] + s[3]);
+        const float expected = dry + reverb + delay + chorus;
+        EXPECT_NEAR(left[static_cast<size_t>(i)], expected, 1.0e-4f) << i;
+        EXPECT_NEAR(right[static_cast<size_t>(i)], -expected, 1.0e-4f) << i;
+    }
+}
+
+TEST(RoutingGraphTest, ChainRendersAsFlatMix) {
+    const auto project = makeChainProject();
+    auto graph = RoutingGraph::compile(project);
+    std::vector<float> left, right;
+    render(*graph, project, left, right);
+
+    for (int i = 0; i < kNumSamples; ++i) {
+        float expected = 0.0f;
+        for (int n = 0; n < kNumInstruments; ++n)
+            expected += 1.2f * sourceSample(n, i);
+        EXPECT_NEAR(left[static_cast<size_t>(i)], expected, 1.0e-3f) << i;
+    }
+}
@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include "../src/model/Project.h"
+
+using namespace model;
+
+namespace {
+
+Step stepWithInstrument(int instrument) {
+    Step step;
+    step.note = 60;
+    step.instrument = static_cast<int16_t>(instrument);
+    return step;
+}
+
+} // namespace
+
+// Three patterns and two chains, indexed once
+class UsageIndexTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        project.addPattern("Pattern 2");
+        project.addPattern("Pattern 3");
+        project.addChain("Chain 2");
+        refresh();
+    }
+
+    const UsageIndex& refresh() { return project.getUsageIndex(); }
+
+    Project project;
+};
+
+// Reads through either getStep() aren't edits; setStep() and markEdited() are
+TEST_F(UsageIndexTest, ReadingStepsKeepsRevision) {
+    Pattern& pattern = *project.getPattern(0);
+    const uint64_t revision = pattern.getRevision();
+
+    for (int track = 0; track < Pattern::NUM_TRACKS; ++track) {
+        for (int row = 0; row < pattern.getLength(); ++row) {
+            EXPECT_EQ(pattern.getStep(track, row).note, Step::NOTE_EMPTY);
+            EXPECT_EQ(static_cast<const Pattern&>(pattern).getStep(track, row).note, Step::NOTE_EMPTY);
+        }
+    }
+    EXPECT_EQ(pattern.getRevision(), revision);
+
+    pattern.setStep(0, 0, stepWithInstrument(1));
+    EXPECT_NE(pattern.getRevision(), revision);
+
+    const uint64_t edited = pattern.getRevision();
+    pattern.markEdited();
+    EXPECT_NE(pattern.getRevision(), edited);
+}
+
+// Nothing edited, nothing rescanned, and the index revision stands
+TEST_F(UsageIndexTest, UnchangedRefreshRescansNothing) {
+    const uint64_t revision = refresh().getRevision();
+
+    for (int row = 0; row < 16; ++row)
+        static_cast<void>(project.getPattern(1)->getStep(0, row));
+
+    EXPECT_EQ(refresh().getLastRescanCount(), 0);
+    EXPECT_EQ(refresh().getRevision(), revision);
+}
+
+TEST_F(UsageIndexTest, RescansOnlyEditedPatterns) {
+    project.getPattern(1)->setStep(2, 4, stepWithInstrument(5));
+
+    const auto& usage = refresh();
+    EXPECT_EQ(usage.getLastRescanCount(), 1);
+    EXPECT_EQ(usage.getPatternsUsingInstrument(5), std::vector<int>{1});
+
+    const auto steps = usage.getStepsUsingInstrument(5);
+    ASSERT_EQ(steps.size(), 1u);
+    EXPECT_EQ(steps[0].pattern, 1);
+    EXPECT_EQ(steps[0].track, 2);
+    EXPECT_EQ(steps[0].row, 4);
+}
+
+// A write through getStep() alone is only picked up once marked, so an
+// unmarked pattern is never rescanned
+TEST_F(UsageIndexTest, UnmarkedWritesAreNotRescanned) {
+    project.getPattern(0)->getStep(0, 0) = stepWithInstrument(6);
+    project.getPattern(2)->getStep(0, 0) = stepWithInstrument(7);
+    project.getPattern(2)->markEdited();
+
+    const auto& usage = refresh();
+    EXPECT_EQ(usage.getLastRescanCount(), 1);
+    EXPECT_FALSE(usage.isInstrumentUsed(6));
+    EXPECT_EQ(usage.getPatternsUsingInstrument(7), std::vector<int>{2});
+}
+
+TEST_F(UsageIndexTest, RescansOnlyEditedChains) {
+    project.getChain(1)->addPattern(2);
+
+    const auto& usage = refresh();
+    EXPECT_EQ(usage.getLastRescanCount(), 1);
+    EXPECT_EQ(usage.getChainsUsingPattern(2), std::vector<int>{1});
+    EXPECT_TRUE(usage.isPatternUsed(2));
+}
+
+// Song reachability follows chain -> pattern -> instrument
+TEST_F(UsageIndexTest, SongInstrumentsFollowChains) {
+    project.getPattern(2)->setStep(0, 0, stepWithInstrument(3));
+    project.getChain(1)->addPattern(2);
+    EXPECT_FALSE(refresh().getInstrumentsInSong().test(3));
+
+    project.getSong().setChain(0, 0, 1);
+    const auto& usage = refresh();
+    EXPECT_EQ(usage.getLastRescanCount(), 0);
+    EXPECT_TRUE(usage.getInstrumentsInSong().test(3));
+    EXPECT_TRUE(usage.isChainUsed(1));
+}
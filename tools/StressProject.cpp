@@ -0,0 +1,124 @@
+#include "StressProject.h"
+#include <algorithm>
+#include <random>
+
+namespace stress {
+
+namespace {
+
+constexpr int kPatternLength = 64;
+constexpr float kTempo = 140.0f;
+constexpr int kLowestNote = 36;
+constexpr int kNoteRange = 48;
+constexpr int kMaxInstrumentPolyphony = 16;
+
+void setUpInstrument(model::Instrument& instrument, const StressConfig& config, int index)
+{
+    instrument.setType(config.type);
+    instrument.getParams().decay = 1.0f;          // Plaits: ring until the next note
+    instrument.getParams().polyphony = std::min(config.polyphony, kMaxInstrumentPolyphony);
+    instrument.getVAParams().ampEnv.sustain = 1.0f;
+    instrument.getVAParams().filter.resonance = 0.5f;
+
+    if (config.strip)
+    {
+        auto& strip = instrument.getChannelStrip();
+        strip.hpfFreq = 40.0f;
+        strip.hpfSlope = 2;
+        strip.lowShelfGain = 3.0f;
+        strip.midGain = -3.0f;
+        strip.highShelfGain = 2.0f;
+        strip.driveAmount = 0.4f;
+        strip.punchAmount = 0.5f;
+        strip.ottLowDepth = 0.6f;
+        strip.ottMidDepth = 0.6f;
+        strip.ottHighDepth = 0.6f;
+        strip.ottLink = true;
+    }
+
+    if (config.effects)
+    {
+        // The first instrument keys the sidechain and ducks the rest
+        auto& sends = instrument.getSends();
+        sends.reverb = 0.3f;
+        sends.delay = 0.3f;
+        sends.chorus = 0.3f;
+        if (index == 0)
+            sends.sidechainKey = 1.0f;
+        else
+            sends.sidechainDuck = 0.8f;
+    }
+}
+
+} // anonymous namespace
+
+model::Project makeStressProject(const StressConfig& config)
+{
+    model::Project project("Stress");
+    project.setTempo(kTempo);
+
+    const int numInstruments = config.getNumInstruments();
+    for (int i = 0; i < numInstruments; ++i)
+    {
+        if (i >= project.getInstrumentCount())
+            project.addInstrument("Stress " + std::to_string(i));
+        setUpInstrument(*project.getInstrument(i), config, i);
+    }
+
+    // Every track starts with a note, so each voice sounds from the first row
+    std::mt19937 random(config.seed);
+    std::uniform_real_distribution<float> chance(0.0f, 1.0f);
+    auto* pattern = project.getPattern(0);
+    pattern->setLength(kPatternLength);
+    for (int track = 0; track < config.tracks; ++track)
+    {
+        for (int row = 0; row < kPatternLength; ++row)
+        {
+            const bool play = row == 0 || chance(random) < config.density;
+            const int note = kLowestNote + static_cast<int>(random() % kNoteRange);
+            if (!play)
+                continue;
+            auto& step = pattern->getStep(track, row);
+            step.note = static_cast<int8_t>(note);
+            step.instrument = static_cast<int16_t>(track / config.polyphony);
+        }
+    }
+    pattern->markEdited();
+    return project;
+}
+
+std::vector<LiveNote> getLiveNotes(const StressConfig& config)
+{
+    // Seeded apart from the pattern, so adding live voices leaves it as it was
+    std::mt19937 random(config.seed + 1);
+    std::vector<LiveNote> notes;
+    for (int voice = config.tracks; voice < config.getNumVoices(); ++voice)
+        notes.push_back({voice / config.polyphony, kLowestNote + static_cast<int>(random() % kNoteRange)});
+    return notes;
+}
+
+const char* getTypeName(model::InstrumentType type)
+{
+    switch (type)
+    {
+        case model::InstrumentType::Plaits: return "plaits";
+        case model::InstrumentType::VASynth: return "va";
+        case model::InstrumentType::DXPreset: return "dx7";
+        default: return "?";
+    }
+}
+
+bool parseType(const std::string& name, model::InstrumentType& type)
+{
+    if (name == "plaits")
+        type = model::InstrumentType::Plaits;
+    else if (name == "va")
+        type = model::InstrumentType::VASynth;
+    else if (name == "dx7")
+        type = model::InstrumentType::DXPreset;
+    else
+        return false;
+    return true;
+}
+
+} // namespace stress
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "model/Project.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace stress {
+
+// One worst-case project shape for the capacity test
+struct StressConfig
+{
+    model::InstrumentType type = model::InstrumentType::VASynth;
+    int tracks = 16;          // Pattern tracks playing, one voice each (1-16)
+    int liveVoices = 0;       // Held notes on the engine's live tracks, after the pattern's
+    int polyphony = 1;        // Voices sharing each instrument
+    bool strip = false;       // Every channel strip stage on
+    bool effects = false;     // Every send on, and sidechain ducking
+    float density = 1.0f;     // Chance of a new note on each row of each track
+    uint32_t seed = 1;
+
+    int getNumVoices() const { return tracks + liveVoices; }
+    int getNumInstruments() const { return (getNumVoices() + polyphony - 1) / polyphony; }
+};
+
+// Builds a one-pattern project for config: voices share instruments
+// polyphony at a time, and notes are held until the next one so every track
+// keeps a voice sounding. The same config (seed included) always gives the
+// same project
+model::Project makeStressProject(const StressConfig& config);
+
+// The notes to hold on the live tracks, one per live voice, for as long as
+// the project plays. Also the same for the same config
+struct LiveNote
+{
+    int instrument;
+    int note;
+};
+std::vector<LiveNote> getLiveNotes(const StressConfig& config);
+
+// "plaits", "va" or "dx7" - the synth types, which need no sample data
+const char* getTypeName(model::InstrumentType type);
+bool parseType(const std::string& name, model::InstrumentType& type);
+
+} // namespace stress
@@ -0,0 +1,437 @@
+// Headless capacity test. For every combination of the listed instrument
+// types, polyphonies, strip and effects settings, note densities and block
+// sizes, it adds voices until the engine no longer keeps up, and writes one
+// CSV row per combination: the most voices it sustained and the block times
+// at that load. Voices are pattern tracks, then held notes on the engine's
+// live tracks; a row that sustains all of them is marked saturated, as the
+// machine could take more than the engine can play.
+//
+//   VitrackerStress [--mode offline,realtime] [--types va,plaits,dx7]
+//                   [--polyphony 1,4,16] [--strip off,on] [--fx off,on]
+//                   [--density 0.25,1] [--blocks 64,128,256,512]
+//                   [--rate 48000] [--seconds 5] [--warmup 1]
+//                   [--headroom 0.8] [--seed 1] [--out results.csv]
+//
+// offline renders blocks back to back: a block taking longer than the audio
+// it renders is an xrun. realtime renders on a realtime thread woken at the
+// device's block rate: a block not ready by the time the device would play
+// it is an xrun. A load is sustained with no xruns and the 99th percentile
+// block time within --headroom of the block's duration. Projects come from
+// --seed, so runs are repeatable; timings are as repeatable as the machine.
+//
+//   VitrackerStress --memory [--project song.vit] [...]
+//
+// instead renders one project (--project, with its samples, or the project
+// generated from the first of each list with every track playing) for
+// --warmup plus --seconds at the first block size, then writes the engine's
+// memory by subsystem as CSV.
+
+#include <JuceHeader.h>
+#include "StressProject.h"
+#include "audio/AudioEngine.h"
+#include "model/ProjectSerializer.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Pattern tracks first, then the live tracks
+constexpr int kMaxVoices = audio::AudioEngine::NUM_TRACKS + audio::AudioEngine::NUM_LIVE_TRACKS;
+
+enum class Mode { Offline, Realtime };
+
+struct Options
+{
+    std::vector<Mode> modes{Mode::Offline};
+    std::vector<model::InstrumentType> types{model::InstrumentType::VASynth,
+                                             model::InstrumentType::Plaits,
+                                             model::InstrumentType::DXPreset};
+    std::vector<int> polyphonies{1, 4, 16};
+    std::vector<bool> strips{false, true};
+    std::vector<bool> effects{false, true};
+    std::vector<float> densities{0.25f, 1.0f};
+    std::vector<int> blockSizes{64, 128, 256, 512};
+    double sampleRate = 48000.0;
+    double seconds = 5.0;
+    double warmup = 1.0;     // Rendered first and not measured
+    double headroom = 0.8;   // Of the block's duration, at the 99th percentile
+    uint32_t seed = 1;
+    juce::File out;          // stdout if not set
+    juce::File project;      // --memory: measured instead of a generated one
+};
+
+struct Measurement
+{
+    std::vector<double> blockMs;  // Measured blocks, sorted
+    int xruns = 0;
+
+    double percentile(double p) const
+    {
+        if (blockMs.empty())
+            return 0.0;
+        const auto rank = static_cast<size_t>(std::ceil(p / 100.0 * static_cast<double>(blockMs.size())));
+        return blockMs[std::clamp<size_t>(rank, 1, blockMs.size()) - 1];
+    }
+};
+
+class BodyThread : public juce::Thread
+{
+public:
+    explicit BodyThread(std::function<void()> body)
+        : juce::Thread("Stress render"), body_(std::move(body))
+    {
+    }
+
+private:
+    void run() override { body_(); }
+
+    std::function<void()> body_;
+};
+
+// Runs body on a realtime thread (a normal high priority one if that isn't
+// permitted), as a device would call the engine, and waits for it
+void runOnRealtimeThread(int blockSize, double sampleRate, std::function<void()> body)
+{
+    BodyThread thread(std::move(body));
+    const auto options = juce::Thread::RealtimeOptions{}
+                             .withApproximateAudioProcessingTime(blockSize, sampleRate);
+    if (!thread.startRealtimeThread(options))
+        thread.startThread(juce::Thread::Priority::highest);
+    thread.waitForThreadToExit(-1);
+}
+
+Measurement measure(model::Project& project, const std::vector<stress::LiveNote>& liveNotes, Mode mode,
+                    int blockSize, const Options& options)
+{
+    audio::AudioEngine engine;
+    engine.setProject(&project);
+    const auto& usage = project.getUsageIndex();
+    auto reachable = usage.getInstrumentsInSong() | usage.getInstrumentsInPattern(0);
+    for (const auto& note : liveNotes)
+        reachable.set(static_cast<size_t>(note.instrument));
+    engine.setReachableInstruments(reachable);
+    engine.prepareToPlay(blockSize, options.sampleRate);
+    engine.setPlayMode(audio::AudioEngine::PlayMode::Pattern);
+    engine.play();
+    for (size_t i = 0; i < liveNotes.size(); ++i)
+        engine.triggerNote(audio::AudioEngine::NUM_TRACKS + static_cast<int>(i), liveNotes[i].note,
+                           liveNotes[i].instrument, 1.0f);
+
+    juce::AudioBuffer<float> buffer(2, blockSize);
+    const juce::AudioSourceChannelInfo info(&buffer, 0, blockSize);
+    const int warmupBlocks = static_cast<int>(options.warmup * options.sampleRate / blockSize);
+    const int numBlocks = warmupBlocks + static_cast<int>(options.seconds * options.sampleRate / blockSize);
+    const auto period = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(blockSize / options.sampleRate));
+
+    Measurement result;
+    result.blockMs.reserve(static_cast<size_t>(numBlocks));
+    auto render = [&]() {
+        juce::ScopedNoDenormals noDenormals;
+        // Block k is asked for when block k - 1 starts playing, and must be
+        // ready when that finishes
+        auto deadline = Clock::now() + period;
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            const auto start = Clock::now();
+            engine.getNextAudioBlock(info);
+            const auto end = Clock::now();
+
+            const bool late = mode == Mode::Offline ? end - start > period : end > deadline;
+            if (block >= warmupBlocks)
+            {
+                result.blockMs.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+                result.xruns += late ? 1 : 0;
+            }
+            if (mode == Mode::Realtime)
+            {
+                if (late)
+                    deadline = end;  // The device skips ahead rather than falling further behind
+                std::this_thread::sleep_until(deadline);
+                deadline += period;
+            }
+        }
+    };
+
+    if (mode == Mode::Realtime)
+        runOnRealtimeThread(blockSize, options.sampleRate, render);
+    else
+        render();
+
+    engine.releaseResources();
+    std::sort(result.blockMs.begin(), result.blockMs.end());
+    return result;
+}
+
+// Samples are decoded here, on this thread - there is no message loop to
+// finish a background load. The slicers' stretch cache is built by such a
+// load, so it isn't filled in
+void loadSamples(model::Project& project, audio::AudioEngine& engine)
+{
+    for (int i = 0; i < project.getInstrumentCount(); ++i)
+    {
+        auto* instrument = project.getInstrument(i);
+        if (instrument->getType() == model::InstrumentType::Sampler)
+        {
+            const juce::File file(instrument->getSamplerParams().sample.path);
+            auto* sampler = engine.getSamplerProcessor(i);
+            if (sampler && file.existsAsFile())
+            {
+                sampler->setInstrument(instrument);
+                sampler->loadSample(file);
+            }
+        }
+        else if (instrument->getType() == model::InstrumentType::Slicer)
+        {
+            const juce::File file(instrument->getSlicerParams().sample.path);
+            auto* slicer = engine.getSlicerProcessor(i);
+            if (slicer && file.existsAsFile())
+            {
+                slicer->setInstrument(instrument);
+                slicer->loadSample(file);
+            }
+        }
+    }
+}
+
+model::MemoryReport measureMemory(model::Project& project, const Options& options)
+{
+    const int blockSize = options.blockSizes.front();
+    audio::AudioEngine engine;
+    engine.setProject(&project);
+    engine.prepareToPlay(blockSize, options.sampleRate);
+    loadSamples(project, engine);
+    engine.setPlayMode(audio::AudioEngine::PlayMode::Pattern);
+    engine.play();
+
+    juce::AudioBuffer<float> buffer(2, blockSize);
+    const juce::AudioSourceChannelInfo info(&buffer, 0, blockSize);
+    const int numBlocks = static_cast<int>((options.warmup + options.seconds) * options.sampleRate / blockSize);
+    for (int block = 0; block < numBlocks; ++block)
+        engine.getNextAudioBlock(info);
+
+    model::MemoryReport report;
+    engine.reportMemoryUsage(report);
+    engine.releaseResources();
+    return report;
+}
+
+bool isSustained(const Measurement& measurement, int blockSize, const Options& options)
+{
+    const double budgetMs = 1000.0 * blockSize / options.sampleRate;
+    return measurement.xruns == 0 && measurement.percentile(99.0) <= options.headroom * budgetMs;
+}
+
+juce::StringArray splitList(const juce::String& list)
+{
+    return juce::StringArray::fromTokens(list, ",", "");
+}
+
+bool parseOptions(const juce::ArgumentList& args, Options& options)
+{
+    bool ok = true;
+    auto listOf = [&](const char* option, auto& values, auto parse) {
+        const auto value = args.getValueForOption(option);
+        if (value.isEmpty())
+            return;
+        values.clear();
+        for (const auto& token : splitList(value))
+        {
+            typename std::decay_t<decltype(values)>::value_type parsed{};
+            if (parse(token.trim(), parsed))
+                values.push_back(parsed);
+            else
+                ok = false;
+        }
+        ok = ok && !values.empty();
+    };
+    auto onOff = [](const juce::String& token, bool& value) {
+        value = token == "on";
+        return token == "on" || token == "off";
+    };
+
+    listOf("--mode", options.modes, [](const juce::String& token, Mode& mode) {
+        mode = token == "realtime" ? Mode::Realtime : Mode::Offline;
+        return token == "realtime" || token == "offline";
+    });
+    listOf("--types", options.types, [](const juce::String& token, model::InstrumentType& type) {
+        return stress::parseType(token.toStdString(), type);
+    });
+    listOf("--polyphony", options.polyphonies, [](const juce::String& token, int& polyphony) {
+        polyphony = token.getIntValue();
+        return polyphony >= 1 && polyphony <= kMaxVoices;
+    });
+    listOf("--strip", options.strips, onOff);
+    listOf("--fx", options.effects, onOff);
+    listOf("--density", options.densities, [](const juce::String& token, float& density) {
+        density = token.getFloatValue();
+        return density > 0.0f && density <= 1.0f;
+    });
+    listOf("--blocks", options.blockSizes, [](const juce::String& token, int& blockSize) {
+        blockSize = token.getIntValue();
+        return blockSize >= 16 && blockSize <= 4096;
+    });
+
+    auto number = [&](const char* option, double& value, double min) {
+        const auto text = args.getValueForOption(option);
+        if (text.isNotEmpty())
+            value = text.getDoubleValue();
+        ok = ok && value >= min;
+    };
+    number("--rate", options.sampleRate, 8000.0);
+    number("--seconds", options.seconds, 0.1);
+    number("--warmup", options.warmup, 0.0);
+    number("--headroom", options.headroom, 0.01);
+
+    if (args.containsOption("--seed"))
+        options.seed = static_cast<uint32_t>(args.getValueForOption("--seed").getLargeIntValue());
+    if (args.containsOption("--out"))
+        options.out = args.getFileForOption("--out");
+    if (args.containsOption("--project"))
+        options.project = args.getFileForOption("--project");
+    return ok;
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    juce::ArgumentList args(argc, argv);
+    Options options;
+    if (args.containsOption("--help|-h") || !parseOptions(args, options))
+    {
+        std::cerr << "Usage: VitrackerStress [--mode offline,realtime] [--types va,plaits,dx7]\n"
+                     "         [--polyphony 1,4,16] [--strip off,on] [--fx off,on] [--density 0.25,1]\n"
+                     "         [--blocks 64,128,256,512] [--rate 48000] [--seconds 5] [--warmup 1]\n"
+                     "         [--headroom 0.8] [--seed 1] [--out results.csv]\n"
+                     "       VitrackerStress --memory [--project song.vit] [options as above]\n";
+        return args.containsOption("--help|-h") ? 0 : 1;
+    }
+
+    std::unique_ptr<juce::FileOutputStream> file;
+    if (options.out != juce::File())
+    {
+        options.out.deleteFile();
+        file = std::make_unique<juce::FileOutputStream>(options.out);
+        if (!file->openedOk())
+        {
+            std::cerr << "Can't write " << options.out.getFullPathName() << "\n";
+            return 1;
+        }
+    }
+    auto writeLine = [&](const juce::String& line) {
+        if (file)
+        {
+            file->writeText(line + "\n", false, false, nullptr);
+            file->flush();
+        }
+        else
+        {
+            std::cout << line << std::endl;
+        }
+    };
+
+    if (args.containsOption("--memory"))
+    {
+        model::Project project;
+        if (options.project != juce::File())
+        {
+            if (!model::ProjectSerializer::load(project, options.project))
+            {
+                std::cerr << "Can't read " << options.project.getFullPathName() << "\n";
+                return 1;
+            }
+        }
+        else
+        {
+            stress::StressConfig config;
+            config.type = options.types.front();
+            config.tracks = model::Pattern::NUM_TRACKS;
+            config.polyphony = options.polyphonies.front();
+            config.strip = options.strips.front();
+            config.effects = options.effects.front();
+            config.density = options.densities.front();
+            config.seed = options.seed;
+            project = stress::makeStressProject(config);
+        }
+
+        const auto report = measureMemory(project, options);
+        writeLine("subsystem,bytes");
+        for (const auto& entry : report.getEntries())
+            writeLine(juce::String(entry.subsystem) + "," + juce::String(static_cast<juce::int64>(entry.bytes)));
+        writeLine("total," + juce::String(static_cast<juce::int64>(report.getTotal())));
+        return 0;
+    }
+
+    writeLine("mode,type,polyphony,strip,fx,density,block,rate,max_voices,saturated,instruments,"
+              "p50_ms,p95_ms,p99_ms,max_ms,p99_load,xruns");
+
+    for (auto mode : options.modes)
+    for (auto type : options.types)
+    for (int polyphony : options.polyphonies)
+    for (bool strip : options.strips)
+    for (bool effects : options.effects)
+    for (float density : options.densities)
+    for (int blockSize : options.blockSizes)
+    {
+        stress::StressConfig config;
+        config.type = type;
+        config.polyphony = polyphony;
+        config.strip = strip;
+        config.effects = effects;
+        config.density = density;
+        config.seed = options.seed;
+
+        // Voices are the load. Stop at the first count that isn't sustained;
+        // report the last that was (or one voice)
+        int maxVoices = 0;
+        Measurement atMax;
+        for (int voices = 1; voices <= kMaxVoices; ++voices)
+        {
+            config.tracks = std::min(voices, model::Pattern::NUM_TRACKS);
+            config.liveVoices = voices - config.tracks;
+            auto project = stress::makeStressProject(config);
+            auto measurement = measure(project, stress::getLiveNotes(config), mode, blockSize, options);
+            const bool sustained = isSustained(measurement, blockSize, options);
+            std::cerr << stress::getTypeName(type) << " poly " << polyphony << " block " << blockSize
+                      << ": " << voices << " voices, p99 " << measurement.percentile(99.0) << " ms, "
+                      << measurement.xruns << " xruns" << (sustained ? "" : " - not sustained") << "\n";
+            if (!sustained && voices > 1)
+                break;
+            atMax = std::move(measurement);
+            if (!sustained)
+                break;
+            maxVoices = voices;
+        }
+
+        const bool saturated = maxVoices == kMaxVoices;
+        config.tracks = std::min(std::max(1, maxVoices), model::Pattern::NUM_TRACKS);
+        config.liveVoices = std::max(1, maxVoices) - config.tracks;
+        const double budgetMs = 1000.0 * blockSize / options.sampleRate;
+        juce::StringArray row;
+        row.add(mode == Mode::Realtime ? "realtime" : "offline");
+        row.add(stress::getTypeName(type));
+        row.add(juce::String(polyphony));
+        row.add(strip ? "on" : "off");
+        row.add(effects ? "on" : "off");
+        row.add(juce::String(density));
+        row.add(juce::String(blockSize));
+        row.add(juce::String(options.sampleRate));
+        row.add(juce::String(maxVoices));
+        row.add(saturated ? "yes" : "no");
+        row.add(juce::String(config.getNumInstruments()));
+        for (double p : {50.0, 95.0, 99.0, 100.0})
+            row.add(juce::String(atMax.percentile(p), 4));
+        row.add(juce::String(atMax.percentile(99.0) / budgetMs, 3));
+        row.add(juce::String(atMax.xruns));
+        writeLine(row.joinIntoString(","));
+    }
+    return 0;
+}